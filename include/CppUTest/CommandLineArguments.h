@@ -52,11 +52,21 @@ public:
     bool isShuffling() const;
     bool isReversing() const;
     size_t getShuffleSeed() const;
+    size_t getFuzzRuns() const;
+    const SimpleString& getCorpusDirectory() const;
+    unsigned int getFuzzSeed() const;
+    size_t getPropertyRuns() const;
+    unsigned int getPropertySeed() const;
+    size_t getTestTimeout() const;
     const TestFilter* getGroupFilters() const;
     const TestFilter* getNameFilters() const;
+    const TestFilter* getTestFilters() const;
     bool isJUnitOutput() const;
+    bool isJUnitSingleFileOutput() const;
     bool isEclipseOutput() const;
     bool isTeamCityOutput() const;
+    bool isJsonOutput() const;
+    bool isBinaryOutput() const;
     bool runTestsInSeperateProcess() const;
     const SimpleString& getPackageName() const;
     const char* usage() const;
@@ -66,7 +76,7 @@ private:
 
     enum OutputType
     {
-        OUTPUT_ECLIPSE, OUTPUT_JUNIT, OUTPUT_TEAMCITY
+        OUTPUT_ECLIPSE, OUTPUT_JUNIT, OUTPUT_JUNIT_SINGLE_FILE, OUTPUT_TEAMCITY, OUTPUT_JSON, OUTPUT_BINARY
     };
 
     int ac_;
@@ -85,14 +95,27 @@ private:
     bool shufflingPreSeeded_;
     size_t repeat_;
     size_t shuffleSeed_;
+    size_t fuzzRuns_;
+    SimpleString corpusDirectory_;
+    unsigned int fuzzSeed_;
+    size_t propertyRuns_;
+    unsigned int propertySeed_;
+    size_t testTimeout_;
     TestFilter* groupFilters_;
     TestFilter* nameFilters_;
+    TestFilter* testFilters_;
     OutputType outputType_;
     SimpleString packageName_;
 
     SimpleString getParameterField(int ac, const char *const *av, int& i, const SimpleString& parameterName);
     void setRepeatCount(int ac, const char *const *av, int& index);
     bool setShuffle(int ac, const char *const *av, int& index);
+    bool setFuzzRuns(int ac, const char *const *av, int& index);
+    void setCorpusDirectory(int ac, const char *const *av, int& index);
+    bool setFuzzSeed(int ac, const char *const *av, int& index);
+    bool setPropertyRuns(int ac, const char *const *av, int& index);
+    bool setPropertySeed(int ac, const char *const *av, int& index);
+    bool setTestTimeout(int ac, const char *const *av, int& index);
     void addGroupFilter(int ac, const char *const *av, int& index);
     bool addGroupDotNameFilter(int ac, const char *const *av, int& index);
     void addStrictGroupFilter(int ac, const char *const *av, int& index);
@@ -102,6 +125,8 @@ private:
     void addStrictNameFilter(int ac, const char *const *av, int& index);
     void addExcludeNameFilter(int ac, const char *const *av, int& index);
     void addExcludeStrictNameFilter(int ac, const char *const *av, int& index);
+    bool addFilterFile(int ac, const char *const *av, int& index);
+    bool addFilterFromFileLine(const SimpleString& line);
     void addTestToRunBasedOnVerboseOutput(int ac, const char *const *av, int& index, const char* parameterName);
     bool setOutputType(int ac, const char *const *av, int& index);
     void setPackageName(int ac, const char *const *av, int& index);
@@ -52,6 +52,8 @@ public:
 protected:
     virtual TestOutput* createTeamCityOutput();
     virtual TestOutput* createJUnitOutput(const SimpleString& packageName);
+    virtual TestOutput* createJsonOutput(const SimpleString& packageName);
+    virtual TestOutput* createBinaryOutput(const SimpleString& packageName);
     virtual TestOutput* createConsoleOutput();
     virtual TestOutput* createCompositeOutput(TestOutput* outputOne, TestOutput* outputTwo);
 
@@ -217,6 +217,16 @@
 #endif
 #endif
 
+/*
+ * Per-test hardware and software performance counters via perf_event_open
+ */
+
+#if CPPUTEST_USE_STD_C_LIB && defined(__linux__) && defined(__GNUC__)
+#define CPPUTEST_HAVE_PERF_EVENT 1
+#else
+#define CPPUTEST_HAVE_PERF_EVENT 0
+#endif
+
 /*
  * Detection of different 64 bit environments
  */
@@ -243,6 +253,28 @@
 #define CPPUTEST_16BIT_INTS
 #endif
 
+/*
+ * Registration of tests through a linker section instead of static constructors.
+ *
+ * Compile test files with CPPUTEST_USE_TEST_SECTION set to 1 and TEST() emits a
+ * constant descriptor, and a pointer to it into the cpputest_tests section,
+ * instead of a global TestInstaller. The section holds pointers only, as the
+ * compiler may pad larger objects placed in it. The registry walks the section
+ * on first use. This needs the
+ * __start_/__stop_ section symbols of ELF linkers, so GCC or clang on ELF.
+ */
+
+#if defined(__GNUC__) && defined(__ELF__)
+#define CPPUTEST_HAVE_TEST_SECTION 1
+#define CPPUTEST_TEST_SECTION __attribute__((used, section("cpputest_tests")))
+#else
+#define CPPUTEST_HAVE_TEST_SECTION 0
+#endif
+
+#if defined(CPPUTEST_USE_TEST_SECTION) && CPPUTEST_USE_TEST_SECTION && !CPPUTEST_HAVE_TEST_SECTION
+#error "CPPUTEST_USE_TEST_SECTION needs GCC or clang on an ELF target"
+#endif
+
 /*
  * Support for "long long" type.
  *
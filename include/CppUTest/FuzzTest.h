@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_FuzzTest_h
+#define D_FuzzTest_h
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// FUZZ_TEST(group, name)(const uint8_t* data, size_t size) declares a fuzz
+// target. A normal run replays the empty input and every file of the corpus
+// directory <corpus>/<group>.<name> as regression cases. With --fuzz the
+// target runs against mutations of that corpus instead: inputs that reach
+// new coverage are written to the corpus directory and the first failing
+// input is saved next to it as <group>.<name>-crash-<hash>. The failure
+// names the --fuzz-seed that repeats the mutations.
+//
+// Coverage is read from the code under test when it is compiled with
+// -fsanitize-coverage=trace-pc-guard (clang) or -fsanitize-coverage=trace-pc
+// (gcc). CppUTest itself must not be compiled with it. Without coverage the
+// mutations are unguided. The coverage callbacks are weak, so libFuzzer or
+// a sanitizer runtime that defines them wins and only its counts are used.
+//
+// Each input runs through the plugins and setup(), testBody() and teardown()
+// like a test of its own, so leaks and failures are found per input. The
+// test object, and so the members of the group, is reused between inputs.
+//
+
+#include "Utest.h"
+#include "TestCaseGenerator.h"
+
+class TestCorpusGenerator : public TestCaseGenerator
+{
+public:
+    explicit TestCorpusGenerator(const char* groupName, const char* testName);
+    virtual ~TestCorpusGenerator() _destructor_override;
+
+    /* The empty input comes first, then the files of the corpus directory */
+    virtual bool first() _override;
+    virtual bool next() _override;
+    virtual const char* getCaseName() const _override;
+
+    const unsigned char* getData() const;
+    size_t getSize() const;
+
+    /* NULLPTR for the default directory "corpus" */
+    void setCorpusDirectory(const char* directory);
+
+    /* <corpus>/<group>.<name>, valid once first() was called */
+    const char* getCorpusPath() const;
+    void close();
+
+private:
+    bool readFile(const char* fileName);
+
+    const char* groupName_;
+    const char* testName_;
+    const char* corpusDirectory_;
+    PlatformSpecificDirectory directory_;
+    char* corpusPath_;
+    char* filePath_;
+    char* caseName_;
+    unsigned char* data_;
+    size_t size_;
+    size_t capacity_;
+
+    TestCorpusGenerator(const TestCorpusGenerator&);
+    TestCorpusGenerator& operator=(const TestCorpusGenerator&);
+};
+
+class FuzzMutator
+{
+public:
+    explicit FuzzMutator(unsigned long seed);
+
+    /* Mutates data in place and returns its new size, at most maxSize */
+    size_t mutate(unsigned char* data, size_t size, size_t maxSize, const unsigned char* other, size_t otherSize);
+    size_t random(size_t bound);
+
+private:
+    unsigned long state_;
+
+    size_t mutateOnce(unsigned char* data, size_t size, size_t maxSize, const unsigned char* other, size_t otherSize);
+};
+
+class FuzzUtestShell : public ParameterizedUtestShell
+{
+public:
+    enum { MAX_INPUT_SIZE = 4096 };
+
+    explicit FuzzUtestShell(const char* groupName, const char* testName);
+    virtual ~FuzzUtestShell() _destructor_override;
+
+    /* Zero runs replays the corpus, anything else fuzzes for that many inputs.
+     * A zero seed takes a new one from the clock for every fuzzing run. */
+    virtual void setFuzzOptions(size_t runs, const char* corpusDirectory, unsigned int seed) _override;
+
+    const unsigned char* getData() const;
+    size_t getSize() const;
+
+    virtual bool firstCase() _override;
+    virtual bool nextCase() _override;
+    virtual void runOneTestInCurrentProcess(TestPlugin* plugin, TestResult& result) _override;
+
+protected:
+    virtual SimpleString getMacroName() const _override;
+    virtual bool runInput(Utest* test, TestPlugin* plugin, TestResult& result, const unsigned char* data, size_t size);
+
+private:
+    void fuzz(Utest* test, TestPlugin* plugin, TestResult& result);
+    bool saveInput(const char* path, const unsigned char* data, size_t size);
+    void failWithInput(TestResult& result, const unsigned char* data, size_t size, unsigned int seed);
+
+    TestCorpusGenerator corpus_;
+    const unsigned char* data_;
+    size_t size_;
+    size_t runs_;
+    unsigned int seed_;
+};
+
+#endif
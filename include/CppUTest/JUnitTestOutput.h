@@ -56,7 +56,10 @@ public:
     virtual void flush() _override;
 
     virtual SimpleString createFileName(const SimpleString& group);
+    virtual SimpleString createSingleFileName();
     void setPackageName(const SimpleString &package);
+    void setSingleFileOutput(bool singleFile);
+    bool isSingleFileOutput() const;
 
 protected:
 
@@ -64,8 +67,11 @@ protected:
     void resetTestGroupResult();
 
     virtual void openFileForWrite(const SimpleString& fileName);
+    virtual void openFileForAppend(const SimpleString& fileName);
     virtual void writeTestGroupToFile();
+    virtual void appendTestGroupToSingleFile();
     virtual void writeToFile(const SimpleString& buffer);
+    virtual void flushWriteBuffer();
     virtual void closeFile();
 
     virtual void writeXmlHeader();
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_JsonTestOutput_h
+#define D_JsonTestOutput_h
+
+#include "TestOutput.h"
+#include "TestResult.h"
+#include "SimpleString.h"
+#include "PlatformSpecificFunctions_c.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//  JsonTestOutput.h
+//
+//  Writes one JSON object per line (JSON Lines) for every finished test and
+//  one summary object at the end of a run, meant for result ingestion.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+struct JsonTestRecord
+{
+    JsonTestRecord();
+
+    SimpleString group_;
+    SimpleString name_;
+    SimpleString file_;
+    size_t lineNumber_;
+    bool ignored_;
+    bool failed_;
+    SimpleString failureFile_;
+    size_t failureLineNumber_;
+    SimpleString failureMessage_;
+    size_t checkCount_;
+    size_t durationInMicroseconds_;
+    TestResourceUsage resources_;
+    TestCounters counters_;
+};
+
+class JsonTestOutput: public TestOutput
+{
+public:
+    JsonTestOutput();
+    virtual ~JsonTestOutput() _destructor_override;
+
+    virtual void printTestsStarted() _override;
+    virtual void printTestsEnded(const TestResult& result) _override;
+    virtual void printCurrentTestStarted(const UtestShell& test) _override;
+    virtual void printCurrentTestEnded(const TestResult& res) _override;
+
+    virtual void printBuffer(const char*) _override;
+    virtual void print(const char*) _override;
+    virtual void print(long) _override;
+    virtual void print(size_t) _override;
+    virtual void printFailure(const TestFailure& failure) _override;
+
+    virtual void flush() _override;
+
+    virtual SimpleString createFileName();
+    void setPackageName(const SimpleString& package);
+
+    static const char* statusOf(const JsonTestRecord& record);
+
+protected:
+    virtual void writeTestRecord(const JsonTestRecord& record);
+    virtual void writeRunSummary(const TestResult& result);
+    virtual SimpleString encodeJsonString(const SimpleString& text);
+
+    virtual void openFileForWrite(const SimpleString& fileName);
+    virtual void writeToFile(const SimpleString& buffer);
+    virtual void closeFile();
+
+    SimpleString package_;
+    PlatformSpecificFile file_;
+    JsonTestRecord record_;
+    size_t checkCountAtTestStart_;
+
+private:
+    JsonTestOutput(const JsonTestOutput&);
+    JsonTestOutput& operator=(const JsonTestOutput&);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//  BinaryTestOutput
+//
+//  Same records as JsonTestOutput, length-prefixed and binary encoded.
+//  All integers are little endian. Each record is:
+//
+//    u32 length of what follows, u8 record type, payload
+//
+//  Test record (type 1): u8 status (0 passed, 1 failed, 2 ignored),
+//    str group, str name, str file, u32 line, u32 checks, u64 duration in us,
+//    and when failed: str failure file, u32 failure line, str failure message,
+//    and when resources were measured: u64 user us, u64 sys us, u64 peak rss
+//    growth in kB, u64 major faults, u64 minor faults, u64 voluntary and
+//    u64 involuntary context switches.
+//  Counters record (type 3), right after the test record it belongs to when
+//    the test has counters: u32 count, then per counter str name, u64 value.
+//  Summary record (type 2): u32 tests, u32 ran, u32 checks, u32 ignored,
+//    u32 filtered out, u32 failures, u64 duration in us.
+//
+//  A str is a u32 byte count followed by the bytes, without terminator.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+class BinaryTestOutput: public JsonTestOutput
+{
+public:
+    enum RecordType { RECORD_TEST = 1, RECORD_SUMMARY = 2, RECORD_COUNTERS = 3 };
+    enum Status { STATUS_PASSED = 0, STATUS_FAILED = 1, STATUS_IGNORED = 2 };
+
+    BinaryTestOutput();
+    virtual ~BinaryTestOutput() _destructor_override;
+
+    virtual SimpleString createFileName() _override;
+
+protected:
+    virtual void writeTestRecord(const JsonTestRecord& record) _override;
+    virtual void writeRunSummary(const TestResult& result) _override;
+    virtual void openFileForWrite(const SimpleString& fileName) _override;
+    virtual void writeBytesToFile(const void* buffer, size_t size);
+
+private:
+    BinaryTestOutput(const BinaryTestOutput&);
+    BinaryTestOutput& operator=(const BinaryTestOutput&);
+};
+
+#endif
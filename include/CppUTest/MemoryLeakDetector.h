@@ -168,6 +168,8 @@ private:
 
 struct MemoryLeakDetectorTable
 {
+    MemoryLeakDetectorTable();
+
     void clearAllAccounting(MemLeakPeriod period);
 
     void addNewNode(MemoryLeakDetectorNode* node);
@@ -175,6 +177,7 @@ struct MemoryLeakDetectorTable
     MemoryLeakDetectorNode* removeNode(char* memory);
 
     size_t getTotalLeaks(MemLeakPeriod period);
+    void markCheckingPeriodLeaksAsNonCheckingPeriod();
 
     MemoryLeakDetectorNode* getFirstLeak(MemLeakPeriod period);
     MemoryLeakDetectorNode* getFirstLeakForAllocationStage(unsigned char allocation_stage);
@@ -183,12 +186,16 @@ struct MemoryLeakDetectorTable
 
 private:
     unsigned long hash(char* memory);
+    size_t countLeaks(MemLeakPeriod period);
 
     enum
     {
         hash_prime = MEMORY_LEAK_HASH_TABLE_SIZE
     };
     MemoryLeakDetectorList table_[hash_prime];
+
+    /* Checked after every test, so it is kept up to date instead of counted */
+    size_t checkingPeriodLeaks_;
 };
 
 class MemoryLeakDetector
@@ -36,6 +36,14 @@ extern void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell* shell, Test
 extern int (*PlatformSpecificFork)(void);
 extern int (*PlatformSpecificWaitPid)(int pid, int* status, int options);
 
+/* Reports the test and aborts the process when it is still running after the timeout */
+extern void (*PlatformSpecificStartWatchdog)(UtestShell* shell, size_t timeoutInMillis);
+extern void (*PlatformSpecificStopWatchdog)(void);
+
+/* Fills in the usage of the process so far, 0 when the platform can't tell */
+struct TestResourceUsage;
+extern int (*PlatformSpecificGetResourceUsage)(TestResourceUsage* usage);
+
 /* Platform specific interface we use in order to minimize dependencies with LibC.
  * This enables porting to different embedded platforms.
  *
@@ -64,8 +64,17 @@ typedef void* PlatformSpecificFile;
 
 extern PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag);
 extern void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file);
+extern void (*PlatformSpecificFWrite)(const void* buffer, size_t size, PlatformSpecificFile file);
+extern size_t (*PlatformSpecificFRead)(void* buffer, size_t size, PlatformSpecificFile file);
 extern void (*PlatformSpecificFClose)(PlatformSpecificFile file);
 
+/* Directory operations, ReadDir returns the next entry name (skipping "." and "..") or NULL */
+typedef void* PlatformSpecificDirectory;
+
+extern PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char* dirname);
+extern const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory directory);
+extern void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory directory);
+
 extern int (*PlatformSpecificPutchar)(int c);
 extern void (*PlatformSpecificFlush)(void);
 
@@ -86,6 +95,9 @@ extern void (*PlatformSpecificMutexLock)(PlatformSpecificMutex mtx);
 extern void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex mtx);
 extern void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex mtx);
 
+/* Identifies the calling thread; platforms without threads return 0 */
+extern unsigned long (*PlatformSpecificGetThreadId)(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_PropertyTest_h
+#define D_PropertyTest_h
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// FOR_ALL(group, name, generator, parameter) defines a test that checks a
+// property for many generated values:
+//
+//   FOR_ALL(Codec, decodesWhatItEncodes, PropertyIntegers<int>(-1000, 1000), int value)
+//   {
+//       LONGS_EQUAL(value, decode(encode(value)));
+//   }
+//
+// The property runs as often as PropertyChecker::getRuns() says, inside the
+// body of a single test, so the setup of the group runs once. When a check
+// fails, the value is shrunk to the simplest one that still fails, and that
+// is reported together with the seed that generated it. --property-seed
+// repeats a run and --property-runs changes the number of runs.
+//
+// The values come from PlatformSpecificRand(). A generator for a user type
+// derives from PropertyGenerator and may offer simpler values in shrink().
+// Values must be copyable and default constructible, and are described in
+// failures by StringFrom() unless the generator overrides describe().
+//
+
+#include "Utest.h"
+#include "TestFailure.h"
+
+class PropertyRandom
+{
+public:
+    explicit PropertyRandom(unsigned int seed);
+
+    /* Uniform in [0, bound), any value when bound is 0 */
+    unsigned long next(unsigned long bound = 0);
+};
+
+template <typename T>
+class PropertyGenerator
+{
+public:
+    typedef T Value;
+
+    virtual ~PropertyGenerator()
+    {
+    }
+
+    virtual T generate(PropertyRandom& random) const=0;
+
+    /* Fills simpler with the candidate-th value that is simpler than value, false when there are no more */
+    virtual bool shrink(const T&, size_t, T&) const
+    {
+        return false;
+    }
+
+    virtual SimpleString describe(const T& value) const
+    {
+        return StringFrom(value);
+    }
+};
+
+/* Counts candidate down past the chunks of a sequence that shrinking removes: all of it, halves, quarters, ... single elements */
+bool propertyRemovalCandidate(size_t length, size_t& candidate, size_t& start, size_t& count);
+
+template <typename T>
+class PropertyIntegers : public PropertyGenerator<T>
+{
+public:
+    PropertyIntegers(T minimum, T maximum) : minimum_(minimum), maximum_(maximum), simplest_(T())
+    {
+        if (T() < minimum_) simplest_ = minimum_;
+        if (maximum_ < T()) simplest_ = maximum_;
+    }
+
+    virtual T generate(PropertyRandom& random) const _override
+    {
+        unsigned long span = (unsigned long) maximum_ - (unsigned long) minimum_;
+
+        /* The edges of the range find the off by one errors, so they come up more often */
+        if (random.next(8) == 0) {
+            switch (random.next(4)) {
+            case 0: return minimum_;
+            case 1: return maximum_;
+            case 2: return (span == 0) ? minimum_ : (T) ((unsigned long) minimum_ + 1);
+            default: return simplest_;
+            }
+        }
+        return (T) ((unsigned long) minimum_ + random.next(span + 1));
+    }
+
+    /* Moves towards zero, or the end of the range closest to it: all the way, half the way, ... one step */
+    virtual bool shrink(const T& value, size_t candidate, T& simpler) const _override
+    {
+        unsigned long distance = (value < simplest_) ? (unsigned long) simplest_ - (unsigned long) value : (unsigned long) value - (unsigned long) simplest_;
+        if (candidate >= sizeof(unsigned long) * 8) return false;
+        unsigned long step = distance >> candidate;
+        if (step == 0) return false;
+        simpler = (value < simplest_) ? (T) ((unsigned long) value + step) : (T) ((unsigned long) value - step);
+        return true;
+    }
+
+private:
+    T minimum_;
+    T maximum_;
+    T simplest_;
+};
+
+template <typename T>
+class PropertyList
+{
+public:
+    PropertyList() : items_(NULLPTR), size_(0), capacity_(0)
+    {
+    }
+
+    PropertyList(const PropertyList& other) : items_(NULLPTR), size_(0), capacity_(0)
+    {
+        for (size_t i = 0; i < other.size_; i++) add(other.items_[i]);
+    }
+
+    PropertyList& operator=(const PropertyList& other)
+    {
+        if (this != &other) {
+            size_ = 0;
+            for (size_t i = 0; i < other.size_; i++) add(other.items_[i]);
+        }
+        return *this;
+    }
+
+    ~PropertyList()
+    {
+        delete [] items_;
+    }
+
+    void add(const T& item)
+    {
+        if (size_ == capacity_) {
+            capacity_ = capacity_ ? capacity_ * 2 : 8;
+            T* items = new T[capacity_];
+            for (size_t i = 0; i < size_; i++) items[i] = items_[i];
+            delete [] items_;
+            items_ = items;
+        }
+        items_[size_++] = item;
+    }
+
+    void remove(size_t start, size_t count)
+    {
+        for (size_t i = start; i + count < size_; i++) items_[i] = items_[i + count];
+        size_ -= count;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    T& operator[](size_t index)
+    {
+        return items_[index];
+    }
+
+private:
+    T* items_;
+    size_t size_;
+    size_t capacity_;
+};
+
+template <typename T>
+SimpleString StringFrom(const PropertyList<T>& list)
+{
+    SimpleString text = "{";
+    for (size_t i = 0; i < list.size(); i++) {
+        if (i) text += ", ";
+        text += StringFrom(list[i]);
+    }
+    return text + "}";
+}
+
+/* Lists of up to maxSize values of the element generator, which is copied */
+template <typename ElementGenerator>
+class PropertyLists : public PropertyGenerator<PropertyList<typename ElementGenerator::Value> >
+{
+public:
+    typedef typename ElementGenerator::Value Element;
+    typedef PropertyList<Element> List;
+
+    PropertyLists(const ElementGenerator& elements, size_t maxSize) : elements_(elements), maxSize_(maxSize)
+    {
+    }
+
+    virtual List generate(PropertyRandom& random) const _override
+    {
+        List list;
+        size_t size = (size_t) random.next((unsigned long) maxSize_ + 1);
+        for (size_t i = 0; i < size; i++) list.add(elements_.generate(random));
+        return list;
+    }
+
+    /* Removes elements first, then shrinks them one by one */
+    virtual bool shrink(const List& value, size_t candidate, List& simpler) const _override
+    {
+        size_t start, count;
+        if (propertyRemovalCandidate(value.size(), candidate, start, count)) {
+            simpler = value;
+            simpler.remove(start, count);
+            return true;
+        }
+        for (size_t i = 0; i < value.size(); i++) {
+            Element element;
+            for (size_t elementCandidate = 0; elements_.shrink(value[i], elementCandidate, element); elementCandidate++) {
+                if (candidate-- == 0) {
+                    simpler = value;
+                    simpler[i] = element;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    virtual SimpleString describe(const List& value) const _override
+    {
+        SimpleString text = "{";
+        for (size_t i = 0; i < value.size(); i++) {
+            if (i) text += ", ";
+            text += elements_.describe(value[i]);
+        }
+        return text + "}";
+    }
+
+private:
+    ElementGenerator elements_;
+    size_t maxSize_;
+};
+
+class PropertyBytes : public PropertyLists<PropertyIntegers<unsigned char> >
+{
+public:
+    explicit PropertyBytes(size_t maxSize);
+
+    virtual SimpleString describe(const PropertyList<unsigned char>& value) const _override;
+};
+
+class PropertyStrings : public PropertyGenerator<SimpleString>
+{
+public:
+    /* Without an alphabet the characters are printable ASCII */
+    explicit PropertyStrings(size_t maxLength, const char* alphabet = NULLPTR);
+
+    virtual SimpleString generate(PropertyRandom& random) const _override;
+    virtual bool shrink(const SimpleString& value, size_t candidate, SimpleString& simpler) const _override;
+    virtual SimpleString describe(const SimpleString& value) const _override;
+
+private:
+    size_t maxLength_;
+    const char* alphabet_;
+    char simplest_;
+};
+
+class PropertyChecker
+{
+public:
+    explicit PropertyChecker(const char* fileName, size_t lineNumber);
+    virtual ~PropertyChecker();
+
+    static void setRuns(size_t runs);
+    static size_t getRuns();
+
+    /* Zero picks a new seed for every property */
+    static void setSeed(unsigned int seed);
+    static unsigned int getSeed();
+
+    PropertyRandom& getRandom();
+
+    /* Runs function(data), false when a check in it failed */
+    virtual bool trial(void (*function)(void*), void* data);
+    virtual bool mayShrink() const;
+    virtual void fail(size_t runs, size_t shrinks, const SimpleString& counterexample);
+
+private:
+    class TrialShell : public UtestShell
+    {
+    public:
+        explicit TrialShell(const UtestShell& test);
+        virtual ~TrialShell() _destructor_override;
+
+        void install();
+        void uninstall(UtestShell* test);
+        bool hasFailedTrial() const;
+        void startTrial();
+
+        SimpleString failureMessage;
+        SimpleString failureFileName;
+        size_t failureLineNumber;
+
+        virtual void failWith(const TestFailure& failure) _override;
+        virtual void failWith(const TestFailure& failure, const TestTerminator& terminator) _override;
+
+    private:
+        SimpleString groupName_;
+        SimpleString testName_;
+        SimpleString fileName_;
+        bool failedTrial_;
+    };
+
+    UtestShell* test_;
+    TrialShell shell_;
+    bool installed_;
+    unsigned int seed_;
+    PropertyRandom random_;
+    size_t shrinkTrials_;
+    const char* fileName_;
+    size_t lineNumber_;
+
+    static size_t runs_;
+    static unsigned int fixedSeed_;
+
+    PropertyChecker(const PropertyChecker&);
+    PropertyChecker& operator=(const PropertyChecker&);
+};
+
+template <typename T, typename Parameter>
+class PropertyTrial
+{
+public:
+    PropertyTrial(void (*property)(Parameter), const T& value) : property_(property), value_(value)
+    {
+    }
+
+    static void run(void* data)
+    {
+        PropertyTrial* trial = (PropertyTrial*) data;
+        trial->property_(trial->value_);
+    }
+
+private:
+    void (*property_)(Parameter);
+    const T& value_;
+};
+
+template <typename Generator, typename Parameter>
+void checkProperty(const Generator& generator, void (*property)(Parameter), const char* fileName, size_t lineNumber)
+{
+    typedef typename Generator::Value Value;
+    PropertyChecker checker(fileName, lineNumber);
+
+    for (size_t run = 1; run <= PropertyChecker::getRuns(); run++) {
+        Value value = generator.generate(checker.getRandom());
+        PropertyTrial<Value, Parameter> trial(property, value);
+        if (checker.trial(PropertyTrial<Value, Parameter>::run, &trial)) continue;
+
+        size_t shrinks = 0;
+        Value simpler;
+        for (size_t candidate = 0; checker.mayShrink() && generator.shrink(value, candidate, simpler); candidate++) {
+            PropertyTrial<Value, Parameter> simplerTrial(property, simpler);
+            if (!checker.trial(PropertyTrial<Value, Parameter>::run, &simplerTrial)) {
+                value = simpler;
+                shrinks++;
+                candidate = (size_t) -1; /* start over from the simpler value */
+            }
+        }
+        checker.fail(run, shrinks, generator.describe(value));
+        return;
+    }
+}
+
+#endif
@@ -147,6 +147,55 @@ private:
     SimpleStringCollection(SimpleStringCollection&);
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// SimpleStringInternTable maps strings to stable handles. Interning equal
+// strings always returns the same handle, so identifiers that are interned
+// once (at registration or first use) can afterwards be compared by pointer
+// instead of by StrCmp. A handle is a pointer to the interned, zero
+// terminated copy of the string and stays valid until the table is cleared
+// or destroyed. Each interned string can carry a pointer of user data.
+// A table created untracked takes its memory from the platform instead of
+// the string allocator, so it may outlive the test that filled it.
+//
+
+struct SimpleStringInternTableNode;
+
+class SimpleStringInternTable
+{
+public:
+    explicit SimpleStringInternTable(bool untracked = false);
+    ~SimpleStringInternTable();
+
+    const char* intern(const char* str);
+    const char* intern(const SimpleString& str);
+    const char* find(const char* str) const;
+    const char* find(const SimpleString& str) const;
+
+    void setData(const char* str, void* data);
+    void* getData(const char* str) const;
+
+    size_t size() const;
+    void clear();
+
+    static size_t hash(const char* str);
+
+private:
+    SimpleStringInternTableNode* findNode(const char* str, size_t hashValue) const;
+    void grow();
+    void deallocateBuckets();
+    char* allocate(size_t size);
+    void deallocate(char* memory, size_t size);
+
+    SimpleStringInternTableNode** buckets_;
+    size_t bucketCount_;
+    size_t size_;
+    bool untracked_;
+
+    SimpleStringInternTable(const SimpleStringInternTable&);
+    SimpleStringInternTable& operator=(const SimpleStringInternTable&);
+};
+
 class GlobalSimpleStringAllocatorStash
 {
 public:
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_TestCaseGenerator_h
+#define D_TestCaseGenerator_h
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// TestCaseGenerator enumerates the cases of a TEST_P one at a time. The
+// registry walks them while it runs the test, so a million cases cost one
+// shell and no more memory than the current case. The test body reads the
+// current case through the generator it was declared with.
+//
+
+#include "StandardCLibrary.h"
+#include "PlatformSpecificFunctions_c.h"
+
+class TestCaseGenerator
+{
+public:
+    virtual ~TestCaseGenerator();
+
+    /* Restart at the first case, false when there are none */
+    virtual bool first()=0;
+    virtual bool next()=0;
+
+    /* Cases are named by their index unless the generator names them */
+    virtual const char* getCaseName() const;
+
+    /* A case the generator could not produce fails with this message instead of running */
+    virtual const char* getCaseError() const;
+};
+
+class TestRangeGenerator : public TestCaseGenerator
+{
+public:
+    TestRangeGenerator(long begin, long end, long step = 1);
+    virtual ~TestRangeGenerator() _destructor_override;
+
+    virtual bool first() _override;
+    virtual bool next() _override;
+
+    long getValue() const;
+
+private:
+    long begin_;
+    long end_;
+    long step_;
+    long value_;
+};
+
+template <typename T>
+class TestArrayGenerator : public TestCaseGenerator
+{
+public:
+    template <size_t N>
+    explicit TestArrayGenerator(const T (&values)[N]) : values_(values), count_(N), index_(0)
+    {
+    }
+
+    TestArrayGenerator(const T* values, size_t count) : values_(values), count_(count), index_(0)
+    {
+    }
+
+    virtual bool first() _override
+    {
+        index_ = 0;
+        return index_ < count_;
+    }
+
+    virtual bool next() _override
+    {
+        return ++index_ < count_;
+    }
+
+    const T& getValue() const
+    {
+        return values_[index_];
+    }
+
+private:
+    const T* values_;
+    size_t count_;
+    size_t index_;
+};
+
+class TestFileLinesGenerator : public TestCaseGenerator
+{
+public:
+    explicit TestFileLinesGenerator(const char* fileName);
+    virtual ~TestFileLinesGenerator() _destructor_override;
+
+    virtual bool first() _override;
+    virtual bool next() _override;
+    virtual const char* getCaseError() const _override;
+
+    const char* getValue() const;
+
+private:
+    void close();
+    bool readLine();
+    bool fillChunk();
+    void appendToLine(const char* text, size_t length);
+
+    const char* fileName_;
+    PlatformSpecificFile file_;
+    char chunk_[4096];
+    size_t chunkLength_;
+    size_t chunkPosition_;
+    char* line_;
+    size_t lineLength_;
+    size_t lineCapacity_;
+    bool cannotOpen_;
+
+    TestFileLinesGenerator(const TestFileLinesGenerator&);
+    TestFileLinesGenerator& operator=(const TestFileLinesGenerator&);
+};
+
+#endif
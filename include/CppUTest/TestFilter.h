@@ -42,10 +42,15 @@ public:
     TestFilter* getNext() const;
 
     bool match(const SimpleString& name) const;
+    bool match(const char* name) const;
 
     void strictMatching();
     void invertMatching();
 
+    bool isStrictMatching() const;
+    bool isInvertMatching() const;
+    const SimpleString& getFilter() const;
+
     bool operator==(const TestFilter& filter) const;
     bool operator!=(const TestFilter& filter) const;
 
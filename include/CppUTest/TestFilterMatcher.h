@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_TestFilterMatcher_h
+#define D_TestFilterMatcher_h
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// TestFilterMatcher compiles the group, name and group.name filters once,
+// so deciding whether a test runs no longer walks every filter for every
+// test. Strict filters go into hash sets and substring filters into an
+// Aho-Corasick automaton, which finds any of the patterns in one pass over
+// the group or test name.
+//
+// A test runs when it isn't excluded by any inverted filter and, if there
+// are include filters, when it is one of the included group.name tests or
+// matches both the group and the name include filters. Excludes always take
+// precedence over includes. A case of a parameterized test is matched on
+// both its own name and the name of its test.
+//
+
+#include "SimpleString.h"
+
+class TestFilter;
+
+struct TestFilterAutomatonState;
+struct TestFilterAutomatonEdge;
+
+class TestFilterAutomaton
+{
+public:
+    TestFilterAutomaton();
+    ~TestFilterAutomaton();
+
+    void add(const char* pattern);
+    void compile();
+    void clear();
+
+    bool isEmpty() const;
+    bool matches(const char* text) const;
+
+private:
+    size_t addState();
+    void addEdge(size_t state, char symbol, size_t target);
+    size_t transition(size_t state, char symbol) const;
+
+    TestFilterAutomatonState* states_;
+    size_t stateCount_;
+    size_t stateCapacity_;
+    TestFilterAutomatonEdge* edges_;
+    size_t edgeCount_;
+    size_t edgeCapacity_;
+    size_t rootTransitions_[256];
+    size_t patternCount_;
+
+    TestFilterAutomaton(const TestFilterAutomaton&);
+    TestFilterAutomaton& operator=(const TestFilterAutomaton&);
+};
+
+class TestFilterPatterns
+{
+public:
+    TestFilterPatterns();
+
+    void add(const TestFilter& filter);
+    void compile();
+    void clear();
+
+    bool isEmpty() const;
+    bool matches(const char* text) const;
+
+private:
+    SimpleStringInternTable strictPatterns_;
+    TestFilterAutomaton substringPatterns_;
+};
+
+class TestFilterMatcher
+{
+public:
+    TestFilterMatcher();
+    ~TestFilterMatcher();
+
+    void compile(const TestFilter* groupFilters, const TestFilter* nameFilters, const TestFilter* testFilters = NULLPTR);
+    void clear();
+
+    bool match(const char* group, const char* name) const;
+    bool match(const char* group, const char* name, const char* testName) const;
+
+private:
+    bool isExcluded(const char* group, const char* name) const;
+    bool isIncluded(const char* group, const char* name) const;
+    bool matchesTest(const TestFilterPatterns& tests, const char* group, const char* name) const;
+
+    TestFilterPatterns includedGroups_;
+    TestFilterPatterns excludedGroups_;
+    TestFilterPatterns includedNames_;
+    TestFilterPatterns excludedNames_;
+    TestFilterPatterns includedTests_;
+    TestFilterPatterns excludedTests_;
+    bool hasIncludes_;
+    bool hasExcludes_;
+
+    TestFilterMatcher(const TestFilterMatcher&);
+    TestFilterMatcher& operator=(const TestFilterMatcher&);
+};
+
+#endif
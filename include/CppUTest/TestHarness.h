@@ -38,6 +38,9 @@
 
 #include "Utest.h"
 #include "UtestMacros.h"
+#include "TestCaseGenerator.h"
+#include "FuzzTest.h"
+#include "PropertyTest.h"
 #include "SimpleString.h"
 #include "TestResult.h"
 #include "TestFailure.h"
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_TestOutputMultiplexer_h
+#define D_TestOutputMultiplexer_h
+
+#include "TestOutput.h"
+#include "TestResult.h"
+#include "SimpleMutex.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// TestOutputMultiplexer lets several workers run tests at the same time while
+// one ordinary TestOutput (console, JUnit, TeamCity, ...) still sees the events
+// of one test after the other, as if the tests ran serially.
+//
+// Every worker reports to its own MultiplexedWorkerTestOutput, which buffers
+// the events of the test it is running. When the test ends, the buffered
+// events are handed to the multiplexer, which re-emits them to the target
+// either in the order the tests were scheduled (registry order) or in the
+// order in which they completed. Group start and end events are generated by
+// the multiplexer itself, so outputs that collect per group, like JUnit,
+// should use registry order.
+//
+
+struct MultiplexedTestRecord;
+class TestOutputMultiplexer;
+
+class MultiplexedWorkerTestOutput : public TestOutput
+{
+public:
+    MultiplexedWorkerTestOutput(TestOutputMultiplexer& multiplexer);
+    virtual ~MultiplexedWorkerTestOutput() _destructor_override;
+
+    virtual void printTestsStarted() _override;
+    virtual void printTestsEnded(const TestResult& result) _override;
+    virtual void printCurrentTestStarted(const UtestShell& test) _override;
+    virtual void printCurrentTestEnded(const TestResult& res) _override;
+    virtual void printCurrentGroupStarted(const UtestShell& test) _override;
+    virtual void printCurrentGroupEnded(const TestResult& res) _override;
+
+    virtual void printBuffer(const char*) _override;
+    virtual void printVeryVerbose(const char*) _override;
+    virtual void printFailure(const TestFailure& failure) _override;
+    virtual void printTestRun(size_t number, size_t total) _override;
+
+    virtual void flush() _override;
+
+private:
+    TestOutputMultiplexer& multiplexer_;
+    MultiplexedTestRecord* record_;
+    size_t checkCountAtTestEnd_;
+
+    MultiplexedTestRecord* currentRecord();
+
+    MultiplexedWorkerTestOutput(const MultiplexedWorkerTestOutput&);
+    MultiplexedWorkerTestOutput& operator=(const MultiplexedWorkerTestOutput&);
+};
+
+class TestOutputMultiplexer
+{
+public:
+    enum Order { registryOrder, completionOrder };
+
+    TestOutputMultiplexer(TestOutput& target, Order order = registryOrder);
+    virtual ~TestOutputMultiplexer();
+
+    virtual MultiplexedWorkerTestOutput* createWorkerOutput();
+    virtual void setProgressOutput(TestOutput* progress);
+
+    virtual void testsStarted();
+    virtual void scheduleTest(const UtestShell& test);
+    virtual void testsEnded(const TestResult& result);
+
+    virtual size_t getScheduledCount() const;
+    virtual size_t getCompletedCount() const;
+    virtual size_t getEmittedCount() const;
+
+    MultiplexedTestRecord* workerStartedTest(const UtestShell& test);
+    void workerEndedTest(MultiplexedTestRecord* record);
+
+private:
+    TestOutput& target_;
+    Order order_;
+    TestOutput* progress_;
+    TestResult replayResult_;
+    SimpleMutex mutex_;
+
+    MultiplexedTestRecord* head_;
+    MultiplexedTestRecord* tail_;
+
+    size_t scheduledCount_;
+    size_t startedCount_;
+    size_t completedCount_;
+    size_t emittedCount_;
+    size_t failedCount_;
+
+    const UtestShell* currentGroupTest_;
+    size_t currentGroupTime_;
+
+    void appendRecord(MultiplexedTestRecord* record);
+    void emitCompletedRecordsInOrder(bool skipUnfinished);
+    void emit(MultiplexedTestRecord* record);
+    void endCurrentGroup();
+    void printProgress();
+
+    TestOutputMultiplexer(const TestOutputMultiplexer&);
+    TestOutputMultiplexer& operator=(const TestOutputMultiplexer&);
+};
+
+#endif
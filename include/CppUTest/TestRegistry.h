@@ -38,8 +38,68 @@
 #include "TestFilter.h"
 
 class UtestShell;
+class TestGroupFixtureShell;
+class TestTimeout;
 class TestResult;
 class TestPlugin;
+class TestFilterMatcher;
+struct TestDescriptor;
+struct TestDescriptorShellBlock;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// TestRegistryIndex is built once from the registered tests (normally right
+// after static registration) and answers lookups by group, by name and by
+// group.name in constant time. The tests of a group are stored contiguously,
+// in registration list order, and groups are kept in order of first
+// appearance, so listing is linear in the number of tests.
+//
+
+struct TestRegistryIndexGroup;
+struct TestRegistryIndexEntry;
+
+class TestRegistryIndex
+{
+public:
+    TestRegistryIndex();
+    ~TestRegistryIndex();
+
+    void build(UtestShell* firstTest);
+    void clear();
+    bool isBuilt() const;
+
+    UtestShell* findTestWithGroup(const SimpleString& group) const;
+    UtestShell* findTestWithName(const SimpleString& name) const;
+    UtestShell* findTestWithGroupAndName(const SimpleString& group, const SimpleString& name) const;
+    size_t countTestsInGroup(const SimpleString& group) const;
+
+    size_t getGroupCount() const;
+    const char* getGroupName(size_t groupIndex) const;
+
+    size_t getUniqueTestCount() const;
+    UtestShell* getUniqueTest(size_t testIndex) const;
+    const char* getUniqueTestGroupName(size_t testIndex) const;
+    const char* getUniqueTestName(size_t testIndex) const;
+
+private:
+    TestRegistryIndexGroup* findGroup(const SimpleString& group) const;
+
+    bool built_;
+    SimpleStringInternTable groupNames_;
+    SimpleStringInternTable testNames_;
+    SimpleStringInternTable groupAndTestNames_;
+
+    TestRegistryIndexGroup* groups_;
+    size_t groupCount_;
+    UtestShell** testsByGroup_;
+    size_t testCount_;
+
+    TestRegistryIndexEntry* uniqueTests_;
+    size_t uniqueTestCount_;
+
+    TestRegistryIndex(const TestRegistryIndex&);
+    TestRegistryIndex& operator=(const TestRegistryIndex&);
+};
 
 class TestRegistry
 {
@@ -48,7 +108,10 @@ public:
     virtual ~TestRegistry();
 
     virtual void addTest(UtestShell *test);
+    virtual void addTests(const TestDescriptor* const* begin, const TestDescriptor* const* end);
     virtual void unDoLastAddTest();
+    virtual void addGroupFixture(TestGroupFixtureShell* fixture);
+    virtual void addTestTimeout(TestTimeout* timeout);
     virtual size_t countTests();
     virtual void runAllTests(TestResult& result);
     virtual void shuffleTests(size_t seed);
@@ -57,6 +120,7 @@ public:
     virtual void listTestGroupAndCaseNames(TestResult& result);
     virtual void setNameFilters(const TestFilter* filters);
     virtual void setGroupFilters(const TestFilter* filters);
+    virtual void setTestFilters(const TestFilter* filters);
     virtual void installPlugin(TestPlugin* plugin);
     virtual void resetPlugins();
     virtual TestPlugin* getFirstPlugin();
@@ -69,6 +133,10 @@ public:
 
     virtual UtestShell* findTestWithName(const SimpleString& name);
     virtual UtestShell* findTestWithGroup(const SimpleString& name);
+    virtual UtestShell* findTestWithGroupAndName(const SimpleString& group, const SimpleString& name);
+    virtual size_t countTestsInGroup(const SimpleString& group);
+    virtual void buildIndex();
+    virtual void clearIndex();
 
     static TestRegistry* getCurrentRegistry();
     virtual void setCurrentRegistry(TestRegistry* registry);
@@ -76,20 +144,40 @@ public:
     virtual void setRunTestsInSeperateProcess();
     int getCurrentRepetition();
     void setRunIgnored();
+    void setTestTimeout(size_t timeoutInMillis);
+    void setFuzzRuns(size_t runs);
+    void setCorpusDirectory(const char* directory);
+    void setFuzzSeed(unsigned int seed);
 
 private:
 
-    bool testShouldRun(UtestShell* test, TestResult& result);
+    bool testShouldRun(UtestShell* test, TestResult& result, const TestFilterMatcher& matcher);
     bool endOfGroup(UtestShell* test);
+    void scheduleGroupFixtures(const TestFilterMatcher& matcher);
+    bool hasGroupFixture(UtestShell* test);
+    bool willRunAnyCase(UtestShell* test, const TestFilterMatcher& matcher);
+    bool runGroupFixturesBefore(UtestShell* test, TestResult& result);
+    void runGroupFixturesAfter(UtestShell* test, TestResult& result);
+    size_t timeoutFor(UtestShell* test);
+    TestRegistryIndex& getIndex();
 
     UtestShell * tests_;
+    TestGroupFixtureShell* groupFixtures_;
+    TestTimeout* testTimeouts_;
     const TestFilter* nameFilters_;
     const TestFilter* groupFilters_;
+    const TestFilter* testFilters_;
     TestPlugin* firstPlugin_;
     static TestRegistry* currentRegistry_;
     bool runInSeperateProcess_;
     int currentRepetition_;
     bool runIgnored_;
+    size_t testTimeout_;
+    size_t fuzzRuns_;
+    const char* corpusDirectory_;
+    unsigned int fuzzSeed_;
+    TestRegistryIndex index_;
+    TestDescriptorShellBlock* descriptorShells_;
 };
 
 #endif
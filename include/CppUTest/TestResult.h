@@ -38,6 +38,36 @@ class TestFailure;
 class TestOutput;
 class UtestShell;
 
+/* What a test cost the process, measured_ is false where the platform can't tell */
+struct TestResourceUsage
+{
+    TestResourceUsage();
+
+    bool measured_;
+    unsigned long userTimeInMicroseconds_;
+    unsigned long systemTimeInMicroseconds_;
+    unsigned long peakResidentSetInKilobytes_;
+    unsigned long majorPageFaults_;
+    unsigned long minorPageFaults_;
+    unsigned long voluntaryContextSwitches_;
+    unsigned long involuntaryContextSwitches_;
+};
+
+/* Named counts a plugin measured for the current test, e.g. instructions */
+struct TestCounters
+{
+    enum { maxCounters = 8, maxNameLength = 23 };
+
+    TestCounters();
+
+    /* Names are copied and cut to maxNameLength. Full lists ignore the rest */
+    void add(const char* name, unsigned long value);
+
+    size_t count_;
+    char names_[maxCounters][maxNameLength + 1];
+    unsigned long values_[maxCounters];
+};
+
 class TestResult
 {
 public:
@@ -60,6 +90,7 @@ public:
     virtual void addFailure(const TestFailure& failure);
     virtual void print(const char* text);
     virtual void printVeryVerbose(const char* text);
+    virtual void addCurrentTestCounter(const char* name, unsigned long value);
 
     size_t getTestCount() const
     {
@@ -95,7 +126,19 @@ public:
     void setTotalExecutionTime(size_t exTime);
 
     size_t getCurrentTestTotalExecutionTime() const;
+    void setCurrentTestTotalExecutionTime(size_t exTime);
     size_t getCurrentGroupTotalExecutionTime() const;
+    void setCurrentGroupTotalExecutionTime(size_t exTime);
+
+    /* The peak resident set is the growth of the peak during the test */
+    const TestResourceUsage& getCurrentTestResourceUsage() const;
+    void setCurrentTestResourceUsage(const TestResourceUsage& usage);
+
+    /* Adds the whole usage of the process that ran the current test */
+    void addSeparateProcessResourceUsage(const TestResourceUsage& usage);
+
+    const TestCounters& getCurrentTestCounters() const;
+    void setCurrentTestCounters(const TestCounters& counters);
 private:
 
     TestOutput& output_;
@@ -111,6 +154,10 @@ private:
     size_t currentTestTotalExecutionTime_;
     size_t currentGroupTimeStarted_;
     size_t currentGroupTotalExecutionTime_;
+    TestResourceUsage currentTestResourceUsageAtStart_;
+    TestResourceUsage separateProcessResourceUsage_;
+    TestResourceUsage currentTestResourceUsage_;
+    TestCounters currentTestCounters_;
 };
 
 #endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_TestResultChannel_h
+#define D_TestResultChannel_h
+
+#include "TestResult.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// A TestResultChannel lays out the results of one test in a block of memory
+// that is shared between the process running the tests and a process that was
+// forked to run a single test (-p). The child appends events into the block
+// without any system calls and the parent replays them into its TestResult
+// after the child is gone, so checks, failures and printed text survive even
+// when the child crashes half-way through a test.
+//
+// Events are appended as records and only become visible once completely
+// written. When the block is full, further records are dropped and reported.
+//
+
+struct TestResultChannelHeader;
+
+class TestResultChannel
+{
+public:
+    TestResultChannel(void* memory, size_t size);
+    virtual ~TestResultChannel();
+
+    virtual void clear();
+
+    virtual void countCheck();
+    virtual void addFailure(const TestFailure& failure);
+    virtual void print(const char* text);
+    virtual void printVeryVerbose(const char* text);
+    virtual void addCounter(const char* name, unsigned long value);
+
+    virtual size_t getCheckCount() const;
+    virtual size_t getFailureCount() const;
+    virtual size_t getDroppedCount() const;
+
+    virtual void replayInto(UtestShell* shell, TestResult& result) const;
+
+private:
+    enum RecordType
+    {
+        RECORD_FAILURE = 1, RECORD_PRINT = 2, RECORD_PRINT_VERY_VERBOSE = 3, RECORD_COUNTER = 4
+    };
+
+    bool appendRecord(RecordType type, size_t lineNumber, const char* first, const char* second);
+
+    TestResultChannelHeader* header_;
+    char* records_;
+    size_t capacity_;
+
+    TestResultChannel(const TestResultChannel&);
+    TestResultChannel& operator=(const TestResultChannel&);
+};
+
+class TestResultChannelWriter : public TestResult
+{
+public:
+    TestResultChannelWriter(const TestResult& result, TestResultChannel& channel);
+    virtual ~TestResultChannelWriter() _destructor_override;
+
+    virtual void countCheck() _override;
+    virtual void addFailure(const TestFailure& failure) _override;
+    virtual void print(const char* text) _override;
+    virtual void printVeryVerbose(const char* text) _override;
+    virtual void addCurrentTestCounter(const char* name, unsigned long value) _override;
+
+private:
+    TestResultChannel& channel_;
+};
+
+#endif
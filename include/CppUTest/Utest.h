@@ -37,7 +37,9 @@ class TestResult;
 class TestPlugin;
 class TestFailure;
 class TestFilter;
+class TestFilterMatcher;
 class TestTerminator;
+class TestCaseGenerator;
 
 extern bool doubles_equal(double d1, double d2, double threshold);
 
@@ -108,6 +110,10 @@ public:
     virtual size_t countTests();
 
     bool shouldRun(const TestFilter* groupFilters, const TestFilter* nameFilters) const;
+    virtual bool shouldRun(const TestFilterMatcher& matcher) const;
+    bool hasSameGroupAs(const UtestShell& test) const;
+    virtual bool firstCase();
+    virtual bool nextCase();
     const SimpleString getName() const;
     const SimpleString getGroup() const;
     virtual SimpleString getFormattedName() const;
@@ -156,6 +162,13 @@ public:
 
     virtual void setRunIgnored();
 
+    /* Milliseconds before the test counts as hung, 0 for no limit */
+    void setTimeout(size_t timeoutInMillis);
+    size_t getTimeout() const;
+
+    /* The --fuzz, --corpus and --fuzz-seed of the run, only FUZZ_TEST uses them */
+    virtual void setFuzzOptions(size_t runs, const char* corpusDirectory, unsigned int seed);
+
     virtual Utest* createTest();
     virtual void destroyTest(Utest* test);
 
@@ -171,6 +184,8 @@ protected:
 
     virtual SimpleString getMacroName() const;
     TestResult *getTestResult();
+    void setTestResult(TestResult* result);
+    void setCurrentTest(UtestShell* test);
 private:
     const char *group_;
     const char *name_;
@@ -179,9 +194,8 @@ private:
     UtestShell *next_;
     bool isRunAsSeperateProcess_;
     bool hasFailed_;
+    size_t timeout_;
 
-    void setTestResult(TestResult* result);
-    void setCurrentTest(UtestShell* test);
     bool match(const char* target, const TestFilter* filters) const;
 
     static UtestShell* currentTest_;
@@ -278,6 +292,80 @@ private:
 
 };
 
+//////////////////// ParameterizedUtestShell
+
+/* A TEST_P runs once for every case of its generator. The registry steps
+ * through the cases and the shell renames itself to name/case for each, so
+ * they are filtered and reported one by one. Filtering on the name of the
+ * test selects or excludes all of its cases. */
+class ParameterizedUtestShell : public UtestShell
+{
+public:
+    explicit ParameterizedUtestShell(const char* groupName, const char* testName, TestCaseGenerator& generator);
+    virtual ~ParameterizedUtestShell() _destructor_override;
+
+    virtual bool shouldRun(const TestFilterMatcher& matcher) const _override;
+    virtual bool firstCase() _override;
+    virtual bool nextCase() _override;
+    virtual void runOneTest(TestPlugin* plugin, TestResult& result) _override;
+    size_t getCaseIndex() const;
+protected:
+    virtual SimpleString getMacroName() const _override;
+private:
+
+    ParameterizedUtestShell(const ParameterizedUtestShell&);
+    ParameterizedUtestShell& operator=(const ParameterizedUtestShell&);
+
+    bool selectCase(bool hasCase);
+
+    const char* groupName_;
+    const char* testName_;
+    const char* currentName_;
+    TestCaseGenerator& generator_;
+    size_t caseIndex_;
+    char* caseName_;
+    size_t caseNameCapacity_;
+};
+
+//////////////////// TestGroupFixtureShell
+
+/* Runs a TEST_GROUP_SETUP_ONCE or TEST_GROUP_TEARDOWN_ONCE function. The
+ * registry schedules it on the first (setup) or last (teardown) test of its
+ * group that runs, so it runs outside the leak checking of the tests. */
+class TestGroupFixtureShell : public UtestShell
+{
+public:
+    explicit TestGroupFixtureShell(const char* groupName, const char* fixtureName,
+            const char* fileName, size_t lineNumber, void (*fixture)(), bool runsBeforeGroup);
+    virtual ~TestGroupFixtureShell() _destructor_override;
+
+    virtual TestGroupFixtureShell* addFixture(TestGroupFixtureShell* fixture);
+    virtual TestGroupFixtureShell* getNextFixture() const;
+
+    bool runsBeforeGroup() const;
+
+    virtual void unschedule();
+    virtual void schedule(UtestShell* test);
+    UtestShell* getScheduledTest() const;
+
+    virtual void runFixture(TestResult& result);
+    bool fixtureFailed() const;
+
+    virtual Utest* createTest() _override;
+protected:
+    virtual SimpleString getMacroName() const _override;
+private:
+
+    TestGroupFixtureShell(const TestGroupFixtureShell&);
+    TestGroupFixtureShell& operator=(const TestGroupFixtureShell&);
+
+    void (*fixture_)();
+    bool runsBeforeGroup_;
+    TestGroupFixtureShell* nextFixture_;
+    UtestShell* scheduledTest_;
+    bool fixtureFailed_;
+};
+
 //////////////////// UtestShellPointerArray
 
 class UtestShellPointerArray
@@ -301,6 +389,21 @@ private:
 };
 
 
+//////////////////// TestDescriptor
+
+/* Constant description of a test, referenced from the test section by TEST()
+ * when compiled with CPPUTEST_USE_TEST_SECTION. The registry creates the shell when
+ * it installs the test. */
+struct TestDescriptor
+{
+    const char* group;
+    const char* name;
+    const char* file;
+    size_t lineNumber;
+    Utest* (*createTest)();
+    bool ignored;
+};
+
 //////////////////// TestInstaller
 
 class TestInstaller
@@ -319,4 +422,58 @@ private:
 
 };
 
+//////////////////// TestTimeout
+
+class TestTimeout
+{
+public:
+    explicit TestTimeout(const char* groupName, const char* testName, size_t timeoutInMillis);
+    virtual ~TestTimeout();
+
+    virtual TestTimeout* addTimeout(TestTimeout* timeout);
+    virtual TestTimeout* getNext() const;
+
+    bool appliesTo(const UtestShell& test) const;
+    size_t getTimeout() const;
+
+private:
+    const char* groupName_;
+    const char* testName_;
+    size_t timeout_;
+    TestTimeout* next_;
+
+    TestTimeout(const TestTimeout&);
+    TestTimeout& operator=(const TestTimeout&);
+};
+
+//////////////////// TestTimeoutInstaller
+
+class TestTimeoutInstaller
+{
+public:
+    explicit TestTimeoutInstaller(TestTimeout& timeout);
+    virtual ~TestTimeoutInstaller();
+
+private:
+
+    TestTimeoutInstaller(const TestTimeoutInstaller&);
+    TestTimeoutInstaller& operator=(const TestTimeoutInstaller&);
+
+};
+
+//////////////////// TestGroupFixtureInstaller
+
+class TestGroupFixtureInstaller
+{
+public:
+    explicit TestGroupFixtureInstaller(TestGroupFixtureShell& fixture);
+    virtual ~TestGroupFixtureInstaller();
+
+private:
+
+    TestGroupFixtureInstaller(const TestGroupFixtureInstaller&);
+    TestGroupFixtureInstaller& operator=(const TestGroupFixtureInstaller&);
+
+};
+
 #endif
@@ -55,6 +55,50 @@
 #define TEST_TEARDOWN() \
   virtual void teardown()
 
+/*! \brief Define a setup run once for a group of tests
+ *
+ * Runs before the first test of the group that runs, and
+ * TEST_GROUP_TEARDOWN_ONCE after the last one, also when the
+ * tests are shuffled or filtered. Share the group resources
+ * through file scope variables. When the setup fails, the
+ * tests of the group are not run but counted as ignored.
+ *
+ */
+#define TEST_GROUP_SETUP_ONCE(testGroup) \
+  CPPUTEST_TEST_GROUP_FIXTURE(testGroup, setupOnce, true)
+
+#define TEST_GROUP_TEARDOWN_ONCE(testGroup) \
+  CPPUTEST_TEST_GROUP_FIXTURE(testGroup, teardownOnce, false)
+
+#define CPPUTEST_TEST_GROUP_FIXTURE(testGroup, fixtureName, runsBeforeGroup) \
+  static void TEST_GROUP_##CppUTestGroup##testGroup##_##fixtureName(); \
+  static TestGroupFixtureShell TEST_GROUP_##CppUTestGroup##testGroup##_##fixtureName##_Shell(#testGroup, #fixtureName, __FILE__, __LINE__, TEST_GROUP_##CppUTestGroup##testGroup##_##fixtureName, runsBeforeGroup); \
+  static TestGroupFixtureInstaller TEST_GROUP_##CppUTestGroup##testGroup##_##fixtureName##_Installer(TEST_GROUP_##CppUTestGroup##testGroup##_##fixtureName##_Shell); \
+  static void TEST_GROUP_##CppUTestGroup##testGroup##_##fixtureName()
+
+#if defined(CPPUTEST_USE_TEST_SECTION) && CPPUTEST_USE_TEST_SECTION
+
+#define CPPUTEST_SECTION_TEST_DESCRIPTOR(testClass, testGroup, testName, isIgnored) \
+  static Utest* testClass##_create() { return new testClass; } \
+  static const TestDescriptor testClass##_descriptor = { #testGroup, #testName, __FILE__, __LINE__, testClass##_create, isIgnored }; \
+  static const TestDescriptor* const testClass##_descriptorEntry CPPUTEST_TEST_SECTION = &testClass##_descriptor;
+
+#define TEST(testGroup, testName) \
+  class TEST_##testGroup##_##testName##_Test : public TEST_GROUP_##CppUTestGroup##testGroup \
+{ public: TEST_##testGroup##_##testName##_Test () : TEST_GROUP_##CppUTestGroup##testGroup () {} \
+       void testBody() _override; }; \
+  CPPUTEST_SECTION_TEST_DESCRIPTOR(TEST_##testGroup##_##testName##_Test, testGroup, testName, false) \
+    void TEST_##testGroup##_##testName##_Test::testBody()
+
+#define IGNORE_TEST(testGroup, testName)\
+  class IGNORE##testGroup##_##testName##_Test : public TEST_GROUP_##CppUTestGroup##testGroup \
+{ public: IGNORE##testGroup##_##testName##_Test () : TEST_GROUP_##CppUTestGroup##testGroup () {} \
+  public: void testBody() _override; }; \
+  CPPUTEST_SECTION_TEST_DESCRIPTOR(IGNORE##testGroup##_##testName##_Test, testGroup, testName, true) \
+    void IGNORE##testGroup##_##testName##_Test::testBody ()
+
+#else
+
 #define TEST(testGroup, testName) \
   /* External declarations for strict compilers */ \
   class TEST_##testGroup##_##testName##_TestShell; \
@@ -83,6 +127,73 @@
    static TestInstaller TEST_##testGroup##testName##_Installer(IGNORE##testGroup##_##testName##_TestShell_instance, #testGroup, #testName, __FILE__,__LINE__); \
     void IGNORE##testGroup##_##testName##_Test::testBody ()
 
+#endif
+
+/*! \brief Define a test run for every case of a generator
+ *
+ * The generator is a TestCaseGenerator declared before the
+ * test, such as a TestRangeGenerator, TestArrayGenerator or
+ * TestFileLinesGenerator. The test body reads the current
+ * case from it. Each case is reported as testName/index.
+ *
+ */
+#define TEST_P(testGroup, testName, generator) \
+  /* External declarations for strict compilers */ \
+  class TEST_##testGroup##_##testName##_TestShell; \
+  extern TEST_##testGroup##_##testName##_TestShell TEST_##testGroup##_##testName##_TestShell_instance; \
+  \
+  class TEST_##testGroup##_##testName##_Test : public TEST_GROUP_##CppUTestGroup##testGroup \
+{ public: TEST_##testGroup##_##testName##_Test () : TEST_GROUP_##CppUTestGroup##testGroup () {} \
+       void testBody() _override; }; \
+  class TEST_##testGroup##_##testName##_TestShell : public ParameterizedUtestShell { \
+  public: TEST_##testGroup##_##testName##_TestShell () : ParameterizedUtestShell(#testGroup, #testName, generator) {} \
+      virtual Utest* createTest() _override { return new TEST_##testGroup##_##testName##_Test; } \
+  } TEST_##testGroup##_##testName##_TestShell_instance; \
+  static TestInstaller TEST_##testGroup##_##testName##_Installer(TEST_##testGroup##_##testName##_TestShell_instance, #testGroup, #testName, __FILE__,__LINE__); \
+    void TEST_##testGroup##_##testName##_Test::testBody()
+
+/*! \brief Define a fuzz target taking (const uint8_t* data, size_t size)
+ *
+ * Normal runs replay the corpus of the target as cases, --fuzz
+ * mutates it guided by sanitizer coverage. See FuzzTest.h.
+ *
+ */
+#define FUZZ_TEST(testGroup, testName) \
+  /* External declarations for strict compilers */ \
+  class FUZZ_##testGroup##_##testName##_TestShell; \
+  extern FUZZ_##testGroup##_##testName##_TestShell FUZZ_##testGroup##_##testName##_TestShell_instance; \
+  static void FUZZ_##testGroup##_##testName##_Target(const unsigned char* data, size_t size); \
+  \
+  class FUZZ_##testGroup##_##testName##_Test : public TEST_GROUP_##CppUTestGroup##testGroup \
+{ public: explicit FUZZ_##testGroup##_##testName##_Test (const FuzzUtestShell* shell) : TEST_GROUP_##CppUTestGroup##testGroup (), shell_(shell) {} \
+       void testBody() _override { FUZZ_##testGroup##_##testName##_Target(shell_->getData(), shell_->getSize()); } \
+  private: const FuzzUtestShell* shell_; }; \
+  class FUZZ_##testGroup##_##testName##_TestShell : public FuzzUtestShell { \
+  public: FUZZ_##testGroup##_##testName##_TestShell () : FuzzUtestShell(#testGroup, #testName) {} \
+      virtual Utest* createTest() _override { return new FUZZ_##testGroup##_##testName##_Test(this); } \
+  } FUZZ_##testGroup##_##testName##_TestShell_instance; \
+  static TestInstaller FUZZ_##testGroup##_##testName##_Installer(FUZZ_##testGroup##_##testName##_TestShell_instance, #testGroup, #testName, __FILE__,__LINE__); \
+  static void FUZZ_##testGroup##_##testName##_Target
+
+/*! \brief Define a test that checks a property for generated values
+ *
+ * The body is a function of the parameter declaration, called with
+ * values of the generator. A failure reports the simplest value
+ * found by shrinking and the seed. See PropertyTest.h.
+ *
+ */
+#define FOR_ALL(testGroup, testName, generator, parameter) \
+  static void PROPERTY_##testGroup##_##testName##_Property(parameter); \
+  TEST(testGroup, testName) \
+  { checkProperty(generator, PROPERTY_##testGroup##_##testName##_Property, __FILE__, __LINE__); } \
+  static void PROPERTY_##testGroup##_##testName##_Property(parameter)
+
+/*! \brief Give a test its own timeout in milliseconds, instead of the one of --timeout
+ */
+#define TEST_TIMEOUT(testGroup, testName, timeoutInMillis) \
+  static TestTimeout TEST_TIMEOUT_##testGroup##_##testName##_Timeout(#testGroup, #testName, timeoutInMillis); \
+  static TestTimeoutInstaller TEST_TIMEOUT_##testGroup##_##testName##_Installer(TEST_TIMEOUT_##testGroup##_##testName##_Timeout)
+
 #define IMPORT_TEST_GROUP(testGroup) \
   extern int externTestGroup##testGroup;\
   extern int* p##testGroup; \
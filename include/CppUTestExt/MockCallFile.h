@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockCallFile_h
+#define D_MockCallFile_h
+
+#include "CppUTestExt/MockExpectedCall.h"
+#include "CppUTestExt/MockCheckedActualCall.h"
+#include "CppUTest/PlatformSpecificFunctions_c.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// A mock call file holds one call per line. Empty lines and lines starting
+// with '#' are skipped. A line is the function name followed by fields that
+// are separated by a single space:
+//
+//   <type>:<name>=<value>     input parameter
+//   out:<name>=<hex bytes>    output parameter that returns the bytes
+//   out:<name>                output parameter that is left unmodified
+//   return:<type>=<value>     return value
+//   ...                       ignore other parameters
+//
+// The types are bool, int, uint, long, ulong, llong, ullong, double, string,
+// buffer (hex bytes), pointer, cpointer and fpointer (0x followed by hex).
+// In names and strings, a '%' followed by two hex digits stands for that
+// character; spaces, '%', ':', '=', '#' and control characters are written so.
+// A NULL string is written as %null, and doubles that are not finite as nan,
+// inf or -inf.
+//
+// For example:
+//
+//   open string:path=%2Fdev%2Fuart0 return:int=3
+//   write int:fd=3 buffer:data=0a0b0c return:long=3
+//   read int:fd=3 out:data=68656c6c6f ...
+//
+
+class MockCallFileReader
+{
+public:
+    MockCallFileReader(const SimpleString& fileName);
+    virtual ~MockCallFileReader();
+
+    bool isOpen() const;
+    const SimpleString& getFileName() const;
+    size_t getLineNumber() const;
+    const SimpleString& getError() const;
+
+    virtual bool hasMoreCalls();
+    virtual bool readNextCall();
+    virtual const char* getFunctionName() const;
+    virtual bool applyTo(MockExpectedCall& call);
+
+private:
+    enum { CHUNK_SIZE = 4096 };
+
+    SimpleString fileName_;
+    PlatformSpecificFile file_;
+    char chunk_[CHUNK_SIZE];
+    size_t chunkPosition_;
+    size_t chunkSize_;
+    size_t lineNumber_;
+    size_t callLineNumber_;
+    SimpleString error_;
+
+    char* lines_[2];
+    size_t lineCapacities_[2];
+    size_t currentLine_;
+    char* fields_;
+    char* fieldsEnd_;
+
+    bool fillChunk();
+    void skipLine();
+    void addToLine(size_t line, size_t length, char c);
+    bool applyField(MockExpectedCall& call, char* field);
+    bool applyParameter(MockExpectedCall& call, const char* type, const char* name, char* value);
+    bool applyReturnValue(MockExpectedCall& call, const char* type, char* value);
+    bool applyOutputParameter(MockExpectedCall& call, const char* name, char* value);
+    bool fail(const SimpleString& error);
+
+    MockCallFileReader(const MockCallFileReader&);
+    MockCallFileReader& operator=(const MockCallFileReader&);
+};
+
+class MockCallFileWriter : public MockIgnoredActualCall
+{
+public:
+    MockCallFileWriter(const SimpleString& fileName);
+    virtual ~MockCallFileWriter() _destructor_override;
+
+    bool isOpen() const;
+    const SimpleString& getFileName() const;
+
+    virtual MockActualCall& startCall(const SimpleString& functionName);
+    virtual void close();
+
+    virtual MockActualCall& withName(const SimpleString& name) _override;
+    virtual MockActualCall& withBoolParameter(const SimpleString& name, bool value) _override;
+    virtual MockActualCall& withIntParameter(const SimpleString& name, int value) _override;
+    virtual MockActualCall& withUnsignedIntParameter(const SimpleString& name, unsigned int value) _override;
+    virtual MockActualCall& withLongIntParameter(const SimpleString& name, long int value) _override;
+    virtual MockActualCall& withUnsignedLongIntParameter(const SimpleString& name, unsigned long int value) _override;
+    virtual MockActualCall& withLongLongIntParameter(const SimpleString& name, cpputest_longlong value) _override;
+    virtual MockActualCall& withUnsignedLongLongIntParameter(const SimpleString& name, cpputest_ulonglong value) _override;
+    virtual MockActualCall& withDoubleParameter(const SimpleString& name, double value) _override;
+    virtual MockActualCall& withStringParameter(const SimpleString& name, const char* value) _override;
+    virtual MockActualCall& withPointerParameter(const SimpleString& name, void* value) _override;
+    virtual MockActualCall& withConstPointerParameter(const SimpleString& name, const void* value) _override;
+    virtual MockActualCall& withFunctionPointerParameter(const SimpleString& name, void (*value)()) _override;
+    virtual MockActualCall& withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size) _override;
+    virtual MockActualCall& withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value) _override;
+    virtual MockActualCall& withOutputParameter(const SimpleString& name, void* output) _override;
+    virtual MockActualCall& withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output) _override;
+
+    static SimpleString escape(const char* text);
+    static SimpleString hexBytes(const unsigned char* bytes, size_t size);
+
+private:
+    SimpleString fileName_;
+    PlatformSpecificFile file_;
+    bool inCall_;
+    bool ignoresOtherParameters_;
+
+    void finishCall();
+    void writeField(const char* type, const SimpleString& name, const SimpleString& value);
+
+    MockCallFileWriter(const MockCallFileWriter&);
+    MockCallFileWriter& operator=(const MockCallFileWriter&);
+};
+
+#endif
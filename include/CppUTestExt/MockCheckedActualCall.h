@@ -31,13 +31,16 @@
 #include "CppUTestExt/MockActualCall.h"
 #include "CppUTestExt/MockExpectedCallsList.h"
 
-class MockCheckedActualCall : public MockActualCall
+class MockCheckedActualCall : public MockActualCall, public MockArenaObject
 {
 public:
     MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& expectations);
+    MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& expectations, const MockExpectedCallsList& candidateExpectations);
+    MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& expectations, const MockExpectedCallsList& candidateExpectations, MockCheckedExpectedCall* expectedNextCall);
     virtual ~MockCheckedActualCall() _destructor_override;
 
     virtual MockActualCall& withName(const SimpleString& name) _override;
+    virtual MockActualCall& withInternedName(const SimpleString& name, const char* internedName);
     virtual MockActualCall& withCallOrder(unsigned int) _override;
     virtual MockActualCall& withBoolParameter(const SimpleString& name, bool value) _override;
     virtual MockActualCall& withIntParameter(const SimpleString& name, int value) _override;
@@ -99,6 +102,8 @@ public:
 
     virtual bool isFulfilled() const;
     virtual bool hasFailed() const;
+    virtual bool wasMatchedByRangeOfCalls() const;
+    virtual MockCheckedExpectedCall* getMatchingExpectation() const;
 
     virtual void checkExpectations();
 
@@ -114,6 +119,7 @@ protected:
     virtual void checkInputParameter(const MockNamedValue& actualParameter);
     virtual void checkOutputParameter(const MockNamedValue& outputParameter);
     virtual void discardCurrentlyMatchingExpectations();
+    virtual bool matchAgainstAllCandidates();
 
     enum ActualCallState {
         CALL_IN_PROGRESS,
@@ -134,7 +140,7 @@ private:
     MockExpectedCallsList potentiallyMatchingExpectations_;
     const MockExpectedCallsList& allExpectations_;
 
-    class MockOutputParametersListNode
+    class MockOutputParametersListNode : public MockArenaObject
     {
     public:
         SimpleString name_;
@@ -150,11 +156,53 @@ private:
 
     virtual void addOutputParameter(const SimpleString& name, const SimpleString& type, void* ptr);
     virtual void cleanUpOutputParameterList();
+
+    /*
+     * A call can first be matched against only the expectation that is due next. The
+     * other candidates are only looked at, with the arguments passed so far, when that
+     * expectation does not match.
+     */
+    enum PassedArgumentKind {
+        INPUT_PARAMETER,
+        OUTPUT_PARAMETER,
+        OBJECT
+    };
+
+    class MockPassedArgumentsListNode : public MockArenaObject
+    {
+    public:
+        PassedArgumentKind kind_;
+        MockNamedValue value_;
+        const void* objectPtr_;
+
+        MockPassedArgumentsListNode* next_;
+        MockPassedArgumentsListNode(PassedArgumentKind kind, const MockNamedValue& value, const void* objectPtr)
+            : kind_(kind), value_(value), objectPtr_(objectPtr), next_(NULLPTR) {}
+    };
+
+    MockCheckedExpectedCall* expectedNextCall_;
+    const MockExpectedCallsList* otherCandidates_;
+    MockPassedArgumentsListNode* passedArguments_;
+    MockPassedArgumentsListNode* lastPassedArgument_;
+
+    virtual void addPassedArgument(PassedArgumentKind kind, const MockNamedValue& value, const void* objectPtr);
+    virtual void cleanUpPassedArgumentsList();
 };
 
+/*
+ * MockActualCallTrace records each traced call as fixed size events (function and
+ * parameter names are interned, string values are copied per event and released
+ * with it) and only renders them to text in getTraceOutput().
+ * By default the trace keeps every event; useRingBuffer() bounds it to a number of
+ * events and chooses what happens when the buffer is full.
+ */
+struct MockTraceEvent;
+
 class MockActualCallTrace : public MockActualCall
 {
 public:
+    enum OverflowPolicy { OVERWRITE_OLDEST, DROP_NEWEST };
+
     MockActualCallTrace();
     virtual ~MockActualCallTrace() _destructor_override;
 
@@ -220,15 +268,46 @@ public:
 
     const char* getTraceOutput();
     void clear();
+    void useRingBuffer(size_t maximumEvents, OverflowPolicy policy = OVERWRITE_OLDEST);
+    size_t getEventCount() const;
+    size_t getDroppedEventCount() const;
+    size_t getNameCount() const;
+
     static MockActualCallTrace& instance();
     static void clearInstance();
 
 private:
-    SimpleString traceBuffer_;
+    char* output_;
+    size_t outputLength_;
+    size_t outputCapacity_;
+    size_t renderedEventCount_;
+    bool outputIsRendered_;
+
+    SimpleStringInternTable names_;
+    MockTraceEvent* events_;
+    size_t eventCapacity_;
+    size_t firstEvent_;
+    size_t eventCount_;
+    size_t droppedEventCount_;
+    size_t maximumEvents_;
+    OverflowPolicy overflowPolicy_;
 
     static MockActualCallTrace* instance_;
 
-    void addParameterName(const SimpleString& name);
+    MockTraceEvent* addEvent(int kind, const SimpleString& name);
+    MockTraceEvent* addEvent(int kind, const SimpleString& typeName, const SimpleString& name);
+    void keepValue(MockTraceEvent* event, const char* value);
+    void releaseValues();
+    void growEvents();
+    void renderEvent(const MockTraceEvent& event);
+    void renderDroppedEvents();
+    void addToOutput(const char* text);
+    void addToOutput(const SimpleString& text);
+    void clearOutput();
+    void addParameterName(const char* name);
+
+    MockActualCallTrace(const MockActualCallTrace&);
+    MockActualCallTrace& operator=(const MockActualCallTrace&);
 };
 
 class MockIgnoredActualCall: public MockActualCall
@@ -31,12 +31,15 @@
 #include "CppUTestExt/MockExpectedCall.h"
 #include "CppUTestExt/MockNamedValue.h"
 
-class MockCheckedExpectedCall : public MockExpectedCall
+class MockExpectedCallsIndex;
+
+class MockCheckedExpectedCall : public MockExpectedCall, public MockArenaObject
 {
 
 public:
     MockCheckedExpectedCall();
     MockCheckedExpectedCall(unsigned int numCalls);
+    MockCheckedExpectedCall(unsigned int minimumCalls, unsigned int maximumCalls);
     virtual ~MockCheckedExpectedCall() _destructor_override;
 
     virtual MockExpectedCall& withName(const SimpleString& name) _override;
@@ -89,6 +92,10 @@ public:
     virtual bool hasOutputParameterWithName(const SimpleString& name);
     virtual bool hasOutputParameter(const MockNamedValue& parameter);
     virtual bool relatesTo(const SimpleString& functionName);
+    virtual bool relatesTo(const SimpleString& functionName, const char* internedFunctionName);
+    virtual void setInternedName(const char* internedName);
+    virtual const char* getInternedName() const;
+    virtual void setExpectedCallsIndex(MockExpectedCallsIndex* index);
     virtual bool relatesToObject(const void* objectPtr) const;
 
     virtual bool isFulfilled();
@@ -109,15 +116,24 @@ public:
     virtual SimpleString missingParametersToString();
 
     enum { NO_EXPECTED_CALL_ORDER = 0 };
+    static const unsigned int NO_MAXIMUM_CALLS = (unsigned int) -1;
 
     virtual unsigned int getActualCallsFulfilled() const;
+    virtual unsigned int getExpectedCallOrder() const;
+    virtual void callWasMadeOutOfOrder();
+    virtual bool expectsRangeOfCalls() const;
+    virtual bool isExpectedAtCallOrder(unsigned int callOrder) const;
+    virtual bool isIgnoringOtherParameters() const;
 
 protected:
+    SimpleString expectedCallsToString() const;
     void setName(const SimpleString& name);
     SimpleString getName() const;
 
 private:
     SimpleString functionName_;
+    const char* internedName_;
+    MockExpectedCallsIndex* index_;
 
     class MockExpectedFunctionParameter : public MockNamedValue
     {
@@ -144,7 +160,8 @@ private:
     bool isSpecificObjectExpected_;
     bool wasPassedToObject_;
     unsigned int actualCalls_;
-    unsigned int expectedCalls_;
+    unsigned int minimumCalls_;
+    unsigned int maximumCalls_;
 };
 
 class MockIgnoredExpectedCall: public MockExpectedCall
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockConcurrentCallLog_h
+#define D_MockConcurrentCallLog_h
+
+#include "CppUTestExt/MockCheckedActualCall.h"
+#include "CppUTest/SimpleMutex.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// MockConcurrentCallLog collects the actual calls of a MockSupport that is
+// recording concurrently. Any thread can add a call; each call gets a number
+// in the log and a number within its own thread. The calls are only matched
+// against the expectations when the MockSupport checks its expectations, in
+// the order in which they were added to the log.
+//
+// A recorded call keeps its own copy of string and memory buffer parameters.
+// Other pointers, like objects and output parameters, are used when the call
+// is matched, so they need to stay valid until then. Recorded calls have no
+// return values; they return the default values.
+//
+// The memory leak detector is not thread-safe, so the objects of the log take
+// their memory straight from the platform. While a log exists, SimpleStrings
+// are allocated one at a time, as every thread makes them. Only the thread
+// that created the log uses the mock arena and changes the shared state of the
+// MockSupport.
+//
+
+class MockSupport;
+struct MockRecordedParameter;
+
+/* The operator new macro of the memory leak detector would clash with the declarations below */
+#ifdef CPPUTEST_USE_NEW_MACROS
+#undef new
+#define D_MockConcurrentCallLog_RestoreNewMacros
+#endif
+
+class MockRecordingObject
+{
+public:
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, const char* file, size_t line);
+    static void operator delete(void* memory);
+    static void operator delete(void* memory, const char* file, size_t line);
+};
+
+#ifdef D_MockConcurrentCallLog_RestoreNewMacros
+#undef D_MockConcurrentCallLog_RestoreNewMacros
+#include "CppUTest/MemoryLeakDetectorNewMacros.h"
+#endif
+
+class MockRecordedActualCall : public MockIgnoredActualCall, public MockRecordingObject
+{
+public:
+    MockRecordedActualCall(MockSupport& support, const SimpleString& functionName, unsigned int threadIndex, unsigned int threadSequence);
+    virtual ~MockRecordedActualCall() _destructor_override;
+
+    virtual MockActualCall& withCallOrder(unsigned int callOrder) _override;
+    virtual MockActualCall& withBoolParameter(const SimpleString& name, bool value) _override;
+    virtual MockActualCall& withIntParameter(const SimpleString& name, int value) _override;
+    virtual MockActualCall& withUnsignedIntParameter(const SimpleString& name, unsigned int value) _override;
+    virtual MockActualCall& withLongIntParameter(const SimpleString& name, long int value) _override;
+    virtual MockActualCall& withUnsignedLongIntParameter(const SimpleString& name, unsigned long int value) _override;
+    virtual MockActualCall& withLongLongIntParameter(const SimpleString& name, cpputest_longlong value) _override;
+    virtual MockActualCall& withUnsignedLongLongIntParameter(const SimpleString& name, cpputest_ulonglong value) _override;
+    virtual MockActualCall& withDoubleParameter(const SimpleString& name, double value) _override;
+    virtual MockActualCall& withStringParameter(const SimpleString& name, const char* value) _override;
+    virtual MockActualCall& withPointerParameter(const SimpleString& name, void* value) _override;
+    virtual MockActualCall& withConstPointerParameter(const SimpleString& name, const void* value) _override;
+    virtual MockActualCall& withFunctionPointerParameter(const SimpleString& name, void (*value)()) _override;
+    virtual MockActualCall& withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size) _override;
+    virtual MockActualCall& withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value) _override;
+    virtual MockActualCall& withOutputParameter(const SimpleString& name, void* output) _override;
+    virtual MockActualCall& withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output) _override;
+    virtual MockActualCall& onObject(const void* objectPtr) _override;
+
+    virtual void replayOn(MockActualCall& call) const;
+
+    MockSupport& getSupport() const;
+    const SimpleString& getFunctionName() const;
+    unsigned int getThreadIndex() const;
+    unsigned int getThreadSequence() const;
+    MockRecordedActualCall* getNext() const;
+
+private:
+    friend class MockConcurrentCallLog;
+
+    MockSupport& support_;
+    SimpleString functionName_;
+    unsigned int threadIndex_;
+    unsigned int threadSequence_;
+    MockRecordedParameter* parameters_;
+    MockRecordedParameter* lastParameter_;
+    MockRecordedActualCall* next_;
+
+    MockRecordedParameter* addParameter(int kind, const SimpleString& name);
+
+    MockRecordedActualCall(const MockRecordedActualCall&);
+    MockRecordedActualCall& operator=(const MockRecordedActualCall&);
+};
+
+struct MockConcurrentThread;
+class MockLockingStringAllocator;
+
+class MockConcurrentCallLog
+{
+public:
+    MockConcurrentCallLog(bool orderPerThread = false);
+    virtual ~MockConcurrentCallLog();
+
+    virtual MockActualCall& record(MockSupport& support, const SimpleString& functionName);
+    virtual MockRecordedActualCall* takeCalls();
+
+    bool isOrderPerThread() const;
+    bool isCalledFromAnotherThread() const;
+    SimpleMutex* getMutex();
+    size_t getCallCount();
+
+    /* A recording thread asked for a scope that does not exist, the first one is kept for the test thread */
+    void recordMissingScope(const SimpleString& scopeName);
+    SimpleString takeMissingScope();
+    size_t getThreadCount();
+
+    virtual void clear();
+
+private:
+    SimpleMutex mutex_;
+    bool orderPerThread_;
+    unsigned long recordingThreadId_;
+    MockRecordedActualCall* head_;
+    MockRecordedActualCall* tail_;
+    size_t callCount_;
+    MockConcurrentThread* threads_;
+    size_t threadCount_;
+    MockLockingStringAllocator* stringAllocator_;
+    char missingScope_[64];
+
+    MockConcurrentThread* threadFor(unsigned long threadId);
+
+    MockConcurrentCallLog(const MockConcurrentCallLog&);
+    MockConcurrentCallLog& operator=(const MockConcurrentCallLog&);
+};
+
+#endif
@@ -28,6 +28,8 @@
 #ifndef D_MockExpectedCallsList_h
 #define D_MockExpectedCallsList_h
 
+#include "CppUTestExt/MockMemoryArena.h"
+
 class MockCheckedExpectedCall;
 class MockNamedValue;
 
@@ -46,6 +48,7 @@ public:
     virtual bool hasFinalizedMatchingExpectations() const;
     virtual bool hasUnmatchingExpectationsBecauseOfMissingParameters() const;
     virtual bool hasExpectationWithName(const SimpleString& name) const;
+    virtual bool hasExpectationWithName(const SimpleString& name, const char* internedName) const;
     virtual bool hasCallsOutOfOrder() const;
     virtual bool isEmpty() const;
 
@@ -55,15 +58,19 @@ public:
 
     virtual void onlyKeepOutOfOrderExpectations();
     virtual void addPotentiallyMatchingExpectations(const MockExpectedCallsList& list);
+    virtual void removeExpectedCall(MockCheckedExpectedCall* call);
 
     virtual void onlyKeepExpectationsRelatedTo(const SimpleString& name);
+    virtual void onlyKeepExpectationsRelatedTo(const SimpleString& name, const char* internedName);
     virtual void onlyKeepExpectationsWithInputParameter(const MockNamedValue& parameter);
     virtual void onlyKeepExpectationsWithInputParameterName(const SimpleString& name);
     virtual void onlyKeepExpectationsWithOutputParameter(const MockNamedValue& parameter);
     virtual void onlyKeepExpectationsWithOutputParameterName(const SimpleString& name);
     virtual void onlyKeepExpectationsOnObject(const void* objectPtr);
     virtual void onlyKeepUnmatchingExpectations();
+    virtual void onlyKeepPotentiallyMatchingExpectations();
 
+    virtual MockCheckedExpectedCall* firstPotentiallyMatchingExpectation();
     virtual MockCheckedExpectedCall* removeFirstFinalizedMatchingExpectation();
     virtual MockCheckedExpectedCall* removeFirstMatchingExpectation();
     virtual MockCheckedExpectedCall* getFirstMatchingExpectation();
@@ -80,7 +87,7 @@ public:
 protected:
     virtual void pruneEmptyNodeFromList();
 
-    class MockExpectedCallsListNode
+    class MockExpectedCallsListNode : public MockArenaObject
     {
     public:
         MockCheckedExpectedCall* expectedCall_;
@@ -92,8 +99,49 @@ protected:
 
 private:
     MockExpectedCallsListNode* head_;
+    MockExpectedCallsListNode* tail_;
 
     MockExpectedCallsList(const MockExpectedCallsList&);
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// MockExpectedCallsIndex keeps, per function name, the expectations that can
+// still match an actual call, in the order in which they were expected. An
+// actual call then only has to look at the expectations for its own function
+// instead of at all expectations. The index does not own the expectations.
+//
+
+struct MockExpectedCallsIndexEntry;
+
+class MockExpectedCallsIndex
+{
+public:
+    MockExpectedCallsIndex();
+    virtual ~MockExpectedCallsIndex();
+
+    virtual void addExpectedCall(const SimpleString& name, MockCheckedExpectedCall* call);
+    virtual void expectedCallWasRenamed(const SimpleString& name, MockCheckedExpectedCall* call);
+    virtual void removeExpectedCall(MockCheckedExpectedCall* call);
+
+    virtual const char* findName(const SimpleString& name) const;
+    virtual const char* internName(const SimpleString& name);
+    virtual bool hasExpectationWithName(const char* internedName) const;
+    virtual const MockExpectedCallsList& potentiallyMatchingExpectationsFor(const char* internedName);
+    virtual const MockExpectedCallsList& expectationsFor(const char* internedName) const;
+    virtual MockCheckedExpectedCall* firstPotentiallyMatchingExpectationFor(const char* internedName);
+
+    virtual void clear();
+
+private:
+    MockExpectedCallsIndexEntry* entryFor(const char* internedName) const;
+
+    SimpleStringInternTable names_;
+    MockExpectedCallsIndexEntry* entries_;
+    MockExpectedCallsList noExpectations_;
+
+    MockExpectedCallsIndex(const MockExpectedCallsIndex&);
+    MockExpectedCallsIndex& operator=(const MockExpectedCallsIndex&);
+};
+
 #endif
@@ -35,6 +35,7 @@ class MockExpectedCallsList;
 class MockCheckedActualCall;
 class MockNamedValue;
 class MockFailure;
+class MockTypedFunction;
 
 class MockFailureReporter
 {
@@ -58,6 +59,7 @@ public:
 protected:
     void addExpectationsAndCallHistory(const MockExpectedCallsList& expectations);
     void addExpectationsAndCallHistoryRelatedTo(const SimpleString& function, const MockExpectedCallsList& expectations);
+    void addExpectationsAndCallHistory(const MockTypedFunction& function);
 };
 
 class MockExpectedCallsDidntHappenFailure : public MockFailure
@@ -120,4 +122,28 @@ public:
     MockExpectedObjectDidntHappenFailure(UtestShell* test, const SimpleString& functionName, const MockExpectedCallsList& expectations);
 };
 
+class MockExpectedTypedCallsDidntHappenFailure : public MockFailure
+{
+public:
+    MockExpectedTypedCallsDidntHappenFailure(UtestShell* test, const MockTypedFunction& function);
+};
+
+class MockUnexpectedTypedCallHappenedFailure : public MockFailure
+{
+public:
+    MockUnexpectedTypedCallHappenedFailure(UtestShell* test, const SimpleString& actualCall, const MockTypedFunction& function);
+};
+
+class MockScopeCreatedWhileRecordingFailure : public MockFailure
+{
+public:
+    MockScopeCreatedWhileRecordingFailure(UtestShell* test, const SimpleString& scopeName);
+};
+
+class MockCallFileFailure : public MockFailure
+{
+public:
+    MockCallFileFailure(UtestShell* test, const SimpleString& fileName, size_t lineNumber, const SimpleString& message);
+};
+
 #endif
@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockFunction_h
+#define D_MockFunction_h
+
+#include "CppUTestExt/MockSupport.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// MockFunction is a typed layer on top of MockSupport. The parameters of an
+// expectation are stored and compared in their own types, so an actual call
+// does not box them into MockNamedValues nor look up comparators. Parameter
+// values are only turned into strings when a failure is reported, using
+// StringFrom like CHECK_EQUAL does.
+//
+//     MockFunction<int(const Foo&, int)> read("read");
+//     read.expect().with(eq(foo), any()).andReturn(3);
+//     LONGS_EQUAL(3, read(foo, 10));
+//
+// Expectations register with mock(scope) and are verified and cleared by its
+// checkExpectations() and clear(). They do not take part in strictOrder(),
+// ignoreOtherCalls(), disable() or tracing(). Functions of up to four
+// parameters are supported.
+//
+
+class MockAnyArgument
+{
+};
+
+inline MockAnyArgument any()
+{
+    return MockAnyArgument();
+}
+
+template <typename T>
+class MockEqualArgument
+{
+public:
+    explicit MockEqualArgument(const T& value) : value_(value) {}
+    const T& getValue() const { return value_; }
+private:
+    T value_;
+};
+
+template <typename T>
+MockEqualArgument<T> eq(T value)
+{
+    return MockEqualArgument<T>(value);
+}
+
+struct MockNoArgument
+{
+};
+
+template <typename T> struct MockArgumentType { typedef T Type; };
+template <typename T> struct MockArgumentType<const T> { typedef T Type; };
+template <typename T> struct MockArgumentType<T&> { typedef T Type; };
+template <typename T> struct MockArgumentType<const T&> { typedef T Type; };
+
+template <typename T>
+struct MockArgumentEquality
+{
+    static bool equal(const T& expected, const T& actual) { return expected == actual; }
+};
+
+template <>
+struct MockArgumentEquality<const char*>
+{
+    static bool equal(const char* expected, const char* actual)
+    {
+        if (expected == NULLPTR || actual == NULLPTR) return expected == actual;
+        return SimpleString::StrCmp(expected, actual) == 0;
+    }
+};
+
+template <>
+struct MockArgumentEquality<MockNoArgument>
+{
+    static bool equal(const MockNoArgument&, const MockNoArgument&) { return true; }
+};
+
+inline void appendMockArgumentString(SimpleString& str, const SimpleString& argument)
+{
+    if (!str.isEmpty()) str += ", ";
+    str += "<";
+    str += argument;
+    str += ">";
+}
+
+template <typename T>
+void appendActualMockArgument(SimpleString& str, const T& value)
+{
+    appendMockArgumentString(str, StringFrom(value));
+}
+
+inline void appendActualMockArgument(SimpleString&, const MockNoArgument&)
+{
+}
+
+template <typename T>
+class MockTypedArgument
+{
+public:
+    MockTypedArgument() : value_(NULLPTR) {}
+    MockTypedArgument(const MockAnyArgument&) : value_(NULLPTR) {}
+    MockTypedArgument(const T& value) : value_(new T(value)) {}
+    template <typename U>
+    MockTypedArgument(const MockEqualArgument<U>& argument) : value_(new T(argument.getValue())) {}
+    MockTypedArgument(const MockTypedArgument& other) : value_((other.value_) ? new T(*other.value_) : NULLPTR) {}
+    ~MockTypedArgument() { delete value_; }
+
+    MockTypedArgument& operator=(const MockTypedArgument& other)
+    {
+        if (this != &other) {
+            delete value_;
+            value_ = (other.value_) ? new T(*other.value_) : NULLPTR;
+        }
+        return *this;
+    }
+
+    bool matches(const T& actual) const
+    {
+        return value_ == NULLPTR || MockArgumentEquality<T>::equal(*value_, actual);
+    }
+
+    void appendTo(SimpleString& str) const
+    {
+        appendMockArgumentString(str, (value_) ? StringFrom(*value_) : SimpleString("any"));
+    }
+
+private:
+    T* value_;
+};
+
+template <>
+class MockTypedArgument<MockNoArgument>
+{
+public:
+    MockTypedArgument() {}
+    MockTypedArgument(const MockAnyArgument&) {}
+    MockTypedArgument(const MockNoArgument&) {}
+
+    bool matches(const MockNoArgument&) const { return true; }
+    void appendTo(SimpleString&) const {}
+};
+
+template <typename R>
+class MockTypedReturnValue
+{
+public:
+    MockTypedReturnValue() : value_(NULLPTR) {}
+    ~MockTypedReturnValue() { delete value_; }
+
+    void set(const R& value)
+    {
+        delete value_;
+        value_ = new R(value);
+    }
+
+    R get() const { return (value_) ? *value_ : R(); }
+
+private:
+    R* value_;
+
+    MockTypedReturnValue(const MockTypedReturnValue&);
+    MockTypedReturnValue& operator=(const MockTypedReturnValue&);
+};
+
+template <>
+class MockTypedReturnValue<void>
+{
+public:
+    void get() const {}
+};
+
+class MockTypedFunction
+{
+public:
+    MockTypedFunction(const SimpleString& name, const SimpleString& scope)
+        : name_((scope.isEmpty()) ? name : scope + "::" + name), scope_(scope), registeredWith_(NULLPTR), nextRegistered_(NULLPTR)
+    {
+    }
+
+    virtual ~MockTypedFunction()
+    {
+        if (registeredWith_) registeredWith_->removeTypedFunction(this);
+    }
+
+    const SimpleString& getName() const { return name_; }
+
+    virtual bool hasUnfulfilledExpectations() const=0;
+    virtual SimpleString unfulfilledCallsToString(const SimpleString& linePrefix) const=0;
+    virtual SimpleString fulfilledCallsToString(const SimpleString& linePrefix) const=0;
+    virtual void clearExpectations()=0;
+
+protected:
+    void expectationWasAdded()
+    {
+        MockSupport& support = mock(scope_);
+        if (registeredWith_ != &support) {
+            if (registeredWith_) registeredWith_->removeTypedFunction(this);
+            support.addTypedFunction(this);
+        }
+        support.countCheck();
+    }
+
+    void failWithUnexpectedCall(const SimpleString& actualArguments)
+    {
+        SimpleString actualCall = name_;
+        actualCall += " -> ";
+        actualCall += (actualArguments.isEmpty()) ? SimpleString("no parameters") : actualArguments;
+        mock(scope_).failTestWithUnexpectedTypedCall(*this, actualCall);
+    }
+
+    static SimpleString expectedCallsToString(unsigned int expectedCalls, unsigned int actualCalls)
+    {
+        return StringFromFormat(" (expected %u call%s, called %u time%s)",
+                                expectedCalls, (expectedCalls == 1) ? "" : "s", actualCalls, (actualCalls == 1) ? "" : "s");
+    }
+
+private:
+    friend class MockSupport;
+
+    SimpleString name_;
+    SimpleString scope_;
+    MockSupport* registeredWith_;
+    MockTypedFunction* nextRegistered_;
+
+    MockTypedFunction(const MockTypedFunction&);
+    MockTypedFunction& operator=(const MockTypedFunction&);
+};
+
+template <typename R, typename A1, typename A2, typename A3, typename A4>
+class MockTypedFunctionImplementation : public MockTypedFunction
+{
+protected:
+    typedef typename MockArgumentType<A1>::Type T1;
+    typedef typename MockArgumentType<A2>::Type T2;
+    typedef typename MockArgumentType<A3>::Type T3;
+    typedef typename MockArgumentType<A4>::Type T4;
+
+public:
+    class Expectation
+    {
+    public:
+        Expectation& with(const MockTypedArgument<T1>& a1 = MockTypedArgument<T1>(), const MockTypedArgument<T2>& a2 = MockTypedArgument<T2>(),
+                          const MockTypedArgument<T3>& a3 = MockTypedArgument<T3>(), const MockTypedArgument<T4>& a4 = MockTypedArgument<T4>())
+        {
+            a1_ = a1;
+            a2_ = a2;
+            a3_ = a3;
+            a4_ = a4;
+            return *this;
+        }
+
+        template <typename V>
+        Expectation& andReturn(const V& value)
+        {
+            returnValue_.set(value);
+            return *this;
+        }
+
+    private:
+        friend class MockTypedFunctionImplementation;
+
+        Expectation(unsigned int expectedCalls) : expectedCalls_(expectedCalls), actualCalls_(0), next_(NULLPTR) {}
+
+        bool matches(const T1& a1, const T2& a2, const T3& a3, const T4& a4) const
+        {
+            return (actualCalls_ < expectedCalls_) && a1_.matches(a1) && a2_.matches(a2) && a3_.matches(a3) && a4_.matches(a4);
+        }
+
+        bool isFulfilled() const { return actualCalls_ == expectedCalls_; }
+
+        SimpleString toString(const SimpleString& name) const
+        {
+            SimpleString arguments;
+            a1_.appendTo(arguments);
+            a2_.appendTo(arguments);
+            a3_.appendTo(arguments);
+            a4_.appendTo(arguments);
+
+            SimpleString str = name;
+            str += " -> ";
+            str += (arguments.isEmpty()) ? SimpleString("no parameters") : arguments;
+            str += expectedCallsToString(expectedCalls_, actualCalls_);
+            return str;
+        }
+
+        unsigned int expectedCalls_;
+        unsigned int actualCalls_;
+        MockTypedArgument<T1> a1_;
+        MockTypedArgument<T2> a2_;
+        MockTypedArgument<T3> a3_;
+        MockTypedArgument<T4> a4_;
+        MockTypedReturnValue<R> returnValue_;
+        Expectation* next_;
+
+        Expectation(const Expectation&);
+        Expectation& operator=(const Expectation&);
+    };
+
+    MockTypedFunctionImplementation(const SimpleString& name, const SimpleString& scope)
+        : MockTypedFunction(name, scope), head_(NULLPTR), tail_(NULLPTR)
+    {
+    }
+
+    virtual ~MockTypedFunctionImplementation() _destructor_override
+    {
+        clearExpectations();
+    }
+
+    Expectation& expect(unsigned int amount = 1)
+    {
+        Expectation* expectation = new Expectation(amount);
+        if (tail_) tail_->next_ = expectation;
+        else head_ = expectation;
+        tail_ = expectation;
+
+        expectationWasAdded();
+        return *expectation;
+    }
+
+    virtual bool hasUnfulfilledExpectations() const _override
+    {
+        for (Expectation* p = head_; p; p = p->next_)
+            if (!p->isFulfilled()) return true;
+        return false;
+    }
+
+    virtual SimpleString unfulfilledCallsToString(const SimpleString& linePrefix) const _override
+    {
+        return callsToString(linePrefix, false);
+    }
+
+    virtual SimpleString fulfilledCallsToString(const SimpleString& linePrefix) const _override
+    {
+        return callsToString(linePrefix, true);
+    }
+
+    virtual void clearExpectations() _override
+    {
+        while (head_) {
+            Expectation* next = head_->next_;
+            delete head_;
+            head_ = next;
+        }
+        tail_ = NULLPTR;
+    }
+
+protected:
+    R call(const T1& a1, const T2& a2, const T3& a3, const T4& a4)
+    {
+        for (Expectation* p = head_; p; p = p->next_)
+            if (p->matches(a1, a2, a3, a4)) {
+                p->actualCalls_++;
+                return p->returnValue_.get();
+            }
+
+        SimpleString actualArguments;
+        appendActualMockArgument(actualArguments, a1);
+        appendActualMockArgument(actualArguments, a2);
+        appendActualMockArgument(actualArguments, a3);
+        appendActualMockArgument(actualArguments, a4);
+        failWithUnexpectedCall(actualArguments);
+        return MockTypedReturnValue<R>().get();
+    }
+
+private:
+    SimpleString callsToString(const SimpleString& linePrefix, bool fulfilled) const
+    {
+        SimpleString str;
+        for (Expectation* p = head_; p; p = p->next_)
+            if (p->isFulfilled() == fulfilled) {
+                if (!str.isEmpty()) str += "\n";
+                str += linePrefix;
+                str += p->toString(getName());
+            }
+        return str;
+    }
+
+    Expectation* head_;
+    Expectation* tail_;
+};
+
+template <typename Signature>
+class MockFunction;
+
+template <typename R>
+class MockFunction<R()> : public MockTypedFunctionImplementation<R, MockNoArgument, MockNoArgument, MockNoArgument, MockNoArgument>
+{
+public:
+    MockFunction(const SimpleString& name, const SimpleString& scope = "")
+        : MockTypedFunctionImplementation<R, MockNoArgument, MockNoArgument, MockNoArgument, MockNoArgument>(name, scope) {}
+
+    R operator()()
+    {
+        return this->call(MockNoArgument(), MockNoArgument(), MockNoArgument(), MockNoArgument());
+    }
+};
+
+template <typename R, typename A1>
+class MockFunction<R(A1)> : public MockTypedFunctionImplementation<R, A1, MockNoArgument, MockNoArgument, MockNoArgument>
+{
+public:
+    MockFunction(const SimpleString& name, const SimpleString& scope = "")
+        : MockTypedFunctionImplementation<R, A1, MockNoArgument, MockNoArgument, MockNoArgument>(name, scope) {}
+
+    R operator()(A1 a1)
+    {
+        return this->call(a1, MockNoArgument(), MockNoArgument(), MockNoArgument());
+    }
+};
+
+template <typename R, typename A1, typename A2>
+class MockFunction<R(A1, A2)> : public MockTypedFunctionImplementation<R, A1, A2, MockNoArgument, MockNoArgument>
+{
+public:
+    MockFunction(const SimpleString& name, const SimpleString& scope = "")
+        : MockTypedFunctionImplementation<R, A1, A2, MockNoArgument, MockNoArgument>(name, scope) {}
+
+    R operator()(A1 a1, A2 a2)
+    {
+        return this->call(a1, a2, MockNoArgument(), MockNoArgument());
+    }
+};
+
+template <typename R, typename A1, typename A2, typename A3>
+class MockFunction<R(A1, A2, A3)> : public MockTypedFunctionImplementation<R, A1, A2, A3, MockNoArgument>
+{
+public:
+    MockFunction(const SimpleString& name, const SimpleString& scope = "")
+        : MockTypedFunctionImplementation<R, A1, A2, A3, MockNoArgument>(name, scope) {}
+
+    R operator()(A1 a1, A2 a2, A3 a3)
+    {
+        return this->call(a1, a2, a3, MockNoArgument());
+    }
+};
+
+template <typename R, typename A1, typename A2, typename A3, typename A4>
+class MockFunction<R(A1, A2, A3, A4)> : public MockTypedFunctionImplementation<R, A1, A2, A3, A4>
+{
+public:
+    MockFunction(const SimpleString& name, const SimpleString& scope = "")
+        : MockTypedFunctionImplementation<R, A1, A2, A3, A4>(name, scope) {}
+
+    R operator()(A1 a1, A2 a2, A3 a3, A4 a4)
+    {
+        return this->call(a1, a2, a3, a4);
+    }
+};
+
+#endif
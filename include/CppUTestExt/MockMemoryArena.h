@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockMemoryArena_h
+#define D_MockMemoryArena_h
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// MockMemoryArena hands out the memory for the bookkeeping objects of the
+// mocking support (expectations, actual calls, list nodes and named values).
+// It takes its memory in chunks straight from the platform, so these objects
+// are not tracked one by one by the memory leak detector. Freed memory at the
+// top of the arena is reused at once.
+//
+// MockSupport::clear() resets the arena. Objects that outlive it, like a list
+// a test built on its own, keep their chunk until they are deleted, but the
+// arena starts over with fresh chunks so they do not pin what comes after.
+//
+// The arena is not synchronized. Only use it from the thread that runs the
+// test; calls recorded from other threads (MockConcurrentCallLog) must not
+// allocate arena objects.
+//
+
+class MockMemoryArena
+{
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* memory);
+    static void reset();
+
+    static size_t getAllocationCount();
+    static size_t getChunkCount();
+};
+
+/* The operator new macro of the memory leak detector would clash with the declarations below */
+#ifdef CPPUTEST_USE_NEW_MACROS
+#undef new
+#define D_MockMemoryArena_RestoreNewMacros
+#endif
+
+class MockArenaObject
+{
+public:
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, const char* file, size_t line);
+    static void operator delete(void* memory);
+    static void operator delete(void* memory, const char* file, size_t line);
+};
+
+#ifdef D_MockMemoryArena_RestoreNewMacros
+#undef D_MockMemoryArena_RestoreNewMacros
+#include "CppUTest/MemoryLeakDetectorNewMacros.h"
+#endif
+
+#endif
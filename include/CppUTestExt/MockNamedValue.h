@@ -29,6 +29,7 @@
 #define D_MockNamedValue_h
 
 #include "CppUTest/CppUTestConfig.h"
+#include "CppUTestExt/MockMemoryArena.h"
 
 /*
  * MockNamedValueComparator is an interface that needs to be used when creating Comparators.
@@ -97,7 +98,7 @@ private:
  */
 
 class MockNamedValueComparatorsAndCopiersRepository;
-class MockNamedValue
+class MockNamedValue : public MockArenaObject
 {
 public:
     MockNamedValue(const SimpleString& name);
@@ -192,7 +193,7 @@ private:
     static MockNamedValueComparatorsAndCopiersRepository* defaultRepository_;
 };
 
-class MockNamedValueListNode
+class MockNamedValueListNode : public MockArenaObject
 {
 public:
     MockNamedValueListNode(MockNamedValue* newValue);
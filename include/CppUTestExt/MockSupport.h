@@ -35,10 +35,64 @@
 
 class UtestShell;
 class MockSupport;
+class MockTypedFunction;
+class MockConcurrentCallLog;
+class MockCallFileReader;
+class MockCallFileWriter;
 
 /* This allows access to "the global" mocking support for easier testing */
 MockSupport& mock(const SimpleString& mockName = "", MockFailureReporter* failureReporterForThisCall = NULLPTR);
 
+/*
+ * MockFunctionId is a handle for a mocked function that is called often. It resolves
+ * the mocking scope and the function name once and reuses them on later calls, until
+ * the mocking support is cleared. Keep it in a static at the call site:
+ *
+ *   static MockFunctionId readId("read");
+ *   return readId.actualCall().withParameter("fd", fd).returnIntValue();
+ *
+ * The names are not copied, so they need to live as long as the handle.
+ */
+class MockFunctionId
+{
+public:
+    explicit MockFunctionId(const char* functionName, const char* scopeName = "");
+
+    MockActualCall& actualCall();
+
+    const char* getFunctionName() const;
+    const char* getScopeName() const;
+
+private:
+    friend class MockSupport;
+
+    const char* functionName_;
+    const char* scopeName_;
+    MockSupport* scope_;
+    MockSupport* support_;
+    const char* internedName_;
+    unsigned int resolvedAtClear_;
+};
+
+/*
+ * MockSupportHandle holds what a handle caches for one mocking support, like the
+ * parameter names of the C function handles. The support deletes it when it is cleared.
+ */
+class MockSupportHandle
+{
+public:
+    MockSupportHandle() : nextHandle_(NULLPTR) {}
+    virtual ~MockSupportHandle() {}
+
+private:
+    friend class MockSupport;
+
+    MockSupportHandle* nextHandle_;
+
+    MockSupportHandle(const MockSupportHandle&);
+    MockSupportHandle& operator=(const MockSupportHandle&);
+};
+
 class MockSupport
 {
 public:
@@ -49,7 +103,20 @@ public:
     virtual MockExpectedCall& expectOneCall(const SimpleString& functionName);
     virtual void expectNoCall(const SimpleString& functionName);
     virtual MockExpectedCall& expectNCalls(unsigned int amount, const SimpleString& functionName);
+    virtual MockExpectedCall& expectAtLeastNCalls(unsigned int amount, const SimpleString& functionName);
+    virtual MockExpectedCall& expectAtMostNCalls(unsigned int amount, const SimpleString& functionName);
     virtual MockActualCall& actualCall(const SimpleString& functionName);
+    MockActualCall& actualCall(MockFunctionId& function);
+
+    /*
+     * Expected calls are read from a mock call file (see MockCallFile.h) one at a time, as the
+     * actual calls arrive, so the calls of a file are expected in the order of the file. They
+     * take no part in strictOrder(). While recording, actual calls are not checked but written
+     * to a mock call file; their return values are the defaults.
+     */
+    virtual void expectCallsFromFile(const SimpleString& fileName);
+    virtual void recordActualCallsToFile(const SimpleString& fileName);
+    virtual void stopRecordingActualCalls();
     virtual bool hasReturnValue();
     virtual MockNamedValue returnValue();
     virtual bool boolReturnValue();
@@ -91,6 +158,7 @@ public:
     MockNamedValue getData(const SimpleString& name);
 
     MockSupport* getMockSupportScope(const SimpleString& name);
+    void addHandle(MockSupportHandle* handle);
 
     const char* getTraceOutput();
     /*
@@ -101,6 +169,19 @@ public:
     virtual void disable();
     virtual void enable();
     virtual void tracing(bool enabled);
+    virtual void tracingToRingBuffer(size_t maximumEvents, MockActualCallTrace::OverflowPolicy policy = MockActualCallTrace::OVERWRITE_OLDEST);
+
+    /*
+     * In concurrent recording, actual calls from any thread are only logged. They are matched
+     * against the expectations in checkExpectations(), in the order in which they were logged.
+     * With strictOrderPerThread, strictOrder() only checks the order of the calls of each thread.
+     * Recorded calls return default values. Create mocking scopes before starting the threads,
+     * a scope first asked for by another thread fails the test when the calls are matched.
+     * mock() called from the other threads leaves the reporter and comparators alone.
+     */
+    virtual void concurrentRecording(bool enabled = true, bool strictOrderPerThread = false);
+    bool isRecordingConcurrently() const;
+    bool isCalledFromARecordingThread() const;
     virtual void ignoreOtherCalls();
 
     virtual void checkExpectations();
@@ -124,14 +205,18 @@ public:
 
 protected:
     MockSupport* clone(const SimpleString& mockName);
-    virtual MockCheckedActualCall *createActualCall();
+    virtual MockCheckedActualCall *createActualCall(const char* internedFunctionName);
     virtual void failTest(MockFailure& failure);
     void countCheck();
 
 private:
+    friend class MockTypedFunction;
+    friend class MockFunctionId;
+
     unsigned int actualCallOrder_;
     unsigned int expectedCallOrder_;
     bool strictOrdering_;
+    bool callsOutOfOrder_;
     MockFailureReporter *activeReporter_;
     MockFailureReporter *standardReporter_;
     MockFailureReporter defaultReporter_;
@@ -142,19 +227,57 @@ private:
     MockNamedValueComparatorsAndCopiersRepository comparatorsAndCopiersRepository_;
     MockNamedValueList data_;
     const SimpleString mockName_;
+    MockExpectedCallsIndex expectationsIndex_;
+    MockTypedFunction* typedFunctions_;
+    MockConcurrentCallLog* concurrentCalls_;
+    bool ownsConcurrentCalls_;
+    MockCallFileReader* expectationsFile_;
+    MockCheckedExpectedCall* fileExpectation_;
+    MockExpectedCallsList retiredFileExpectations_;
+    MockCallFileWriter* callRecorder_;
+    MockSupportHandle* handles_;
 
     bool tracing_;
 
+    static unsigned int clearCount_;
+
     void checkExpectationsOfLastActualCall();
     bool wasLastActualCallFulfilled();
+    void addExpectationsOfAllScopesTo(MockExpectedCallsList& expectationsList);
+    MockFailure createExpectedCallsNotFulfilledFailure();
+    MockFailure createCallOrderFailure();
     void failTestWithExpectedCallsNotFulfilled();
     void failTestWithOutOfOrderCalls();
 
+    void addTypedFunction(MockTypedFunction* function);
+    void removeTypedFunction(MockTypedFunction* function);
+    void clearTypedFunctions();
+    bool hasUnfulfilledTypedExpectations();
+    MockTypedFunction* getTypedFunctionWithUnfulfilledExpectations();
+    void failTestWithUnexpectedTypedCall(const MockTypedFunction& function, const SimpleString& actualCall);
+
     MockNamedValue* retrieveDataFromStore(const SimpleString& name);
 
     MockSupport* getMockSupport(MockNamedValueListNode* node);
+    MockNamedValue* findMockSupportScope(const SimpleString& mockingSupportName);
+    MockSupport* createMockSupportScope(const SimpleString& mockingSupportName, const SimpleString& name);
 
-    bool callIsIgnored(const SimpleString& functionName);
+    MockExpectedCall& expectCalls(unsigned int minimumCalls, unsigned int maximumCalls, const SimpleString& functionName);
+    MockCheckedExpectedCall* createExpectedCall(unsigned int minimumCalls, unsigned int maximumCalls, const SimpleString& functionName);
+    bool advanceExpectationsFile();
+    void retireFileExpectation();
+    void clearCallFiles();
+    void clearHandles();
+    void failTestWithCallFileError(const SimpleString& fileName, size_t lineNumber, const SimpleString& message);
+    bool isFirstExpectationDueAt(const MockCheckedExpectedCall* expectation, unsigned int callOrder) const;
+    bool callIsIgnored(const char* internedFunctionName);
+    void finishLastActualCall();
+    MockActualCall& actualCallWithScopedName(const SimpleString& scopeFunctionName);
+    void setConcurrentCalls(MockConcurrentCallLog* concurrentCalls);
+    void replayConcurrentCalls();
+    MockActualCall& checkedActualCall(const SimpleString& scopeFunctionName, const char* internedFunctionName);
+    static bool isResolvedFor(const MockSupport* support, const MockFunctionId& function);
+    void checkCallOrderOf(MockCheckedActualCall* call);
     bool hasCallsOutOfOrder();
 
     SimpleString appendScopeToName(const SimpleString& functionName);
@@ -231,6 +231,50 @@ struct SMockSupport_c
 MockSupport_c* mock_c(void);
 MockSupport_c* mock_scope_c(const char* scope);
 
+/*
+ * Function handles pass their parameters by position, in the order of the parameter
+ * descriptors, so the names are not converted on every call. A handle resolves its
+ * mocking scope and parameter names on first use and again after the scope is cleared.
+ * Keep it in a static next to the mocked function:
+ *
+ *   static const MockParameter_c writeParameters[] = {
+ *       { MOCKVALUETYPE_INTEGER, "fd", NULL },
+ *       { MOCKVALUETYPE_MEMORYBUFFER, "data", NULL }
+ *   };
+ *   static MockFunction_c writeFunction = MOCK_FUNCTION_C("write", writeParameters);
+ *
+ *   int write(int fd, const unsigned char* data, size_t size)
+ *   {
+ *       return mock_c_actualCall(&writeFunction, fd, data, size)->intReturnValue();
+ *   }
+ *
+ * Values are passed as their C types; a memory buffer takes the buffer and its size,
+ * and an object parameter takes a const void* of the type named in its descriptor.
+ */
+typedef struct SMockParameter_c
+{
+    MockValueType_c type;
+    const char* name;
+    const char* typeName;
+} MockParameter_c;
+
+typedef struct SMockFunction_c
+{
+    const char* scope;
+    const char* name;
+    const MockParameter_c* parameters;
+    size_t parameterCount;
+    void* resolved;
+} MockFunction_c;
+
+#define MOCK_FUNCTION_C(name, parameters) { "", name, parameters, sizeof(parameters) / sizeof((parameters)[0]), NULL }
+#define MOCK_SCOPED_FUNCTION_C(scope, name, parameters) { scope, name, parameters, sizeof(parameters) / sizeof((parameters)[0]), NULL }
+#define MOCK_FUNCTION_WITHOUT_PARAMETERS_C(name) { "", name, NULL, 0, NULL }
+
+MockExpectedCall_c* mock_c_expectCall(MockFunction_c* function, ...);
+MockExpectedCall_c* mock_c_expectNCalls(unsigned int number, MockFunction_c* function, ...);
+MockActualCall_c* mock_c_actualCall(MockFunction_c* function, ...);
+
 #ifdef __cplusplus
 }
 #endif
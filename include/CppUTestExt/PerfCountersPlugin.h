@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_PerfCountersPlugin_h
+#define D_PerfCountersPlugin_h
+
+#include "CppUTest/TestPlugin.h"
+
+/*
+ * With -pperfcounters, counts instructions, cycles, cache misses and branch
+ * misses of every test through perf_event_open and adds them to the test's
+ * result, so they end up in -v, JSON and binary output. Where no hardware
+ * counter can be opened, e.g. in most virtual machines, it counts task clock
+ * and page faults instead. Counting is per thread and excludes the kernel.
+ * On platforms without perf_event_open nothing is counted.
+ */
+class PerfCountersPlugin : public TestPlugin
+{
+public:
+    enum Counter
+    {
+        INSTRUCTIONS, CYCLES, CACHE_MISSES, BRANCH_MISSES,
+        TASK_CLOCK, PAGE_FAULTS,
+        NUMBER_OF_COUNTERS
+    };
+
+    PerfCountersPlugin(const SimpleString& name = "PerfCountersPlugin");
+    virtual ~PerfCountersPlugin() _destructor_override;
+
+    virtual void preTestAction(UtestShell& test, TestResult& result) _override;
+    virtual void postTestAction(UtestShell& test, TestResult& result) _override;
+    virtual bool parseArguments(int, const char *const *, int) _override;
+
+    void activate();
+    bool isCounting(Counter counter) const;
+    static const char* nameOf(Counter counter);
+
+protected:
+    /* Returns a handle to a stopped counter for the calling thread, or -1 */
+    virtual int openCounter(Counter counter);
+    virtual void startCounter(int handle);
+    virtual bool stopCounter(int handle, unsigned long& value);
+    virtual void closeCounter(int handle);
+
+    virtual long currentProcess();
+
+    /* Subclasses with their own counters close them in their destructor */
+    void closeCounters();
+
+private:
+    void openCounters();
+
+    bool active_;
+    long openedInProcess_;
+    int handles_[NUMBER_OF_COUNTERS];
+};
+
+#endif
@@ -18,6 +18,13 @@ CPPU_OBJECTS := \
   $(CPPUTEST_HOME)/src/CppUTest/TestTestingFixture.o \
   $(CPPUTEST_HOME)/src/CppUTest/TestResult.o \
   $(CPPUTEST_HOME)/src/CppUTest/Utest.o \
+  $(CPPUTEST_HOME)/src/CppUTest/PropertyTest.o \
+  $(CPPUTEST_HOME)/src/CppUTest/FuzzTest.o \
+  $(CPPUTEST_HOME)/src/CppUTest/TestCaseGenerator.o \
+  $(CPPUTEST_HOME)/src/CppUTest/TestFilterMatcher.o \
+  $(CPPUTEST_HOME)/src/CppUTest/TestOutputMultiplexer.o \
+  $(CPPUTEST_HOME)/src/CppUTest/TestResultChannel.o \
+  $(CPPUTEST_HOME)/src/CppUTest/JsonTestOutput.o \
   $(CPPUTEST_HOME)/src/Platforms/Dos/UtestPlatform.o
 
 CPPUX_OBJECTS := \
@@ -32,6 +39,10 @@ CPPUX_OBJECTS := \
   $(CPPUTEST_HOME)/src/CppUTestExt/MockExpectedCall.o \
   $(CPPUTEST_HOME)/src/CppUTestExt/MockNamedValue.o \
   $(CPPUTEST_HOME)/src/CppUTestExt/OrderedTest.o \
+  $(CPPUTEST_HOME)/src/CppUTestExt/PerfCountersPlugin.o \
+  $(CPPUTEST_HOME)/src/CppUTestExt/MockCallFile.o \
+  $(CPPUTEST_HOME)/src/CppUTestExt/MockConcurrentCallLog.o \
+  $(CPPUTEST_HOME)/src/CppUTestExt/MockMemoryArena.o \
   $(CPPUTEST_HOME)/src/CppUTestExt/MemoryReportFormatter.o \
   $(CPPUTEST_HOME)/src/CppUTestExt/MockExpectedCallsList.o \
   $(CPPUTEST_HOME)/src/CppUTestExt/MockSupport.o
@@ -93,6 +104,15 @@ CPPU8_OBJECTS := \
   $(CPPUTEST_HOME)/tests/CppUTest/AllTests.o \
   $(CPPUTEST_HOME)/tests/CppUTest/UtestPlatformTest.o \
   $(CPPUTEST_HOME)/tests/CppUTest/UtestTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/PropertyTestTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/FuzzTestTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/TestCaseGeneratorTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/TestGroupFixtureTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/TestSectionRegistrationTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/TestFilterMatcherTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/TestOutputMultiplexerTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/TestResultChannelTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTest/JsonOutputTest.o \
   $(CPPUTEST_HOME)/tests/CppUTest/TestUTestStringMacro.o \
 
 CPPUX1_OBJECTS := \
@@ -164,3 +184,8 @@ CPPUX9_OBJECTS := \
   $(CPPUTEST_HOME)/tests/CppUTestExt/MockReturnValueTest.o \
   $(CPPUTEST_HOME)/tests/CppUTestExt/MockStrictOrderTest.o \
   $(CPPUTEST_HOME)/tests/CppUTestExt/MockSupportTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTestExt/PerfCountersPluginTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTestExt/MockCallFileTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTestExt/MockConcurrentCallLogTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTestExt/MockMemoryArenaTest.o \
+  $(CPPUTEST_HOME)/tests/CppUTestExt/MockFunctionTest.o \
@@ -30,7 +30,7 @@
 #include "CppUTest/PlatformSpecificFunctions.h"
 
 CommandLineArguments::CommandLineArguments(int ac, const char *const *av) :
-    ac_(ac), av_(av), needHelp_(false), verbose_(false), veryVerbose_(false), color_(false), runTestsAsSeperateProcess_(false), listTestGroupNames_(false), listTestGroupAndCaseNames_(false), runIgnored_(false), reversing_(false), shuffling_(false), shufflingPreSeeded_(false), repeat_(1), shuffleSeed_(0), groupFilters_(NULLPTR), nameFilters_(NULLPTR), outputType_(OUTPUT_ECLIPSE)
+    ac_(ac), av_(av), needHelp_(false), verbose_(false), veryVerbose_(false), color_(false), runTestsAsSeperateProcess_(false), listTestGroupNames_(false), listTestGroupAndCaseNames_(false), runIgnored_(false), reversing_(false), shuffling_(false), shufflingPreSeeded_(false), repeat_(1), shuffleSeed_(0), fuzzRuns_(0), fuzzSeed_(0), propertyRuns_(0), propertySeed_(0), testTimeout_(0), groupFilters_(NULLPTR), nameFilters_(NULLPTR), testFilters_(NULLPTR), outputType_(OUTPUT_ECLIPSE)
 {
 }
 
@@ -46,6 +46,11 @@ CommandLineArguments::~CommandLineArguments()
         nameFilters_ = nameFilters_->getNext();
         delete current;
     }
+    while(testFilters_) {
+        TestFilter* current = testFilters_;
+        testFilters_ = testFilters_->getNext();
+        delete current;
+    }
 }
 
 bool CommandLineArguments::parse(TestPlugin* plugin)
@@ -67,6 +72,13 @@ bool CommandLineArguments::parse(TestPlugin* plugin)
         else if (argument == "-ln") listTestGroupAndCaseNames_ = true;
         else if (argument == "-ri") runIgnored_ = true;
         else if (argument.startsWith("-r")) setRepeatCount(ac_, av_, i);
+        else if (argument.startsWith("--filter-file")) correctParameters = addFilterFile(ac_, av_, i);
+        else if (argument.startsWith("--fuzz-seed")) correctParameters = setFuzzSeed(ac_, av_, i);
+        else if (argument.startsWith("--fuzz")) correctParameters = setFuzzRuns(ac_, av_, i);
+        else if (argument.startsWith("--corpus")) setCorpusDirectory(ac_, av_, i);
+        else if (argument.startsWith("--property-runs")) correctParameters = setPropertyRuns(ac_, av_, i);
+        else if (argument.startsWith("--property-seed")) correctParameters = setPropertySeed(ac_, av_, i);
+        else if (argument.startsWith("--timeout")) correctParameters = setTestTimeout(ac_, av_, i);
         else if (argument.startsWith("-g")) addGroupFilter(ac_, av_, i);
         else if (argument.startsWith("-t")) correctParameters = addGroupDotNameFilter(ac_, av_, i);
         else if (argument.startsWith("-sg")) addStrictGroupFilter(ac_, av_, i);
@@ -93,9 +105,11 @@ bool CommandLineArguments::parse(TestPlugin* plugin)
 
 const char* CommandLineArguments::usage() const
 {
-    return "use -h for more extensive help\nusage [-h] [-v] [-vv] [-c] [-p] [-lg] [-ln] [-ri] [-r#]\n"
+    return "use -h for more extensive help\nusage [-h] [-v] [-vv] [-c] [-p] [-lg] [-ln] [-ri] [-r#] [--timeout=ms]\n"
                                            "      [-g|sg|xg|xsg groupName]... [-n|sn|xn|xsn testName]... [-t groupName.testName]...\n"
-                                           "      [-b] [-s [randomizerSeed>0]] [\"TEST(groupName, testName)\"]... [-o{normal, junit, teamcity}] [-k packageName]\n";
+                                           "      [--filter-file fileName]... [--fuzz[=runs]] [--corpus directory] [--fuzz-seed seed]\n"
+                                           "      [--property-runs runs] [--property-seed seed]\n"
+                                           "      [-b] [-s [randomizerSeed>0]] [\"TEST(groupName, testName)\"]... [-o{normal, junit, junitsingle, teamcity, json, binary}] [-k packageName]\n";
 }
 
 const char* CommandLineArguments::help() const
@@ -116,6 +130,9 @@ const char* CommandLineArguments::help() const
       "Options that change the output location:\n"
       "  -oteamcity       - output to xml files (as the name suggests, for TeamCity)\n"
       "  -ojunit          - output to JUnit ant plugin style xml files (for CI systems)\n"
+      "  -ojunitsingle    - output to one JUnit xml file for the whole run, appended per group\n"
+      "  -ojson           - output one JSON object per test to a JSON Lines file (for result ingestion)\n"
+      "  -obinary         - output the -ojson records length-prefixed and binary encoded\n"
       "  -k package name  - Add a package name in JUnit output (for classification in CI systems)\n"
       "\n"
       "\n"
@@ -129,12 +146,30 @@ const char* CommandLineArguments::help() const
       "  -xn name         - exclude tests whose name contains the substring name (v3.8)\n"
       "  TEST(group,name) - only run test whose group and name matches the strings group and name.\n"
       "                     This can be used to copy-paste output from the -v option on the command line.\n"
+      "  --filter-file file - read filters from file, one per line: any of the filter options\n"
+      "                     above with its argument, or group.name to run exactly that test.\n"
+      "                     Lines starting with # are ignored. Excludes win over includes.\n"
       "\n"
       "Options that control how the tests are run:\n"
       "  -p               - run tests in a separate process.\n"
       "  -b               - run the tests backwards, reversing the normal way\n"
       "  -s [seed]        - shuffle tests randomly. Seed is optional\n"
-      "  -r#              - repeat the tests some number (#) of times, or twice if # is not specified.\n";
+      "  -r#              - repeat the tests some number (#) of times, or twice if # is not specified.\n"
+      "  --timeout=ms     - fail a test that runs longer than ms milliseconds, TEST_TIMEOUT overrides\n"
+      "                     it per test. With -p the test process is killed, otherwise the hung test\n"
+      "                     is reported with its stack and the run is aborted.\n"
+      "\n"
+      "Options for FUZZ_TEST:\n"
+      "  --fuzz[=runs]    - run fuzz targets on mutated inputs instead of replaying their corpus,\n"
+      "                     for 100000 runs if runs is not specified. Use filters to pick a target.\n"
+      "  --corpus dir     - the corpus directories are dir/group.name, by default corpus/group.name\n"
+      "  --fuzz-seed s    - mutate from seed s, as reported by a failing input, instead of a new\n"
+      "                     seed for every fuzz target\n"
+      "\n"
+      "Options for FOR_ALL:\n"
+      "  --property-runs n - check every property for n generated values instead of 100\n"
+      "  --property-seed s - generate the values from seed s, as reported by a failed property,\n"
+      "                     instead of a new seed for every property\n";
 }
 
 bool CommandLineArguments::needHelp() const
@@ -193,6 +228,36 @@ bool CommandLineArguments::isShuffling() const
     return shuffling_;
 }
 
+size_t CommandLineArguments::getFuzzRuns() const
+{
+    return fuzzRuns_;
+}
+
+const SimpleString& CommandLineArguments::getCorpusDirectory() const
+{
+    return corpusDirectory_;
+}
+
+unsigned int CommandLineArguments::getFuzzSeed() const
+{
+    return fuzzSeed_;
+}
+
+size_t CommandLineArguments::getPropertyRuns() const
+{
+    return propertyRuns_;
+}
+
+unsigned int CommandLineArguments::getPropertySeed() const
+{
+    return propertySeed_;
+}
+
+size_t CommandLineArguments::getTestTimeout() const
+{
+    return testTimeout_;
+}
+
 size_t CommandLineArguments::getShuffleSeed() const
 {
     return shuffleSeed_;
@@ -208,6 +273,58 @@ const TestFilter* CommandLineArguments::getNameFilters() const
     return nameFilters_;
 }
 
+const TestFilter* CommandLineArguments::getTestFilters() const
+{
+    return testFilters_;
+}
+
+bool CommandLineArguments::setFuzzRuns(int, const char *const *av, int& i)
+{
+    SimpleString fuzzParameter(av[i]);
+    if (fuzzParameter == "--fuzz") {
+        fuzzRuns_ = 100000;
+        return true;
+    }
+    if (!fuzzParameter.startsWith("--fuzz=")) return false;
+    fuzzRuns_ = (size_t) SimpleString::AtoU(av[i] + 7);
+    return fuzzRuns_ != 0;
+}
+
+void CommandLineArguments::setCorpusDirectory(int ac, const char *const *av, int& i)
+{
+    corpusDirectory_ = getParameterField(ac, av, i, "--corpus");
+}
+
+/* Both --option value and --option=value */
+static unsigned int parseOptionNumber(const SimpleString& field)
+{
+    return SimpleString::AtoU(field.asCharString() + (field.startsWith("=") ? 1 : 0));
+}
+
+bool CommandLineArguments::setFuzzSeed(int ac, const char *const *av, int& i)
+{
+    fuzzSeed_ = parseOptionNumber(getParameterField(ac, av, i, "--fuzz-seed"));
+    return fuzzSeed_ != 0;
+}
+
+bool CommandLineArguments::setPropertyRuns(int ac, const char *const *av, int& i)
+{
+    propertyRuns_ = parseOptionNumber(getParameterField(ac, av, i, "--property-runs"));
+    return propertyRuns_ != 0;
+}
+
+bool CommandLineArguments::setPropertySeed(int ac, const char *const *av, int& i)
+{
+    propertySeed_ = parseOptionNumber(getParameterField(ac, av, i, "--property-seed"));
+    return propertySeed_ != 0;
+}
+
+bool CommandLineArguments::setTestTimeout(int ac, const char *const *av, int& i)
+{
+    testTimeout_ = parseOptionNumber(getParameterField(ac, av, i, "--timeout"));
+    return testTimeout_ != 0;
+}
+
 void CommandLineArguments::setRepeatCount(int ac, const char *const *av, int& i)
 {
     repeat_ = 0;
@@ -336,6 +453,86 @@ void CommandLineArguments::addTestToRunBasedOnVerboseOutput(int ac, const char *
     nameFilters_ = namefilter->add(nameFilters_);
 }
 
+static bool isFilterFileSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+static SimpleString trimFilterFileField(const char* field)
+{
+    while (isFilterFileSpace(*field)) field++;
+    size_t length = SimpleString::StrLen(field);
+    while (length > 0 && isFilterFileSpace(field[length - 1])) length--;
+    return SimpleString(field).subString(0, length);
+}
+
+bool CommandLineArguments::addFilterFromFileLine(const SimpleString& line)
+{
+    if (line.isEmpty() || line.startsWith("#")) return true;
+
+    if (!line.startsWith("-")) {
+        if (line.find('.') == SimpleString::npos) return false;
+        TestFilter* testFilter = new TestFilter(line);
+        testFilter->strictMatching();
+        testFilters_ = testFilter->add(testFilters_);
+        return true;
+    }
+
+    size_t optionEnd = 0;
+    while (optionEnd < line.size() && !isFilterFileSpace(line.at(optionEnd))) optionEnd++;
+    SimpleString option = line.subString(0, optionEnd);
+    SimpleString parameter = trimFilterFileField(line.asCharString() + optionEnd);
+
+    const char* av[] = { option.asCharString(), parameter.asCharString() };
+    int ac = parameter.isEmpty() ? 1 : 2;
+    int i = 0;
+
+    if (option.startsWith("-g")) addGroupFilter(ac, av, i);
+    else if (option.startsWith("-t")) return addGroupDotNameFilter(ac, av, i);
+    else if (option.startsWith("-sg")) addStrictGroupFilter(ac, av, i);
+    else if (option.startsWith("-xg")) addExcludeGroupFilter(ac, av, i);
+    else if (option.startsWith("-xsg")) addExcludeStrictGroupFilter(ac, av, i);
+    else if (option.startsWith("-n")) addNameFilter(ac, av, i);
+    else if (option.startsWith("-sn")) addStrictNameFilter(ac, av, i);
+    else if (option.startsWith("-xn")) addExcludeNameFilter(ac, av, i);
+    else if (option.startsWith("-xsn")) addExcludeStrictNameFilter(ac, av, i);
+    else return false;
+    return true;
+}
+
+bool CommandLineArguments::addFilterFile(int ac, const char *const *av, int& i)
+{
+    SimpleString fileName = getParameterField(ac, av, i, "--filter-file");
+    if (fileName.startsWith("=")) fileName = fileName.subString(1);
+    if (fileName.isEmpty()) return false;
+
+    PlatformSpecificFile file = PlatformSpecificFOpen(fileName.asCharString(), "r");
+    if (file == NULLPTR) return false;
+
+    bool correctFile = true;
+    char chunk[512 + 1];
+    SimpleString line;
+    size_t chunkSize;
+    while (correctFile && (chunkSize = PlatformSpecificFRead(chunk, sizeof(chunk) - 1, file)) > 0) {
+        chunk[chunkSize] = '\0';
+        size_t lineStart = 0;
+        for (size_t pos = 0; pos < chunkSize && correctFile; pos++) {
+            if (chunk[pos] != '\n') continue;
+            chunk[pos] = '\0';
+            line += chunk + lineStart;
+            correctFile = addFilterFromFileLine(trimFilterFileField(line.asCharString()));
+            line = "";
+            lineStart = pos + 1;
+        }
+        line += chunk + lineStart;
+    }
+    if (correctFile)
+        correctFile = addFilterFromFileLine(trimFilterFileField(line.asCharString()));
+
+    PlatformSpecificFClose(file);
+    return correctFile;
+}
+
 void CommandLineArguments::setPackageName(int ac, const char *const *av, int& i)
 {
     SimpleString packageName = getParameterField(ac, av, i, "-k");
@@ -357,10 +554,22 @@ bool CommandLineArguments::setOutputType(int ac, const char *const *av, int& i)
         outputType_ = OUTPUT_JUNIT;
         return true;
     }
+    if (outputType == "junitsingle") {
+        outputType_ = OUTPUT_JUNIT_SINGLE_FILE;
+        return true;
+    }
     if (outputType == "teamcity") {
         outputType_ = OUTPUT_TEAMCITY;
         return true;
     }
+    if (outputType == "json") {
+        outputType_ = OUTPUT_JSON;
+        return true;
+    }
+    if (outputType == "binary") {
+        outputType_ = OUTPUT_BINARY;
+        return true;
+    }
 
     return false;
 }
@@ -375,11 +584,26 @@ bool CommandLineArguments::isJUnitOutput() const
     return outputType_ == OUTPUT_JUNIT;
 }
 
+bool CommandLineArguments::isJUnitSingleFileOutput() const
+{
+    return outputType_ == OUTPUT_JUNIT_SINGLE_FILE;
+}
+
 bool CommandLineArguments::isTeamCityOutput() const
 {
     return outputType_ == OUTPUT_TEAMCITY;
 }
 
+bool CommandLineArguments::isJsonOutput() const
+{
+    return outputType_ == OUTPUT_JSON;
+}
+
+bool CommandLineArguments::isBinaryOutput() const
+{
+    return outputType_ == OUTPUT_BINARY;
+}
+
 const SimpleString& CommandLineArguments::getPackageName() const
 {
     return packageName_;
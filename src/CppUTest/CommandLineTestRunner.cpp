@@ -29,6 +29,7 @@
 #include "CppUTest/CommandLineTestRunner.h"
 #include "CppUTest/TestOutput.h"
 #include "CppUTest/JUnitTestOutput.h"
+#include "CppUTest/JsonTestOutput.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
 #include "CppUTest/TeamCityTestOutput.h"
 #include "CppUTest/TestRegistry.h"
@@ -78,9 +79,17 @@ int CommandLineTestRunner::runAllTestsMain()
     SetPointerPlugin pPlugin(DEF_PLUGIN_SET_POINTER);
     registry_->installPlugin(&pPlugin);
 
+    size_t savedPropertyRuns = PropertyChecker::getRuns();
+    unsigned int savedPropertySeed = PropertyChecker::getSeed();
+
     if (parseArguments(registry_->getFirstPlugin()))
         testResult = runAllTests();
 
+    PropertyChecker::setRuns(savedPropertyRuns);
+    PropertyChecker::setSeed(savedPropertySeed);
+
+    /* The corpus directory belongs to the arguments, which go with the runner */
+    registry_->setCorpusDirectory(NULLPTR);
     registry_->removePluginByName(DEF_PLUGIN_SET_POINTER);
     return testResult;
 }
@@ -89,12 +98,19 @@ void CommandLineTestRunner::initializeTestRun()
 {
     registry_->setGroupFilters(arguments_->getGroupFilters());
     registry_->setNameFilters(arguments_->getNameFilters());
+    registry_->setTestFilters(arguments_->getTestFilters());
 
     if (arguments_->isVerbose()) output_->verbose(TestOutput::level_verbose);
     if (arguments_->isVeryVerbose()) output_->verbose(TestOutput::level_veryVerbose);
     if (arguments_->isColor()) output_->color();
     if (arguments_->runTestsInSeperateProcess()) registry_->setRunTestsInSeperateProcess();
     if (arguments_->isRunIgnored()) registry_->setRunIgnored();
+    if (arguments_->getTestTimeout() != 0) registry_->setTestTimeout(arguments_->getTestTimeout());
+    if (arguments_->getFuzzRuns() != 0) registry_->setFuzzRuns(arguments_->getFuzzRuns());
+    if (!arguments_->getCorpusDirectory().isEmpty()) registry_->setCorpusDirectory(arguments_->getCorpusDirectory().asCharString());
+    if (arguments_->getFuzzSeed() != 0) registry_->setFuzzSeed(arguments_->getFuzzSeed());
+    if (arguments_->getPropertyRuns() != 0) PropertyChecker::setRuns(arguments_->getPropertyRuns());
+    if (arguments_->getPropertySeed() != 0) PropertyChecker::setSeed(arguments_->getPropertySeed());
 }
 
 int CommandLineTestRunner::runAllTests()
@@ -133,6 +149,9 @@ int CommandLineTestRunner::runAllTests()
         if (arguments_->isShuffling())
             registry_->shuffleTests(arguments_->getShuffleSeed());
 
+        /* Built before the first test runs, so lookups from within tests don't allocate */
+        registry_->buildIndex();
+
         output_->printTestRun(loopCount, repeatCount);
         TestResult tr(*output_);
         registry_->runAllTests(tr);
@@ -154,10 +173,25 @@ TestOutput* CommandLineTestRunner::createJUnitOutput(const SimpleString& package
     JUnitTestOutput* junitOutput = new JUnitTestOutput;
     if (junitOutput != NULLPTR) {
       junitOutput->setPackageName(packageName);
+      junitOutput->setSingleFileOutput(arguments_->isJUnitSingleFileOutput());
     }
     return junitOutput;
 }
 
+TestOutput* CommandLineTestRunner::createJsonOutput(const SimpleString& packageName)
+{
+    JsonTestOutput* jsonOutput = new JsonTestOutput;
+    jsonOutput->setPackageName(packageName);
+    return jsonOutput;
+}
+
+TestOutput* CommandLineTestRunner::createBinaryOutput(const SimpleString& packageName)
+{
+    BinaryTestOutput* binaryOutput = new BinaryTestOutput;
+    binaryOutput->setPackageName(packageName);
+    return binaryOutput;
+}
+
 TestOutput* CommandLineTestRunner::createConsoleOutput()
 {
     return new ConsoleTestOutput;
@@ -179,10 +213,17 @@ bool CommandLineTestRunner::parseArguments(TestPlugin* plugin)
     return false;
   }
 
-  if (arguments_->isJUnitOutput()) {
+  if (arguments_->isJUnitOutput() || arguments_->isJUnitSingleFileOutput()) {
     output_= createJUnitOutput(arguments_->getPackageName());
     if (arguments_->isVerbose())
       output_ = createCompositeOutput(output_, createConsoleOutput());
+  } else if (arguments_->isJsonOutput() || arguments_->isBinaryOutput()) {
+    if (arguments_->isJsonOutput())
+      output_ = createJsonOutput(arguments_->getPackageName());
+    else
+      output_ = createBinaryOutput(arguments_->getPackageName());
+    if (arguments_->isVerbose())
+      output_ = createCompositeOutput(output_, createConsoleOutput());
   } else if (arguments_->isTeamCityOutput()) {
     output_ = createTeamCityOutput();
   } else
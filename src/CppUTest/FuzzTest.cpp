@@ -0,0 +1,609 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/FuzzTest.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+//////////////////// Coverage
+
+/*
+ * The sanitizer coverage callbacks count hits per edge (trace-pc-guard) or
+ * per hashed return address (trace-pc). The fuzzer turns the counts into
+ * libFuzzer style hit count buckets, an input is kept when it reaches a
+ * bucket that no input reached before.
+ */
+
+enum { FUZZ_PC_COUNTERS = 1 << 16, FUZZ_PC_BLOCK_SHIFT = 8, FUZZ_PC_BLOCKS = FUZZ_PC_COUNTERS >> FUZZ_PC_BLOCK_SHIFT };
+
+/* The hashed counters are sparse, the blocks that were hit are marked so that only those are scanned */
+static size_t fuzzPcCounterWords[FUZZ_PC_COUNTERS / sizeof(size_t)];
+static unsigned char fuzzPcBlocksHit[FUZZ_PC_BLOCKS];
+static bool fuzzPcCountersUsed = false;
+static unsigned char* fuzzGuardCounters = NULLPTR;
+static size_t fuzzGuardCount = 0;
+static size_t fuzzGuardCountersSize = 0;
+
+#if defined(__GNUC__)
+
+/* Weak, so that libFuzzer, a sanitizer runtime or the user can define them instead */
+extern "C" void __sanitizer_cov_trace_pc_guard_init(unsigned int* start, unsigned int* stop) __attribute__((weak));
+extern "C" void __sanitizer_cov_trace_pc_guard(unsigned int* guard) __attribute__((weak));
+extern "C" void __sanitizer_cov_trace_pc(void) __attribute__((weak));
+
+extern "C" void __sanitizer_cov_trace_pc_guard_init(unsigned int* start, unsigned int* stop)
+{
+    if (start == stop || *start != 0) return;
+
+    size_t guards = fuzzGuardCount;
+    for (unsigned int* guard = start; guard < stop; guard++)
+        *guard = (unsigned int) ++guards;
+
+    size_t size = (guards + sizeof(size_t)) / sizeof(size_t) * sizeof(size_t);
+    fuzzGuardCounters = (unsigned char*) PlatformSpecificRealloc(fuzzGuardCounters, size);
+    PlatformSpecificMemset(fuzzGuardCounters + fuzzGuardCountersSize, 0, size - fuzzGuardCountersSize);
+    fuzzGuardCount = guards;
+    fuzzGuardCountersSize = size;
+}
+
+extern "C" void __sanitizer_cov_trace_pc_guard(unsigned int* guard)
+{
+    fuzzGuardCounters[*guard]++;
+}
+
+extern "C" void __sanitizer_cov_trace_pc(void)
+{
+    size_t pc = (size_t) __builtin_return_address(0);
+    size_t index = (pc ^ (pc >> 16)) & (FUZZ_PC_COUNTERS - 1);
+    ((unsigned char*) fuzzPcCounterWords)[index]++;
+    fuzzPcBlocksHit[index >> FUZZ_PC_BLOCK_SHIFT] = 1;
+    fuzzPcCountersUsed = true;
+}
+
+#endif
+
+static unsigned char hitCountBucket(unsigned char hits)
+{
+    if (hits >= 128) return 128;
+    if (hits >= 32) return 64;
+    if (hits >= 16) return 32;
+    if (hits >= 8) return 16;
+    if (hits >= 4) return 8;
+    if (hits == 3) return 4;
+    if (hits == 2) return 2;
+    return 1;
+}
+
+static size_t collectFeatures(unsigned char* counters, unsigned char* seen, size_t size)
+{
+    size_t newFeatures = 0;
+    const size_t* words = (const size_t*) (void*) counters;
+    for (size_t word = 0; word < size / sizeof(size_t); word++) {
+        if (words[word] == 0) continue;
+        for (size_t i = word * sizeof(size_t); i < (word + 1) * sizeof(size_t); i++) {
+            if (counters[i] == 0) continue;
+            unsigned char bucket = hitCountBucket(counters[i]);
+            counters[i] = 0;
+            if ((seen[i] & bucket) == 0) {
+                seen[i] |= bucket;
+                newFeatures++;
+            }
+        }
+    }
+    return newFeatures;
+}
+
+class FuzzCoverage
+{
+public:
+    FuzzCoverage() : guardSeenSize_(fuzzGuardCountersSize), featureCount_(0)
+    {
+        guardSeen_ = (unsigned char*) PlatformSpecificMalloc(guardSeenSize_ + 1);
+        pcSeen_ = (unsigned char*) PlatformSpecificMalloc(FUZZ_PC_COUNTERS);
+        PlatformSpecificMemset(guardSeen_, 0, guardSeenSize_);
+        PlatformSpecificMemset(pcSeen_, 0, FUZZ_PC_COUNTERS);
+        if (fuzzGuardCounters) PlatformSpecificMemset(fuzzGuardCounters, 0, fuzzGuardCountersSize);
+        PlatformSpecificMemset(fuzzPcCounterWords, 0, sizeof(fuzzPcCounterWords));
+        PlatformSpecificMemset(fuzzPcBlocksHit, 0, sizeof(fuzzPcBlocksHit));
+    }
+
+    ~FuzzCoverage()
+    {
+        PlatformSpecificFree(guardSeen_);
+        PlatformSpecificFree(pcSeen_);
+    }
+
+    /* Clears the counters, returns how many features the last run reached first */
+    size_t collect()
+    {
+        size_t newFeatures = 0;
+        if (fuzzGuardCounters) newFeatures += collectFeatures(fuzzGuardCounters, guardSeen_, guardSeenSize_);
+        if (fuzzPcCountersUsed) newFeatures += collectPcFeatures();
+        featureCount_ += newFeatures;
+        return newFeatures;
+    }
+
+    size_t getFeatureCount() const
+    {
+        return featureCount_;
+    }
+
+private:
+    size_t collectPcFeatures()
+    {
+        size_t newFeatures = 0;
+        const size_t blockSize = (size_t) 1 << FUZZ_PC_BLOCK_SHIFT;
+        for (size_t block = 0; block < FUZZ_PC_BLOCKS; block++) {
+            if (fuzzPcBlocksHit[block] == 0) continue;
+            fuzzPcBlocksHit[block] = 0;
+            size_t offset = block * blockSize;
+            newFeatures += collectFeatures((unsigned char*) fuzzPcCounterWords + offset, pcSeen_ + offset, blockSize);
+        }
+        return newFeatures;
+    }
+
+    unsigned char* guardSeen_;
+    size_t guardSeenSize_;
+    unsigned char* pcSeen_;
+    size_t featureCount_;
+
+    FuzzCoverage(const FuzzCoverage&);
+    FuzzCoverage& operator=(const FuzzCoverage&);
+};
+
+//////////////////// Helpers
+
+static char* concatenate(char* buffer, const char* first, const char* second, const char* third = "", const char* fourth = "", const char* fifth = "")
+{
+    const char* parts[] = { first, second, third, fourth, fifth };
+    size_t length = 0;
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++)
+        length += SimpleString::StrLen(parts[i]);
+
+    buffer = (char*) PlatformSpecificRealloc(buffer, length + 1);
+    char* end = buffer;
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+        size_t partLength = SimpleString::StrLen(parts[i]);
+        PlatformSpecificMemCpy(end, parts[i], partLength);
+        end += partLength;
+    }
+    *end = '\0';
+    return buffer;
+}
+
+static void moveBytes(unsigned char* to, const unsigned char* from, size_t size)
+{
+    if (to < from)
+        for (size_t i = 0; i < size; i++) to[i] = from[i];
+    else
+        for (size_t i = size; i > 0; i--) to[i - 1] = from[i - 1];
+}
+
+static size_t smallest(size_t first, size_t second)
+{
+    return (first < second) ? first : second;
+}
+
+/* FNV-1a, so an input that is found again is saved under the same name */
+static void formatInputHash(char* hex, const unsigned char* data, size_t size)
+{
+    unsigned long hash = 2166136261UL;
+    for (size_t i = 0; i < size; i++)
+        hash = ((hash ^ data[i]) * 16777619UL) & 0xffffffffUL;
+
+    for (size_t i = 8; i > 0; i--) {
+        hex[i - 1] = "0123456789abcdef"[hash & 0xf];
+        hash >>= 4;
+    }
+    hex[8] = '\0';
+}
+
+class FuzzInputs
+{
+public:
+    FuzzInputs() : inputs_(NULLPTR), count_(0), capacity_(0)
+    {
+    }
+
+    ~FuzzInputs()
+    {
+        for (size_t i = 0; i < count_; i++)
+            PlatformSpecificFree(inputs_[i].data);
+        PlatformSpecificFree(inputs_);
+    }
+
+    void add(const unsigned char* data, size_t size)
+    {
+        if (count_ == capacity_) {
+            capacity_ = capacity_ ? capacity_ * 2 : 64;
+            inputs_ = (Input*) PlatformSpecificRealloc(inputs_, capacity_ * sizeof(Input));
+        }
+        inputs_[count_].data = (unsigned char*) PlatformSpecificMalloc(size + 1);
+        PlatformSpecificMemCpy(inputs_[count_].data, data, size);
+        inputs_[count_].size = size;
+        count_++;
+    }
+
+    size_t count() const
+    {
+        return count_;
+    }
+
+    const unsigned char* getData(size_t index) const
+    {
+        return inputs_[index].data;
+    }
+
+    size_t getSize(size_t index) const
+    {
+        return inputs_[index].size;
+    }
+
+private:
+    struct Input
+    {
+        unsigned char* data;
+        size_t size;
+    };
+
+    Input* inputs_;
+    size_t count_;
+    size_t capacity_;
+
+    FuzzInputs(const FuzzInputs&);
+    FuzzInputs& operator=(const FuzzInputs&);
+};
+
+//////////////////// TestCorpusGenerator
+
+TestCorpusGenerator::TestCorpusGenerator(const char* groupName, const char* testName) :
+    groupName_(groupName), testName_(testName), corpusDirectory_(NULLPTR), directory_(NULLPTR), corpusPath_(NULLPTR), filePath_(NULLPTR),
+    caseName_(NULLPTR), data_(NULLPTR), size_(0), capacity_(0)
+{
+}
+
+TestCorpusGenerator::~TestCorpusGenerator()
+{
+    close();
+    PlatformSpecificFree(corpusPath_);
+    PlatformSpecificFree(filePath_);
+    PlatformSpecificFree(caseName_);
+    PlatformSpecificFree(data_);
+}
+
+bool TestCorpusGenerator::first()
+{
+    close();
+    corpusPath_ = concatenate(corpusPath_, corpusDirectory_ ? corpusDirectory_ : "corpus", "/", groupName_, ".", testName_);
+    caseName_ = concatenate(caseName_, "empty", "");
+    size_ = 0;
+    directory_ = PlatformSpecificOpenDir(corpusPath_);
+    return true;
+}
+
+bool TestCorpusGenerator::next()
+{
+    if (directory_ == NULLPTR) return false;
+
+    const char* fileName;
+    while ((fileName = PlatformSpecificReadDir(directory_)) != NULLPTR) {
+        if (fileName[0] != '.' && readFile(fileName)) {
+            caseName_ = concatenate(caseName_, fileName, "");
+            return true;
+        }
+    }
+    close();
+    return false;
+}
+
+void TestCorpusGenerator::setCorpusDirectory(const char* directory)
+{
+    corpusDirectory_ = directory;
+}
+
+const char* TestCorpusGenerator::getCaseName() const
+{
+    return caseName_;
+}
+
+const unsigned char* TestCorpusGenerator::getData() const
+{
+    return data_;
+}
+
+size_t TestCorpusGenerator::getSize() const
+{
+    return size_;
+}
+
+const char* TestCorpusGenerator::getCorpusPath() const
+{
+    return corpusPath_;
+}
+
+void TestCorpusGenerator::close()
+{
+    if (directory_) PlatformSpecificCloseDir(directory_);
+    directory_ = NULLPTR;
+}
+
+bool TestCorpusGenerator::readFile(const char* fileName)
+{
+    filePath_ = concatenate(filePath_, corpusPath_, "/", fileName);
+    PlatformSpecificFile file = PlatformSpecificFOpen(filePath_, "rb");
+    if (file == NULLPTR) return false;
+
+    size_ = 0;
+    size_t bytesRead;
+    do {
+        if (capacity_ - size_ < 4096) {
+            capacity_ += 4096;
+            data_ = (unsigned char*) PlatformSpecificRealloc(data_, capacity_);
+        }
+        bytesRead = PlatformSpecificFRead(data_ + size_, capacity_ - size_, file);
+        size_ += bytesRead;
+    } while (bytesRead != 0);
+    PlatformSpecificFClose(file);
+    return true;
+}
+
+//////////////////// FuzzMutator
+
+static const unsigned char interestingBytes[] = { 0x00, 0x01, 0x10, 0x20, 0x40, 0x7e, 0x7f, 0x80, 0x81, 0xff };
+
+FuzzMutator::FuzzMutator(unsigned long seed) : state_(seed & 0xffffffffUL)
+{
+    if (state_ == 0) state_ = 0x9e3779b9UL;
+}
+
+size_t FuzzMutator::random(size_t bound)
+{
+    state_ ^= (state_ << 13) & 0xffffffffUL;
+    state_ ^= state_ >> 17;
+    state_ ^= (state_ << 5) & 0xffffffffUL;
+    return (bound == 0) ? 0 : (size_t) (state_ % bound);
+}
+
+size_t FuzzMutator::mutate(unsigned char* data, size_t size, size_t maxSize, const unsigned char* other, size_t otherSize)
+{
+    size = smallest(size, maxSize);
+    size_t mutations = 1 + random(4);
+    for (size_t i = 0; i < mutations; i++)
+        size = mutateOnce(data, size, maxSize, other, otherSize);
+    return size;
+}
+
+size_t FuzzMutator::mutateOnce(unsigned char* data, size_t size, size_t maxSize, const unsigned char* other, size_t otherSize)
+{
+    if (size == 0) {
+        if (maxSize == 0) return 0;
+        data[0] = (unsigned char) random(256);
+        return 1;
+    }
+
+    size_t position = random(size);
+    switch (random(8)) {
+    case 0: /* flip a bit */
+        data[position] = (unsigned char) (data[position] ^ (1u << random(8)));
+        return size;
+    case 1: /* change a byte */
+        data[position] = (unsigned char) random(256);
+        return size;
+    case 2: /* add or subtract a little */
+        data[position] = (unsigned char) (data[position] + random(33) - 16);
+        return size;
+    case 3: /* an interesting value */
+        data[position] = interestingBytes[random(sizeof(interestingBytes))];
+        return size;
+    case 4: /* insert a byte */
+        if (size == maxSize) return size;
+        moveBytes(data + position + 1, data + position, size - position);
+        data[position] = (unsigned char) random(256);
+        return size + 1;
+    case 5: { /* erase bytes */
+        size_t length = 1 + random(smallest(size - position, 16));
+        if (length == size) return size;
+        moveBytes(data + position, data + position + length, size - position - length);
+        return size - length;
+    }
+    case 6: { /* copy bytes within the input */
+        size_t from = random(size);
+        size_t length = 1 + random(smallest(size - from, size - position));
+        moveBytes(data + position, data + from, length);
+        return size;
+    }
+    default: { /* splice in bytes of another input */
+        if (otherSize == 0) return size;
+        size_t from = random(otherSize);
+        size_t length = 1 + random(smallest(otherSize - from, maxSize - position));
+        moveBytes(data + position, other + from, length);
+        return (position + length > size) ? position + length : size;
+    }
+    }
+}
+
+//////////////////// FuzzUtestShell
+
+FuzzUtestShell::FuzzUtestShell(const char* groupName, const char* testName) :
+    ParameterizedUtestShell(groupName, testName, corpus_), corpus_(groupName, testName), data_(NULLPTR), size_(0), runs_(0), seed_(0)
+{
+}
+
+FuzzUtestShell::~FuzzUtestShell()
+{
+}
+
+void FuzzUtestShell::setFuzzOptions(size_t runs, const char* corpusDirectory, unsigned int seed)
+{
+    runs_ = runs;
+    seed_ = seed;
+    corpus_.setCorpusDirectory(corpusDirectory);
+}
+
+const unsigned char* FuzzUtestShell::getData() const
+{
+    return data_;
+}
+
+size_t FuzzUtestShell::getSize() const
+{
+    return size_;
+}
+
+bool FuzzUtestShell::firstCase()
+{
+    if (runs_ != 0) return UtestShell::firstCase();
+    return ParameterizedUtestShell::firstCase();
+}
+
+bool FuzzUtestShell::nextCase()
+{
+    if (runs_ != 0) return UtestShell::nextCase();
+    return ParameterizedUtestShell::nextCase();
+}
+
+SimpleString FuzzUtestShell::getMacroName() const
+{
+    return "FUZZ_TEST";
+}
+
+void FuzzUtestShell::runOneTestInCurrentProcess(TestPlugin* plugin, TestResult& result)
+{
+    if (runs_ == 0) {
+        data_ = corpus_.getData();
+        size_ = corpus_.getSize();
+        ParameterizedUtestShell::runOneTestInCurrentProcess(plugin, result);
+        return;
+    }
+
+    UtestShell* savedTest = UtestShell::getCurrent();
+    TestResult* savedResult = UtestShell::getTestResult();
+
+    UtestShell::setTestResult(&result);
+    UtestShell::setCurrentTest(this);
+
+    Utest* testToRun = createTest();
+    fuzz(testToRun, plugin, result);
+    destroyTest(testToRun);
+
+    UtestShell::setCurrentTest(savedTest);
+    UtestShell::setTestResult(savedResult);
+}
+
+bool FuzzUtestShell::runInput(Utest* test, TestPlugin* plugin, TestResult& result, const unsigned char* data, size_t size)
+{
+    size_t failureCount = result.getFailureCount();
+    data_ = data;
+    size_ = size;
+
+    plugin->runAllPreTestAction(*this, result);
+    test->run();
+    plugin->runAllPostTestAction(*this, result);
+    return result.getFailureCount() == failureCount;
+}
+
+void FuzzUtestShell::fuzz(Utest* test, TestPlugin* plugin, TestResult& result)
+{
+    FuzzCoverage coverage;
+    FuzzInputs inputs;
+    long startTime = GetPlatformSpecificTimeInMillis();
+    unsigned int seed = seed_ ? seed_ : (unsigned int) startTime | 1;
+    FuzzMutator mutator(seed);
+    size_t executions = 0;
+    bool failed = false;
+
+    for (bool hasInput = corpus_.first(); hasInput && !failed; hasInput = corpus_.next()) {
+        executions++;
+        if (!runInput(test, plugin, result, corpus_.getData(), corpus_.getSize())) {
+            failWithInput(result, corpus_.getData(), corpus_.getSize(), seed);
+            failed = true;
+        }
+        else if (coverage.collect() != 0 || inputs.count() == 0)
+            inputs.add(corpus_.getData(), corpus_.getSize());
+    }
+    corpus_.close();
+
+    unsigned char* input = (unsigned char*) PlatformSpecificMalloc(MAX_INPUT_SIZE);
+    for (size_t run = 0; run < runs_ && !failed; run++) {
+        size_t base = mutator.random(inputs.count());
+        size_t other = mutator.random(inputs.count());
+        size_t size = smallest(inputs.getSize(base), MAX_INPUT_SIZE);
+        PlatformSpecificMemCpy(input, inputs.getData(base), size);
+        size = mutator.mutate(input, size, MAX_INPUT_SIZE, inputs.getData(other), inputs.getSize(other));
+
+        executions++;
+        if (!runInput(test, plugin, result, input, size)) {
+            failWithInput(result, input, size, seed);
+            failed = true;
+        }
+        else if (coverage.collect() != 0) {
+            inputs.add(input, size);
+            char hash[9];
+            formatInputHash(hash, input, size);
+            char* path = concatenate(NULLPTR, corpus_.getCorpusPath(), "/", hash);
+            saveInput(path, input, size);
+            PlatformSpecificFree(path);
+        }
+    }
+    PlatformSpecificFree(input);
+
+    long elapsed = GetPlatformSpecificTimeInMillis() - startTime;
+    result.print(StringFromFormat("\n%s: %lu runs in %ld ms (%lu exec/s), %lu inputs in corpus, %lu coverage features\n",
+        getFormattedName().asCharString(), (unsigned long) executions, elapsed,
+        (unsigned long) (executions * 1000 / (size_t) (elapsed > 0 ? elapsed : 1)),
+        (unsigned long) inputs.count(), (unsigned long) coverage.getFeatureCount()).asCharString());
+}
+
+bool FuzzUtestShell::saveInput(const char* path, const unsigned char* data, size_t size)
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(path, "wb");
+    if (file == NULLPTR) return false;
+    PlatformSpecificFWrite(data, size, file);
+    PlatformSpecificFClose(file);
+    return true;
+}
+
+void FuzzUtestShell::failWithInput(TestResult& result, const unsigned char* data, size_t size, unsigned int seed)
+{
+    char hash[9];
+    formatInputHash(hash, data, size);
+    char* path = concatenate(NULLPTR, corpus_.getCorpusPath(), "-crash-", hash);
+
+    SimpleString message = StringFromFormat("Failing input of %lu bytes ", (unsigned long) size);
+    if (saveInput(path, data, size))
+        message += StringFromFormat("saved to <%s>", path);
+    else
+        message += StringFromFormat("could not be saved to <%s>", path);
+    message += StringFromFormat(", mutated with --fuzz-seed %u", seed);
+    if (size != 0)
+        message += StringFromFormat(": %s%s", StringFromBinary(data, smallest(size, 32)).asCharString(), (size > 32) ? " ..." : "");
+    PlatformSpecificFree(path);
+
+    result.addFailure(TestFailure(this, getFile().asCharString(), getLineNumber(), message));
+}
@@ -65,12 +65,21 @@ struct JUnitTestGroupResult
     JUnitTestCaseResultNode* tail_;
 };
 
+#define JUNIT_WRITE_BUFFER_SIZE 4096
+
 struct JUnitTestOutputImpl
 {
+    JUnitTestOutputImpl() : file_(NULLPTR), singleFile_(false), bufferUsed_(0)
+    {
+    }
+
     JUnitTestGroupResult results_;
     PlatformSpecificFile file_;
     SimpleString package_;
     SimpleString stdOutput_;
+    bool singleFile_;
+    size_t bufferUsed_;
+    char buffer_[JUNIT_WRITE_BUFFER_SIZE];
 };
 
 JUnitTestOutput::JUnitTestOutput() :
@@ -102,6 +111,12 @@ void JUnitTestOutput::resetTestGroupResult()
 
 void JUnitTestOutput::printTestsStarted()
 {
+    if (!impl_->singleFile_) return;
+
+    openFileForWrite(createSingleFileName());
+    writeXmlHeader();
+    writeToFile("<testsuites>\n");
+    closeFile();
 }
 
 void JUnitTestOutput::printCurrentGroupStarted(const UtestShell& /*test*/)
@@ -116,12 +131,22 @@ void JUnitTestOutput::printCurrentTestEnded(const TestResult& result)
 
 void JUnitTestOutput::printTestsEnded(const TestResult& /*result*/)
 {
+    if (!impl_->singleFile_) return;
+
+    openFileForAppend(createSingleFileName());
+    writeToFile("</testsuites>\n");
+    closeFile();
 }
 
 void JUnitTestOutput::printCurrentGroupEnded(const TestResult& result)
 {
     impl_->results_.groupExecTime_ = result.getCurrentGroupTotalExecutionTime();
-    writeTestGroupToFile();
+    if (impl_->singleFile_) {
+        appendTestGroupToSingleFile();
+        impl_->stdOutput_ = "";
+    }
+    else
+        writeTestGroupToFile();
     resetTestGroupResult();
 }
 
@@ -158,6 +183,11 @@ SimpleString JUnitTestOutput::createFileName(const SimpleString& group)
     return encodeFileName(fileName) + ".xml";
 }
 
+SimpleString JUnitTestOutput::createSingleFileName()
+{
+    return createFileName("all");
+}
+
 SimpleString JUnitTestOutput::encodeFileName(const SimpleString& fileName)
 {
     // special character list based on: https://en.wikipedia.org/wiki/Filename
@@ -177,6 +207,16 @@ void JUnitTestOutput::setPackageName(const SimpleString& package)
     }
 }
 
+void JUnitTestOutput::setSingleFileOutput(bool singleFile)
+{
+    impl_->singleFile_ = singleFile;
+}
+
+bool JUnitTestOutput::isSingleFileOutput() const
+{
+    return impl_->singleFile_;
+}
+
 void JUnitTestOutput::writeXmlHeader()
 {
     writeToFile("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n");
@@ -275,6 +315,21 @@ void JUnitTestOutput::writeTestGroupToFile()
     closeFile();
 }
 
+/*
+ * In single file mode the file is re-opened for append and closed again for every
+ * group. Everything up to the last finished group survives a crash of the test
+ * executable; only the closing </testsuites> tag will be missing in that case.
+ */
+void JUnitTestOutput::appendTestGroupToSingleFile()
+{
+    openFileForAppend(createSingleFileName());
+    writeTestSuiteSummary();
+    writeProperties();
+    writeTestCases();
+    writeFileEnding();
+    closeFile();
+}
+
 // LCOV_EXCL_START
 
 void JUnitTestOutput::printBuffer(const char*)
@@ -313,12 +368,36 @@ void JUnitTestOutput::openFileForWrite(const SimpleString& fileName)
     impl_->file_ = PlatformSpecificFOpen(fileName.asCharString(), "w");
 }
 
+void JUnitTestOutput::openFileForAppend(const SimpleString& fileName)
+{
+    impl_->file_ = PlatformSpecificFOpen(fileName.asCharString(), "a");
+}
+
 void JUnitTestOutput::writeToFile(const SimpleString& buffer)
 {
-    PlatformSpecificFPuts(buffer.asCharString(), impl_->file_);
+    size_t length = buffer.size();
+    if (impl_->bufferUsed_ + length >= JUNIT_WRITE_BUFFER_SIZE)
+        flushWriteBuffer();
+
+    if (length >= JUNIT_WRITE_BUFFER_SIZE) {
+        PlatformSpecificFPuts(buffer.asCharString(), impl_->file_);
+        return;
+    }
+
+    PlatformSpecificMemCpy(impl_->buffer_ + impl_->bufferUsed_, buffer.asCharString(), length + 1);
+    impl_->bufferUsed_ += length;
+}
+
+void JUnitTestOutput::flushWriteBuffer()
+{
+    if (impl_->bufferUsed_ == 0) return;
+
+    PlatformSpecificFPuts(impl_->buffer_, impl_->file_);
+    impl_->bufferUsed_ = 0;
 }
 
 void JUnitTestOutput::closeFile()
 {
+    flushWriteBuffer();
     PlatformSpecificFClose(impl_->file_);
 }
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/JsonTestOutput.h"
+#include "CppUTest/TestResult.h"
+#include "CppUTest/TestFailure.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+JsonTestRecord::JsonTestRecord() :
+    lineNumber_(0), ignored_(false), failed_(false), failureLineNumber_(0), checkCount_(0), durationInMicroseconds_(0)
+{
+}
+
+JsonTestOutput::JsonTestOutput() :
+    file_(NULLPTR), checkCountAtTestStart_(0)
+{
+}
+
+JsonTestOutput::~JsonTestOutput()
+{
+}
+
+void JsonTestOutput::setPackageName(const SimpleString& package)
+{
+    package_ = package;
+}
+
+SimpleString JsonTestOutput::createFileName()
+{
+    if (package_.isEmpty())
+        return "cpputest_results.jsonl";
+    return StringFromFormat("cpputest_%s_results.jsonl", package_.asCharString());
+}
+
+const char* JsonTestOutput::statusOf(const JsonTestRecord& record)
+{
+    if (record.failed_) return "failed";
+    if (record.ignored_) return "ignored";
+    return "passed";
+}
+
+void JsonTestOutput::printTestsStarted()
+{
+    checkCountAtTestStart_ = 0;
+    openFileForWrite(createFileName());
+}
+
+void JsonTestOutput::printTestsEnded(const TestResult& result)
+{
+    writeRunSummary(result);
+    closeFile();
+}
+
+void JsonTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    record_ = JsonTestRecord();
+    record_.group_ = test.getGroup();
+    record_.name_ = test.getName();
+    record_.file_ = test.getFile();
+    record_.lineNumber_ = test.getLineNumber();
+    record_.ignored_ = !test.willRun();
+}
+
+void JsonTestOutput::printCurrentTestEnded(const TestResult& result)
+{
+    record_.checkCount_ = result.getCheckCount() - checkCountAtTestStart_;
+    record_.durationInMicroseconds_ = result.getCurrentTestTotalExecutionTime() * 1000;
+    record_.resources_ = result.getCurrentTestResourceUsage();
+    record_.counters_ = result.getCurrentTestCounters();
+    checkCountAtTestStart_ = result.getCheckCount();
+    writeTestRecord(record_);
+}
+
+void JsonTestOutput::printFailure(const TestFailure& failure)
+{
+    if (record_.failed_) return;
+
+    record_.failed_ = true;
+    record_.failureFile_ = failure.getFileName();
+    record_.failureLineNumber_ = failure.getFailureLineNumber();
+    record_.failureMessage_ = failure.getMessage();
+}
+
+SimpleString JsonTestOutput::encodeJsonString(const SimpleString& text)
+{
+    SimpleString result;
+    const char* start = text.asCharString();
+    const char* current = start;
+
+    for (; *current; current++) {
+        unsigned char ch = (unsigned char) *current;
+        if (ch >= 0x20 && ch != '"' && ch != '\\') continue;
+
+        result += SimpleString(start).subString(0, (size_t) (current - start));
+        if (ch == '"') result += "\\\"";
+        else if (ch == '\\') result += "\\\\";
+        else if (ch == '\n') result += "\\n";
+        else if (ch == '\r') result += "\\r";
+        else if (ch == '\t') result += "\\t";
+        else result += StringFromFormat("\\u%04x", (unsigned int) ch);
+        start = current + 1;
+    }
+    result += start;
+    return result;
+}
+
+void JsonTestOutput::writeTestRecord(const JsonTestRecord& record)
+{
+    SimpleString buf = StringFromFormat(
+            "{\"event\":\"test\",\"group\":\"%s\",\"name\":\"%s\",\"file\":\"%s\",\"line\":%lu,\"status\":\"%s\"",
+            encodeJsonString(record.group_).asCharString(),
+            encodeJsonString(record.name_).asCharString(),
+            encodeJsonString(record.file_).asCharString(),
+            (unsigned long) record.lineNumber_,
+            statusOf(record));
+
+    if (record.failed_) {
+        buf += StringFromFormat(",\"failure\":{\"file\":\"%s\",\"line\":%lu,\"message\":\"%s\"}",
+                encodeJsonString(record.failureFile_).asCharString(),
+                (unsigned long) record.failureLineNumber_,
+                encodeJsonString(record.failureMessage_).asCharString());
+    }
+
+    buf += StringFromFormat(",\"checks\":%lu,\"duration_us\":%lu",
+            (unsigned long) record.checkCount_,
+            (unsigned long) record.durationInMicroseconds_);
+
+    if (record.resources_.measured_) {
+        buf += StringFromFormat(",\"resources\":{\"user_us\":%lu,\"sys_us\":%lu,\"peak_rss_delta_kb\":%lu",
+                record.resources_.userTimeInMicroseconds_,
+                record.resources_.systemTimeInMicroseconds_,
+                record.resources_.peakResidentSetInKilobytes_);
+        buf += StringFromFormat(",\"major_faults\":%lu,\"minor_faults\":%lu,\"voluntary_switches\":%lu,\"involuntary_switches\":%lu}",
+                record.resources_.majorPageFaults_,
+                record.resources_.minorPageFaults_,
+                record.resources_.voluntaryContextSwitches_,
+                record.resources_.involuntaryContextSwitches_);
+    }
+    for (size_t i = 0; i < record.counters_.count_; i++) {
+        buf += (i == 0) ? ",\"counters\":{" : ",";
+        buf += StringFromFormat("\"%s\":%lu", encodeJsonString(record.counters_.names_[i]).asCharString(), record.counters_.values_[i]);
+    }
+    if (record.counters_.count_) buf += "}";
+    buf += "}\n";
+    writeToFile(buf);
+}
+
+void JsonTestOutput::writeRunSummary(const TestResult& result)
+{
+    writeToFile(StringFromFormat(
+            "{\"event\":\"summary\",\"tests\":%lu,\"ran\":%lu,\"checks\":%lu,\"ignored\":%lu,\"filtered_out\":%lu,\"failures\":%lu,\"duration_us\":%lu}\n",
+            (unsigned long) result.getTestCount(),
+            (unsigned long) result.getRunCount(),
+            (unsigned long) result.getCheckCount(),
+            (unsigned long) result.getIgnoredCount(),
+            (unsigned long) result.getFilteredOutCount(),
+            (unsigned long) result.getFailureCount(),
+            (unsigned long) result.getTotalExecutionTime() * 1000));
+}
+
+void JsonTestOutput::openFileForWrite(const SimpleString& fileName)
+{
+    file_ = PlatformSpecificFOpen(fileName.asCharString(), "w");
+}
+
+void JsonTestOutput::writeToFile(const SimpleString& buffer)
+{
+    PlatformSpecificFPuts(buffer.asCharString(), file_);
+}
+
+void JsonTestOutput::closeFile()
+{
+    PlatformSpecificFClose(file_);
+}
+
+// LCOV_EXCL_START
+
+void JsonTestOutput::printBuffer(const char*)
+{
+}
+
+void JsonTestOutput::print(const char*)
+{
+}
+
+void JsonTestOutput::print(long)
+{
+}
+
+void JsonTestOutput::print(size_t)
+{
+}
+
+void JsonTestOutput::flush()
+{
+}
+
+// LCOV_EXCL_STOP
+
+class BinaryRecordBuffer
+{
+public:
+    BinaryRecordBuffer() : buffer_(NULLPTR), size_(0), capacity_(0)
+    {
+        reserve(256);
+        addUnsigned32(0); /* length, filled in by finish() */
+    }
+
+    ~BinaryRecordBuffer()
+    {
+        delete [] buffer_;
+    }
+
+    void addByte(unsigned char byte)
+    {
+        reserve(size_ + 1);
+        buffer_[size_++] = byte;
+    }
+
+    void addUnsigned32(size_t value)
+    {
+        for (int i = 0; i < 4; i++) {
+            addByte((unsigned char) (value & 0xff));
+            value >>= 8;
+        }
+    }
+
+    void addUnsigned64(size_t value)
+    {
+        addUnsigned32(value & 0xffffffff);
+        addUnsigned32((value >> 16) >> 16);
+    }
+
+    void addString(const SimpleString& value)
+    {
+        size_t length = value.size();
+        addUnsigned32(length);
+        reserve(size_ + length);
+        PlatformSpecificMemCpy(buffer_ + size_, value.asCharString(), length);
+        size_ += length;
+    }
+
+    const unsigned char* finish()
+    {
+        size_t length = size_ - 4;
+        for (size_t i = 0; i < 4; i++) {
+            buffer_[i] = (unsigned char) (length & 0xff);
+            length >>= 8;
+        }
+        return buffer_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    void reserve(size_t needed)
+    {
+        if (needed <= capacity_) return;
+
+        size_t newCapacity = (capacity_ == 0) ? needed : capacity_ * 2;
+        if (newCapacity < needed) newCapacity = needed;
+
+        unsigned char* newBuffer = new unsigned char[newCapacity];
+        if (buffer_) PlatformSpecificMemCpy(newBuffer, buffer_, size_);
+        delete [] buffer_;
+        buffer_ = newBuffer;
+        capacity_ = newCapacity;
+    }
+
+    unsigned char* buffer_;
+    size_t size_;
+    size_t capacity_;
+
+    BinaryRecordBuffer(const BinaryRecordBuffer&);
+    BinaryRecordBuffer& operator=(const BinaryRecordBuffer&);
+};
+
+BinaryTestOutput::BinaryTestOutput()
+{
+}
+
+BinaryTestOutput::~BinaryTestOutput()
+{
+}
+
+SimpleString BinaryTestOutput::createFileName()
+{
+    if (package_.isEmpty())
+        return "cpputest_results.bin";
+    return StringFromFormat("cpputest_%s_results.bin", package_.asCharString());
+}
+
+void BinaryTestOutput::openFileForWrite(const SimpleString& fileName)
+{
+    file_ = PlatformSpecificFOpen(fileName.asCharString(), "wb");
+}
+
+void BinaryTestOutput::writeTestRecord(const JsonTestRecord& record)
+{
+    BinaryRecordBuffer buffer;
+    buffer.addByte((unsigned char) RECORD_TEST);
+    if (record.failed_) buffer.addByte((unsigned char) STATUS_FAILED);
+    else if (record.ignored_) buffer.addByte((unsigned char) STATUS_IGNORED);
+    else buffer.addByte((unsigned char) STATUS_PASSED);
+    buffer.addString(record.group_);
+    buffer.addString(record.name_);
+    buffer.addString(record.file_);
+    buffer.addUnsigned32(record.lineNumber_);
+    buffer.addUnsigned32(record.checkCount_);
+    buffer.addUnsigned64(record.durationInMicroseconds_);
+    if (record.failed_) {
+        buffer.addString(record.failureFile_);
+        buffer.addUnsigned32(record.failureLineNumber_);
+        buffer.addString(record.failureMessage_);
+    }
+    if (record.resources_.measured_) {
+        buffer.addUnsigned64(record.resources_.userTimeInMicroseconds_);
+        buffer.addUnsigned64(record.resources_.systemTimeInMicroseconds_);
+        buffer.addUnsigned64(record.resources_.peakResidentSetInKilobytes_);
+        buffer.addUnsigned64(record.resources_.majorPageFaults_);
+        buffer.addUnsigned64(record.resources_.minorPageFaults_);
+        buffer.addUnsigned64(record.resources_.voluntaryContextSwitches_);
+        buffer.addUnsigned64(record.resources_.involuntaryContextSwitches_);
+    }
+    writeBytesToFile(buffer.finish(), buffer.size());
+
+    if (record.counters_.count_ == 0) return;
+
+    BinaryRecordBuffer counters;
+    counters.addByte((unsigned char) RECORD_COUNTERS);
+    counters.addUnsigned32(record.counters_.count_);
+    for (size_t i = 0; i < record.counters_.count_; i++) {
+        counters.addString(record.counters_.names_[i]);
+        counters.addUnsigned64(record.counters_.values_[i]);
+    }
+    writeBytesToFile(counters.finish(), counters.size());
+}
+
+void BinaryTestOutput::writeRunSummary(const TestResult& result)
+{
+    BinaryRecordBuffer buffer;
+    buffer.addByte((unsigned char) RECORD_SUMMARY);
+    buffer.addUnsigned32(result.getTestCount());
+    buffer.addUnsigned32(result.getRunCount());
+    buffer.addUnsigned32(result.getCheckCount());
+    buffer.addUnsigned32(result.getIgnoredCount());
+    buffer.addUnsigned32(result.getFilteredOutCount());
+    buffer.addUnsigned32(result.getFailureCount());
+    buffer.addUnsigned64(result.getTotalExecutionTime() * 1000);
+    writeBytesToFile(buffer.finish(), buffer.size());
+}
+
+void BinaryTestOutput::writeBytesToFile(const void* buffer, size_t size)
+{
+    PlatformSpecificFWrite(buffer, size, file_);
+}
@@ -384,6 +384,10 @@ size_t MemoryLeakDetectorList::getTotalLeaks(MemLeakPeriod period)
 
 /////////////////////////////////////////////////////////////
 
+MemoryLeakDetectorTable::MemoryLeakDetectorTable() : checkingPeriodLeaks_(0)
+{
+}
+
 unsigned long MemoryLeakDetectorTable::hash(char* memory)
 {
     return (unsigned long)((size_t)memory % hash_prime);
@@ -393,16 +397,20 @@ void MemoryLeakDetectorTable::clearAllAccounting(MemLeakPeriod period)
 {
     for (int i = 0; i < hash_prime; i++)
         table_[i].clearAllAccounting(period);
+    checkingPeriodLeaks_ = countLeaks(mem_leak_period_checking);
 }
 
 void MemoryLeakDetectorTable::addNewNode(MemoryLeakDetectorNode* node)
 {
+    if (node->period_ == mem_leak_period_checking) checkingPeriodLeaks_++;
     table_[hash(node->memory_)].addNewNode(node);
 }
 
 MemoryLeakDetectorNode* MemoryLeakDetectorTable::removeNode(char* memory)
 {
-    return table_[hash(memory)].removeNode(memory);
+    MemoryLeakDetectorNode* node = table_[hash(memory)].removeNode(memory);
+    if (node && node->period_ == mem_leak_period_checking) checkingPeriodLeaks_--;
+    return node;
 }
 
 MemoryLeakDetectorNode* MemoryLeakDetectorTable::retrieveNode(char* memory)
@@ -411,6 +419,24 @@ MemoryLeakDetectorNode* MemoryLeakDetectorTable::retrieveNode(char* memory)
 }
 
 size_t MemoryLeakDetectorTable::getTotalLeaks(MemLeakPeriod period)
+{
+    if (period == mem_leak_period_checking) return checkingPeriodLeaks_;
+    return countLeaks(period);
+}
+
+void MemoryLeakDetectorTable::markCheckingPeriodLeaksAsNonCheckingPeriod()
+{
+    if (checkingPeriodLeaks_ == 0) return;
+
+    MemoryLeakDetectorNode* leak = getFirstLeak(mem_leak_period_checking);
+    while (leak) {
+        if (leak->period_ == mem_leak_period_checking) leak->period_ = mem_leak_period_enabled;
+        leak = getNextLeak(leak, mem_leak_period_checking);
+    }
+    checkingPeriodLeaks_ = 0;
+}
+
+size_t MemoryLeakDetectorTable::countLeaks(MemLeakPeriod period)
 {
     size_t total_leaks = 0;
     for (int i = 0; i < hash_prime; i++)
@@ -743,11 +769,7 @@ const char* MemoryLeakDetector::report(MemLeakPeriod period)
 
 void MemoryLeakDetector::markCheckingPeriodLeaksAsNonCheckingPeriod()
 {
-    MemoryLeakDetectorNode* leak = memoryTable_.getFirstLeak(mem_leak_period_checking);
-    while (leak) {
-        if (leak->period_ == mem_leak_period_checking) leak->period_ = mem_leak_period_enabled;
-        leak = memoryTable_.getNextLeak(leak, mem_leak_period_checking);
-    }
+    memoryTable_.markCheckingPeriodLeaksAsNonCheckingPeriod();
 }
 
 size_t MemoryLeakDetector::totalMemoryLeaks(MemLeakPeriod period)
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/PropertyTest.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+//////////////////// PropertyRandom
+
+PropertyRandom::PropertyRandom(unsigned int seed)
+{
+    PlatformSpecificSrand(seed);
+}
+
+unsigned long PropertyRandom::next(unsigned long bound)
+{
+    /* rand() may give as few as 15 bits */
+    unsigned long bits = 0;
+    for (size_t collected = 0; collected < sizeof(unsigned long) * 8; collected += 15)
+        bits = (bits << 15) ^ ((unsigned long) PlatformSpecificRand() & 0x7fff);
+    return (bound == 0) ? bits : bits % bound;
+}
+
+bool propertyRemovalCandidate(size_t length, size_t& candidate, size_t& start, size_t& count)
+{
+    for (size_t chunk = length; chunk > 0; chunk /= 2) {
+        size_t chunks = length / chunk;
+        if (candidate < chunks) {
+            start = candidate * chunk;
+            count = chunk;
+            return true;
+        }
+        candidate -= chunks;
+    }
+    return false;
+}
+
+//////////////////// PropertyBytes
+
+PropertyBytes::PropertyBytes(size_t maxSize) : PropertyLists<PropertyIntegers<unsigned char> >(PropertyIntegers<unsigned char>(0, 255), maxSize)
+{
+}
+
+SimpleString PropertyBytes::describe(const PropertyList<unsigned char>& value) const
+{
+    SimpleString text = "{";
+    for (size_t i = 0; i < value.size(); i++) {
+        if (i) text += " ";
+        text += StringFromFormat("%02X", (unsigned int) value[i]);
+    }
+    return text + "}";
+}
+
+//////////////////// PropertyStrings
+
+PropertyStrings::PropertyStrings(size_t maxLength, const char* alphabet) :
+    maxLength_(maxLength), alphabet_(alphabet), simplest_(alphabet ? alphabet[0] : 'a')
+{
+}
+
+SimpleString PropertyStrings::generate(PropertyRandom& random) const
+{
+    size_t length = (size_t) random.next((unsigned long) maxLength_ + 1);
+    char* characters = new char[length + 1];
+    for (size_t i = 0; i < length; i++) {
+        if (alphabet_)
+            characters[i] = alphabet_[random.next(SimpleString::StrLen(alphabet_))];
+        else
+            characters[i] = (char) (' ' + random.next('~' - ' ' + 1));
+    }
+    characters[length] = '\0';
+    SimpleString text(characters);
+    delete [] characters;
+    return text;
+}
+
+/* Removes characters first, then makes them the simplest one */
+bool PropertyStrings::shrink(const SimpleString& value, size_t candidate, SimpleString& simpler) const
+{
+    size_t start, count;
+    if (propertyRemovalCandidate(value.size(), candidate, start, count)) {
+        simpler = value.subString(0, start) + value.subString(start + count);
+        return true;
+    }
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value.at(i) != simplest_ && candidate-- == 0) {
+            const char simplest[] = { simplest_, '\0' };
+            simpler = value.subString(0, i) + simplest + value.subString(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+SimpleString PropertyStrings::describe(const SimpleString& value) const
+{
+    return StringFromFormat("\"%s\"", value.asCharString());
+}
+
+//////////////////// PropertyChecker
+
+size_t PropertyChecker::runs_ = 100;
+unsigned int PropertyChecker::fixedSeed_ = 0;
+
+/* Enough to shrink a list of integers, bounded so that a slow property still ends */
+static const size_t maxShrinkTrials = 10000;
+
+PropertyChecker::PropertyChecker(const char* fileName, size_t lineNumber) :
+    test_(UtestShell::getCurrent()), shell_(*test_), installed_(true),
+    seed_(fixedSeed_ ? fixedSeed_ : (unsigned int) GetPlatformSpecificTimeInMillis() | 1),
+    random_(seed_), shrinkTrials_(0), fileName_(fileName), lineNumber_(lineNumber)
+{
+    shell_.install();
+}
+
+PropertyChecker::~PropertyChecker()
+{
+    if (installed_) shell_.uninstall(test_);
+}
+
+void PropertyChecker::setRuns(size_t runs)
+{
+    runs_ = runs;
+}
+
+size_t PropertyChecker::getRuns()
+{
+    return runs_;
+}
+
+void PropertyChecker::setSeed(unsigned int seed)
+{
+    fixedSeed_ = seed;
+}
+
+unsigned int PropertyChecker::getSeed()
+{
+    return fixedSeed_;
+}
+
+PropertyRandom& PropertyChecker::getRandom()
+{
+    return random_;
+}
+
+#if CPPUTEST_USE_STD_CPP_LIB
+
+/* Ends a failed trial, so that the objects of the property are destroyed on the way out */
+class PropertyTrialFailedException
+{
+public:
+    int dummy_;
+};
+
+#endif
+
+bool PropertyChecker::trial(void (*function)(void*), void* data)
+{
+    shell_.startTrial();
+#if CPPUTEST_USE_STD_CPP_LIB
+    try {
+        PlatformSpecificSetJmp(function, data);
+    }
+    catch (PropertyTrialFailedException&)
+    {
+        PlatformSpecificRestoreJumpBuffer();
+    }
+#else
+    PlatformSpecificSetJmp(function, data);
+#endif
+    if (!shell_.hasFailedTrial()) return true;
+    shrinkTrials_++;
+    return false;
+}
+
+bool PropertyChecker::mayShrink() const
+{
+    return shrinkTrials_ < maxShrinkTrials;
+}
+
+void PropertyChecker::fail(size_t runs, size_t shrinks, const SimpleString& counterexample)
+{
+    shell_.uninstall(test_);
+    installed_ = false;
+
+    SimpleString message = StringFromFormat("FOR_ALL at %s:%lu failed after %lu run(s) with --property-seed %u\n",
+            fileName_, (unsigned long) lineNumber_, (unsigned long) runs, seed_);
+    message += StringFromFormat("\tSimplest counterexample (%lu shrinks): ", (unsigned long) shrinks);
+    message += counterexample;
+    message += "\n\t";
+    message += shell_.failureMessage;
+    test_->failWith(TestFailure(test_, shell_.failureFileName.asCharString(), shell_.failureLineNumber, message));
+}
+
+PropertyChecker::TrialShell::TrialShell(const UtestShell& test) :
+    failureLineNumber(0), groupName_(test.getGroup()), testName_(test.getName()), fileName_(test.getFile()), failedTrial_(false)
+{
+    setGroupName(groupName_.asCharString());
+    setTestName(testName_.asCharString());
+    setFileName(fileName_.asCharString());
+    setLineNumber(test.getLineNumber());
+}
+
+PropertyChecker::TrialShell::~TrialShell()
+{
+}
+
+void PropertyChecker::TrialShell::install()
+{
+    setCurrentTest(this);
+}
+
+void PropertyChecker::TrialShell::uninstall(UtestShell* test)
+{
+    setCurrentTest(test);
+}
+
+void PropertyChecker::TrialShell::startTrial()
+{
+    failedTrial_ = false;
+}
+
+bool PropertyChecker::TrialShell::hasFailedTrial() const
+{
+    return failedTrial_;
+}
+
+void PropertyChecker::TrialShell::failWith(const TestFailure& failure)
+{
+    failWith(failure, getCurrentTestTerminator());
+}
+
+/* Failures of a trial are kept instead of reported, the trial ends where it was started */
+void PropertyChecker::TrialShell::failWith(const TestFailure& failure, const TestTerminator&)
+{
+    failedTrial_ = true;
+    failureMessage = failure.getMessage();
+    failureFileName = failure.getFileName();
+    failureLineNumber = failure.getFailureLineNumber();
+#if CPPUTEST_USE_STD_CPP_LIB
+    throw PropertyTrialFailedException();
+#else
+    PlatformSpecificLongJmp();
+#endif
+}
@@ -995,3 +995,159 @@ SimpleString& SimpleStringCollection::operator[](size_t index)
 
     return collection_[index];
 }
+
+/* The text is stored right after the node, in the same allocation */
+struct SimpleStringInternTableNode
+{
+    SimpleStringInternTableNode* next_;
+    size_t hash_;
+    size_t length_;
+    const char* text_;
+    void* data_;
+};
+
+static const size_t initialInternTableBucketCount = 32;
+
+SimpleStringInternTable::SimpleStringInternTable(bool untracked)
+    : buckets_(NULLPTR), bucketCount_(0), size_(0), untracked_(untracked)
+{
+}
+
+char* SimpleStringInternTable::allocate(size_t size)
+{
+    if (untracked_) return (char*) PlatformSpecificMalloc(size);
+    return SimpleString::allocStringBuffer(size, __FILE__, __LINE__);
+}
+
+void SimpleStringInternTable::deallocate(char* memory, size_t size)
+{
+    if (untracked_) PlatformSpecificFree(memory);
+    else SimpleString::deallocStringBuffer(memory, size, __FILE__, __LINE__);
+}
+
+SimpleStringInternTable::~SimpleStringInternTable()
+{
+    clear();
+}
+
+size_t SimpleStringInternTable::hash(const char* str)
+{
+    size_t hashValue = 2166136261u;
+    while (*str) {
+        hashValue ^= (unsigned char) *str++;
+        hashValue *= 16777619u;
+    }
+    return hashValue;
+}
+
+SimpleStringInternTableNode* SimpleStringInternTable::findNode(const char* str, size_t hashValue) const
+{
+    if (bucketCount_ == 0) return NULLPTR;
+
+    for (SimpleStringInternTableNode* node = buckets_[hashValue % bucketCount_]; node; node = node->next_)
+        if (node->hash_ == hashValue && SimpleString::StrCmp(node->text_, str) == 0)
+            return node;
+    return NULLPTR;
+}
+
+const char* SimpleStringInternTable::find(const char* str) const
+{
+    SimpleStringInternTableNode* node = findNode(str, hash(str));
+    return (node) ? node->text_ : NULLPTR;
+}
+
+const char* SimpleStringInternTable::find(const SimpleString& str) const
+{
+    return find(str.asCharString());
+}
+
+void SimpleStringInternTable::setData(const char* str, void* data)
+{
+    SimpleStringInternTableNode* node = findNode(str, hash(str));
+    if (node) node->data_ = data;
+}
+
+void* SimpleStringInternTable::getData(const char* str) const
+{
+    SimpleStringInternTableNode* node = findNode(str, hash(str));
+    return (node) ? node->data_ : NULLPTR;
+}
+
+const char* SimpleStringInternTable::intern(const SimpleString& str)
+{
+    return intern(str.asCharString());
+}
+
+const char* SimpleStringInternTable::intern(const char* str)
+{
+    const size_t hashValue = hash(str);
+    SimpleStringInternTableNode* node = findNode(str, hashValue);
+    if (node) return node->text_;
+
+    if (size_ >= bucketCount_) grow();
+
+    const size_t length = SimpleString::StrLen(str);
+    char* memory = allocate(sizeof(SimpleStringInternTableNode) + length + 1);
+    char* text = memory + sizeof(SimpleStringInternTableNode);
+    PlatformSpecificMemCpy(text, str, length + 1);
+
+    node = (SimpleStringInternTableNode*) (void*) memory;
+    node->next_ = buckets_[hashValue % bucketCount_];
+    node->hash_ = hashValue;
+    node->length_ = length;
+    node->text_ = text;
+    node->data_ = NULLPTR;
+    buckets_[hashValue % bucketCount_] = node;
+    size_++;
+    return text;
+}
+
+void SimpleStringInternTable::grow()
+{
+    const size_t newBucketCount = (bucketCount_ == 0) ? initialInternTableBucketCount : bucketCount_ * 2;
+    SimpleStringInternTableNode** newBuckets = (SimpleStringInternTableNode**)
+        (void*) allocate(newBucketCount * sizeof(SimpleStringInternTableNode*));
+    for (size_t i = 0; i < newBucketCount; i++)
+        newBuckets[i] = NULLPTR;
+
+    for (size_t i = 0; i < bucketCount_; i++) {
+        SimpleStringInternTableNode* node = buckets_[i];
+        while (node) {
+            SimpleStringInternTableNode* next = node->next_;
+            node->next_ = newBuckets[node->hash_ % newBucketCount];
+            newBuckets[node->hash_ % newBucketCount] = node;
+            node = next;
+        }
+    }
+
+    deallocateBuckets();
+    buckets_ = newBuckets;
+    bucketCount_ = newBucketCount;
+}
+
+void SimpleStringInternTable::deallocateBuckets()
+{
+    if (buckets_)
+        deallocate((char*) (void*) buckets_, bucketCount_ * sizeof(SimpleStringInternTableNode*));
+}
+
+size_t SimpleStringInternTable::size() const
+{
+    return size_;
+}
+
+void SimpleStringInternTable::clear()
+{
+    for (size_t i = 0; i < bucketCount_; i++) {
+        SimpleStringInternTableNode* node = buckets_[i];
+        while (node) {
+            SimpleStringInternTableNode* next = node->next_;
+            deallocate((char*) (void*) node, sizeof(SimpleStringInternTableNode) + node->length_ + 1);
+            node = next;
+        }
+    }
+    deallocateBuckets();
+    buckets_ = NULLPTR;
+    bucketCount_ = 0;
+    size_ = 0;
+}
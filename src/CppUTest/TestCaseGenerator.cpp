@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestCaseGenerator.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+TestCaseGenerator::~TestCaseGenerator()
+{
+}
+
+const char* TestCaseGenerator::getCaseName() const
+{
+    return NULLPTR;
+}
+
+const char* TestCaseGenerator::getCaseError() const
+{
+    return NULLPTR;
+}
+
+TestRangeGenerator::TestRangeGenerator(long begin, long end, long step)
+    : begin_(begin), end_(end), step_(step), value_(begin)
+{
+}
+
+TestRangeGenerator::~TestRangeGenerator()
+{
+}
+
+bool TestRangeGenerator::first()
+{
+    value_ = begin_;
+    return (step_ > 0) ? value_ < end_ : (step_ < 0 && value_ > end_);
+}
+
+bool TestRangeGenerator::next()
+{
+    /* The distance left is taken unsigned, so stepping never runs past LONG_MAX or LONG_MIN */
+    if (step_ == 0) return false;
+    const unsigned long left = (step_ > 0) ? (unsigned long) end_ - (unsigned long) value_ : (unsigned long) value_ - (unsigned long) end_;
+    const unsigned long stride = (step_ > 0) ? (unsigned long) step_ : 0UL - (unsigned long) step_;
+    if (stride >= left) return false;
+
+    value_ += step_;
+    return true;
+}
+
+long TestRangeGenerator::getValue() const
+{
+    return value_;
+}
+
+/*
+ * The line buffer lives as long as the generator, which usually is a global
+ * outliving the memory leak detector, so it isn't allocated through it.
+ */
+TestFileLinesGenerator::TestFileLinesGenerator(const char* fileName)
+    : fileName_(fileName), file_(NULLPTR), chunkLength_(0), chunkPosition_(0), line_(NULLPTR), lineLength_(0), lineCapacity_(0), cannotOpen_(false)
+{
+}
+
+TestFileLinesGenerator::~TestFileLinesGenerator()
+{
+    close();
+    PlatformSpecificFree(line_);
+}
+
+/* A missing file is a single case that fails, so the test does not pass without running */
+bool TestFileLinesGenerator::first()
+{
+    close();
+    cannotOpen_ = false;
+    file_ = PlatformSpecificFOpen(fileName_, "r");
+    if (file_ == NULLPTR) {
+        cannotOpen_ = true;
+        lineLength_ = 0;
+        appendToLine("cannot open ", 12);
+        appendToLine(fileName_, SimpleString::StrLen(fileName_));
+        return true;
+    }
+
+    chunkLength_ = 0;
+    chunkPosition_ = 0;
+    return readLine();
+}
+
+bool TestFileLinesGenerator::next()
+{
+    if (file_ == NULLPTR) return false;
+    return readLine();
+}
+
+const char* TestFileLinesGenerator::getCaseError() const
+{
+    return (cannotOpen_) ? line_ : NULLPTR;
+}
+
+const char* TestFileLinesGenerator::getValue() const
+{
+    return (line_ == NULLPTR || cannotOpen_) ? "" : line_;
+}
+
+void TestFileLinesGenerator::close()
+{
+    if (file_ != NULLPTR) PlatformSpecificFClose(file_);
+    file_ = NULLPTR;
+}
+
+bool TestFileLinesGenerator::readLine()
+{
+    bool lineStarted = false;
+    lineLength_ = 0;
+    appendToLine("", 0);
+
+    while (chunkPosition_ < chunkLength_ || fillChunk()) {
+        lineStarted = true;
+        size_t lineEnd = chunkPosition_;
+        while (lineEnd < chunkLength_ && chunk_[lineEnd] != '\n') lineEnd++;
+
+        appendToLine(chunk_ + chunkPosition_, lineEnd - chunkPosition_);
+        if (lineEnd < chunkLength_) {
+            chunkPosition_ = lineEnd + 1;
+            if (lineLength_ > 0 && line_[lineLength_ - 1] == '\r') line_[--lineLength_] = '\0';
+            return true;
+        }
+        chunkPosition_ = chunkLength_;
+    }
+
+    if (!lineStarted) close();
+    return lineStarted;
+}
+
+bool TestFileLinesGenerator::fillChunk()
+{
+    chunkPosition_ = 0;
+    chunkLength_ = PlatformSpecificFRead(chunk_, sizeof(chunk_), file_);
+    return chunkLength_ > 0;
+}
+
+void TestFileLinesGenerator::appendToLine(const char* text, size_t length)
+{
+    if (lineLength_ + length + 1 > lineCapacity_) {
+        size_t capacity = (lineCapacity_ == 0) ? 128 : lineCapacity_;
+        while (lineLength_ + length + 1 > capacity) capacity *= 2;
+        line_ = (char*) PlatformSpecificRealloc(line_, capacity);
+        lineCapacity_ = capacity;
+    }
+    SimpleString::StrNCpy(line_ + lineLength_, text, length);
+    lineLength_ += length;
+    line_[lineLength_] = '\0';
+}
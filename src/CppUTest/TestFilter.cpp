@@ -63,14 +63,34 @@ void TestFilter::invertMatching()
     invertMatching_ = true;
 }
 
+bool TestFilter::isStrictMatching() const
+{
+    return strictMatching_;
+}
+
+bool TestFilter::isInvertMatching() const
+{
+    return invertMatching_;
+}
+
+const SimpleString& TestFilter::getFilter() const
+{
+    return filter_;
+}
+
 bool TestFilter::match(const SimpleString& name) const
+{
+    return match(name.asCharString());
+}
+
+bool TestFilter::match(const char* name) const
 {
     bool matches = false;
 
     if(strictMatching_)
-        matches = name == filter_;
+        matches = SimpleString::StrCmp(name, filter_.asCharString()) == 0;
     else
-        matches = name.contains(filter_);
+        matches = SimpleString::StrStr(name, filter_.asCharString()) != NULLPTR;
 
     return invertMatching_ ? !matches : matches;
 }
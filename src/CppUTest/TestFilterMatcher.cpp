@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestFilter.h"
+#include "CppUTest/TestFilterMatcher.h"
+
+static const size_t noState = (size_t) -1;
+static const size_t rootState = 0;
+
+struct TestFilterAutomatonState
+{
+    size_t firstEdge_;
+    size_t failure_;
+    bool accepting_;
+};
+
+struct TestFilterAutomatonEdge
+{
+    char symbol_;
+    size_t target_;
+    size_t next_;
+};
+
+TestFilterAutomaton::TestFilterAutomaton()
+    : states_(NULLPTR), stateCount_(0), stateCapacity_(0), edges_(NULLPTR), edgeCount_(0), edgeCapacity_(0), patternCount_(0)
+{
+    for (size_t i = 0; i < 256; i++)
+        rootTransitions_[i] = noState;
+}
+
+TestFilterAutomaton::~TestFilterAutomaton()
+{
+    clear();
+}
+
+void TestFilterAutomaton::clear()
+{
+    delete [] states_;
+    delete [] edges_;
+    states_ = NULLPTR;
+    edges_ = NULLPTR;
+    stateCount_ = stateCapacity_ = 0;
+    edgeCount_ = edgeCapacity_ = 0;
+    patternCount_ = 0;
+    for (size_t i = 0; i < 256; i++)
+        rootTransitions_[i] = noState;
+}
+
+bool TestFilterAutomaton::isEmpty() const
+{
+    return patternCount_ == 0;
+}
+
+size_t TestFilterAutomaton::addState()
+{
+    if (stateCount_ == stateCapacity_) {
+        size_t newCapacity = (stateCapacity_ == 0) ? 16 : stateCapacity_ * 2;
+        TestFilterAutomatonState* newStates = new TestFilterAutomatonState[newCapacity];
+        for (size_t i = 0; i < stateCount_; i++)
+            newStates[i] = states_[i];
+        delete [] states_;
+        states_ = newStates;
+        stateCapacity_ = newCapacity;
+    }
+    TestFilterAutomatonState& state = states_[stateCount_];
+    state.firstEdge_ = noState;
+    state.failure_ = rootState;
+    state.accepting_ = false;
+    return stateCount_++;
+}
+
+void TestFilterAutomaton::addEdge(size_t state, char symbol, size_t target)
+{
+    if (edgeCount_ == edgeCapacity_) {
+        size_t newCapacity = (edgeCapacity_ == 0) ? 16 : edgeCapacity_ * 2;
+        TestFilterAutomatonEdge* newEdges = new TestFilterAutomatonEdge[newCapacity];
+        for (size_t i = 0; i < edgeCount_; i++)
+            newEdges[i] = edges_[i];
+        delete [] edges_;
+        edges_ = newEdges;
+        edgeCapacity_ = newCapacity;
+    }
+    TestFilterAutomatonEdge& edge = edges_[edgeCount_];
+    edge.symbol_ = symbol;
+    edge.target_ = target;
+    edge.next_ = states_[state].firstEdge_;
+    states_[state].firstEdge_ = edgeCount_++;
+
+    if (state == rootState)
+        rootTransitions_[(unsigned char) symbol] = target;
+}
+
+size_t TestFilterAutomaton::transition(size_t state, char symbol) const
+{
+    if (state == rootState)
+        return rootTransitions_[(unsigned char) symbol];
+
+    for (size_t edge = states_[state].firstEdge_; edge != noState; edge = edges_[edge].next_)
+        if (edges_[edge].symbol_ == symbol)
+            return edges_[edge].target_;
+    return noState;
+}
+
+void TestFilterAutomaton::add(const char* pattern)
+{
+    if (stateCount_ == 0) addState();
+
+    size_t state = rootState;
+    for (; *pattern; pattern++) {
+        size_t next = transition(state, *pattern);
+        if (next == noState) {
+            next = addState();
+            addEdge(state, *pattern, next);
+        }
+        state = next;
+    }
+    states_[state].accepting_ = true;
+    patternCount_++;
+}
+
+void TestFilterAutomaton::compile()
+{
+    if (stateCount_ == 0) return;
+
+    /* Breadth first, so the failure state of a parent is known before its children are visited */
+    size_t* queue = new size_t[stateCount_];
+    size_t head = 0;
+    size_t tail = 0;
+    queue[tail++] = rootState;
+
+    while (head < tail) {
+        size_t state = queue[head++];
+        for (size_t edge = states_[state].firstEdge_; edge != noState; edge = edges_[edge].next_) {
+            size_t child = edges_[edge].target_;
+            queue[tail++] = child;
+
+            size_t failure = rootState;
+            if (state != rootState) {
+                failure = states_[state].failure_;
+                while (failure != rootState && transition(failure, edges_[edge].symbol_) == noState)
+                    failure = states_[failure].failure_;
+                size_t target = transition(failure, edges_[edge].symbol_);
+                failure = (target == noState) ? rootState : target;
+            }
+            states_[child].failure_ = failure;
+            states_[child].accepting_ = states_[child].accepting_ || states_[failure].accepting_;
+        }
+    }
+    delete [] queue;
+}
+
+bool TestFilterAutomaton::matches(const char* text) const
+{
+    if (stateCount_ == 0) return false;
+    if (states_[rootState].accepting_) return true;
+
+    size_t state = rootState;
+    for (; *text; text++) {
+        size_t next = transition(state, *text);
+        while (next == noState && state != rootState) {
+            state = states_[state].failure_;
+            next = transition(state, *text);
+        }
+        state = (next == noState) ? rootState : next;
+        if (states_[state].accepting_) return true;
+    }
+    return false;
+}
+
+TestFilterPatterns::TestFilterPatterns()
+{
+}
+
+void TestFilterPatterns::add(const TestFilter& filter)
+{
+    if (filter.isStrictMatching())
+        strictPatterns_.intern(filter.getFilter());
+    else
+        substringPatterns_.add(filter.getFilter().asCharString());
+}
+
+void TestFilterPatterns::compile()
+{
+    substringPatterns_.compile();
+}
+
+void TestFilterPatterns::clear()
+{
+    strictPatterns_.clear();
+    substringPatterns_.clear();
+}
+
+bool TestFilterPatterns::isEmpty() const
+{
+    return strictPatterns_.size() == 0 && substringPatterns_.isEmpty();
+}
+
+bool TestFilterPatterns::matches(const char* text) const
+{
+    if (strictPatterns_.size() != 0 && strictPatterns_.find(text) != NULLPTR) return true;
+    return substringPatterns_.matches(text);
+}
+
+TestFilterMatcher::TestFilterMatcher()
+    : hasIncludes_(false), hasExcludes_(false)
+{
+}
+
+TestFilterMatcher::~TestFilterMatcher()
+{
+}
+
+void TestFilterMatcher::clear()
+{
+    includedGroups_.clear();
+    excludedGroups_.clear();
+    includedNames_.clear();
+    excludedNames_.clear();
+    includedTests_.clear();
+    excludedTests_.clear();
+    hasIncludes_ = false;
+    hasExcludes_ = false;
+}
+
+static void addFilters(const TestFilter* filters, TestFilterPatterns& included, TestFilterPatterns& excluded)
+{
+    for (; filters != NULLPTR; filters = filters->getNext()) {
+        if (filters->isInvertMatching())
+            excluded.add(*filters);
+        else
+            included.add(*filters);
+    }
+    included.compile();
+    excluded.compile();
+}
+
+void TestFilterMatcher::compile(const TestFilter* groupFilters, const TestFilter* nameFilters, const TestFilter* testFilters)
+{
+    clear();
+
+    addFilters(groupFilters, includedGroups_, excludedGroups_);
+    addFilters(nameFilters, includedNames_, excludedNames_);
+    addFilters(testFilters, includedTests_, excludedTests_);
+
+    hasIncludes_ = !includedGroups_.isEmpty() || !includedNames_.isEmpty() || !includedTests_.isEmpty();
+    hasExcludes_ = !excludedGroups_.isEmpty() || !excludedNames_.isEmpty() || !excludedTests_.isEmpty();
+}
+
+bool TestFilterMatcher::matchesTest(const TestFilterPatterns& tests, const char* group, const char* name) const
+{
+    if (tests.isEmpty()) return false;
+
+    char buffer[256];
+    size_t groupLength = SimpleString::StrLen(group);
+    size_t nameLength = SimpleString::StrLen(name);
+
+    if (groupLength + nameLength + 2 > sizeof(buffer))
+        return tests.matches((SimpleString(group) + "." + name).asCharString());
+
+    SimpleString::StrNCpy(buffer, group, groupLength + 1);
+    buffer[groupLength] = '.';
+    SimpleString::StrNCpy(buffer + groupLength + 1, name, nameLength + 1);
+    return tests.matches(buffer);
+}
+
+bool TestFilterMatcher::match(const char* group, const char* name) const
+{
+    if (hasExcludes_ && isExcluded(group, name)) return false;
+    return !hasIncludes_ || isIncluded(group, name);
+}
+
+bool TestFilterMatcher::match(const char* group, const char* name, const char* testName) const
+{
+    if (hasExcludes_ && (isExcluded(group, name) || isExcluded(group, testName))) return false;
+    return !hasIncludes_ || isIncluded(group, name) || isIncluded(group, testName);
+}
+
+bool TestFilterMatcher::isExcluded(const char* group, const char* name) const
+{
+    return excludedGroups_.matches(group) || excludedNames_.matches(name) || matchesTest(excludedTests_, group, name);
+}
+
+bool TestFilterMatcher::isIncluded(const char* group, const char* name) const
+{
+    if (matchesTest(includedTests_, group, name)) return true;
+
+    if (includedGroups_.isEmpty() && includedNames_.isEmpty()) return false;
+
+    return (includedGroups_.isEmpty() || includedGroups_.matches(group)) &&
+           (includedNames_.isEmpty() || includedNames_.matches(name));
+}
@@ -106,12 +106,44 @@ void TestOutput::printCurrentTestStarted(const UtestShell& test)
     }
 }
 
+static SimpleString millisecondsFromMicroseconds(unsigned long micros)
+{
+    return StringFromFormat("%lu.%03lu ms", micros / 1000, micros % 1000);
+}
+
+static SimpleString resourceUsageSummary(const TestResourceUsage& usage)
+{
+    SimpleString summary(" (user ");
+    summary += millisecondsFromMicroseconds(usage.userTimeInMicroseconds_);
+    summary += ", sys ";
+    summary += millisecondsFromMicroseconds(usage.systemTimeInMicroseconds_);
+    summary += StringFromFormat(", rss +%lu kB", usage.peakResidentSetInKilobytes_);
+    summary += StringFromFormat(", faults %lu major / %lu minor", usage.majorPageFaults_, usage.minorPageFaults_);
+    summary += StringFromFormat(", switches %lu voluntary / %lu involuntary)", usage.voluntaryContextSwitches_, usage.involuntaryContextSwitches_);
+    return summary;
+}
+
+static SimpleString countersSummary(const TestCounters& counters)
+{
+    SimpleString summary;
+    for (size_t i = 0; i < counters.count_; i++) {
+        summary += (i == 0) ? " [" : ", ";
+        summary += StringFromFormat("%s %lu", counters.names_[i], counters.values_[i]);
+    }
+    if (counters.count_) summary += "]";
+    return summary;
+}
+
 void TestOutput::printCurrentTestEnded(const TestResult& res)
 {
     if (verbose_ > level_quiet) {
         print(" - ");
         print(res.getCurrentTestTotalExecutionTime());
-        print(" ms\n");
+        print(" ms");
+        if (res.getCurrentTestResourceUsage().measured_)
+            print(resourceUsageSummary(res.getCurrentTestResourceUsage()).asCharString());
+        print(countersSummary(res.getCurrentTestCounters()).asCharString());
+        print("\n");
     }
     else {
         printProgressIndicator();
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestOutputMultiplexer.h"
+
+struct MultiplexedTestEvent
+{
+    enum Kind { PRINT, PRINT_VERY_VERBOSE, FAILURE };
+
+    MultiplexedTestEvent(Kind kind, const SimpleString& text, TestFailure* failure)
+        : kind_(kind), text_(text), failure_(failure), next_(NULLPTR)
+    {
+    }
+
+    ~MultiplexedTestEvent()
+    {
+        delete failure_;
+    }
+
+    Kind kind_;
+    SimpleString text_;
+    TestFailure* failure_;
+    MultiplexedTestEvent* next_;
+};
+
+struct MultiplexedTestRecord
+{
+    enum State { SCHEDULED, RUNNING, COMPLETED };
+
+    MultiplexedTestRecord(const UtestShell* test, State state)
+        : test_(test), state_(state), firstEvent_(NULLPTR), lastEvent_(NULLPTR), executionTime_(0), checkCount_(0), next_(NULLPTR)
+    {
+    }
+
+    ~MultiplexedTestRecord()
+    {
+        while (firstEvent_) {
+            MultiplexedTestEvent* next = firstEvent_->next_;
+            delete firstEvent_;
+            firstEvent_ = next;
+        }
+    }
+
+    void addEvent(MultiplexedTestEvent* event)
+    {
+        if (lastEvent_) lastEvent_->next_ = event;
+        else firstEvent_ = event;
+        lastEvent_ = event;
+    }
+
+    void takeEventsFrom(MultiplexedTestRecord* other)
+    {
+        if (other->firstEvent_ == NULLPTR) return;
+        other->lastEvent_->next_ = firstEvent_;
+        if (lastEvent_ == NULLPTR) lastEvent_ = other->lastEvent_;
+        firstEvent_ = other->firstEvent_;
+        other->firstEvent_ = other->lastEvent_ = NULLPTR;
+    }
+
+    const UtestShell* test_;
+    State state_;
+    MultiplexedTestEvent* firstEvent_;
+    MultiplexedTestEvent* lastEvent_;
+    size_t executionTime_;
+    size_t checkCount_;
+    TestResourceUsage resourceUsage_;
+    TestCounters counters_;
+    MultiplexedTestRecord* next_;
+};
+
+MultiplexedWorkerTestOutput::MultiplexedWorkerTestOutput(TestOutputMultiplexer& multiplexer)
+    : multiplexer_(multiplexer), record_(NULLPTR), checkCountAtTestEnd_(0)
+{
+}
+
+MultiplexedWorkerTestOutput::~MultiplexedWorkerTestOutput()
+{
+    delete record_;
+}
+
+MultiplexedTestRecord* MultiplexedWorkerTestOutput::currentRecord()
+{
+    if (record_ == NULLPTR)
+        record_ = new MultiplexedTestRecord(NULLPTR, MultiplexedTestRecord::RUNNING);
+    return record_;
+}
+
+void MultiplexedWorkerTestOutput::printTestsStarted()
+{
+}
+
+void MultiplexedWorkerTestOutput::printTestsEnded(const TestResult& /*result*/)
+{
+    if (record_ && record_->firstEvent_) {
+        multiplexer_.workerEndedTest(record_);
+        record_ = NULLPTR;
+    }
+}
+
+void MultiplexedWorkerTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    MultiplexedTestRecord* record = multiplexer_.workerStartedTest(test);
+    if (record_) {
+        record->takeEventsFrom(record_);
+        delete record_;
+    }
+    record_ = record;
+}
+
+void MultiplexedWorkerTestOutput::printCurrentTestEnded(const TestResult& res)
+{
+    MultiplexedTestRecord* record = currentRecord();
+    record->executionTime_ = res.getCurrentTestTotalExecutionTime();
+    record->resourceUsage_ = res.getCurrentTestResourceUsage();
+    record->counters_ = res.getCurrentTestCounters();
+    record->checkCount_ = res.getCheckCount() - checkCountAtTestEnd_;
+    checkCountAtTestEnd_ = res.getCheckCount();
+
+    multiplexer_.workerEndedTest(record);
+    record_ = NULLPTR;
+}
+
+void MultiplexedWorkerTestOutput::printCurrentGroupStarted(const UtestShell& /*test*/)
+{
+}
+
+void MultiplexedWorkerTestOutput::printCurrentGroupEnded(const TestResult& /*res*/)
+{
+}
+
+void MultiplexedWorkerTestOutput::printBuffer(const char* text)
+{
+    currentRecord()->addEvent(new MultiplexedTestEvent(MultiplexedTestEvent::PRINT, text, NULLPTR));
+}
+
+void MultiplexedWorkerTestOutput::printVeryVerbose(const char* text)
+{
+    currentRecord()->addEvent(new MultiplexedTestEvent(MultiplexedTestEvent::PRINT_VERY_VERBOSE, text, NULLPTR));
+}
+
+void MultiplexedWorkerTestOutput::printFailure(const TestFailure& failure)
+{
+    currentRecord()->addEvent(new MultiplexedTestEvent(MultiplexedTestEvent::FAILURE, "", new TestFailure(failure)));
+}
+
+void MultiplexedWorkerTestOutput::printTestRun(size_t /*number*/, size_t /*total*/)
+{
+}
+
+void MultiplexedWorkerTestOutput::flush()
+{
+}
+
+TestOutputMultiplexer::TestOutputMultiplexer(TestOutput& target, Order order)
+    : target_(target), order_(order), progress_(NULLPTR), replayResult_(target), head_(NULLPTR), tail_(NULLPTR),
+      scheduledCount_(0), startedCount_(0), completedCount_(0), emittedCount_(0), failedCount_(0),
+      currentGroupTest_(NULLPTR), currentGroupTime_(0)
+{
+}
+
+TestOutputMultiplexer::~TestOutputMultiplexer()
+{
+    while (head_) {
+        MultiplexedTestRecord* next = head_->next_;
+        delete head_;
+        head_ = next;
+    }
+}
+
+MultiplexedWorkerTestOutput* TestOutputMultiplexer::createWorkerOutput()
+{
+    return new MultiplexedWorkerTestOutput(*this);
+}
+
+void TestOutputMultiplexer::setProgressOutput(TestOutput* progress)
+{
+    progress_ = progress;
+}
+
+void TestOutputMultiplexer::testsStarted()
+{
+    target_.printTestsStarted();
+}
+
+void TestOutputMultiplexer::scheduleTest(const UtestShell& test)
+{
+    ScopedMutexLock lock(&mutex_);
+    scheduledCount_++;
+    if (order_ == registryOrder)
+        appendRecord(new MultiplexedTestRecord(&test, MultiplexedTestRecord::SCHEDULED));
+}
+
+void TestOutputMultiplexer::testsEnded(const TestResult& result)
+{
+    {
+        ScopedMutexLock lock(&mutex_);
+        emitCompletedRecordsInOrder(true);
+        endCurrentGroup();
+        if (progress_) progress_->print("\n");
+    }
+    target_.printTestsEnded(result);
+}
+
+size_t TestOutputMultiplexer::getScheduledCount() const
+{
+    return scheduledCount_;
+}
+
+size_t TestOutputMultiplexer::getCompletedCount() const
+{
+    return completedCount_;
+}
+
+size_t TestOutputMultiplexer::getEmittedCount() const
+{
+    return emittedCount_;
+}
+
+MultiplexedTestRecord* TestOutputMultiplexer::workerStartedTest(const UtestShell& test)
+{
+    ScopedMutexLock lock(&mutex_);
+    startedCount_++;
+
+    if (order_ == completionOrder)
+        return new MultiplexedTestRecord(&test, MultiplexedTestRecord::RUNNING);
+
+    for (MultiplexedTestRecord* record = head_; record; record = record->next_) {
+        if (record->test_ == &test && record->state_ == MultiplexedTestRecord::SCHEDULED) {
+            record->state_ = MultiplexedTestRecord::RUNNING;
+            return record;
+        }
+    }
+
+    MultiplexedTestRecord* record = new MultiplexedTestRecord(&test, MultiplexedTestRecord::RUNNING);
+    appendRecord(record);
+    return record;
+}
+
+void TestOutputMultiplexer::workerEndedTest(MultiplexedTestRecord* record)
+{
+    ScopedMutexLock lock(&mutex_);
+
+    const bool queued = (order_ == registryOrder) && (record->state_ == MultiplexedTestRecord::RUNNING) && record->test_;
+    record->state_ = MultiplexedTestRecord::COMPLETED;
+
+    if (record->test_) {
+        completedCount_++;
+        for (MultiplexedTestEvent* event = record->firstEvent_; event; event = event->next_) {
+            if (event->kind_ == MultiplexedTestEvent::FAILURE) {
+                failedCount_++;
+                break;
+            }
+        }
+    }
+
+    if (queued)
+        emitCompletedRecordsInOrder(false);
+    else if (order_ == registryOrder && head_) {
+        appendRecord(record);
+        emitCompletedRecordsInOrder(false);
+    }
+    else {
+        emit(record);
+        delete record;
+    }
+
+    printProgress();
+}
+
+void TestOutputMultiplexer::appendRecord(MultiplexedTestRecord* record)
+{
+    if (tail_) tail_->next_ = record;
+    else head_ = record;
+    tail_ = record;
+}
+
+void TestOutputMultiplexer::emitCompletedRecordsInOrder(bool skipUnfinished)
+{
+    while (head_ && (skipUnfinished || head_->state_ == MultiplexedTestRecord::COMPLETED)) {
+        MultiplexedTestRecord* record = head_;
+        head_ = head_->next_;
+        if (head_ == NULLPTR) tail_ = NULLPTR;
+
+        if (record->state_ == MultiplexedTestRecord::COMPLETED)
+            emit(record);
+        delete record;
+    }
+}
+
+void TestOutputMultiplexer::emit(MultiplexedTestRecord* record)
+{
+    const UtestShell* test = record->test_;
+
+    if (test) {
+        if (currentGroupTest_ == NULLPTR || currentGroupTest_->getGroup() != test->getGroup()) {
+            endCurrentGroup();
+            target_.printCurrentGroupStarted(*test);
+            currentGroupTest_ = test;
+        }
+        target_.printCurrentTestStarted(*test);
+    }
+
+    for (MultiplexedTestEvent* event = record->firstEvent_; event; event = event->next_) {
+        if (event->kind_ == MultiplexedTestEvent::FAILURE)
+            replayResult_.addFailure(*event->failure_);
+        else if (event->kind_ == MultiplexedTestEvent::PRINT_VERY_VERBOSE)
+            target_.printVeryVerbose(event->text_.asCharString());
+        else
+            target_.print(event->text_.asCharString());
+    }
+
+    if (test) {
+        for (size_t i = 0; i < record->checkCount_; i++)
+            replayResult_.countCheck();
+        replayResult_.setCurrentTestTotalExecutionTime(record->executionTime_);
+        replayResult_.setCurrentTestResourceUsage(record->resourceUsage_);
+        replayResult_.setCurrentTestCounters(record->counters_);
+        currentGroupTime_ += record->executionTime_;
+        target_.printCurrentTestEnded(replayResult_);
+        emittedCount_++;
+    }
+}
+
+void TestOutputMultiplexer::endCurrentGroup()
+{
+    if (currentGroupTest_ == NULLPTR) return;
+
+    replayResult_.setCurrentGroupTotalExecutionTime(currentGroupTime_);
+    target_.printCurrentGroupEnded(replayResult_);
+    currentGroupTest_ = NULLPTR;
+    currentGroupTime_ = 0;
+}
+
+void TestOutputMultiplexer::printProgress()
+{
+    if (progress_ == NULLPTR) return;
+
+    const size_t total = (scheduledCount_ > startedCount_) ? scheduledCount_ : startedCount_;
+    progress_->print(StringFromFormat("\r[%lu/%lu] %lu running, %lu failed",
+        (unsigned long) completedCount_, (unsigned long) total,
+        (unsigned long) (startedCount_ - completedCount_), (unsigned long) failedCount_).asCharString());
+}
@@ -27,42 +27,177 @@
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestFilterMatcher.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
 
+/*
+ * Shells for tests from TestDescriptors are constructed in place, in blocks
+ * that are not leak checked, as they live as long as their registry. Placement
+ * new clashes with the operator new macro of the memory leak detector.
+ */
+#ifdef CPPUTEST_USE_NEW_MACROS
+#undef new
+#define D_TestRegistry_RestoreNewMacros
+#endif
+
+struct TestDescriptorShellBlock
+{
+    TestDescriptorShellBlock* next_;
+    size_t count_;
+};
+
+namespace
+{
+    class TestDescriptorShell : public UtestShell
+    {
+    public:
+        explicit TestDescriptorShell(const TestDescriptor& descriptor)
+            : UtestShell(descriptor.group, descriptor.name, descriptor.file, descriptor.lineNumber), descriptor_(descriptor)
+        {
+        }
+
+        virtual Utest* createTest() _override
+        {
+            return descriptor_.createTest();
+        }
+
+        static void* operator new(size_t, void* memory) { return memory; }
+        static void operator delete(void*, void*) {}
+        static void operator delete(void*) {}
+
+    private:
+        const TestDescriptor& descriptor_;
+    };
+
+    class IgnoredTestDescriptorShell : public IgnoredUtestShell
+    {
+    public:
+        explicit IgnoredTestDescriptorShell(const TestDescriptor& descriptor)
+            : IgnoredUtestShell(descriptor.group, descriptor.name, descriptor.file, descriptor.lineNumber), descriptor_(descriptor)
+        {
+        }
+
+        virtual Utest* createTest() _override
+        {
+            return descriptor_.createTest();
+        }
+
+        static void* operator new(size_t, void* memory) { return memory; }
+        static void operator delete(void*, void*) {}
+        static void operator delete(void*) {}
+
+    private:
+        const TestDescriptor& descriptor_;
+    };
+}
+
+static const size_t descriptorShellSize =
+    (sizeof(TestDescriptorShell) > sizeof(IgnoredTestDescriptorShell)) ? sizeof(TestDescriptorShell) : sizeof(IgnoredTestDescriptorShell);
+
+static UtestShell* getDescriptorShell(TestDescriptorShellBlock* block, size_t index)
+{
+    return (UtestShell*) (void*) ((char*) (void*) (block + 1) + index * descriptorShellSize);
+}
+
+static TestDescriptorShellBlock* createDescriptorShells(const TestDescriptor* const* begin, const TestDescriptor* const* end, TestDescriptorShellBlock* next)
+{
+    size_t count = (size_t) (end - begin);
+    TestDescriptorShellBlock* block = (TestDescriptorShellBlock*) PlatformSpecificMalloc(sizeof(TestDescriptorShellBlock) + count * descriptorShellSize);
+    block->next_ = next;
+    block->count_ = count;
+
+    for (size_t i = 0; i < count; i++) {
+        void* memory = getDescriptorShell(block, i);
+        if (begin[i]->ignored)
+            new (memory) IgnoredTestDescriptorShell(*begin[i]);
+        else
+            new (memory) TestDescriptorShell(*begin[i]);
+    }
+    return block;
+}
+
+static void deleteDescriptorShells(TestDescriptorShellBlock* block)
+{
+    while (block) {
+        TestDescriptorShellBlock* next = block->next_;
+        for (size_t i = 0; i < block->count_; i++)
+            getDescriptorShell(block, i)->~UtestShell();
+        PlatformSpecificFree(block);
+        block = next;
+    }
+}
+
+#ifdef D_TestRegistry_RestoreNewMacros
+#undef D_TestRegistry_RestoreNewMacros
+#include "CppUTest/MemoryLeakDetectorNewMacros.h"
+#endif
+
 TestRegistry::TestRegistry() :
-    tests_(NULLPTR), nameFilters_(NULLPTR), groupFilters_(NULLPTR), firstPlugin_(NullTestPlugin::instance()), runInSeperateProcess_(false), currentRepetition_(0), runIgnored_(false)
+    tests_(NULLPTR), groupFixtures_(NULLPTR), testTimeouts_(NULLPTR), nameFilters_(NULLPTR), groupFilters_(NULLPTR), testFilters_(NULLPTR), firstPlugin_(NullTestPlugin::instance()), runInSeperateProcess_(false), currentRepetition_(0), runIgnored_(false), testTimeout_(0), fuzzRuns_(0), corpusDirectory_(NULLPTR), fuzzSeed_(0), descriptorShells_(NULLPTR)
 {
 }
 
 TestRegistry::~TestRegistry()
 {
+    deleteDescriptorShells(descriptorShells_);
 }
 
 void TestRegistry::addTest(UtestShell *test)
 {
+    index_.clear();
     tests_ = test->addTest(tests_);
 }
 
+void TestRegistry::addTests(const TestDescriptor* const* begin, const TestDescriptor* const* end)
+{
+    if (begin == end) return;
+
+    descriptorShells_ = createDescriptorShells(begin, end, descriptorShells_);
+    for (size_t i = 0; i < descriptorShells_->count_; i++)
+        addTest(getDescriptorShell(descriptorShells_, i));
+}
+
+void TestRegistry::addGroupFixture(TestGroupFixtureShell* fixture)
+{
+    groupFixtures_ = fixture->addFixture(groupFixtures_);
+}
+
+void TestRegistry::addTestTimeout(TestTimeout* timeout)
+{
+    testTimeouts_ = timeout->addTimeout(testTimeouts_);
+}
+
 void TestRegistry::runAllTests(TestResult& result)
 {
     bool groupStart = true;
+    TestFilterMatcher matcher;
+    matcher.compile(groupFilters_, nameFilters_, testFilters_);
+    scheduleGroupFixtures(matcher);
 
     result.testsStarted();
     for (UtestShell *test = tests_; test != NULLPTR; test = test->getNext()) {
         if (runInSeperateProcess_) test->setRunInSeperateProcess();
         if (runIgnored_) test->setRunIgnored();
+        if (testTimeout_ || testTimeouts_) test->setTimeout(timeoutFor(test));
+        test->setFuzzOptions(fuzzRuns_, corpusDirectory_, fuzzSeed_);
 
         if (groupStart) {
             result.currentGroupStarted(test);
             groupStart = false;
         }
 
-        result.countTest();
-        if (testShouldRun(test, result)) {
-            result.currentTestStarted(test);
-            test->runOneTest(firstPlugin_, result);
-            result.currentTestEnded(test);
+        for (bool hasCase = test->firstCase(); hasCase; hasCase = test->nextCase()) {
+            result.countTest();
+            if (testShouldRun(test, result, matcher)) {
+                result.currentTestStarted(test);
+                if (runGroupFixturesBefore(test, result))
+                    test->runOneTest(firstPlugin_, result);
+                else
+                    result.countIgnored();
+                result.currentTestEnded(test);
+            }
         }
+        runGroupFixturesAfter(test, result);
 
         if (endOfGroup(test)) {
             groupStart = true;
@@ -73,53 +208,90 @@ void TestRegistry::runAllTests(TestResult& result)
     currentRepetition_++;
 }
 
-void TestRegistry::listTestGroupNames(TestResult& result)
+namespace
 {
-    SimpleString groupList;
+    class TestRegistryNameList
+    {
+    public:
+        explicit TestRegistryNameList(size_t capacity)
+            : capacity_(capacity + 1), length_(0)
+        {
+            buffer_ = SimpleString::allocStringBuffer(capacity_, __FILE__, __LINE__);
+            buffer_[0] = '\0';
+        }
 
-    for (UtestShell *test = tests_; test != NULLPTR; test = test->getNext()) {
-        SimpleString gname;
-        gname += "#";
-        gname += test->getGroup();
-        gname += "#";
-
-        if (!groupList.contains(gname)) {
-            groupList += gname;
-            groupList += " ";
+        ~TestRegistryNameList()
+        {
+            SimpleString::deallocStringBuffer(buffer_, capacity_, __FILE__, __LINE__);
+        }
+
+        static size_t sizeOf(const char* group, const char* name = NULLPTR)
+        {
+            return 1 + SimpleString::StrLen(group) + ((name) ? 1 + SimpleString::StrLen(name) : 0);
         }
-    }
 
-    groupList.replace("#", "");
+        void add(const char* group, const char* name = NULLPTR)
+        {
+            if (length_ != 0) append(" ");
+            append(group);
+            if (name) {
+                append(".");
+                append(name);
+            }
+        }
+
+        const char* asCharString() const
+        {
+            return buffer_;
+        }
+
+    private:
+        void append(const char* text)
+        {
+            size_t length = SimpleString::StrLen(text);
+            SimpleString::StrNCpy(buffer_ + length_, text, length + 1);
+            length_ += length;
+        }
+
+        char* buffer_;
+        size_t capacity_;
+        size_t length_;
+
+        TestRegistryNameList(const TestRegistryNameList&);
+        TestRegistryNameList& operator=(const TestRegistryNameList&);
+    };
+}
+
+void TestRegistry::listTestGroupNames(TestResult& result)
+{
+    TestRegistryIndex& index = getIndex();
+
+    size_t size = 0;
+    for (size_t i = 0; i < index.getGroupCount(); i++)
+        size += TestRegistryNameList::sizeOf(index.getGroupName(i));
+
+    TestRegistryNameList groupList(size);
+    for (size_t i = 0; i < index.getGroupCount(); i++)
+        groupList.add(index.getGroupName(i));
 
-    if (groupList.endsWith(" "))
-        groupList = groupList.subString(0, groupList.size() - 1);
     result.print(groupList.asCharString());
 }
 
 void TestRegistry::listTestGroupAndCaseNames(TestResult& result)
 {
-    SimpleString groupAndNameList;
+    TestRegistryIndex& index = getIndex();
+    TestFilterMatcher matcher;
+    matcher.compile(groupFilters_, nameFilters_, testFilters_);
 
-    for (UtestShell *test = tests_; test != NULLPTR; test = test->getNext()) {
-        if (testShouldRun(test, result)) {
-            SimpleString groupAndName;
-            groupAndName += "#";
-            groupAndName += test->getGroup();
-            groupAndName += ".";
-            groupAndName += test->getName();
-            groupAndName += "#";
-
-            if (!groupAndNameList.contains(groupAndName)) {
-                groupAndNameList += groupAndName;
-                groupAndNameList += " ";
-            }
-        }
-    }
+    size_t size = 0;
+    for (size_t i = 0; i < index.getUniqueTestCount(); i++)
+        size += TestRegistryNameList::sizeOf(index.getUniqueTestGroupName(i), index.getUniqueTestName(i));
 
-    groupAndNameList.replace("#", "");
+    TestRegistryNameList groupAndNameList(size);
+    for (size_t i = 0; i < index.getUniqueTestCount(); i++)
+        if (testShouldRun(index.getUniqueTest(i), result, matcher))
+            groupAndNameList.add(index.getUniqueTestGroupName(i), index.getUniqueTestName(i));
 
-    if (groupAndNameList.endsWith(" "))
-        groupAndNameList = groupAndNameList.subString(0, groupAndNameList.size() - 1);
     result.print(groupAndNameList.asCharString());
 }
 
@@ -128,6 +300,67 @@ bool TestRegistry::endOfGroup(UtestShell* test)
     return (!test || !test->getNext() || test->getGroup() != test->getNext()->getGroup());
 }
 
+/*
+ * Group fixtures are scheduled on the tests that will actually run, in the
+ * order they run in, so shuffling and filtering only move them. A setup once
+ * runs before the first of those tests, a teardown once after the last (and
+ * after all of its cases). Both run outside the plugins, and thus outside the
+ * leak checking period of the test, so resources of the group are not
+ * reported as leaks of that test.
+ */
+void TestRegistry::scheduleGroupFixtures(const TestFilterMatcher& matcher)
+{
+    if (groupFixtures_ == NULLPTR) return;
+
+    for (TestGroupFixtureShell* fixture = groupFixtures_; fixture != NULLPTR; fixture = fixture->getNextFixture())
+        fixture->unschedule();
+
+    for (UtestShell* test = tests_; test != NULLPTR; test = test->getNext()) {
+        if (!hasGroupFixture(test) || !willRunAnyCase(test, matcher)) continue;
+
+        for (TestGroupFixtureShell* fixture = groupFixtures_; fixture != NULLPTR; fixture = fixture->getNextFixture())
+            if (fixture->hasSameGroupAs(*test))
+                fixture->schedule(test);
+    }
+}
+
+bool TestRegistry::hasGroupFixture(UtestShell* test)
+{
+    for (TestGroupFixtureShell* fixture = groupFixtures_; fixture != NULLPTR; fixture = fixture->getNextFixture())
+        if (fixture->hasSameGroupAs(*test))
+            return true;
+    return false;
+}
+
+bool TestRegistry::willRunAnyCase(UtestShell* test, const TestFilterMatcher& matcher)
+{
+    if (!(runIgnored_ || test->willRun())) return false;
+
+    bool willRun = false;
+    for (bool hasCase = test->firstCase(); hasCase && !willRun; hasCase = test->nextCase())
+        willRun = test->shouldRun(matcher);
+    return willRun;
+}
+
+bool TestRegistry::runGroupFixturesBefore(UtestShell* test, TestResult& result)
+{
+    bool groupIsSetUp = true;
+    for (TestGroupFixtureShell* fixture = groupFixtures_; fixture != NULLPTR; fixture = fixture->getNextFixture()) {
+        if (fixture->runsBeforeGroup() && fixture->getScheduledTest() == test)
+            fixture->runFixture(result);
+        if (fixture->fixtureFailed() && fixture->hasSameGroupAs(*test))
+            groupIsSetUp = false;
+    }
+    return groupIsSetUp;
+}
+
+void TestRegistry::runGroupFixturesAfter(UtestShell* test, TestResult& result)
+{
+    for (TestGroupFixtureShell* fixture = groupFixtures_; fixture != NULLPTR; fixture = fixture->getNextFixture())
+        if (!fixture->runsBeforeGroup() && fixture->getScheduledTest() == test)
+            fixture->runFixture(result);
+}
+
 size_t TestRegistry::countTests()
 {
     return tests_ ? tests_->countTests() : 0;
@@ -135,9 +368,31 @@ size_t TestRegistry::countTests()
 
 TestRegistry* TestRegistry::currentRegistry_ = NULLPTR;
 
+#if CPPUTEST_HAVE_TEST_SECTION
+extern "C" {
+    /* Provided by the linker when any object contains the test section */
+    extern const TestDescriptor* const __start_cpputest_tests[] __attribute__((weak));
+    extern const TestDescriptor* const __stop_cpputest_tests[] __attribute__((weak));
+}
+
+static void addTestsFromSection(TestRegistry& registry)
+{
+    registry.addTests(__start_cpputest_tests, __stop_cpputest_tests);
+}
+#else
+static void addTestsFromSection(TestRegistry&)
+{
+}
+#endif
+
 TestRegistry* TestRegistry::getCurrentRegistry()
 {
     static TestRegistry registry;
+    static bool sectionTestsAdded = false;
+    if (!sectionTestsAdded) {
+        sectionTestsAdded = true;
+        addTestsFromSection(registry);
+    }
     return (currentRegistry_ == NULLPTR) ? &registry : currentRegistry_;
 }
 
@@ -148,8 +403,8 @@ void TestRegistry::setCurrentRegistry(TestRegistry* registry)
 
 void TestRegistry::unDoLastAddTest()
 {
+    index_.clear();
     tests_ = tests_ ? tests_->getNext() : NULLPTR;
-
 }
 
 void TestRegistry::setNameFilters(const TestFilter* filters)
@@ -162,6 +417,11 @@ void TestRegistry::setGroupFilters(const TestFilter* filters)
     groupFilters_ = filters;
 }
 
+void TestRegistry::setTestFilters(const TestFilter* filters)
+{
+    testFilters_ = filters;
+}
+
 void TestRegistry::setRunIgnored()
 {
     runIgnored_ = true;
@@ -172,14 +432,45 @@ void TestRegistry::setRunTestsInSeperateProcess()
     runInSeperateProcess_ = true;
 }
 
+void TestRegistry::setTestTimeout(size_t timeoutInMillis)
+{
+    testTimeout_ = timeoutInMillis;
+}
+
+void TestRegistry::setFuzzRuns(size_t runs)
+{
+    fuzzRuns_ = runs;
+}
+
+/* NULLPTR for the default corpus directory */
+void TestRegistry::setCorpusDirectory(const char* directory)
+{
+    corpusDirectory_ = directory;
+}
+
+/* 0 for a new seed for every fuzz target */
+void TestRegistry::setFuzzSeed(unsigned int seed)
+{
+    fuzzSeed_ = seed;
+}
+
+/* A TEST_TIMEOUT of the test wins over the --timeout of the run */
+size_t TestRegistry::timeoutFor(UtestShell* test)
+{
+    for (TestTimeout* timeout = testTimeouts_; timeout != NULLPTR; timeout = timeout->getNext())
+        if (timeout->appliesTo(*test))
+            return timeout->getTimeout();
+    return testTimeout_;
+}
+
 int TestRegistry::getCurrentRepetition()
 {
     return currentRepetition_;
 }
 
-bool TestRegistry::testShouldRun(UtestShell* test, TestResult& result)
+bool TestRegistry::testShouldRun(UtestShell* test, TestResult& result, const TestFilterMatcher& matcher)
 {
-    if (test->shouldRun(groupFilters_, nameFilters_)) return true;
+    if (test->shouldRun(matcher)) return true;
     else {
         result.countFilteredOut();
         return false;
@@ -231,6 +522,7 @@ void TestRegistry::shuffleTests(size_t seed)
 {
     UtestShellPointerArray array(getFirstTest());
     array.shuffle(seed);
+    index_.clear();
     tests_ = array.getFirstTest();
 }
 
@@ -238,6 +530,7 @@ void TestRegistry::reverseTests()
 {
     UtestShellPointerArray array(getFirstTest());
     array.reverse();
+    index_.clear();
     tests_ = array.getFirstTest();
 }
 
@@ -251,23 +544,208 @@ UtestShell* TestRegistry::getTestWithNext(UtestShell* test)
 
 UtestShell* TestRegistry::findTestWithName(const SimpleString& name)
 {
-    UtestShell* current = tests_;
-    while (current) {
-        if (current->getName() == name)
-            return current;
-        current = current->getNext();
-    }
-    return NULLPTR;
+    return getIndex().findTestWithName(name);
 }
 
 UtestShell* TestRegistry::findTestWithGroup(const SimpleString& group)
 {
-    UtestShell* current = tests_;
-    while (current) {
-        if (current->getGroup() == group)
-            return current;
-        current = current->getNext();
+    return getIndex().findTestWithGroup(group);
+}
+
+UtestShell* TestRegistry::findTestWithGroupAndName(const SimpleString& group, const SimpleString& name)
+{
+    return getIndex().findTestWithGroupAndName(group, name);
+}
+
+size_t TestRegistry::countTestsInGroup(const SimpleString& group)
+{
+    return getIndex().countTestsInGroup(group);
+}
+
+void TestRegistry::buildIndex()
+{
+    if (!index_.isBuilt()) index_.build(tests_);
+}
+
+void TestRegistry::clearIndex()
+{
+    index_.clear();
+}
+
+TestRegistryIndex& TestRegistry::getIndex()
+{
+    buildIndex();
+    return index_;
+}
+
+//////////////////// TestRegistryIndex
+
+struct TestRegistryIndexGroup
+{
+    const char* name_;
+    size_t first_;
+    size_t count_;
+};
+
+struct TestRegistryIndexEntry
+{
+    UtestShell* test_;
+    const char* group_;
+    const char* name_;
+};
+
+/* The index may be rebuilt during a test and outlive it, so it is not leak checked */
+TestRegistryIndex::TestRegistryIndex()
+    : built_(false), groupNames_(true), testNames_(true), groupAndTestNames_(true), groups_(NULLPTR), groupCount_(0), testsByGroup_(NULLPTR), testCount_(0), uniqueTests_(NULLPTR), uniqueTestCount_(0)
+{
+}
+
+TestRegistryIndex::~TestRegistryIndex()
+{
+    clear();
+}
+
+bool TestRegistryIndex::isBuilt() const
+{
+    return built_;
+}
+
+void TestRegistryIndex::clear()
+{
+    if (!built_) return;
+
+    groupNames_.clear();
+    testNames_.clear();
+    groupAndTestNames_.clear();
+
+    PlatformSpecificFree(groups_);
+    PlatformSpecificFree(testsByGroup_);
+    PlatformSpecificFree(uniqueTests_);
+    groups_ = NULLPTR;
+    testsByGroup_ = NULLPTR;
+    uniqueTests_ = NULLPTR;
+    groupCount_ = 0;
+    testCount_ = 0;
+    uniqueTestCount_ = 0;
+    built_ = false;
+}
+
+void TestRegistryIndex::build(UtestShell* firstTest)
+{
+    clear();
+    built_ = true;
+
+    for (UtestShell* test = firstTest; test != NULLPTR; test = test->getNext())
+        testCount_++;
+    if (testCount_ == 0) return;
+
+    groups_ = (TestRegistryIndexGroup*) PlatformSpecificMalloc(testCount_ * sizeof(TestRegistryIndexGroup));
+    testsByGroup_ = (UtestShell**) PlatformSpecificMalloc(testCount_ * sizeof(UtestShell*));
+    uniqueTests_ = (TestRegistryIndexEntry*) PlatformSpecificMalloc(testCount_ * sizeof(TestRegistryIndexEntry));
+    TestRegistryIndexGroup** groupOfTest = (TestRegistryIndexGroup**) PlatformSpecificMalloc(testCount_ * sizeof(TestRegistryIndexGroup*));
+
+    size_t testIndex = 0;
+    for (UtestShell* test = firstTest; test != NULLPTR; test = test->getNext(), testIndex++) {
+        const SimpleString group = test->getGroup();
+        const SimpleString name = test->getName();
+
+        size_t knownGroups = groupNames_.size();
+        const char* groupHandle = groupNames_.intern(group);
+        if (groupNames_.size() != knownGroups) {
+            TestRegistryIndexGroup& newGroup = groups_[groupCount_++];
+            newGroup.name_ = groupHandle;
+            newGroup.first_ = 0;
+            newGroup.count_ = 0;
+            groupNames_.setData(groupHandle, &newGroup);
+        }
+        groupOfTest[testIndex] = (TestRegistryIndexGroup*) groupNames_.getData(groupHandle);
+        groupOfTest[testIndex]->count_++;
+
+        size_t knownNames = testNames_.size();
+        const char* nameHandle = testNames_.intern(name);
+        if (testNames_.size() != knownNames)
+            testNames_.setData(nameHandle, test);
+
+        size_t knownGroupAndNames = groupAndTestNames_.size();
+        const char* groupAndNameHandle = groupAndTestNames_.intern(group + "." + name);
+        if (groupAndTestNames_.size() != knownGroupAndNames) {
+            groupAndTestNames_.setData(groupAndNameHandle, test);
+            TestRegistryIndexEntry& entry = uniqueTests_[uniqueTestCount_++];
+            entry.test_ = test;
+            entry.group_ = groupHandle;
+            entry.name_ = nameHandle;
+        }
+    }
+
+    size_t first = 0;
+    for (size_t i = 0; i < groupCount_; i++) {
+        groups_[i].first_ = first;
+        first += groups_[i].count_;
+        groups_[i].count_ = 0;
+    }
+
+    testIndex = 0;
+    for (UtestShell* test = firstTest; test != NULLPTR; test = test->getNext(), testIndex++) {
+        TestRegistryIndexGroup* group = groupOfTest[testIndex];
+        testsByGroup_[group->first_ + group->count_++] = test;
     }
-    return NULLPTR;
+
+    PlatformSpecificFree(groupOfTest);
+}
+
+TestRegistryIndexGroup* TestRegistryIndex::findGroup(const SimpleString& group) const
+{
+    return (TestRegistryIndexGroup*) groupNames_.getData(group.asCharString());
+}
+
+UtestShell* TestRegistryIndex::findTestWithGroup(const SimpleString& group) const
+{
+    TestRegistryIndexGroup* indexGroup = findGroup(group);
+    return (indexGroup) ? testsByGroup_[indexGroup->first_] : NULLPTR;
+}
+
+UtestShell* TestRegistryIndex::findTestWithName(const SimpleString& name) const
+{
+    return (UtestShell*) testNames_.getData(name.asCharString());
+}
+
+UtestShell* TestRegistryIndex::findTestWithGroupAndName(const SimpleString& group, const SimpleString& name) const
+{
+    return (UtestShell*) groupAndTestNames_.getData((group + "." + name).asCharString());
+}
+
+size_t TestRegistryIndex::countTestsInGroup(const SimpleString& group) const
+{
+    TestRegistryIndexGroup* indexGroup = findGroup(group);
+    return (indexGroup) ? indexGroup->count_ : 0;
+}
+
+size_t TestRegistryIndex::getGroupCount() const
+{
+    return groupCount_;
+}
+
+const char* TestRegistryIndex::getGroupName(size_t groupIndex) const
+{
+    return groups_[groupIndex].name_;
+}
+
+size_t TestRegistryIndex::getUniqueTestCount() const
+{
+    return uniqueTestCount_;
+}
+
+UtestShell* TestRegistryIndex::getUniqueTest(size_t testIndex) const
+{
+    return uniqueTests_[testIndex].test_;
+}
+
+const char* TestRegistryIndex::getUniqueTestGroupName(size_t testIndex) const
+{
+    return uniqueTests_[testIndex].group_;
 }
 
+const char* TestRegistryIndex::getUniqueTestName(size_t testIndex) const
+{
+    return uniqueTests_[testIndex].name_;
+}
@@ -31,6 +31,49 @@
 #include "CppUTest/TestOutput.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
 
+TestResourceUsage::TestResourceUsage() :
+    measured_(false), userTimeInMicroseconds_(0), systemTimeInMicroseconds_(0), peakResidentSetInKilobytes_(0),
+    majorPageFaults_(0), minorPageFaults_(0), voluntaryContextSwitches_(0), involuntaryContextSwitches_(0)
+{
+}
+
+TestCounters::TestCounters() : count_(0)
+{
+}
+
+void TestCounters::add(const char* name, unsigned long value)
+{
+    if (count_ == maxCounters) return;
+
+    size_t length = 0;
+    for (; name[length] && length < maxNameLength; length++)
+        names_[count_][length] = name[length];
+    names_[count_][length] = '\0';
+    values_[count_] = value;
+    count_++;
+}
+
+static unsigned long growth(unsigned long start, unsigned long end)
+{
+    return (end > start) ? end - start : 0;
+}
+
+static TestResourceUsage resourceUsageOfTest(const TestResourceUsage& start, const TestResourceUsage& end, const TestResourceUsage& separateProcess)
+{
+    TestResourceUsage usage;
+    usage.measured_ = true;
+    usage.userTimeInMicroseconds_ = growth(start.userTimeInMicroseconds_, end.userTimeInMicroseconds_) + separateProcess.userTimeInMicroseconds_;
+    usage.systemTimeInMicroseconds_ = growth(start.systemTimeInMicroseconds_, end.systemTimeInMicroseconds_) + separateProcess.systemTimeInMicroseconds_;
+    usage.peakResidentSetInKilobytes_ = growth(start.peakResidentSetInKilobytes_, end.peakResidentSetInKilobytes_);
+    if (growth(start.peakResidentSetInKilobytes_, separateProcess.peakResidentSetInKilobytes_) > usage.peakResidentSetInKilobytes_)
+        usage.peakResidentSetInKilobytes_ = growth(start.peakResidentSetInKilobytes_, separateProcess.peakResidentSetInKilobytes_);
+    usage.majorPageFaults_ = growth(start.majorPageFaults_, end.majorPageFaults_) + separateProcess.majorPageFaults_;
+    usage.minorPageFaults_ = growth(start.minorPageFaults_, end.minorPageFaults_) + separateProcess.minorPageFaults_;
+    usage.voluntaryContextSwitches_ = growth(start.voluntaryContextSwitches_, end.voluntaryContextSwitches_) + separateProcess.voluntaryContextSwitches_;
+    usage.involuntaryContextSwitches_ = growth(start.involuntaryContextSwitches_, end.involuntaryContextSwitches_) + separateProcess.involuntaryContextSwitches_;
+    return usage;
+}
+
 TestResult::TestResult(TestOutput& p) :
     output_(p), testCount_(0), runCount_(0), checkCount_(0), failureCount_(0), filteredOutCount_(0), ignoredCount_(0), totalExecutionTime_(0), timeStarted_(0), currentTestTimeStarted_(0),
             currentTestTotalExecutionTime_(0), currentGroupTimeStarted_(0), currentGroupTotalExecutionTime_(0)
@@ -57,6 +100,9 @@ void TestResult::currentTestStarted(UtestShell* test)
 {
     output_.printCurrentTestStarted(*test);
     currentTestTimeStarted_ = (size_t) GetPlatformSpecificTimeInMillis();
+    separateProcessResourceUsage_ = TestResourceUsage();
+    currentTestCounters_ = TestCounters();
+    currentTestResourceUsageAtStart_.measured_ = PlatformSpecificGetResourceUsage(&currentTestResourceUsageAtStart_) != 0;
 }
 
 void TestResult::print(const char* text)
@@ -72,6 +118,10 @@ void TestResult::printVeryVerbose(const char* text)
 void TestResult::currentTestEnded(UtestShell* /*test*/)
 {
     currentTestTotalExecutionTime_ = (size_t) GetPlatformSpecificTimeInMillis() - currentTestTimeStarted_;
+    currentTestResourceUsage_ = TestResourceUsage();
+    TestResourceUsage end;
+    if (currentTestResourceUsageAtStart_.measured_ && PlatformSpecificGetResourceUsage(&end))
+        currentTestResourceUsage_ = resourceUsageOfTest(currentTestResourceUsageAtStart_, end, separateProcessResourceUsage_);
     output_.printCurrentTestEnded(*this);
 
 }
@@ -135,8 +185,54 @@ size_t TestResult::getCurrentTestTotalExecutionTime() const
     return currentTestTotalExecutionTime_;
 }
 
+void TestResult::setCurrentTestTotalExecutionTime(size_t exTime)
+{
+    currentTestTotalExecutionTime_ = exTime;
+}
+
 size_t TestResult::getCurrentGroupTotalExecutionTime() const
 {
     return currentGroupTotalExecutionTime_;
 }
 
+void TestResult::setCurrentGroupTotalExecutionTime(size_t exTime)
+{
+    currentGroupTotalExecutionTime_ = exTime;
+}
+
+const TestResourceUsage& TestResult::getCurrentTestResourceUsage() const
+{
+    return currentTestResourceUsage_;
+}
+
+void TestResult::setCurrentTestResourceUsage(const TestResourceUsage& usage)
+{
+    currentTestResourceUsage_ = usage;
+}
+
+void TestResult::addSeparateProcessResourceUsage(const TestResourceUsage& usage)
+{
+    separateProcessResourceUsage_.userTimeInMicroseconds_ += usage.userTimeInMicroseconds_;
+    separateProcessResourceUsage_.systemTimeInMicroseconds_ += usage.systemTimeInMicroseconds_;
+    if (usage.peakResidentSetInKilobytes_ > separateProcessResourceUsage_.peakResidentSetInKilobytes_)
+        separateProcessResourceUsage_.peakResidentSetInKilobytes_ = usage.peakResidentSetInKilobytes_;
+    separateProcessResourceUsage_.majorPageFaults_ += usage.majorPageFaults_;
+    separateProcessResourceUsage_.minorPageFaults_ += usage.minorPageFaults_;
+    separateProcessResourceUsage_.voluntaryContextSwitches_ += usage.voluntaryContextSwitches_;
+    separateProcessResourceUsage_.involuntaryContextSwitches_ += usage.involuntaryContextSwitches_;
+}
+
+void TestResult::addCurrentTestCounter(const char* name, unsigned long value)
+{
+    currentTestCounters_.add(name, value);
+}
+
+const TestCounters& TestResult::getCurrentTestCounters() const
+{
+    return currentTestCounters_;
+}
+
+void TestResult::setCurrentTestCounters(const TestCounters& counters)
+{
+    currentTestCounters_ = counters;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestResultChannel.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+struct TestResultChannelHeader
+{
+    volatile size_t checkCount_;
+    volatile size_t failureCount_;
+    volatile size_t droppedCount_;
+    volatile size_t used_;
+};
+
+static const size_t recordFieldsSize = 3 * sizeof(size_t);
+
+static size_t alignedRecordSize(size_t size)
+{
+    return (size + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+}
+
+static size_t readRecordField(const char* record, size_t index)
+{
+    size_t value;
+    PlatformSpecificMemCpy(&value, record + index * sizeof(size_t), sizeof(size_t));
+    return value;
+}
+
+static void writeRecordField(char* record, size_t index, size_t value)
+{
+    PlatformSpecificMemCpy(record + index * sizeof(size_t), &value, sizeof(size_t));
+}
+
+TestResultChannel::TestResultChannel(void* memory, size_t size)
+    : header_(NULLPTR), records_(NULLPTR), capacity_(0)
+{
+    if (memory != NULLPTR && size >= sizeof(TestResultChannelHeader)) {
+        header_ = (TestResultChannelHeader*) memory;
+        records_ = (char*) memory + sizeof(TestResultChannelHeader);
+        capacity_ = size - sizeof(TestResultChannelHeader);
+    }
+}
+
+TestResultChannel::~TestResultChannel()
+{
+}
+
+void TestResultChannel::clear()
+{
+    if (header_ == NULLPTR) return;
+    header_->checkCount_ = 0;
+    header_->failureCount_ = 0;
+    header_->droppedCount_ = 0;
+    header_->used_ = 0;
+}
+
+void TestResultChannel::countCheck()
+{
+    if (header_ == NULLPTR) return;
+    header_->checkCount_ = header_->checkCount_ + 1;
+}
+
+void TestResultChannel::addFailure(const TestFailure& failure)
+{
+    if (header_ == NULLPTR) return;
+    header_->failureCount_ = header_->failureCount_ + 1;
+    appendRecord(RECORD_FAILURE, failure.getFailureLineNumber(), failure.getFileName().asCharString(), failure.getMessage().asCharString());
+}
+
+void TestResultChannel::print(const char* text)
+{
+    appendRecord(RECORD_PRINT, 0, text, "");
+}
+
+void TestResultChannel::printVeryVerbose(const char* text)
+{
+    appendRecord(RECORD_PRINT_VERY_VERBOSE, 0, text, "");
+}
+
+void TestResultChannel::addCounter(const char* name, unsigned long value)
+{
+    appendRecord(RECORD_COUNTER, (size_t) value, name, "");
+}
+
+size_t TestResultChannel::getCheckCount() const
+{
+    return (header_ == NULLPTR) ? 0 : header_->checkCount_;
+}
+
+size_t TestResultChannel::getFailureCount() const
+{
+    return (header_ == NULLPTR) ? 0 : header_->failureCount_;
+}
+
+size_t TestResultChannel::getDroppedCount() const
+{
+    return (header_ == NULLPTR) ? 0 : header_->droppedCount_;
+}
+
+bool TestResultChannel::appendRecord(RecordType type, size_t lineNumber, const char* first, const char* second)
+{
+    if (header_ == NULLPTR) return false;
+
+    const size_t firstLength = SimpleString::StrLen(first) + 1;
+    const size_t secondLength = SimpleString::StrLen(second) + 1;
+    const size_t recordSize = alignedRecordSize(recordFieldsSize + firstLength + secondLength);
+    const size_t used = header_->used_;
+
+    if (recordSize > capacity_ - used) {
+        header_->droppedCount_ = header_->droppedCount_ + 1;
+        return false;
+    }
+
+    char* record = records_ + used;
+    writeRecordField(record, 0, recordSize);
+    writeRecordField(record, 1, (size_t) type);
+    writeRecordField(record, 2, lineNumber);
+    PlatformSpecificMemCpy(record + recordFieldsSize, first, firstLength);
+    PlatformSpecificMemCpy(record + recordFieldsSize + firstLength, second, secondLength);
+
+    /* Only publish the record once it is completely written */
+    header_->used_ = used + recordSize;
+    return true;
+}
+
+void TestResultChannel::replayInto(UtestShell* shell, TestResult& result) const
+{
+    if (header_ == NULLPTR) return;
+
+    const size_t used = header_->used_;
+    size_t replayedFailures = 0;
+    size_t offset = 0;
+
+    while (offset + recordFieldsSize <= used) {
+        const char* record = records_ + offset;
+        const size_t recordSize = readRecordField(record, 0);
+        const size_t type = readRecordField(record, 1);
+        const char* first = record + recordFieldsSize;
+        const char* second = first + SimpleString::StrLen(first) + 1;
+
+        if (recordSize == 0) break;
+
+        if (type == RECORD_FAILURE) {
+            result.addFailure(TestFailure(shell, first, readRecordField(record, 2), second));
+            replayedFailures++;
+        }
+        else if (type == RECORD_PRINT)
+            result.print(first);
+        else if (type == RECORD_PRINT_VERY_VERBOSE)
+            result.printVeryVerbose(first);
+        else if (type == RECORD_COUNTER)
+            result.addCurrentTestCounter(first, (unsigned long) readRecordField(record, 2));
+
+        offset += recordSize;
+    }
+
+    for (size_t i = 0; i < header_->checkCount_; i++)
+        result.countCheck();
+
+    if (replayedFailures < header_->failureCount_)
+        result.addFailure(TestFailure(shell, StringFromFormat("Failed in separate process - %d failure(s) did not fit in the result channel",
+            (int) (header_->failureCount_ - replayedFailures))));
+    else if (header_->droppedCount_ != 0)
+        result.print(StringFromFormat("\n%d output event(s) of the separate process did not fit in the result channel\n", (int) header_->droppedCount_).asCharString());
+}
+
+TestResultChannelWriter::TestResultChannelWriter(const TestResult& result, TestResultChannel& channel)
+    : TestResult(result), channel_(channel)
+{
+}
+
+TestResultChannelWriter::~TestResultChannelWriter()
+{
+}
+
+void TestResultChannelWriter::countCheck()
+{
+    channel_.countCheck();
+}
+
+void TestResultChannelWriter::addFailure(const TestFailure& failure)
+{
+    channel_.addFailure(failure);
+}
+
+void TestResultChannelWriter::print(const char* text)
+{
+    channel_.print(text);
+}
+
+void TestResultChannelWriter::printVeryVerbose(const char* text)
+{
+    channel_.printVeryVerbose(text);
+}
+
+void TestResultChannelWriter::addCurrentTestCounter(const char* name, unsigned long value)
+{
+    channel_.addCounter(name, value);
+}
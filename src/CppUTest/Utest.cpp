@@ -27,6 +27,7 @@
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestFilterMatcher.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
 #include "CppUTest/TestOutput.h"
 
@@ -139,17 +140,17 @@ const TestTerminator *UtestShell::currentTestTerminator_ = &normalTestTerminator
 /******************************** */
 
 UtestShell::UtestShell() :
-    group_("UndefinedTestGroup"), name_("UndefinedTest"), file_("UndefinedFile"), lineNumber_(0), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false)
+    group_("UndefinedTestGroup"), name_("UndefinedTest"), file_("UndefinedFile"), lineNumber_(0), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false), timeout_(0)
 {
 }
 
 UtestShell::UtestShell(const char* groupName, const char* testName, const char* fileName, size_t lineNumber) :
-    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false)
+    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false), timeout_(0)
 {
 }
 
 UtestShell::UtestShell(const char* groupName, const char* testName, const char* fileName, size_t lineNumber, UtestShell* nextTest) :
-    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(nextTest), isRunAsSeperateProcess_(false), hasFailed_(false)
+    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(nextTest), isRunAsSeperateProcess_(false), hasFailed_(false), timeout_(0)
 {
 }
 
@@ -188,8 +189,13 @@ void UtestShell::runOneTest(TestPlugin* plugin, TestResult& result)
     HelperTestRunInfo runInfo(this, plugin, &result);
     if (isRunInSeperateProcess())
         PlatformSpecificSetJmp(helperDoRunOneTestSeperateProcess, &runInfo);
-    else
+    else if (timeout_ == 0)
         PlatformSpecificSetJmp(helperDoRunOneTestInCurrentProcess, &runInfo);
+    else {
+        PlatformSpecificStartWatchdog(this, timeout_);
+        PlatformSpecificSetJmp(helperDoRunOneTestInCurrentProcess, &runInfo);
+        PlatformSpecificStopWatchdog();
+    }
 }
 
 Utest* UtestShell::createTest()
@@ -303,6 +309,20 @@ void UtestShell::setRunInSeperateProcess()
     isRunAsSeperateProcess_ = true;
 }
 
+void UtestShell::setTimeout(size_t timeoutInMillis)
+{
+    timeout_ = timeoutInMillis;
+}
+
+size_t UtestShell::getTimeout() const
+{
+    return timeout_;
+}
+
+void UtestShell::setFuzzOptions(size_t, const char*, unsigned int)
+{
+}
+
 
 void UtestShell::setRunIgnored()
 {
@@ -341,12 +361,19 @@ size_t UtestShell::getLineNumber() const
 
 bool UtestShell::match(const char* target, const TestFilter* filters) const
 {
-    if(filters == NULLPTR) return true;
-
-    for(; filters != NULLPTR; filters = filters->getNext())
-        if(filters->match(target)) return true;
+    bool hasIncludes = false;
+    bool included = false;
 
-    return false;
+    for(; filters != NULLPTR; filters = filters->getNext()) {
+        if (filters->isInvertMatching()) {
+            if (!filters->match(target)) return false;
+        }
+        else {
+            hasIncludes = true;
+            included = included || filters->match(target);
+        }
+    }
+    return included || !hasIncludes;
 }
 
 bool UtestShell::shouldRun(const TestFilter* groupFilters, const TestFilter* nameFilters) const
@@ -354,6 +381,26 @@ bool UtestShell::shouldRun(const TestFilter* groupFilters, const TestFilter* nam
     return match(group_, groupFilters) && match(name_, nameFilters);
 }
 
+bool UtestShell::shouldRun(const TestFilterMatcher& matcher) const
+{
+    return matcher.match(group_, name_);
+}
+
+bool UtestShell::hasSameGroupAs(const UtestShell& test) const
+{
+    return SimpleString::StrCmp(group_, test.group_) == 0;
+}
+
+bool UtestShell::firstCase()
+{
+    return true;
+}
+
+bool UtestShell::nextCase()
+{
+    return false;
+}
+
 void UtestShell::failWith(const TestFailure& failure)
 {
     failWith(failure, getCurrentTestTerminator());
@@ -798,6 +845,177 @@ void IgnoredUtestShell::setRunIgnored()
     runIgnored_ = true;
 }
 
+/////////////// ParameterizedUtestShell /////////////
+
+/* The case name outlives the leak checking of the cases, so its buffer
+ * doesn't go through the memory leak detector. */
+ParameterizedUtestShell::ParameterizedUtestShell(const char* groupName, const char* testName, TestCaseGenerator& generator) :
+    UtestShell(groupName, testName, "", 0), groupName_(groupName), testName_(testName), currentName_(testName), generator_(generator),
+    caseIndex_(0), caseName_(NULLPTR), caseNameCapacity_(0)
+{
+}
+
+ParameterizedUtestShell::~ParameterizedUtestShell()
+{
+    PlatformSpecificFree(caseName_);
+}
+
+bool ParameterizedUtestShell::shouldRun(const TestFilterMatcher& matcher) const
+{
+    return matcher.match(groupName_, currentName_, testName_);
+}
+
+bool ParameterizedUtestShell::firstCase()
+{
+    caseIndex_ = 0;
+    return selectCase(generator_.first());
+}
+
+bool ParameterizedUtestShell::nextCase()
+{
+    caseIndex_++;
+    return selectCase(generator_.next());
+}
+
+void ParameterizedUtestShell::runOneTest(TestPlugin* plugin, TestResult& result)
+{
+    const char* error = generator_.getCaseError();
+    if (error == NULLPTR) {
+        UtestShell::runOneTest(plugin, result);
+        return;
+    }
+
+    result.countRun();
+    result.addFailure(TestFailure(this, getFile().asCharString(), getLineNumber(), error));
+}
+
+size_t ParameterizedUtestShell::getCaseIndex() const
+{
+    return caseIndex_;
+}
+
+SimpleString ParameterizedUtestShell::getMacroName() const
+{
+    return "TEST_P";
+}
+
+bool ParameterizedUtestShell::selectCase(bool hasCase)
+{
+    currentName_ = testName_;
+    if (hasCase) {
+        char indexName[24];
+        const char* caseName = generator_.getCaseName();
+        if (caseName == NULLPTR) {
+            char* digit = indexName + sizeof(indexName) - 1;
+            *digit = '\0';
+            size_t index = caseIndex_;
+            do {
+                *--digit = (char) ('0' + index % 10);
+                index /= 10;
+            } while (index != 0);
+            caseName = digit;
+        }
+
+        size_t testNameLength = SimpleString::StrLen(testName_);
+        size_t caseNameLength = SimpleString::StrLen(caseName);
+        if (testNameLength + caseNameLength + 2 > caseNameCapacity_) {
+            caseNameCapacity_ = testNameLength + caseNameLength + 2 + 32;
+            caseName_ = (char*) PlatformSpecificRealloc(caseName_, caseNameCapacity_);
+        }
+        SimpleString::StrNCpy(caseName_, testName_, testNameLength);
+        caseName_[testNameLength] = '/';
+        SimpleString::StrNCpy(caseName_ + testNameLength + 1, caseName, caseNameLength + 1);
+        currentName_ = caseName_;
+    }
+    setTestName(currentName_);
+    return hasCase;
+}
+
+/////////////// TestGroupFixtureShell /////////////
+
+namespace
+{
+    class TestGroupFixtureTest : public Utest
+    {
+    public:
+        explicit TestGroupFixtureTest(void (*fixture)()) : fixture_(fixture)
+        {
+        }
+
+        void testBody() _override
+        {
+            fixture_();
+        }
+    private:
+        void (*fixture_)();
+    };
+}
+
+TestGroupFixtureShell::TestGroupFixtureShell(const char* groupName, const char* fixtureName, const char* fileName, size_t lineNumber, void (*fixture)(), bool runsBeforeGroup) :
+    UtestShell(groupName, fixtureName, fileName, lineNumber), fixture_(fixture), runsBeforeGroup_(runsBeforeGroup), nextFixture_(NULLPTR), scheduledTest_(NULLPTR), fixtureFailed_(false)
+{
+}
+
+TestGroupFixtureShell::~TestGroupFixtureShell()
+{
+}
+
+TestGroupFixtureShell* TestGroupFixtureShell::addFixture(TestGroupFixtureShell* fixture)
+{
+    nextFixture_ = fixture;
+    return this;
+}
+
+TestGroupFixtureShell* TestGroupFixtureShell::getNextFixture() const
+{
+    return nextFixture_;
+}
+
+bool TestGroupFixtureShell::runsBeforeGroup() const
+{
+    return runsBeforeGroup_;
+}
+
+void TestGroupFixtureShell::unschedule()
+{
+    scheduledTest_ = NULLPTR;
+    fixtureFailed_ = false;
+}
+
+void TestGroupFixtureShell::schedule(UtestShell* test)
+{
+    if (!runsBeforeGroup_ || scheduledTest_ == NULLPTR)
+        scheduledTest_ = test;
+}
+
+UtestShell* TestGroupFixtureShell::getScheduledTest() const
+{
+    return scheduledTest_;
+}
+
+void TestGroupFixtureShell::runFixture(TestResult& result)
+{
+    scheduledTest_ = NULLPTR;
+    size_t failureCount = result.getFailureCount();
+    runOneTestInCurrentProcess(NullTestPlugin::instance(), result);
+    fixtureFailed_ = result.getFailureCount() != failureCount;
+}
+
+bool TestGroupFixtureShell::fixtureFailed() const
+{
+    return fixtureFailed_;
+}
+
+Utest* TestGroupFixtureShell::createTest()
+{
+    return new TestGroupFixtureTest(fixture_);
+}
+
+SimpleString TestGroupFixtureShell::getMacroName() const
+{
+    return runsBeforeGroup_ ? "TEST_GROUP_SETUP_ONCE" : "TEST_GROUP_TEARDOWN_ONCE";
+}
+
 //////////////////// UtestShellPointerArray
 
 UtestShellPointerArray::UtestShellPointerArray(UtestShell* firstTest)
@@ -897,3 +1115,57 @@ void TestInstaller::unDo()
 {
     TestRegistry::getCurrentRegistry()->unDoLastAddTest();
 }
+
+////////////// TestTimeout ////////////
+
+TestTimeout::TestTimeout(const char* groupName, const char* testName, size_t timeoutInMillis) :
+    groupName_(groupName), testName_(testName), timeout_(timeoutInMillis), next_(NULLPTR)
+{
+}
+
+TestTimeout::~TestTimeout()
+{
+}
+
+TestTimeout* TestTimeout::addTimeout(TestTimeout* timeout)
+{
+    next_ = timeout;
+    return this;
+}
+
+TestTimeout* TestTimeout::getNext() const
+{
+    return next_;
+}
+
+bool TestTimeout::appliesTo(const UtestShell& test) const
+{
+    return test.getGroup() == groupName_ && test.getName() == testName_;
+}
+
+size_t TestTimeout::getTimeout() const
+{
+    return timeout_;
+}
+
+////////////// TestTimeoutInstaller ////////////
+
+TestTimeoutInstaller::TestTimeoutInstaller(TestTimeout& timeout)
+{
+    TestRegistry::getCurrentRegistry()->addTestTimeout(&timeout);
+}
+
+TestTimeoutInstaller::~TestTimeoutInstaller()
+{
+}
+
+////////////// TestGroupFixtureInstaller ////////////
+
+TestGroupFixtureInstaller::TestGroupFixtureInstaller(TestGroupFixtureShell& fixture)
+{
+    TestRegistry::getCurrentRegistry()->addGroupFixture(&fixture);
+}
+
+TestGroupFixtureInstaller::~TestGroupFixtureInstaller()
+{
+}
@@ -51,14 +51,32 @@ SimpleString MockCheckedActualCall::getName() const
 
 MockCheckedActualCall::MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& allExpectations)
     : callOrder_(callOrder), reporter_(reporter), state_(CALL_SUCCEED), expectationsChecked_(false), matchingExpectation_(NULLPTR),
-      allExpectations_(allExpectations), outputParameterExpectations_(NULLPTR)
+      allExpectations_(allExpectations), outputParameterExpectations_(NULLPTR),
+      expectedNextCall_(NULLPTR), otherCandidates_(NULLPTR), passedArguments_(NULLPTR), lastPassedArgument_(NULLPTR)
 {
     potentiallyMatchingExpectations_.addPotentiallyMatchingExpectations(allExpectations);
 }
 
+MockCheckedActualCall::MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& allExpectations, const MockExpectedCallsList& candidateExpectations)
+    : callOrder_(callOrder), reporter_(reporter), state_(CALL_SUCCEED), expectationsChecked_(false), matchingExpectation_(NULLPTR),
+      allExpectations_(allExpectations), outputParameterExpectations_(NULLPTR),
+      expectedNextCall_(NULLPTR), otherCandidates_(NULLPTR), passedArguments_(NULLPTR), lastPassedArgument_(NULLPTR)
+{
+    potentiallyMatchingExpectations_.addPotentiallyMatchingExpectations(candidateExpectations);
+}
+
+MockCheckedActualCall::MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& allExpectations, const MockExpectedCallsList& candidateExpectations, MockCheckedExpectedCall* expectedNextCall)
+    : callOrder_(callOrder), reporter_(reporter), state_(CALL_SUCCEED), expectationsChecked_(false), matchingExpectation_(NULLPTR),
+      allExpectations_(allExpectations), outputParameterExpectations_(NULLPTR),
+      expectedNextCall_(expectedNextCall), otherCandidates_(&candidateExpectations), passedArguments_(NULLPTR), lastPassedArgument_(NULLPTR)
+{
+    potentiallyMatchingExpectations_.addExpectedCall(expectedNextCall);
+}
+
 MockCheckedActualCall::~MockCheckedActualCall()
 {
     cleanUpOutputParameterList();
+    cleanUpPassedArgumentsList();
 }
 
 void MockCheckedActualCall::setMockFailureReporter(MockFailureReporter* reporter)
@@ -135,12 +153,51 @@ void MockCheckedActualCall::discardCurrentlyMatchingExpectations()
     potentiallyMatchingExpectations_.onlyKeepUnmatchingExpectations();
 }
 
+bool MockCheckedActualCall::matchAgainstAllCandidates()
+{
+    if (otherCandidates_ == NULLPTR) return false;
+
+    const MockExpectedCallsList& candidates = *otherCandidates_;
+    otherCandidates_ = NULLPTR;
+
+    discardCurrentlyMatchingExpectations();
+    potentiallyMatchingExpectations_.removeExpectedCall(expectedNextCall_);
+    expectedNextCall_->resetActualCallMatchingState();
+
+    setState(CALL_IN_PROGRESS);
+    potentiallyMatchingExpectations_.addPotentiallyMatchingExpectations(candidates);
+    completeCallWhenMatchIsFound();
+
+    for (MockPassedArgumentsListNode* p = passedArguments_; p && !hasFailed(); p = p->next_) {
+        switch (p->kind_) {
+        case INPUT_PARAMETER:
+            checkInputParameter(p->value_);
+            break;
+        case OUTPUT_PARAMETER:
+            checkOutputParameter(p->value_);
+            break;
+        case OBJECT:
+            onObject(p->objectPtr_);
+            break;
+        default:
+            break;
+        }
+    }
+    cleanUpPassedArgumentsList();
+    return true;
+}
+
 MockActualCall& MockCheckedActualCall::withName(const SimpleString& name)
+{
+    return withInternedName(name, NULLPTR);
+}
+
+MockActualCall& MockCheckedActualCall::withInternedName(const SimpleString& name, const char* internedName)
 {
     setName(name);
     setState(CALL_IN_PROGRESS);
 
-    potentiallyMatchingExpectations_.onlyKeepExpectationsRelatedTo(name);
+    potentiallyMatchingExpectations_.onlyKeepExpectationsRelatedTo(name, internedName);
     if (potentiallyMatchingExpectations_.isEmpty()) {
         MockUnexpectedCallHappenedFailure failure(getTest(), name, allExpectations_);
         failTest(failure);
@@ -164,12 +221,15 @@ void MockCheckedActualCall::checkInputParameter(const MockNamedValue& actualPara
         return;
     }
 
+    if (otherCandidates_) addPassedArgument(INPUT_PARAMETER, actualParameter, NULLPTR);
+
     setState(CALL_IN_PROGRESS);
     discardCurrentlyMatchingExpectations();
 
     potentiallyMatchingExpectations_.onlyKeepExpectationsWithInputParameter(actualParameter);
 
     if (potentiallyMatchingExpectations_.isEmpty()) {
+        if (matchAgainstAllCandidates()) return;
         MockUnexpectedInputParameterFailure failure(getTest(), getName(), actualParameter, allExpectations_);
         failTest(failure);
         return;
@@ -186,12 +246,15 @@ void MockCheckedActualCall::checkOutputParameter(const MockNamedValue& outputPar
         return;
     }
 
+    if (otherCandidates_) addPassedArgument(OUTPUT_PARAMETER, outputParameter, NULLPTR);
+
     setState(CALL_IN_PROGRESS);
     discardCurrentlyMatchingExpectations();
 
     potentiallyMatchingExpectations_.onlyKeepExpectationsWithOutputParameter(outputParameter);
 
     if (potentiallyMatchingExpectations_.isEmpty()) {
+        if (matchAgainstAllCandidates()) return;
         MockUnexpectedOutputParameterFailure failure(getTest(), getName(), outputParameter, allExpectations_);
         failTest(failure);
         return;
@@ -364,6 +427,16 @@ bool MockCheckedActualCall::isFulfilled() const
     return state_ == CALL_SUCCEED;
 }
 
+bool MockCheckedActualCall::wasMatchedByRangeOfCalls() const
+{
+    return isFulfilled() && matchingExpectation_ && matchingExpectation_->expectsRangeOfCalls();
+}
+
+MockCheckedExpectedCall* MockCheckedActualCall::getMatchingExpectation() const
+{
+    return (state_ == CALL_SUCCEED) ? matchingExpectation_ : NULLPTR;
+}
+
 bool MockCheckedActualCall::hasFailed() const
 {
     return state_ == CALL_FAILED;
@@ -397,6 +470,12 @@ void MockCheckedActualCall::checkExpectations()
         return;
     }
 
+    if (matchAgainstAllCandidates()) {
+        expectationsChecked_ = false;
+        checkExpectations();
+        return;
+    }
+
     if (potentiallyMatchingExpectations_.hasUnmatchingExpectationsBecauseOfMissingParameters()) {
         MockExpectedParameterDidntHappenFailure failure(getTest(), getName(), allExpectations_);
         failTest(failure);
@@ -620,9 +699,12 @@ MockActualCall& MockCheckedActualCall::onObject(const void* objectPtr)
     // Currently matching expectations are not discarded because the passed object
     // is ignored if not specifically set in the expectation
 
+    if (otherCandidates_) addPassedArgument(OBJECT, MockNamedValue(""), objectPtr);
+
     potentiallyMatchingExpectations_.onlyKeepExpectationsOnObject(objectPtr);
 
     if ((!matchingExpectation_) && potentiallyMatchingExpectations_.isEmpty()) {
+        if (matchAgainstAllCandidates()) return *this;
         MockUnexpectedObjectFailure failure(getTest(), getName(), objectPtr, allExpectations_);
         failTest(failure);
         return *this;
@@ -662,68 +744,325 @@ void MockCheckedActualCall::cleanUpOutputParameterList()
     }
 }
 
+void MockCheckedActualCall::addPassedArgument(PassedArgumentKind kind, const MockNamedValue& value, const void* objectPtr)
+{
+    MockPassedArgumentsListNode* newNode = new MockPassedArgumentsListNode(kind, value, objectPtr);
+
+    if (passedArguments_ == NULLPTR)
+        passedArguments_ = newNode;
+    else
+        lastPassedArgument_->next_ = newNode;
+    lastPassedArgument_ = newNode;
+}
+
+void MockCheckedActualCall::cleanUpPassedArgumentsList()
+{
+    while (passedArguments_) {
+        MockPassedArgumentsListNode* toBeDeleted = passedArguments_;
+        passedArguments_ = passedArguments_->next_;
+        delete toBeDeleted;
+    }
+    lastPassedArgument_ = NULLPTR;
+}
+
+
+enum MockTraceEventKind
+{
+    traceFunctionName,
+    traceCallOrder,
+    traceOnObject,
+    traceBoolParameter,
+    traceIntParameter,
+    traceUnsignedIntParameter,
+    traceLongIntParameter,
+    traceUnsignedLongIntParameter,
+    traceLongLongIntParameter,
+    traceUnsignedLongLongIntParameter,
+    traceDoubleParameter,
+    traceStringParameter,
+    tracePointerParameter,
+    traceFunctionPointerParameter,
+    traceMemoryBufferParameter,
+    traceParameterOfType
+};
+
+struct MockTraceEvent
+{
+    int kind_;
+    const char* name_;
+    const char* typeName_;
+    /* The copy of a string or memory buffer value, freed when the slot is reused */
+    char* ownedValue_;
+    union {
+        bool boolValue_;
+        int intValue_;
+        unsigned int unsignedIntValue_;
+        long int longIntValue_;
+        unsigned long int unsignedLongIntValue_;
+#ifdef CPPUTEST_USE_LONG_LONG
+        cpputest_longlong longLongIntValue_;
+        cpputest_ulonglong unsignedLongLongIntValue_;
+#endif
+        double doubleValue_;
+        const char* stringValue_;
+        const void* pointerValue_;
+        void (*functionPointerValue_)();
+    } value_;
+};
+
+static const size_t initialTraceEventCapacity = 64;
+static MockTraceEvent droppedTraceEvent;
 
 MockActualCallTrace::MockActualCallTrace()
+    : output_(NULLPTR), outputLength_(0), outputCapacity_(0), renderedEventCount_(0), outputIsRendered_(true), events_(NULLPTR), eventCapacity_(0), firstEvent_(0), eventCount_(0),
+      droppedEventCount_(0), maximumEvents_(0), overflowPolicy_(OVERWRITE_OLDEST)
 {
 }
 
 MockActualCallTrace::~MockActualCallTrace()
 {
+    releaseValues();
+    PlatformSpecificFree(events_);
+    PlatformSpecificFree(output_);
 }
 
-MockActualCall& MockActualCallTrace::withName(const SimpleString& name)
+void MockActualCallTrace::useRingBuffer(size_t maximumEvents, OverflowPolicy policy)
 {
-    traceBuffer_ += "\nFunction name:";
-    traceBuffer_ += name;
-    return *this;
+    clear();
+    PlatformSpecificFree(events_);
+    events_ = NULLPTR;
+    eventCapacity_ = 0;
+
+    maximumEvents_ = maximumEvents;
+    overflowPolicy_ = policy;
 }
 
-MockActualCall& MockActualCallTrace::withCallOrder(unsigned int callOrder)
+void MockActualCallTrace::growEvents()
+{
+    size_t newCapacity = (eventCapacity_ == 0) ? initialTraceEventCapacity : eventCapacity_ * 2;
+    if (maximumEvents_ != 0 && newCapacity > maximumEvents_) newCapacity = maximumEvents_;
+
+    /* The events only wrap around once a bounded buffer is full, so growing keeps their order */
+    events_ = (MockTraceEvent*) PlatformSpecificRealloc(events_, newCapacity * sizeof(MockTraceEvent));
+    if (events_ == NULLPTR) FAIL("MockActualCallTrace: out of memory");
+    for (size_t i = eventCapacity_; i < newCapacity; i++)
+        events_[i].ownedValue_ = NULLPTR;
+    eventCapacity_ = newCapacity;
+}
+
+void MockActualCallTrace::releaseValues()
 {
-    traceBuffer_ += " withCallOrder:";
-    traceBuffer_ += StringFrom(callOrder);
+    for (size_t i = 0; i < eventCapacity_; i++) {
+        PlatformSpecificFree(events_[i].ownedValue_);
+        events_[i].ownedValue_ = NULLPTR;
+    }
+}
+
+/* The value may be gone by the time the trace is rendered */
+void MockActualCallTrace::keepValue(MockTraceEvent* event, const char* value)
+{
+    event->value_.stringValue_ = NULLPTR;
+    if (value == NULLPTR || event == &droppedTraceEvent) return;
+
+    const size_t size = SimpleString::StrLen(value) + 1;
+    event->ownedValue_ = (char*) PlatformSpecificMalloc(size);
+    if (event->ownedValue_ == NULLPTR) FAIL("MockActualCallTrace: out of memory");
+    PlatformSpecificMemCpy(event->ownedValue_, value, size);
+    event->value_.stringValue_ = event->ownedValue_;
+}
+
+MockTraceEvent* MockActualCallTrace::addEvent(int kind, const SimpleString& name)
+{
+    return addEvent(kind, "", name);
+}
+
+MockTraceEvent* MockActualCallTrace::addEvent(int kind, const SimpleString& typeName, const SimpleString& name)
+{
+    outputIsRendered_ = false;
+
+    if (eventCount_ == eventCapacity_ && (maximumEvents_ == 0 || eventCapacity_ < maximumEvents_))
+        growEvents();
+
+    MockTraceEvent* event;
+    if (eventCount_ < eventCapacity_) {
+        event = &events_[(firstEvent_ + eventCount_) % eventCapacity_];
+        eventCount_++;
+    }
+    else if (overflowPolicy_ == OVERWRITE_OLDEST) {
+        event = &events_[firstEvent_];
+        firstEvent_ = (firstEvent_ + 1) % eventCapacity_;
+        droppedEventCount_++;
+    }
+    else {
+        droppedEventCount_++;
+        return &droppedTraceEvent;
+    }
+
+    PlatformSpecificFree(event->ownedValue_);
+    event->ownedValue_ = NULLPTR;
+    event->kind_ = kind;
+    event->name_ = name.isEmpty() ? "" : names_.intern(name);
+    event->typeName_ = typeName.isEmpty() ? "" : names_.intern(typeName);
+    return event;
+}
+
+void MockActualCallTrace::addToOutput(const char* text)
+{
+    const size_t length = SimpleString::StrLen(text);
+    if (outputLength_ + length + 1 > outputCapacity_) {
+        size_t newCapacity = (outputCapacity_ == 0) ? 256 : outputCapacity_ * 2;
+        while (outputLength_ + length + 1 > newCapacity) newCapacity *= 2;
+        output_ = (char*) PlatformSpecificRealloc(output_, newCapacity);
+        if (output_ == NULLPTR) FAIL("MockActualCallTrace: out of memory");
+        outputCapacity_ = newCapacity;
+    }
+    PlatformSpecificMemCpy(output_ + outputLength_, text, length + 1);
+    outputLength_ += length;
+}
+
+void MockActualCallTrace::addToOutput(const SimpleString& text)
+{
+    addToOutput(text.asCharString());
+}
+
+void MockActualCallTrace::clearOutput()
+{
+    outputLength_ = 0;
+    if (output_) output_[0] = '\0';
+    renderedEventCount_ = 0;
+}
+
+void MockActualCallTrace::renderDroppedEvents()
+{
+    addToOutput(StringFromFormat("\nTrace events dropped:%lu", (unsigned long) droppedEventCount_));
+}
+
+void MockActualCallTrace::addParameterName(const char* name)
+{
+    addToOutput(" ");
+    addToOutput(name);
+    addToOutput(":");
+}
+
+void MockActualCallTrace::renderEvent(const MockTraceEvent& event)
+{
+    switch ((MockTraceEventKind) event.kind_) {
+    case traceFunctionName:
+        addToOutput("\nFunction name:");
+        addToOutput(event.name_);
+        break;
+    case traceCallOrder:
+        addToOutput(" withCallOrder:");
+        addToOutput(StringFrom(event.value_.unsignedIntValue_));
+        break;
+    case traceOnObject:
+        addToOutput(" onObject:");
+        addToOutput(StringFrom(event.value_.pointerValue_));
+        break;
+    case traceBoolParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.boolValue_));
+        break;
+    case traceIntParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.intValue_) + " " + BracketsFormattedHexStringFrom(event.value_.intValue_));
+        break;
+    case traceUnsignedIntParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.unsignedIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.unsignedIntValue_));
+        break;
+    case traceLongIntParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.longIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.longIntValue_));
+        break;
+    case traceUnsignedLongIntParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.unsignedLongIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.unsignedLongIntValue_));
+        break;
+#ifdef CPPUTEST_USE_LONG_LONG
+    case traceLongLongIntParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.longLongIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.longLongIntValue_));
+        break;
+    case traceUnsignedLongLongIntParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.unsignedLongLongIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.unsignedLongLongIntValue_));
+        break;
+#else
+    case traceLongLongIntParameter:
+    case traceUnsignedLongLongIntParameter:
+        break;
+#endif
+    case traceDoubleParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.doubleValue_));
+        break;
+    case traceStringParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.stringValue_));
+        break;
+    case tracePointerParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.pointerValue_));
+        break;
+    case traceFunctionPointerParameter:
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.functionPointerValue_));
+        break;
+    case traceMemoryBufferParameter:
+        addParameterName(event.name_);
+        addToOutput(event.value_.stringValue_);
+        break;
+    case traceParameterOfType:
+        addToOutput(" ");
+        addToOutput(event.typeName_);
+        addParameterName(event.name_);
+        addToOutput(StringFrom(event.value_.pointerValue_));
+        break;
+    default:
+        break;
+    }
+}
+
+MockActualCall& MockActualCallTrace::withName(const SimpleString& name)
+{
+    addEvent(traceFunctionName, name);
     return *this;
 }
 
-void MockActualCallTrace::addParameterName(const SimpleString& name)
+MockActualCall& MockActualCallTrace::withCallOrder(unsigned int callOrder)
 {
-    traceBuffer_ += " ";
-    traceBuffer_ += name;
-    traceBuffer_ += ":";
+    addEvent(traceCallOrder, "")->value_.unsignedIntValue_ = callOrder;
+    return *this;
 }
 
 MockActualCall& MockActualCallTrace::withBoolParameter(const SimpleString& name, bool value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(traceBoolParameter, name)->value_.boolValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withUnsignedIntParameter(const SimpleString& name, unsigned int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addEvent(traceUnsignedIntParameter, name)->value_.unsignedIntValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withIntParameter(const SimpleString& name, int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addEvent(traceIntParameter, name)->value_.intValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withUnsignedLongIntParameter(const SimpleString& name, unsigned long int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addEvent(traceUnsignedLongIntParameter, name)->value_.unsignedLongIntValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withLongIntParameter(const SimpleString& name, long int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addEvent(traceLongIntParameter, name)->value_.longIntValue_ = value;
     return *this;
 }
 
@@ -731,15 +1070,13 @@ MockActualCall& MockActualCallTrace::withLongIntParameter(const SimpleString& na
 
 MockActualCall& MockActualCallTrace::withUnsignedLongLongIntParameter(const SimpleString& name, cpputest_ulonglong value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addEvent(traceUnsignedLongLongIntParameter, name)->value_.unsignedLongLongIntValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withLongLongIntParameter(const SimpleString& name, cpputest_longlong value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addEvent(traceLongLongIntParameter, name)->value_.longLongIntValue_ = value;
     return *this;
 }
 
@@ -761,68 +1098,55 @@ MockActualCall& MockActualCallTrace::withLongLongIntParameter(const SimpleString
 
 MockActualCall& MockActualCallTrace::withDoubleParameter(const SimpleString& name, double value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(traceDoubleParameter, name)->value_.doubleValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withStringParameter(const SimpleString& name, const char* value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    keepValue(addEvent(traceStringParameter, name), value);
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withPointerParameter(const SimpleString& name, void* value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(tracePointerParameter, name)->value_.pointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withConstPointerParameter(const SimpleString& name, const void* value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(tracePointerParameter, name)->value_.pointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withFunctionPointerParameter(const SimpleString& name, void (*value)())
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(traceFunctionPointerParameter, name)->value_.functionPointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFromBinaryWithSizeOrNull(value, size);
+    keepValue(addEvent(traceMemoryBufferParameter, name), StringFromBinaryWithSizeOrNull(value, size).asCharString());
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value)
 {
-    traceBuffer_ += " ";
-    traceBuffer_ += typeName;
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(traceParameterOfType, typeName, name)->value_.pointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withOutputParameter(const SimpleString& name, void* output)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(output);
+    addEvent(tracePointerParameter, name)->value_.pointerValue_ = output;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output)
 {
-    traceBuffer_ += " ";
-    traceBuffer_ += typeName;
-    addParameterName(name);
-    traceBuffer_ += StringFrom(output);
+    addEvent(traceParameterOfType, typeName, name)->value_.pointerValue_ = output;
     return *this;
 }
 
@@ -988,19 +1312,64 @@ unsigned int MockActualCallTrace::returnUnsignedIntValueOrDefault(unsigned int)
 
 MockActualCall& MockActualCallTrace::onObject(const void* objectPtr)
 {
-    traceBuffer_ += " onObject:";
-    traceBuffer_ += StringFrom(objectPtr);
+    addEvent(traceOnObject, "")->value_.pointerValue_ = objectPtr;
     return *this;
 }
 
 void MockActualCallTrace::clear()
 {
-    traceBuffer_ = "";
+    clearOutput();
+    outputIsRendered_ = true;
+    names_.clear();
+    releaseValues();
+    firstEvent_ = 0;
+    eventCount_ = 0;
+    droppedEventCount_ = 0;
+}
+
+size_t MockActualCallTrace::getEventCount() const
+{
+    return eventCount_;
+}
+
+size_t MockActualCallTrace::getDroppedEventCount() const
+{
+    return droppedEventCount_;
+}
+
+size_t MockActualCallTrace::getNameCount() const
+{
+    return names_.size();
 }
 
 const char* MockActualCallTrace::getTraceOutput()
 {
-    return traceBuffer_.asCharString();
+    if (outputIsRendered_) return (output_) ? output_ : "";
+
+    /* Without dropped events the earlier rendering stays valid and only new events are added */
+    size_t i = renderedEventCount_;
+    if (droppedEventCount_) {
+        clearOutput();
+        i = 0;
+    }
+
+    if (droppedEventCount_ && overflowPolicy_ == OVERWRITE_OLDEST) {
+        renderDroppedEvents();
+
+        /* A call whose first events were overwritten is left out as a whole */
+        while (i < eventCount_ && events_[(firstEvent_ + i) % eventCapacity_].kind_ != traceFunctionName)
+            i++;
+    }
+
+    for (; i < eventCount_; i++)
+        renderEvent(events_[(firstEvent_ + i) % eventCapacity_]);
+    renderedEventCount_ = eventCount_;
+
+    if (droppedEventCount_ && overflowPolicy_ == DROP_NEWEST)
+        renderDroppedEvents();
+
+    outputIsRendered_ = true;
+    return (output_) ? output_ : "";
 }
 
 MockActualCallTrace* MockActualCallTrace::instance_ = NULLPTR;
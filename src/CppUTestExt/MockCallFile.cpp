@@ -0,0 +1,674 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockCallFile.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+#ifdef CPPUTEST_USE_LONG_LONG
+typedef cpputest_ulonglong MockCallFileNumber;
+#else
+typedef unsigned long MockCallFileNumber;
+#endif
+
+static bool isEscaped(char c)
+{
+    return c == ' ' || c == '%' || c == ':' || c == '=' || c == '#' || (unsigned char) c < 0x20 || (unsigned char) c == 0x7f;
+}
+
+static int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static const char hexDigits[] = "0123456789abcdef";
+
+/* Not a valid escape, so no string is ever written like this */
+static const char nullStringToken[] = "%null";
+
+static double zero = 0.0;
+
+static bool decodeEscapes(char* text)
+{
+    char* out = text;
+    for (const char* in = text; *in; in++) {
+        if (*in == '%') {
+            int high = hexDigitValue(in[1]);
+            int low = (high < 0) ? -1 : hexDigitValue(in[2]);
+            if (low < 0) return false;
+            *out++ = (char) (high * 16 + low);
+            in += 2;
+        }
+        else
+            *out++ = *in;
+    }
+    *out = '\0';
+    return true;
+}
+
+static bool decodeHexBytes(char* text, size_t& size)
+{
+    size = 0;
+    for (const char* in = text; *in; in += 2) {
+        int high = hexDigitValue(in[0]);
+        int low = (high < 0) ? -1 : hexDigitValue(in[1]);
+        if (low < 0) return false;
+        text[size++] = (char) (high * 16 + low);
+    }
+    return true;
+}
+
+static bool parseUnsigned(const char* text, MockCallFileNumber& result)
+{
+    MockCallFileNumber base = 10;
+    if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        base = 16;
+        text += 2;
+    }
+    if (*text == '\0') return false;
+
+    result = 0;
+    for (; *text; text++) {
+        int digit = hexDigitValue(*text);
+        if (digit < 0 || (MockCallFileNumber) digit >= base) return false;
+        if (result > (((MockCallFileNumber) -1) - (MockCallFileNumber) digit) / base) return false;
+        result = result * base + (MockCallFileNumber) digit;
+    }
+    return true;
+}
+
+static bool parseSigned(const char* text, MockCallFileNumber& magnitude, bool& negative)
+{
+    negative = (*text == '-');
+    if (*text == '-' || *text == '+') text++;
+    return parseUnsigned(text, magnitude);
+}
+
+static bool fitsSigned(MockCallFileNumber magnitude, bool negative, MockCallFileNumber maximum)
+{
+    return (negative) ? magnitude <= maximum + 1 : magnitude <= maximum;
+}
+
+static bool parseDouble(const char* text, double& result)
+{
+    if (SimpleString::StrCmp(text, "nan") == 0) {
+        result = zero / zero;
+        return true;
+    }
+
+    bool negative = (*text == '-');
+    if (*text == '-' || *text == '+') text++;
+
+    if (SimpleString::StrCmp(text, "inf") == 0) {
+        result = (negative) ? -1.0 / zero : 1.0 / zero;
+        return true;
+    }
+
+    double value = 0.0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for (; *text >= '0' && *text <= '9'; text++, hasDigits = true)
+        value = value * 10.0 + (*text - '0');
+    if (*text == '.')
+        for (text++; *text >= '0' && *text <= '9'; text++, hasDigits = true, exponent--)
+            value = value * 10.0 + (*text - '0');
+    if (!hasDigits) return false;
+
+    if (*text == 'e' || *text == 'E') {
+        MockCallFileNumber magnitude;
+        bool negativeExponent;
+        if (!parseSigned(text + 1, magnitude, negativeExponent) || magnitude > 1000) return false;
+        exponent += (negativeExponent) ? -(int) magnitude : (int) magnitude;
+        while (*text) text++;
+    }
+    if (*text) return false;
+
+    double scale = 1.0;
+    for (int i = (exponent < 0) ? -exponent : exponent; i > 0; i--)
+        scale *= 10.0;
+    value = (exponent < 0) ? value / scale : value * scale;
+    result = (negative) ? -value : value;
+    return true;
+}
+
+static SimpleString formatDouble(double value)
+{
+    if (PlatformSpecificIsNan(value)) return "nan";
+    if (PlatformSpecificIsInf(value)) return (value < 0) ? "-inf" : "inf";
+    return StringFrom(value, 17);
+}
+
+static bool parseBool(const char* text, bool& result)
+{
+    if (SimpleString::StrCmp(text, "true") == 0 || SimpleString::StrCmp(text, "1") == 0) result = true;
+    else if (SimpleString::StrCmp(text, "false") == 0 || SimpleString::StrCmp(text, "0") == 0) result = false;
+    else return false;
+    return true;
+}
+
+MockCallFileReader::MockCallFileReader(const SimpleString& fileName)
+    : fileName_(fileName), chunkPosition_(0), chunkSize_(0), lineNumber_(0), callLineNumber_(0), currentLine_(0), fields_(NULLPTR), fieldsEnd_(NULLPTR)
+{
+    file_ = PlatformSpecificFOpen(fileName.asCharString(), "rb");
+    lines_[0] = lines_[1] = NULLPTR;
+    lineCapacities_[0] = lineCapacities_[1] = 0;
+}
+
+MockCallFileReader::~MockCallFileReader()
+{
+    if (file_) PlatformSpecificFClose(file_);
+    PlatformSpecificFree(lines_[0]);
+    PlatformSpecificFree(lines_[1]);
+}
+
+bool MockCallFileReader::isOpen() const
+{
+    return file_ != NULLPTR;
+}
+
+const SimpleString& MockCallFileReader::getFileName() const
+{
+    return fileName_;
+}
+
+size_t MockCallFileReader::getLineNumber() const
+{
+    return callLineNumber_;
+}
+
+const SimpleString& MockCallFileReader::getError() const
+{
+    return error_;
+}
+
+bool MockCallFileReader::fillChunk()
+{
+    if (chunkPosition_ < chunkSize_) return true;
+    if (file_ == NULLPTR) return false;
+
+    chunkSize_ = PlatformSpecificFRead(chunk_, CHUNK_SIZE, file_);
+    chunkPosition_ = 0;
+    return chunkSize_ != 0;
+}
+
+void MockCallFileReader::skipLine()
+{
+    while (fillChunk())
+        if (chunk_[chunkPosition_++] == '\n') {
+            lineNumber_++;
+            return;
+        }
+}
+
+bool MockCallFileReader::hasMoreCalls()
+{
+    while (fillChunk()) {
+        char c = chunk_[chunkPosition_];
+        if (c == '#') {
+            skipLine();
+            continue;
+        }
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') return true;
+        if (c == '\n') lineNumber_++;
+        chunkPosition_++;
+    }
+    return false;
+}
+
+void MockCallFileReader::addToLine(size_t line, size_t length, char c)
+{
+    if (length == lineCapacities_[line]) {
+        lineCapacities_[line] = (length == 0) ? 128 : 2 * length;
+        lines_[line] = (char*) PlatformSpecificRealloc(lines_[line], lineCapacities_[line]);
+        if (lines_[line] == NULLPTR) FAIL("MockCallFileReader: out of memory"); // LCOV_EXCL_LINE
+    }
+    lines_[line][length] = c;
+}
+
+bool MockCallFileReader::readNextCall()
+{
+    if (!hasMoreCalls()) return false;
+
+    /* The previous line stays intact, as its expectation can still refer to it */
+    currentLine_ = 1 - currentLine_;
+    callLineNumber_ = lineNumber_ + 1;
+
+    size_t length = 0;
+    while (fillChunk()) {
+        char c = chunk_[chunkPosition_++];
+        if (c == '\n') break;
+        if (c != '\r') addToLine(currentLine_, length++, c);
+    }
+    while (length > 0 && (lines_[currentLine_][length - 1] == ' ' || lines_[currentLine_][length - 1] == '\t'))
+        length--;
+    addToLine(currentLine_, length, '\0');
+    lineNumber_ = callLineNumber_;
+
+    char* line = lines_[currentLine_];
+    fieldsEnd_ = line + length;
+    for (fields_ = line; *fields_ && *fields_ != ' '; fields_++)
+        ;
+    if (fields_ < fieldsEnd_) *fields_++ = '\0';
+
+    if (!decodeEscapes(line)) return fail("invalid escape in function name");
+    return true;
+}
+
+const char* MockCallFileReader::getFunctionName() const
+{
+    return lines_[currentLine_];
+}
+
+bool MockCallFileReader::applyTo(MockExpectedCall& call)
+{
+    char* field = fields_;
+    while (field < fieldsEnd_) {
+        char* next = field;
+        while (*next && *next != ' ') next++;
+        if (next < fieldsEnd_) *next++ = '\0';
+
+        if (*field && !applyField(call, field)) return false;
+        field = next;
+    }
+    fields_ = fieldsEnd_;
+    return true;
+}
+
+bool MockCallFileReader::applyField(MockExpectedCall& call, char* field)
+{
+    if (SimpleString::StrCmp(field, "...") == 0) {
+        call.ignoreOtherParameters();
+        return true;
+    }
+
+    char* name = field;
+    while (*name && *name != ':') name++;
+    if (*name == '\0') return fail(StringFromFormat("field without a type: %s", field));
+    *name++ = '\0';
+
+    char* value = name;
+    while (*value && *value != '=') value++;
+    if (*value) *value++ = '\0';
+    else value = NULLPTR;
+
+    if (SimpleString::StrCmp(field, "return") == 0) {
+        if (value == NULLPTR) return fail("return value without a value");
+        return applyReturnValue(call, name, value);
+    }
+
+    if (!decodeEscapes(name)) return fail("invalid escape in parameter name");
+    if (SimpleString::StrCmp(field, "out") == 0)
+        return applyOutputParameter(call, name, value);
+
+    if (value == NULLPTR) return fail(StringFromFormat("parameter without a value: %s", name));
+    return applyParameter(call, field, name, value);
+}
+
+bool MockCallFileReader::applyParameter(MockExpectedCall& call, const char* type, const char* name, char* value)
+{
+    MockCallFileNumber number = 0;
+    bool negative = false;
+
+    if (SimpleString::StrCmp(type, "bool") == 0) {
+        bool boolValue;
+        if (!parseBool(value, boolValue)) return fail(StringFromFormat("invalid bool: %s", value));
+        call.withBoolParameter(name, boolValue);
+    }
+    else if (SimpleString::StrCmp(type, "int") == 0) {
+        if (!parseSigned(value, number, negative) || !fitsSigned(number, negative, ((unsigned int) -1) >> 1)) return fail(StringFromFormat("invalid int: %s", value));
+        call.withIntParameter(name, (negative) ? -(int) (number - 1) - 1 : (int) number);
+    }
+    else if (SimpleString::StrCmp(type, "uint") == 0) {
+        if (!parseUnsigned(value, number) || number > (unsigned int) -1) return fail(StringFromFormat("invalid unsigned int: %s", value));
+        call.withUnsignedIntParameter(name, (unsigned int) number);
+    }
+    else if (SimpleString::StrCmp(type, "long") == 0) {
+        if (!parseSigned(value, number, negative) || !fitsSigned(number, negative, ((unsigned long) -1) >> 1)) return fail(StringFromFormat("invalid long: %s", value));
+        call.withLongIntParameter(name, (negative) ? -(long) (number - 1) - 1 : (long) number);
+    }
+    else if (SimpleString::StrCmp(type, "ulong") == 0) {
+        if (!parseUnsigned(value, number) || number > (unsigned long) -1) return fail(StringFromFormat("invalid unsigned long: %s", value));
+        call.withUnsignedLongIntParameter(name, (unsigned long) number);
+    }
+#ifdef CPPUTEST_USE_LONG_LONG
+    else if (SimpleString::StrCmp(type, "llong") == 0) {
+        if (!parseSigned(value, number, negative) || !fitsSigned(number, negative, ((cpputest_ulonglong) -1) >> 1)) return fail(StringFromFormat("invalid long long: %s", value));
+        call.withLongLongIntParameter(name, (negative) ? -(cpputest_longlong) (number - 1) - 1 : (cpputest_longlong) number);
+    }
+    else if (SimpleString::StrCmp(type, "ullong") == 0) {
+        if (!parseUnsigned(value, number)) return fail(StringFromFormat("invalid unsigned long long: %s", value));
+        call.withUnsignedLongLongIntParameter(name, number);
+    }
+#endif
+    else if (SimpleString::StrCmp(type, "double") == 0) {
+        double doubleValue;
+        if (!parseDouble(value, doubleValue)) return fail(StringFromFormat("invalid double: %s", value));
+        call.withDoubleParameter(name, doubleValue);
+    }
+    else if (SimpleString::StrCmp(type, "string") == 0) {
+        if (SimpleString::StrCmp(value, nullStringToken) == 0) call.withStringParameter(name, NULLPTR);
+        else if (!decodeEscapes(value)) return fail(StringFromFormat("invalid escape in string parameter: %s", name));
+        else call.withStringParameter(name, value);
+    }
+    else if (SimpleString::StrCmp(type, "buffer") == 0) {
+        size_t size;
+        if (!decodeHexBytes(value, size)) return fail(StringFromFormat("invalid buffer: %s", name));
+        call.withMemoryBufferParameter(name, (const unsigned char*) value, size);
+    }
+    else if (SimpleString::StrCmp(type, "pointer") == 0 || SimpleString::StrCmp(type, "cpointer") == 0 || SimpleString::StrCmp(type, "fpointer") == 0) {
+        if (!parseUnsigned(value, number)) return fail(StringFromFormat("invalid pointer: %s", value));
+        if (type[0] == 'p') call.withPointerParameter(name, (void*) (size_t) number);
+        else if (type[0] == 'c') call.withConstPointerParameter(name, (const void*) (size_t) number);
+        else call.withFunctionPointerParameter(name, (void (*)()) (size_t) number);
+    }
+    else
+        return fail(StringFromFormat("unknown parameter type: %s", type));
+    return true;
+}
+
+bool MockCallFileReader::applyReturnValue(MockExpectedCall& call, const char* type, char* value)
+{
+    MockCallFileNumber number = 0;
+    bool negative = false;
+
+    if (SimpleString::StrCmp(type, "bool") == 0) {
+        bool boolValue;
+        if (!parseBool(value, boolValue)) return fail(StringFromFormat("invalid bool: %s", value));
+        call.andReturnValue(boolValue);
+    }
+    else if (SimpleString::StrCmp(type, "int") == 0) {
+        if (!parseSigned(value, number, negative) || !fitsSigned(number, negative, ((unsigned int) -1) >> 1)) return fail(StringFromFormat("invalid int: %s", value));
+        call.andReturnValue((negative) ? -(int) (number - 1) - 1 : (int) number);
+    }
+    else if (SimpleString::StrCmp(type, "uint") == 0) {
+        if (!parseUnsigned(value, number) || number > (unsigned int) -1) return fail(StringFromFormat("invalid unsigned int: %s", value));
+        call.andReturnValue((unsigned int) number);
+    }
+    else if (SimpleString::StrCmp(type, "long") == 0) {
+        if (!parseSigned(value, number, negative) || !fitsSigned(number, negative, ((unsigned long) -1) >> 1)) return fail(StringFromFormat("invalid long: %s", value));
+        call.andReturnValue((negative) ? -(long) (number - 1) - 1 : (long) number);
+    }
+    else if (SimpleString::StrCmp(type, "ulong") == 0) {
+        if (!parseUnsigned(value, number) || number > (unsigned long) -1) return fail(StringFromFormat("invalid unsigned long: %s", value));
+        call.andReturnValue((unsigned long) number);
+    }
+#ifdef CPPUTEST_USE_LONG_LONG
+    else if (SimpleString::StrCmp(type, "llong") == 0) {
+        if (!parseSigned(value, number, negative) || !fitsSigned(number, negative, ((cpputest_ulonglong) -1) >> 1)) return fail(StringFromFormat("invalid long long: %s", value));
+        call.andReturnValue((negative) ? -(cpputest_longlong) (number - 1) - 1 : (cpputest_longlong) number);
+    }
+    else if (SimpleString::StrCmp(type, "ullong") == 0) {
+        if (!parseUnsigned(value, number)) return fail(StringFromFormat("invalid unsigned long long: %s", value));
+        call.andReturnValue(number);
+    }
+#endif
+    else if (SimpleString::StrCmp(type, "double") == 0) {
+        double doubleValue;
+        if (!parseDouble(value, doubleValue)) return fail(StringFromFormat("invalid double: %s", value));
+        call.andReturnValue(doubleValue);
+    }
+    else if (SimpleString::StrCmp(type, "string") == 0) {
+        if (SimpleString::StrCmp(value, nullStringToken) == 0) call.andReturnValue((const char*) NULLPTR);
+        else if (!decodeEscapes(value)) return fail("invalid escape in string return value");
+        else call.andReturnValue((const char*) value);
+    }
+    else if (SimpleString::StrCmp(type, "pointer") == 0 || SimpleString::StrCmp(type, "cpointer") == 0 || SimpleString::StrCmp(type, "fpointer") == 0) {
+        if (!parseUnsigned(value, number)) return fail(StringFromFormat("invalid pointer: %s", value));
+        if (type[0] == 'p') call.andReturnValue((void*) (size_t) number);
+        else if (type[0] == 'c') call.andReturnValue((const void*) (size_t) number);
+        else call.andReturnValue((void (*)()) (size_t) number);
+    }
+    else
+        return fail(StringFromFormat("unknown return value type: %s", type));
+    return true;
+}
+
+bool MockCallFileReader::applyOutputParameter(MockExpectedCall& call, const char* name, char* value)
+{
+    if (value == NULLPTR) {
+        call.withUnmodifiedOutputParameter(name);
+        return true;
+    }
+
+    size_t size;
+    if (!decodeHexBytes(value, size)) return fail(StringFromFormat("invalid output parameter: %s", name));
+    call.withOutputParameterReturning(name, value, size);
+    return true;
+}
+
+bool MockCallFileReader::fail(const SimpleString& error)
+{
+    error_ = error;
+    return false;
+}
+
+MockCallFileWriter::MockCallFileWriter(const SimpleString& fileName)
+    : fileName_(fileName), inCall_(false), ignoresOtherParameters_(false)
+{
+    file_ = PlatformSpecificFOpen(fileName.asCharString(), "w");
+}
+
+MockCallFileWriter::~MockCallFileWriter()
+{
+    close();
+}
+
+bool MockCallFileWriter::isOpen() const
+{
+    return file_ != NULLPTR;
+}
+
+const SimpleString& MockCallFileWriter::getFileName() const
+{
+    return fileName_;
+}
+
+SimpleString MockCallFileWriter::escape(const char* text)
+{
+    if (text == NULLPTR) return "";
+
+    size_t size = 3 * SimpleString::StrLen(text) + 1;
+    char* buffer = SimpleString::allocStringBuffer(size, __FILE__, __LINE__);
+    char* out = buffer;
+    for (; *text; text++) {
+        if (isEscaped(*text)) {
+            *out++ = '%';
+            *out++ = hexDigits[((unsigned char) *text) >> 4];
+            *out++ = hexDigits[((unsigned char) *text) & 0xf];
+        }
+        else
+            *out++ = *text;
+    }
+    *out = '\0';
+
+    SimpleString result(buffer);
+    SimpleString::deallocStringBuffer(buffer, size, __FILE__, __LINE__);
+    return result;
+}
+
+SimpleString MockCallFileWriter::hexBytes(const unsigned char* bytes, size_t size)
+{
+    size_t bufferSize = 2 * size + 1;
+    char* buffer = SimpleString::allocStringBuffer(bufferSize, __FILE__, __LINE__);
+    for (size_t i = 0; i < size; i++) {
+        buffer[2 * i] = hexDigits[bytes[i] >> 4];
+        buffer[2 * i + 1] = hexDigits[bytes[i] & 0xf];
+    }
+    buffer[2 * size] = '\0';
+
+    SimpleString result(buffer);
+    SimpleString::deallocStringBuffer(buffer, bufferSize, __FILE__, __LINE__);
+    return result;
+}
+
+void MockCallFileWriter::finishCall()
+{
+    if (!inCall_) return;
+
+    /* Parameters of custom types cannot be written, so the call ignores them when read back */
+    if (ignoresOtherParameters_) PlatformSpecificFPuts(" ...", file_);
+    PlatformSpecificFPuts("\n", file_);
+    inCall_ = false;
+}
+
+MockActualCall& MockCallFileWriter::startCall(const SimpleString& functionName)
+{
+    if (file_ == NULLPTR) return *this;
+
+    finishCall();
+    PlatformSpecificFPuts(escape(functionName.asCharString()).asCharString(), file_);
+    inCall_ = true;
+    ignoresOtherParameters_ = false;
+    return *this;
+}
+
+void MockCallFileWriter::close()
+{
+    if (file_ == NULLPTR) return;
+
+    finishCall();
+    PlatformSpecificFClose(file_);
+    file_ = NULLPTR;
+}
+
+void MockCallFileWriter::writeField(const char* type, const SimpleString& name, const SimpleString& value)
+{
+    if (!inCall_) return;
+
+    SimpleString field(" ");
+    field += type;
+    field += ":";
+    field += escape(name.asCharString());
+    field += "=";
+    field += value;
+    PlatformSpecificFPuts(field.asCharString(), file_);
+}
+
+MockActualCall& MockCallFileWriter::withName(const SimpleString& name)
+{
+    return startCall(name);
+}
+
+MockActualCall& MockCallFileWriter::withBoolParameter(const SimpleString& name, bool value)
+{
+    writeField("bool", name, (value) ? "true" : "false");
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withIntParameter(const SimpleString& name, int value)
+{
+    writeField("int", name, StringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withUnsignedIntParameter(const SimpleString& name, unsigned int value)
+{
+    writeField("uint", name, StringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withLongIntParameter(const SimpleString& name, long int value)
+{
+    writeField("long", name, StringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withUnsignedLongIntParameter(const SimpleString& name, unsigned long int value)
+{
+    writeField("ulong", name, StringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withLongLongIntParameter(const SimpleString& name, cpputest_longlong value)
+{
+    writeField("llong", name, StringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withUnsignedLongLongIntParameter(const SimpleString& name, cpputest_ulonglong value)
+{
+    writeField("ullong", name, StringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withDoubleParameter(const SimpleString& name, double value)
+{
+    writeField("double", name, formatDouble(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withStringParameter(const SimpleString& name, const char* value)
+{
+    writeField("string", name, (value) ? escape(value) : SimpleString(nullStringToken));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withPointerParameter(const SimpleString& name, void* value)
+{
+    writeField("pointer", name, SimpleString("0x") + HexStringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withConstPointerParameter(const SimpleString& name, const void* value)
+{
+    writeField("cpointer", name, SimpleString("0x") + HexStringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withFunctionPointerParameter(const SimpleString& name, void (*value)())
+{
+    writeField("fpointer", name, SimpleString("0x") + HexStringFrom(value));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size)
+{
+    writeField("buffer", name, hexBytes(value, size));
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withParameterOfType(const SimpleString&, const SimpleString&, const void*)
+{
+    ignoresOtherParameters_ = true;
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withOutputParameter(const SimpleString& name, void*)
+{
+    if (inCall_) PlatformSpecificFPuts((SimpleString(" out:") + escape(name.asCharString())).asCharString(), file_);
+    return *this;
+}
+
+MockActualCall& MockCallFileWriter::withOutputParameterOfType(const SimpleString&, const SimpleString&, void*)
+{
+    ignoresOtherParameters_ = true;
+    return *this;
+}
@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockConcurrentCallLog.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/TestMemoryAllocator.h"
+
+#undef new
+
+void* MockRecordingObject::operator new(size_t size)
+{
+    void* memory = PlatformSpecificMalloc(size);
+    if (memory == NULLPTR) FAIL("MockConcurrentCallLog: out of memory");
+    return memory;
+}
+
+void* MockRecordingObject::operator new(size_t size, const char*, size_t)
+{
+    return operator new(size);
+}
+
+void MockRecordingObject::operator delete(void* memory)
+{
+    PlatformSpecificFree(memory);
+}
+
+void MockRecordingObject::operator delete(void* memory, const char*, size_t)
+{
+    PlatformSpecificFree(memory);
+}
+
+enum MockRecordedParameterKind
+{
+    recordedCallOrder,
+    recordedOnObject,
+    recordedBoolParameter,
+    recordedIntParameter,
+    recordedUnsignedIntParameter,
+    recordedLongIntParameter,
+    recordedUnsignedLongIntParameter,
+    recordedLongLongIntParameter,
+    recordedUnsignedLongLongIntParameter,
+    recordedDoubleParameter,
+    recordedStringParameter,
+    recordedPointerParameter,
+    recordedConstPointerParameter,
+    recordedFunctionPointerParameter,
+    recordedMemoryBufferParameter,
+    recordedParameterOfType,
+    recordedOutputParameter,
+    recordedOutputParameterOfType
+};
+
+struct MockRecordedParameter : public MockRecordingObject
+{
+    MockRecordedParameter(int kind, const SimpleString& name) : kind_(kind), name_(name), buffer_(NULLPTR), size_(0), next_(NULLPTR) {}
+    ~MockRecordedParameter()
+    {
+        if (buffer_) SimpleString::deallocStringBuffer(buffer_, size_, __FILE__, __LINE__);
+    }
+
+    int kind_;
+    SimpleString name_;
+    SimpleString typeName_;
+    SimpleString string_;
+    char* buffer_;
+    size_t size_;
+    union {
+        bool boolValue_;
+        int intValue_;
+        unsigned int unsignedIntValue_;
+        long int longIntValue_;
+        unsigned long int unsignedLongIntValue_;
+#ifdef CPPUTEST_USE_LONG_LONG
+        cpputest_longlong longLongIntValue_;
+        cpputest_ulonglong unsignedLongLongIntValue_;
+#endif
+        double doubleValue_;
+        void* pointerValue_;
+        const void* constPointerValue_;
+        void (*functionPointerValue_)();
+    } value_;
+    MockRecordedParameter* next_;
+};
+
+MockRecordedActualCall::MockRecordedActualCall(MockSupport& support, const SimpleString& functionName, unsigned int threadIndex, unsigned int threadSequence)
+    : support_(support), functionName_(functionName), threadIndex_(threadIndex), threadSequence_(threadSequence),
+      parameters_(NULLPTR), lastParameter_(NULLPTR), next_(NULLPTR)
+{
+}
+
+MockRecordedActualCall::~MockRecordedActualCall()
+{
+    while (parameters_) {
+        MockRecordedParameter* next = parameters_->next_;
+        delete parameters_;
+        parameters_ = next;
+    }
+}
+
+MockRecordedParameter* MockRecordedActualCall::addParameter(int kind, const SimpleString& name)
+{
+    MockRecordedParameter* parameter = new MockRecordedParameter(kind, name);
+    if (lastParameter_) lastParameter_->next_ = parameter;
+    else parameters_ = parameter;
+    lastParameter_ = parameter;
+    return parameter;
+}
+
+MockActualCall& MockRecordedActualCall::withCallOrder(unsigned int callOrder)
+{
+    addParameter(recordedCallOrder, "")->value_.unsignedIntValue_ = callOrder;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withBoolParameter(const SimpleString& name, bool value)
+{
+    addParameter(recordedBoolParameter, name)->value_.boolValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withIntParameter(const SimpleString& name, int value)
+{
+    addParameter(recordedIntParameter, name)->value_.intValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withUnsignedIntParameter(const SimpleString& name, unsigned int value)
+{
+    addParameter(recordedUnsignedIntParameter, name)->value_.unsignedIntValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withLongIntParameter(const SimpleString& name, long int value)
+{
+    addParameter(recordedLongIntParameter, name)->value_.longIntValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withUnsignedLongIntParameter(const SimpleString& name, unsigned long int value)
+{
+    addParameter(recordedUnsignedLongIntParameter, name)->value_.unsignedLongIntValue_ = value;
+    return *this;
+}
+
+#ifdef CPPUTEST_USE_LONG_LONG
+
+MockActualCall& MockRecordedActualCall::withLongLongIntParameter(const SimpleString& name, cpputest_longlong value)
+{
+    addParameter(recordedLongLongIntParameter, name)->value_.longLongIntValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withUnsignedLongLongIntParameter(const SimpleString& name, cpputest_ulonglong value)
+{
+    addParameter(recordedUnsignedLongLongIntParameter, name)->value_.unsignedLongLongIntValue_ = value;
+    return *this;
+}
+
+#else
+
+MockActualCall& MockRecordedActualCall::withLongLongIntParameter(const SimpleString&, cpputest_longlong)
+{
+    FAIL("Long Long type is not supported");
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withUnsignedLongLongIntParameter(const SimpleString&, cpputest_ulonglong)
+{
+    FAIL("Unsigned Long Long type is not supported");
+    return *this;
+}
+
+#endif
+
+MockActualCall& MockRecordedActualCall::withDoubleParameter(const SimpleString& name, double value)
+{
+    addParameter(recordedDoubleParameter, name)->value_.doubleValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withStringParameter(const SimpleString& name, const char* value)
+{
+    MockRecordedParameter* parameter = addParameter(recordedStringParameter, name);
+    parameter->value_.constPointerValue_ = value;
+    if (value) parameter->string_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withPointerParameter(const SimpleString& name, void* value)
+{
+    addParameter(recordedPointerParameter, name)->value_.pointerValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withConstPointerParameter(const SimpleString& name, const void* value)
+{
+    addParameter(recordedConstPointerParameter, name)->value_.constPointerValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withFunctionPointerParameter(const SimpleString& name, void (*value)())
+{
+    addParameter(recordedFunctionPointerParameter, name)->value_.functionPointerValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size)
+{
+    MockRecordedParameter* parameter = addParameter(recordedMemoryBufferParameter, name);
+    parameter->value_.constPointerValue_ = value;
+    parameter->size_ = size;
+    if (value && size) {
+        parameter->buffer_ = SimpleString::allocStringBuffer(size, __FILE__, __LINE__);
+        PlatformSpecificMemCpy(parameter->buffer_, value, size);
+    }
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value)
+{
+    MockRecordedParameter* parameter = addParameter(recordedParameterOfType, name);
+    parameter->typeName_ = typeName;
+    parameter->value_.constPointerValue_ = value;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withOutputParameter(const SimpleString& name, void* output)
+{
+    addParameter(recordedOutputParameter, name)->value_.pointerValue_ = output;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output)
+{
+    MockRecordedParameter* parameter = addParameter(recordedOutputParameterOfType, name);
+    parameter->typeName_ = typeName;
+    parameter->value_.pointerValue_ = output;
+    return *this;
+}
+
+MockActualCall& MockRecordedActualCall::onObject(const void* objectPtr)
+{
+    addParameter(recordedOnObject, "")->value_.constPointerValue_ = objectPtr;
+    return *this;
+}
+
+void MockRecordedActualCall::replayOn(MockActualCall& call) const
+{
+    for (MockRecordedParameter* p = parameters_; p; p = p->next_) {
+        switch ((MockRecordedParameterKind) p->kind_) {
+        case recordedCallOrder:
+            call.withCallOrder(p->value_.unsignedIntValue_);
+            break;
+        case recordedOnObject:
+            call.onObject(p->value_.constPointerValue_);
+            break;
+        case recordedBoolParameter:
+            call.withBoolParameter(p->name_, p->value_.boolValue_);
+            break;
+        case recordedIntParameter:
+            call.withIntParameter(p->name_, p->value_.intValue_);
+            break;
+        case recordedUnsignedIntParameter:
+            call.withUnsignedIntParameter(p->name_, p->value_.unsignedIntValue_);
+            break;
+        case recordedLongIntParameter:
+            call.withLongIntParameter(p->name_, p->value_.longIntValue_);
+            break;
+        case recordedUnsignedLongIntParameter:
+            call.withUnsignedLongIntParameter(p->name_, p->value_.unsignedLongIntValue_);
+            break;
+#ifdef CPPUTEST_USE_LONG_LONG
+        case recordedLongLongIntParameter:
+            call.withLongLongIntParameter(p->name_, p->value_.longLongIntValue_);
+            break;
+        case recordedUnsignedLongLongIntParameter:
+            call.withUnsignedLongLongIntParameter(p->name_, p->value_.unsignedLongLongIntValue_);
+            break;
+#else
+        case recordedLongLongIntParameter:
+        case recordedUnsignedLongLongIntParameter:
+            break;
+#endif
+        case recordedDoubleParameter:
+            call.withDoubleParameter(p->name_, p->value_.doubleValue_);
+            break;
+        case recordedStringParameter:
+            call.withStringParameter(p->name_, (p->value_.constPointerValue_) ? p->string_.asCharString() : NULLPTR);
+            break;
+        case recordedPointerParameter:
+            call.withPointerParameter(p->name_, p->value_.pointerValue_);
+            break;
+        case recordedConstPointerParameter:
+            call.withConstPointerParameter(p->name_, p->value_.constPointerValue_);
+            break;
+        case recordedFunctionPointerParameter:
+            call.withFunctionPointerParameter(p->name_, p->value_.functionPointerValue_);
+            break;
+        case recordedMemoryBufferParameter:
+            call.withMemoryBufferParameter(p->name_, (p->buffer_) ? (const unsigned char*) p->buffer_ : (const unsigned char*) p->value_.constPointerValue_, p->size_);
+            break;
+        case recordedParameterOfType:
+            call.withParameterOfType(p->typeName_, p->name_, p->value_.constPointerValue_);
+            break;
+        case recordedOutputParameter:
+            call.withOutputParameter(p->name_, p->value_.pointerValue_);
+            break;
+        case recordedOutputParameterOfType:
+            call.withOutputParameterOfType(p->typeName_, p->name_, p->value_.pointerValue_);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+MockSupport& MockRecordedActualCall::getSupport() const
+{
+    return support_;
+}
+
+const SimpleString& MockRecordedActualCall::getFunctionName() const
+{
+    return functionName_;
+}
+
+unsigned int MockRecordedActualCall::getThreadIndex() const
+{
+    return threadIndex_;
+}
+
+unsigned int MockRecordedActualCall::getThreadSequence() const
+{
+    return threadSequence_;
+}
+
+MockRecordedActualCall* MockRecordedActualCall::getNext() const
+{
+    return next_;
+}
+
+struct MockConcurrentThread : public MockRecordingObject
+{
+    MockConcurrentThread(unsigned long threadId, unsigned int index, MockConcurrentThread* next)
+        : threadId_(threadId), index_(index), callCount_(0), next_(next) {}
+
+    unsigned long threadId_;
+    unsigned int index_;
+    unsigned int callCount_;
+    MockConcurrentThread* next_;
+};
+
+class MockLockingStringAllocator : public TestMemoryAllocator
+{
+public:
+    MockLockingStringAllocator(TestMemoryAllocator* originalAllocator) : originalAllocator_(originalAllocator) {}
+
+    virtual char* alloc_memory(size_t size, const char* file, size_t line) _override
+    {
+        ScopedMutexLock lock(&mutex_);
+        return originalAllocator_->alloc_memory(size, file, line);
+    }
+
+    virtual void free_memory(char* memory, size_t size, const char* file, size_t line) _override
+    {
+        ScopedMutexLock lock(&mutex_);
+        originalAllocator_->free_memory(memory, size, file, line);
+    }
+
+    virtual const char* name() const _override { return originalAllocator_->name(); }
+    virtual const char* alloc_name() const _override { return originalAllocator_->alloc_name(); }
+    virtual const char* free_name() const _override { return originalAllocator_->free_name(); }
+    virtual TestMemoryAllocator* actualAllocator() _override { return originalAllocator_->actualAllocator(); }
+
+    TestMemoryAllocator* originalAllocator() { return originalAllocator_; }
+
+private:
+    SimpleMutex mutex_;
+    TestMemoryAllocator* originalAllocator_;
+};
+
+MockConcurrentCallLog::MockConcurrentCallLog(bool orderPerThread)
+    : orderPerThread_(orderPerThread), recordingThreadId_(PlatformSpecificGetThreadId()), head_(NULLPTR), tail_(NULLPTR), callCount_(0), threads_(NULLPTR), threadCount_(0),
+      stringAllocator_(new MockLockingStringAllocator(SimpleString::getStringAllocator()))
+{
+    missingScope_[0] = '\0';
+    SimpleString::setStringAllocator(stringAllocator_);
+}
+
+MockConcurrentCallLog::~MockConcurrentCallLog()
+{
+    clear();
+
+    if (SimpleString::getStringAllocator() == stringAllocator_)
+        SimpleString::setStringAllocator(stringAllocator_->originalAllocator());
+    delete stringAllocator_;
+}
+
+MockConcurrentThread* MockConcurrentCallLog::threadFor(unsigned long threadId)
+{
+    for (MockConcurrentThread* thread = threads_; thread; thread = thread->next_)
+        if (thread->threadId_ == threadId)
+            return thread;
+
+    threads_ = new MockConcurrentThread(threadId, (unsigned int) threadCount_++, threads_);
+    return threads_;
+}
+
+MockActualCall& MockConcurrentCallLog::record(MockSupport& support, const SimpleString& functionName)
+{
+    const unsigned long threadId = PlatformSpecificGetThreadId();
+    ScopedMutexLock lock(&mutex_);
+
+    MockConcurrentThread* thread = threadFor(threadId);
+    MockRecordedActualCall* call = new MockRecordedActualCall(support, functionName, thread->index_, ++thread->callCount_);
+
+    if (tail_) tail_->next_ = call;
+    else head_ = call;
+    tail_ = call;
+    callCount_++;
+    return *call;
+}
+
+MockRecordedActualCall* MockConcurrentCallLog::takeCalls()
+{
+    ScopedMutexLock lock(&mutex_);
+
+    MockRecordedActualCall* calls = head_;
+    head_ = tail_ = NULLPTR;
+    callCount_ = 0;
+    return calls;
+}
+
+bool MockConcurrentCallLog::isOrderPerThread() const
+{
+    return orderPerThread_;
+}
+
+bool MockConcurrentCallLog::isCalledFromAnotherThread() const
+{
+    return PlatformSpecificGetThreadId() != recordingThreadId_;
+}
+
+SimpleMutex* MockConcurrentCallLog::getMutex()
+{
+    return &mutex_;
+}
+
+void MockConcurrentCallLog::recordMissingScope(const SimpleString& scopeName)
+{
+    ScopedMutexLock lock(&mutex_);
+    if (missingScope_[0] != '\0') return;
+    SimpleString::StrNCpy(missingScope_, scopeName.asCharString(), sizeof(missingScope_) - 1);
+    missingScope_[sizeof(missingScope_) - 1] = '\0';
+}
+
+SimpleString MockConcurrentCallLog::takeMissingScope()
+{
+    ScopedMutexLock lock(&mutex_);
+    SimpleString scopeName(missingScope_);
+    missingScope_[0] = '\0';
+    return scopeName;
+}
+
+size_t MockConcurrentCallLog::getCallCount()
+{
+    ScopedMutexLock lock(&mutex_);
+    return callCount_;
+}
+
+size_t MockConcurrentCallLog::getThreadCount()
+{
+    ScopedMutexLock lock(&mutex_);
+    return threadCount_;
+}
+
+void MockConcurrentCallLog::clear()
+{
+    MockRecordedActualCall* calls = takeCalls();
+    while (calls) {
+        MockRecordedActualCall* next = calls->next_;
+        delete calls;
+        calls = next;
+    }
+
+    ScopedMutexLock lock(&mutex_);
+    while (threads_) {
+        MockConcurrentThread* next = threads_->next_;
+        delete threads_;
+        threads_ = next;
+    }
+    threadCount_ = 0;
+    callCount_ = 0;
+    missingScope_[0] = '\0';
+}
@@ -27,6 +27,7 @@
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTestExt/MockCheckedExpectedCall.h"
+#include "CppUTestExt/MockExpectedCallsList.h"
 
 MockExpectedCall::MockExpectedCall()
 {
@@ -52,20 +53,30 @@ SimpleString MockCheckedExpectedCall::getName() const
 }
 
 MockCheckedExpectedCall::MockCheckedExpectedCall()
-    : ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
+    : internedName_(NULLPTR), index_(NULLPTR), ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
       initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER), finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
       outOfOrder_(false), returnValue_(""), objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true),
-      actualCalls_(0), expectedCalls_(1)
+      actualCalls_(0), minimumCalls_(1), maximumCalls_(1)
 {
     inputParameters_ = new MockNamedValueList();
     outputParameters_ = new MockNamedValueList();
 }
 
 MockCheckedExpectedCall::MockCheckedExpectedCall(unsigned int numCalls)
-    : ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
+    : internedName_(NULLPTR), index_(NULLPTR), ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
       initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER), finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
       outOfOrder_(false), returnValue_(""), objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true),
-      actualCalls_(0), expectedCalls_(numCalls)
+      actualCalls_(0), minimumCalls_(numCalls), maximumCalls_(numCalls)
+{
+    inputParameters_ = new MockNamedValueList();
+    outputParameters_ = new MockNamedValueList();
+}
+
+MockCheckedExpectedCall::MockCheckedExpectedCall(unsigned int minimumCalls, unsigned int maximumCalls)
+    : internedName_(NULLPTR), index_(NULLPTR), ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
+      initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER), finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
+      outOfOrder_(false), returnValue_(""), objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true),
+      actualCalls_(0), minimumCalls_(minimumCalls), maximumCalls_(maximumCalls)
 {
     inputParameters_ = new MockNamedValueList();
     outputParameters_ = new MockNamedValueList();
@@ -82,9 +93,28 @@ MockCheckedExpectedCall::~MockCheckedExpectedCall()
 MockExpectedCall& MockCheckedExpectedCall::withName(const SimpleString& name)
 {
     setName(name);
+    if (index_)
+        index_->expectedCallWasRenamed(name, this);
+    else
+        internedName_ = NULLPTR;
     return *this;
 }
 
+void MockCheckedExpectedCall::setInternedName(const char* internedName)
+{
+    internedName_ = internedName;
+}
+
+const char* MockCheckedExpectedCall::getInternedName() const
+{
+    return internedName_;
+}
+
+void MockCheckedExpectedCall::setExpectedCallsIndex(MockExpectedCallsIndex* index)
+{
+    index_ = index;
+}
+
 MockExpectedCall& MockCheckedExpectedCall::withBoolParameter(const SimpleString& name, bool value)
 {
     MockNamedValue* newParameter = new MockExpectedFunctionParameter(name);
@@ -295,12 +325,27 @@ MockExpectedCall& MockCheckedExpectedCall::ignoreOtherParameters()
 
 bool MockCheckedExpectedCall::isFulfilled()
 {
-    return (actualCalls_ == expectedCalls_);
+    return (minimumCalls_ <= actualCalls_) && (actualCalls_ <= maximumCalls_);
+}
+
+bool MockCheckedExpectedCall::expectsRangeOfCalls() const
+{
+    return minimumCalls_ != maximumCalls_;
+}
+
+bool MockCheckedExpectedCall::isExpectedAtCallOrder(unsigned int callOrder) const
+{
+    return (initialExpectedCallOrder_ != NO_EXPECTED_CALL_ORDER) && (callOrder >= initialExpectedCallOrder_) && (callOrder <= finalExpectedCallOrder_);
+}
+
+bool MockCheckedExpectedCall::isIgnoringOtherParameters() const
+{
+    return ignoreOtherParameters_;
 }
 
 bool MockCheckedExpectedCall::canMatchActualCalls()
 {
-    return (actualCalls_ < expectedCalls_);
+    return (actualCalls_ < maximumCalls_);
 }
 
 bool MockCheckedExpectedCall::isMatchingActualCallAndFinalized()
@@ -317,7 +362,7 @@ void MockCheckedExpectedCall::callWasMade(unsigned int callOrder)
 {
     actualCalls_++;
 
-    if ( (initialExpectedCallOrder_ != NO_EXPECTED_CALL_ORDER) &&
+    if ( (initialExpectedCallOrder_ != NO_EXPECTED_CALL_ORDER) && (callOrder != NO_EXPECTED_CALL_ORDER) &&
          ((callOrder < initialExpectedCallOrder_) || (callOrder > finalExpectedCallOrder_)) ) {
         outOfOrder_ = true;
     }
@@ -325,6 +370,16 @@ void MockCheckedExpectedCall::callWasMade(unsigned int callOrder)
     resetActualCallMatchingState();
 }
 
+unsigned int MockCheckedExpectedCall::getExpectedCallOrder() const
+{
+    return initialExpectedCallOrder_;
+}
+
+void MockCheckedExpectedCall::callWasMadeOutOfOrder()
+{
+    outOfOrder_ = true;
+}
+
 void MockCheckedExpectedCall::finalizeActualCallMatch()
 {
     isActualCallMatchFinalized_ = true;
@@ -423,12 +478,23 @@ SimpleString MockCheckedExpectedCall::callToString()
             str += ", other parameters are ignored";
     }
 
-    str += StringFromFormat(" (expected %d call%s, called %d time%s)",
-                            expectedCalls_, (expectedCalls_ == 1) ? "" : "s", actualCalls_, (actualCalls_ == 1) ? "" : "s" );
+    str += StringFromFormat(" (expected %s, called %d time%s)",
+                            expectedCallsToString().asCharString(), actualCalls_, (actualCalls_ == 1) ? "" : "s" );
 
     return str;
 }
 
+SimpleString MockCheckedExpectedCall::expectedCallsToString() const
+{
+    if (maximumCalls_ == NO_MAXIMUM_CALLS)
+        return StringFromFormat("at least %d call%s", minimumCalls_, (minimumCalls_ == 1) ? "" : "s");
+    if (minimumCalls_ == maximumCalls_)
+        return StringFromFormat("%d call%s", minimumCalls_, (minimumCalls_ == 1) ? "" : "s");
+    if (minimumCalls_ == 0)
+        return StringFromFormat("at most %d call%s", maximumCalls_, (maximumCalls_ == 1) ? "" : "s");
+    return StringFromFormat("between %d and %d calls", minimumCalls_, maximumCalls_);
+}
+
 SimpleString MockCheckedExpectedCall::missingParametersToString()
 {
     SimpleString str;
@@ -454,6 +520,13 @@ bool MockCheckedExpectedCall::relatesTo(const SimpleString& functionName)
     return functionName == getName();
 }
 
+bool MockCheckedExpectedCall::relatesTo(const SimpleString& functionName, const char* internedFunctionName)
+{
+    if (internedName_ && internedFunctionName)
+        return internedName_ == internedFunctionName;
+    return relatesTo(functionName);
+}
+
 bool MockCheckedExpectedCall::relatesToObject(const void* objectPtr) const
 {
     return (!isSpecificObjectExpected_) || (objectPtr_ == objectPtr);
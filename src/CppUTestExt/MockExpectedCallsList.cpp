@@ -29,7 +29,7 @@
 #include "CppUTestExt/MockExpectedCallsList.h"
 #include "CppUTestExt/MockCheckedExpectedCall.h"
 
-MockExpectedCallsList::MockExpectedCallsList() : head_(NULLPTR)
+MockExpectedCallsList::MockExpectedCallsList() : head_(NULLPTR), tail_(NULLPTR)
 {
 }
 
@@ -104,9 +104,14 @@ bool MockExpectedCallsList::hasUnfulfilledExpectations() const
 
 bool MockExpectedCallsList::hasExpectationWithName(const SimpleString& name) const
 {
-        for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
-            if (p->expectedCall_->relatesTo(name))
-                return true;
+    return hasExpectationWithName(name, NULLPTR);
+}
+
+bool MockExpectedCallsList::hasExpectationWithName(const SimpleString& name, const char* internedName) const
+{
+    for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
+        if (p->expectedCall_->relatesTo(name, internedName))
+            return true;
     return false;
 }
 
@@ -116,11 +121,9 @@ void MockExpectedCallsList::addExpectedCall(MockCheckedExpectedCall* call)
 
     if (head_ == NULLPTR)
         head_ = newCall;
-    else {
-        MockExpectedCallsListNode* lastCall = head_;
-        while (lastCall->next_) lastCall = lastCall->next_;
-        lastCall->next_ = newCall;
-    }
+    else
+        tail_->next_ = newCall;
+    tail_ = newCall;
 }
 
 void MockExpectedCallsList::addPotentiallyMatchingExpectations(const MockExpectedCallsList& list)
@@ -130,6 +133,14 @@ void MockExpectedCallsList::addPotentiallyMatchingExpectations(const MockExpecte
             addExpectedCall(p->expectedCall_);
 }
 
+void MockExpectedCallsList::removeExpectedCall(MockCheckedExpectedCall* call)
+{
+    for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
+        if (p->expectedCall_ == call)
+            p->expectedCall_ = NULLPTR;
+    pruneEmptyNodeFromList();
+}
+
 void MockExpectedCallsList::addExpectationsRelatedTo(const SimpleString& name, const MockExpectedCallsList& list)
 {
     for (MockExpectedCallsListNode* p = list.head_; p; p = p->next_)
@@ -144,9 +155,14 @@ void MockExpectedCallsList::addExpectations(const MockExpectedCallsList& list)
 }
 
 void MockExpectedCallsList::onlyKeepExpectationsRelatedTo(const SimpleString& name)
+{
+    onlyKeepExpectationsRelatedTo(name, NULLPTR);
+}
+
+void MockExpectedCallsList::onlyKeepExpectationsRelatedTo(const SimpleString& name, const char* internedName)
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
-        if (! p->expectedCall_->relatesTo(name))
+        if (! p->expectedCall_->relatesTo(name, internedName))
             p->expectedCall_ = NULLPTR;
 
     pruneEmptyNodeFromList();
@@ -172,6 +188,15 @@ void MockExpectedCallsList::onlyKeepUnmatchingExpectations()
     pruneEmptyNodeFromList();
 }
 
+void MockExpectedCallsList::onlyKeepPotentiallyMatchingExpectations()
+{
+    for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
+        if (! p->expectedCall_->canMatchActualCalls())
+            p->expectedCall_ = NULLPTR;
+
+    pruneEmptyNodeFromList();
+}
+
 void MockExpectedCallsList::onlyKeepExpectationsWithInputParameterName(const SimpleString& name)
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
@@ -212,6 +237,18 @@ void MockExpectedCallsList::onlyKeepExpectationsOnObject(const void* objectPtr)
     pruneEmptyNodeFromList();
 }
 
+MockCheckedExpectedCall* MockExpectedCallsList::firstPotentiallyMatchingExpectation()
+{
+    /* Only drops expectations from the front, so walking a list that is used up in order stays cheap */
+    while (head_ && !head_->expectedCall_->canMatchActualCalls()) {
+        MockExpectedCallsListNode* toBeDeleted = head_;
+        head_ = head_->next_;
+        delete toBeDeleted;
+    }
+    if (head_ == NULLPTR) tail_ = NULLPTR;
+    return (head_) ? head_->expectedCall_ : NULLPTR;
+}
+
 MockCheckedExpectedCall* MockExpectedCallsList::removeFirstFinalizedMatchingExpectation()
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_) {
@@ -268,6 +305,7 @@ void MockExpectedCallsList::pruneEmptyNodeFromList()
             current = current->next_;
         }
     }
+    tail_ = previous;
 }
 
 void MockExpectedCallsList::deleteAllExpectationsAndClearList()
@@ -278,6 +316,7 @@ void MockExpectedCallsList::deleteAllExpectationsAndClearList()
         delete head_;
         head_ = next;
     }
+    tail_ = NULLPTR;
 }
 
 void MockExpectedCallsList::resetActualCallMatchingState()
@@ -362,3 +401,104 @@ bool MockExpectedCallsList::hasUnmatchingExpectationsBecauseOfMissingParameters(
     return false;
 }
 
+
+struct MockExpectedCallsIndexEntry : public MockArenaObject
+{
+    MockExpectedCallsIndexEntry(MockExpectedCallsIndexEntry* next) : expectationCount_(0), next_(next) {}
+
+    MockExpectedCallsList expectations_;
+    unsigned int expectationCount_;
+    MockExpectedCallsIndexEntry* next_;
+};
+
+MockExpectedCallsIndex::MockExpectedCallsIndex() : entries_(NULLPTR)
+{
+}
+
+MockExpectedCallsIndex::~MockExpectedCallsIndex()
+{
+    clear();
+}
+
+MockExpectedCallsIndexEntry* MockExpectedCallsIndex::entryFor(const char* internedName) const
+{
+    if (internedName == NULLPTR) return NULLPTR;
+    return (MockExpectedCallsIndexEntry*) names_.getData(internedName);
+}
+
+void MockExpectedCallsIndex::addExpectedCall(const SimpleString& name, MockCheckedExpectedCall* call)
+{
+    const char* internedName = names_.intern(name);
+    MockExpectedCallsIndexEntry* entry = entryFor(internedName);
+    if (entry == NULLPTR) {
+        entry = entries_ = new MockExpectedCallsIndexEntry(entries_);
+        names_.setData(internedName, entry);
+    }
+
+    entry->expectations_.addExpectedCall(call);
+    entry->expectationCount_++;
+    call->setInternedName(internedName);
+    call->setExpectedCallsIndex(this);
+}
+
+void MockExpectedCallsIndex::expectedCallWasRenamed(const SimpleString& name, MockCheckedExpectedCall* call)
+{
+    removeExpectedCall(call);
+    addExpectedCall(name, call);
+}
+
+void MockExpectedCallsIndex::removeExpectedCall(MockCheckedExpectedCall* call)
+{
+    MockExpectedCallsIndexEntry* entry = entryFor(call->getInternedName());
+    if (entry) {
+        entry->expectations_.removeExpectedCall(call);
+        entry->expectationCount_--;
+    }
+}
+
+const char* MockExpectedCallsIndex::findName(const SimpleString& name) const
+{
+    return names_.find(name);
+}
+
+const char* MockExpectedCallsIndex::internName(const SimpleString& name)
+{
+    return names_.intern(name);
+}
+
+bool MockExpectedCallsIndex::hasExpectationWithName(const char* internedName) const
+{
+    MockExpectedCallsIndexEntry* entry = entryFor(internedName);
+    return entry && entry->expectationCount_ != 0;
+}
+
+const MockExpectedCallsList& MockExpectedCallsIndex::potentiallyMatchingExpectationsFor(const char* internedName)
+{
+    MockExpectedCallsIndexEntry* entry = entryFor(internedName);
+    if (entry == NULLPTR) return noExpectations_;
+
+    entry->expectations_.onlyKeepPotentiallyMatchingExpectations();
+    return entry->expectations_;
+}
+
+const MockExpectedCallsList& MockExpectedCallsIndex::expectationsFor(const char* internedName) const
+{
+    MockExpectedCallsIndexEntry* entry = entryFor(internedName);
+    return (entry) ? entry->expectations_ : noExpectations_;
+}
+
+MockCheckedExpectedCall* MockExpectedCallsIndex::firstPotentiallyMatchingExpectationFor(const char* internedName)
+{
+    MockExpectedCallsIndexEntry* entry = entryFor(internedName);
+    return (entry) ? entry->expectations_.firstPotentiallyMatchingExpectation() : NULLPTR;
+}
+
+void MockExpectedCallsIndex::clear()
+{
+    while (entries_) {
+        MockExpectedCallsIndexEntry* next = entries_->next_;
+        delete entries_;
+        entries_ = next;
+    }
+    names_.clear();
+}
@@ -30,6 +30,7 @@
 #include "CppUTestExt/MockExpectedCall.h"
 #include "CppUTestExt/MockExpectedCallsList.h"
 #include "CppUTestExt/MockNamedValue.h"
+#include "CppUTestExt/MockFunction.h"
 
 class MockFailureReporterTestTerminator : public TestTerminator
 {
@@ -95,6 +96,19 @@ void MockFailure::addExpectationsAndCallHistoryRelatedTo(const SimpleString& nam
     message_ += expectationsForFunction.fulfilledCallsToString("\t\t");
 }
 
+static SimpleString callsOrNoneTextWhenEmpty(const SimpleString& calls, const SimpleString& linePrefix)
+{
+    return (calls.isEmpty()) ? linePrefix + "<none>" : calls;
+}
+
+void MockFailure::addExpectationsAndCallHistory(const MockTypedFunction& function)
+{
+    message_ += "\tEXPECTED calls that WERE NOT fulfilled:\n";
+    message_ += callsOrNoneTextWhenEmpty(function.unfulfilledCallsToString("\t\t"), "\t\t");
+    message_ += "\n\tEXPECTED calls that WERE fulfilled:\n";
+    message_ += callsOrNoneTextWhenEmpty(function.fulfilledCallsToString("\t\t"), "\t\t");
+}
+
 MockExpectedCallsDidntHappenFailure::MockExpectedCallsDidntHappenFailure(UtestShell* test, const MockExpectedCallsList& expectations) : MockFailure(test)
 {
     message_ = "Mock Failure: Expected call WAS NOT fulfilled.\n";
@@ -239,3 +253,33 @@ MockExpectedObjectDidntHappenFailure::MockExpectedObjectDidntHappenFailure(Utest
 }
 
 
+
+MockExpectedTypedCallsDidntHappenFailure::MockExpectedTypedCallsDidntHappenFailure(UtestShell* test, const MockTypedFunction& function) : MockFailure(test)
+{
+    message_ = "Mock Failure: Expected call WAS NOT fulfilled.\n";
+    addExpectationsAndCallHistory(function);
+}
+
+MockUnexpectedTypedCallHappenedFailure::MockUnexpectedTypedCallHappenedFailure(UtestShell* test, const SimpleString& actualCall, const MockTypedFunction& function) : MockFailure(test)
+{
+    message_ = "Mock Failure: Unexpected call to function: ";
+    message_ += actualCall;
+    message_ += "\n";
+    addExpectationsAndCallHistory(function);
+}
+
+MockScopeCreatedWhileRecordingFailure::MockScopeCreatedWhileRecordingFailure(UtestShell* test, const SimpleString& scopeName) : MockFailure(test)
+{
+    message_ = "Mock Failure: mock scope <";
+    message_ += scopeName;
+    message_ += "> must be created before recording threads start";
+}
+
+MockCallFileFailure::MockCallFileFailure(UtestShell* test, const SimpleString& fileName, size_t lineNumber, const SimpleString& message) : MockFailure(test)
+{
+    message_ = "Mock Failure: ";
+    message_ += fileName;
+    if (lineNumber) message_ += StringFromFormat(":%lu", (unsigned long) lineNumber);
+    message_ += ": ";
+    message_ += message;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockMemoryArena.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+#undef new
+
+/*
+ * Blocks are stacked in chunks. Every block starts with a header that links
+ * it to the block below it in the same chunk. A freed block is only marked;
+ * freed blocks are popped as soon as they are on top of the stack.
+ *
+ * reset() starts over with an empty stack. Chunks that still hold live
+ * blocks are set aside as retired chunks; they count their live blocks and
+ * are given back when the last of them is freed.
+ */
+
+struct MockMemoryArenaBlock
+{
+    size_t previousBlock_;
+    bool isFree_;
+};
+
+struct MockMemoryArenaChunk
+{
+    MockMemoryArenaChunk* previous_;
+    size_t size_;
+    size_t used_;
+    size_t topBlock_;
+    size_t liveBlocks_;
+};
+
+static const size_t mockMemoryArenaAlignment = 2 * sizeof(void*);
+static const size_t mockMemoryArenaChunkSize = 64 * 1024;
+static const size_t mockMemoryArenaNoBlock = (size_t) -1;
+
+static MockMemoryArenaChunk* currentChunk_ = NULLPTR;
+static MockMemoryArenaChunk* spareChunk_ = NULLPTR;
+static MockMemoryArenaChunk* retiredChunks_ = NULLPTR;
+static size_t allocationCount_ = 0;
+static size_t chunkCount_ = 0;
+
+static size_t alignedSize(size_t size)
+{
+    return (size + mockMemoryArenaAlignment - 1) & ~(mockMemoryArenaAlignment - 1);
+}
+
+static const size_t blockHeaderSize = alignedSize(sizeof(MockMemoryArenaBlock));
+static const size_t chunkHeaderSize = alignedSize(sizeof(MockMemoryArenaChunk));
+
+static char* chunkData(MockMemoryArenaChunk* chunk)
+{
+    return ((char*) (void*) chunk) + chunkHeaderSize;
+}
+
+static MockMemoryArenaBlock* blockAt(MockMemoryArenaChunk* chunk, size_t offset)
+{
+    return (MockMemoryArenaBlock*) (void*) (chunkData(chunk) + offset);
+}
+
+static void freeChunk(MockMemoryArenaChunk* chunk)
+{
+    PlatformSpecificFree(chunk);
+    chunkCount_--;
+}
+
+static MockMemoryArenaChunk* newChunk(size_t minimumSize)
+{
+    if (spareChunk_ && spareChunk_->size_ >= minimumSize) {
+        MockMemoryArenaChunk* chunk = spareChunk_;
+        spareChunk_ = NULLPTR;
+        return chunk;
+    }
+
+    const size_t size = (minimumSize > mockMemoryArenaChunkSize) ? minimumSize : mockMemoryArenaChunkSize;
+    MockMemoryArenaChunk* chunk = (MockMemoryArenaChunk*) PlatformSpecificMalloc(chunkHeaderSize + size);
+    if (chunk == NULLPTR) FAIL("MockMemoryArena: out of memory");
+    chunk->size_ = size;
+    chunkCount_++;
+    return chunk;
+}
+
+static void popFreeBlocks()
+{
+    while (currentChunk_) {
+        while (currentChunk_->topBlock_ != mockMemoryArenaNoBlock && blockAt(currentChunk_, currentChunk_->topBlock_)->isFree_) {
+            currentChunk_->used_ = currentChunk_->topBlock_;
+            currentChunk_->topBlock_ = blockAt(currentChunk_, currentChunk_->topBlock_)->previousBlock_;
+        }
+
+        if (currentChunk_->topBlock_ != mockMemoryArenaNoBlock || currentChunk_->previous_ == NULLPTR)
+            return;
+
+        MockMemoryArenaChunk* emptyChunk = currentChunk_;
+        currentChunk_ = emptyChunk->previous_;
+        if (spareChunk_) freeChunk(spareChunk_);
+        spareChunk_ = emptyChunk;
+    }
+}
+
+void* MockMemoryArena::allocate(size_t size)
+{
+    const size_t blockSize = blockHeaderSize + alignedSize(size);
+
+    if (currentChunk_ == NULLPTR || currentChunk_->used_ + blockSize > currentChunk_->size_) {
+        MockMemoryArenaChunk* chunk = newChunk(blockSize);
+        chunk->previous_ = currentChunk_;
+        chunk->used_ = 0;
+        chunk->topBlock_ = mockMemoryArenaNoBlock;
+        currentChunk_ = chunk;
+    }
+
+    MockMemoryArenaBlock* block = blockAt(currentChunk_, currentChunk_->used_);
+    block->previousBlock_ = currentChunk_->topBlock_;
+    block->isFree_ = false;
+    currentChunk_->topBlock_ = currentChunk_->used_;
+    currentChunk_->used_ += blockSize;
+    allocationCount_++;
+
+    return ((char*) (void*) block) + blockHeaderSize;
+}
+
+static MockMemoryArenaChunk** findRetiredChunkHolding(MockMemoryArenaBlock* block)
+{
+    const char* address = (const char*) (void*) block;
+    for (MockMemoryArenaChunk** link = &retiredChunks_; *link; link = &(*link)->previous_) {
+        const char* data = chunkData(*link);
+        if (address >= data && address < data + (*link)->used_)
+            return link;
+    }
+    return NULLPTR;
+}
+
+static void releaseBlockOfRetiredChunk(MockMemoryArenaChunk** link)
+{
+    MockMemoryArenaChunk* chunk = *link;
+    if (--chunk->liveBlocks_ != 0) return;
+
+    *link = chunk->previous_;
+    freeChunk(chunk);
+}
+
+static size_t countLiveBlocks(MockMemoryArenaChunk* chunk)
+{
+    size_t liveBlocks = 0;
+    for (size_t offset = chunk->topBlock_; offset != mockMemoryArenaNoBlock; offset = blockAt(chunk, offset)->previousBlock_)
+        if (!blockAt(chunk, offset)->isFree_) liveBlocks++;
+    return liveBlocks;
+}
+
+static void retireChunk(MockMemoryArenaChunk* chunk)
+{
+    chunk->liveBlocks_ = countLiveBlocks(chunk);
+    if (chunk->liveBlocks_ == 0) {
+        freeChunk(chunk);
+        return;
+    }
+    chunk->previous_ = retiredChunks_;
+    retiredChunks_ = chunk;
+}
+
+void MockMemoryArena::deallocate(void* memory)
+{
+    if (memory == NULLPTR) return;
+
+    MockMemoryArenaBlock* block = (MockMemoryArenaBlock*) (void*) (((char*) memory) - blockHeaderSize);
+    block->isFree_ = true;
+    allocationCount_--;
+
+    MockMemoryArenaChunk** retiredChunk = (retiredChunks_) ? findRetiredChunkHolding(block) : NULLPTR;
+    if (retiredChunk)
+        releaseBlockOfRetiredChunk(retiredChunk);
+    else
+        popFreeBlocks();
+}
+
+void MockMemoryArena::reset()
+{
+    if (spareChunk_) freeChunk(spareChunk_);
+    spareChunk_ = NULLPTR;
+    while (currentChunk_) {
+        MockMemoryArenaChunk* previous = currentChunk_->previous_;
+        retireChunk(currentChunk_);
+        currentChunk_ = previous;
+    }
+}
+
+size_t MockMemoryArena::getAllocationCount()
+{
+    return allocationCount_;
+}
+
+size_t MockMemoryArena::getChunkCount()
+{
+    return chunkCount_;
+}
+
+void* MockArenaObject::operator new(size_t size)
+{
+    return MockMemoryArena::allocate(size);
+}
+
+void* MockArenaObject::operator new(size_t size, const char*, size_t)
+{
+    return MockMemoryArena::allocate(size);
+}
+
+void MockArenaObject::operator delete(void* memory)
+{
+    MockMemoryArena::deallocate(memory);
+}
+
+void MockArenaObject::operator delete(void* memory, const char*, size_t)
+{
+    MockMemoryArena::deallocate(memory);
+}
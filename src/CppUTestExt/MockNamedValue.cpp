@@ -367,100 +367,107 @@ MockNamedValueCopier* MockNamedValue::getCopier() const
     return copier_;
 }
 
+static bool isOfType(const SimpleString& type, const char* typeName)
+{
+    return SimpleString::StrCmp(type.asCharString(), typeName) == 0;
+}
+
 bool MockNamedValue::equals(const MockNamedValue& p) const
 {
-    if((type_ == "long int") && (p.type_ == "int"))
-        return value_.longIntValue_ == p.value_.intValue_;
-    else if((type_ == "int") && (p.type_ == "long int"))
-        return value_.intValue_ == p.value_.longIntValue_;
-    else if((type_ == "unsigned int") && (p.type_ == "int"))
-        return (p.value_.intValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned int)p.value_.intValue_);
-    else if((type_ == "int") && (p.type_ == "unsigned int"))
-        return (value_.intValue_ >= 0) && ((unsigned int)value_.intValue_ == p.value_.unsignedIntValue_);
-    else if((type_ == "unsigned long int") && (p.type_ == "int"))
-        return (p.value_.intValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long)p.value_.intValue_);
-    else if((type_ == "int") && (p.type_ == "unsigned long int"))
-        return (value_.intValue_ >= 0) && ((unsigned long)value_.intValue_ == p.value_.unsignedLongIntValue_);
-    else if((type_ == "unsigned int") && (p.type_ == "long int"))
-        return (p.value_.longIntValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned long)p.value_.longIntValue_);
-    else if((type_ == "long int") && (p.type_ == "unsigned int"))
-        return (value_.longIntValue_ >= 0) && ((unsigned long)value_.longIntValue_ == p.value_.unsignedIntValue_);
-    else if((type_ == "unsigned int") && (p.type_ == "unsigned long int"))
-        return value_.unsignedIntValue_ == p.value_.unsignedLongIntValue_;
-    else if((type_ == "unsigned long int") && (p.type_ == "unsigned int"))
-        return value_.unsignedLongIntValue_ == p.value_.unsignedIntValue_;
-    else if((type_ == "long int") && (p.type_ == "unsigned long int"))
-        return (value_.longIntValue_ >= 0) && ((unsigned long)value_.longIntValue_ == p.value_.unsignedLongIntValue_);
-    else if((type_ == "unsigned long int") && (p.type_ == "long int"))
-        return (p.value_.longIntValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long) p.value_.longIntValue_);
+    /* Comparing the type names in place keeps this hot path free of temporary strings */
+    if (type_ != p.type_) {
+        if(isOfType(type_, "long int") && isOfType(p.type_, "int"))
+            return value_.longIntValue_ == p.value_.intValue_;
+        else if(isOfType(type_, "int") && isOfType(p.type_, "long int"))
+            return value_.intValue_ == p.value_.longIntValue_;
+        else if(isOfType(type_, "unsigned int") && isOfType(p.type_, "int"))
+            return (p.value_.intValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned int)p.value_.intValue_);
+        else if(isOfType(type_, "int") && isOfType(p.type_, "unsigned int"))
+            return (value_.intValue_ >= 0) && ((unsigned int)value_.intValue_ == p.value_.unsignedIntValue_);
+        else if(isOfType(type_, "unsigned long int") && isOfType(p.type_, "int"))
+            return (p.value_.intValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long)p.value_.intValue_);
+        else if(isOfType(type_, "int") && isOfType(p.type_, "unsigned long int"))
+            return (value_.intValue_ >= 0) && ((unsigned long)value_.intValue_ == p.value_.unsignedLongIntValue_);
+        else if(isOfType(type_, "unsigned int") && isOfType(p.type_, "long int"))
+            return (p.value_.longIntValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned long)p.value_.longIntValue_);
+        else if(isOfType(type_, "long int") && isOfType(p.type_, "unsigned int"))
+            return (value_.longIntValue_ >= 0) && ((unsigned long)value_.longIntValue_ == p.value_.unsignedIntValue_);
+        else if(isOfType(type_, "unsigned int") && isOfType(p.type_, "unsigned long int"))
+            return value_.unsignedIntValue_ == p.value_.unsignedLongIntValue_;
+        else if(isOfType(type_, "unsigned long int") && isOfType(p.type_, "unsigned int"))
+            return value_.unsignedLongIntValue_ == p.value_.unsignedIntValue_;
+        else if(isOfType(type_, "long int") && isOfType(p.type_, "unsigned long int"))
+            return (value_.longIntValue_ >= 0) && ((unsigned long)value_.longIntValue_ == p.value_.unsignedLongIntValue_);
+        else if(isOfType(type_, "unsigned long int") && isOfType(p.type_, "long int"))
+            return (p.value_.longIntValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long) p.value_.longIntValue_);
 #ifdef CPPUTEST_USE_LONG_LONG
-    else if ((type_ == "long long int") && (p.type_ == "int"))
-        return value_.longLongIntValue_ == p.value_.intValue_;
-    else if ((type_ == "int") && (p.type_ == "long long int"))
-        return value_.intValue_ == p.value_.longLongIntValue_;
-    else if ((type_ == "long long int") && (p.type_ == "long int"))
-        return value_.longLongIntValue_ == p.value_.longIntValue_;
-    else if ((type_ == "long int") && (p.type_ == "long long int"))
-        return value_.longIntValue_ == p.value_.longLongIntValue_;
-    else if ((type_ == "long long int") && (p.type_ == "unsigned int"))
-        return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedIntValue_);
-    else if ((type_ == "unsigned int") && (p.type_ == "long long int"))
-        return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
-    else if ((type_ == "long long int") && (p.type_ == "unsigned long int"))
-        return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedLongIntValue_);
-    else if ((type_ == "unsigned long int") && (p.type_ == "long long int"))
-        return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
-    else if ((type_ == "long long int") && (p.type_ == "unsigned long long int"))
-        return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedLongLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "long long int"))
-        return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "int"))
-        return (p.value_.intValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.intValue_);
-    else if ((type_ == "int") && (p.type_ == "unsigned long long int"))
-        return (value_.intValue_ >= 0) && ((unsigned long long)value_.intValue_ == p.value_.unsignedLongLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "unsigned int"))
-        return value_.unsignedLongLongIntValue_ == p.value_.unsignedIntValue_;
-    else if ((type_ == "unsigned int") && (p.type_ == "unsigned long long int"))
-        return value_.unsignedIntValue_ == p.value_.unsignedLongLongIntValue_;
-    else if ((type_ == "unsigned long long int") && (p.type_ == "long int"))
-        return (p.value_.longIntValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.longIntValue_);
-    else if ((type_ == "long int") && (p.type_ == "unsigned long long int"))
-        return (value_.longIntValue_ >= 0) && ((unsigned long long)value_.longIntValue_ == p.value_.unsignedLongLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "unsigned long int"))
-        return value_.unsignedLongLongIntValue_ == p.value_.unsignedLongIntValue_;
-    else if ((type_ == "unsigned long int") && (p.type_ == "unsigned long long int"))
-        return value_.unsignedLongIntValue_ == p.value_.unsignedLongLongIntValue_;
+        else if (isOfType(type_, "long long int") && isOfType(p.type_, "int"))
+            return value_.longLongIntValue_ == p.value_.intValue_;
+        else if (isOfType(type_, "int") && isOfType(p.type_, "long long int"))
+            return value_.intValue_ == p.value_.longLongIntValue_;
+        else if (isOfType(type_, "long long int") && isOfType(p.type_, "long int"))
+            return value_.longLongIntValue_ == p.value_.longIntValue_;
+        else if (isOfType(type_, "long int") && isOfType(p.type_, "long long int"))
+            return value_.longIntValue_ == p.value_.longLongIntValue_;
+        else if (isOfType(type_, "long long int") && isOfType(p.type_, "unsigned int"))
+            return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedIntValue_);
+        else if (isOfType(type_, "unsigned int") && isOfType(p.type_, "long long int"))
+            return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
+        else if (isOfType(type_, "long long int") && isOfType(p.type_, "unsigned long int"))
+            return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedLongIntValue_);
+        else if (isOfType(type_, "unsigned long int") && isOfType(p.type_, "long long int"))
+            return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
+        else if (isOfType(type_, "long long int") && isOfType(p.type_, "unsigned long long int"))
+            return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedLongLongIntValue_);
+        else if (isOfType(type_, "unsigned long long int") && isOfType(p.type_, "long long int"))
+            return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
+        else if (isOfType(type_, "unsigned long long int") && isOfType(p.type_, "int"))
+            return (p.value_.intValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.intValue_);
+        else if (isOfType(type_, "int") && isOfType(p.type_, "unsigned long long int"))
+            return (value_.intValue_ >= 0) && ((unsigned long long)value_.intValue_ == p.value_.unsignedLongLongIntValue_);
+        else if (isOfType(type_, "unsigned long long int") && isOfType(p.type_, "unsigned int"))
+            return value_.unsignedLongLongIntValue_ == p.value_.unsignedIntValue_;
+        else if (isOfType(type_, "unsigned int") && isOfType(p.type_, "unsigned long long int"))
+            return value_.unsignedIntValue_ == p.value_.unsignedLongLongIntValue_;
+        else if (isOfType(type_, "unsigned long long int") && isOfType(p.type_, "long int"))
+            return (p.value_.longIntValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.longIntValue_);
+        else if (isOfType(type_, "long int") && isOfType(p.type_, "unsigned long long int"))
+            return (value_.longIntValue_ >= 0) && ((unsigned long long)value_.longIntValue_ == p.value_.unsignedLongLongIntValue_);
+        else if (isOfType(type_, "unsigned long long int") && isOfType(p.type_, "unsigned long int"))
+            return value_.unsignedLongLongIntValue_ == p.value_.unsignedLongIntValue_;
+        else if (isOfType(type_, "unsigned long int") && isOfType(p.type_, "unsigned long long int"))
+            return value_.unsignedLongIntValue_ == p.value_.unsignedLongLongIntValue_;
 #endif
+        return false;
+    }
 
-    if (type_ != p.type_) return false;
-
-    if (type_ == "bool")
+    if (isOfType(type_, "bool"))
         return value_.boolValue_ == p.value_.boolValue_;
-    else if (type_ == "int")
+    else if (isOfType(type_, "int"))
         return value_.intValue_ == p.value_.intValue_;
-    else if (type_ == "unsigned int")
+    else if (isOfType(type_, "unsigned int"))
         return value_.unsignedIntValue_ == p.value_.unsignedIntValue_;
-    else if (type_ == "long int")
+    else if (isOfType(type_, "long int"))
         return value_.longIntValue_ == p.value_.longIntValue_;
-    else if (type_ == "unsigned long int")
+    else if (isOfType(type_, "unsigned long int"))
         return value_.unsignedLongIntValue_ == p.value_.unsignedLongIntValue_;
 #ifdef CPPUTEST_USE_LONG_LONG
-    else if (type_ == "long long int")
+    else if (isOfType(type_, "long long int"))
         return value_.longLongIntValue_ == p.value_.longLongIntValue_;
-    else if (type_ == "unsigned long long int")
+    else if (isOfType(type_, "unsigned long long int"))
         return value_.unsignedLongLongIntValue_ == p.value_.unsignedLongLongIntValue_;
 #endif
-    else if (type_ == "const char*")
-        return SimpleString(value_.stringValue_) == SimpleString(p.value_.stringValue_);
-    else if (type_ == "void*")
+    else if (isOfType(type_, "const char*"))
+        return SimpleString::StrCmp((value_.stringValue_) ? value_.stringValue_ : "", (p.value_.stringValue_) ? p.value_.stringValue_ : "") == 0;
+    else if (isOfType(type_, "void*"))
         return value_.pointerValue_ == p.value_.pointerValue_;
-    else if (type_ == "const void*")
+    else if (isOfType(type_, "const void*"))
         return value_.constPointerValue_ == p.value_.constPointerValue_;
-    else if (type_ == "void (*)()")
+    else if (isOfType(type_, "void (*)()"))
         return value_.functionPointerValue_ == p.value_.functionPointerValue_;
-    else if (type_ == "double")
+    else if (isOfType(type_, "double"))
         return (doubles_equal(value_.doubleValue_.value, p.value_.doubleValue_.value, value_.doubleValue_.tolerance));
-    else if (type_ == "const unsigned char*")
+    else if (isOfType(type_, "const unsigned char*"))
     {
         if (size_ != p.size_) {
             return false;
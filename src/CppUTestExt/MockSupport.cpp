@@ -30,6 +30,9 @@
 #include "CppUTestExt/MockActualCall.h"
 #include "CppUTestExt/MockExpectedCall.h"
 #include "CppUTestExt/MockFailure.h"
+#include "CppUTestExt/MockFunction.h"
+#include "CppUTestExt/MockConcurrentCallLog.h"
+#include "CppUTestExt/MockCallFile.h"
 
 #define MOCK_SUPPORT_SCOPE_PREFIX "!!!$$$MockingSupportScope$$$!!!"
 
@@ -37,20 +40,60 @@ static MockSupport global_mock;
 
 MockSupport& mock(const SimpleString& mockName, MockFailureReporter* failureReporterForThisCall)
 {
+    if (global_mock.isCalledFromARecordingThread())
+        return (mockName != "") ? *global_mock.getMockSupportScope(mockName) : global_mock;
+
     MockSupport& mock_support = (mockName != "") ? *global_mock.getMockSupportScope(mockName) : global_mock;
     mock_support.setActiveReporter(failureReporterForThisCall);
     mock_support.setDefaultComparatorsAndCopiersRepository();
     return mock_support;
 }
 
+MockFunctionId::MockFunctionId(const char* functionName, const char* scopeName)
+    : functionName_(functionName), scopeName_(scopeName), scope_(NULLPTR), support_(NULLPTR), internedName_(NULLPTR), resolvedAtClear_(0)
+{
+}
+
+MockActualCall& MockFunctionId::actualCall()
+{
+    /* The scope may have been deleted by a clear, so it is only dereferenced once it is known to be current */
+    if (scope_ == NULLPTR || !MockSupport::isResolvedFor(scope_, *this) || scope_->isRecordingConcurrently()) {
+        MockSupport& scope = mock(scopeName_);
+        /* While recording, the id may be shared between threads, so it is not written */
+        if (!scope.isRecordingConcurrently()) scope_ = &scope;
+        return scope.actualCall(*this);
+    }
+
+    scope_->setActiveReporter(NULLPTR);
+    scope_->setDefaultComparatorsAndCopiersRepository();
+    return scope_->actualCall(*this);
+}
+
+const char* MockFunctionId::getFunctionName() const
+{
+    return functionName_;
+}
+
+const char* MockFunctionId::getScopeName() const
+{
+    return scopeName_;
+}
+
+unsigned int MockSupport::clearCount_ = 0;
+
 MockSupport::MockSupport(const SimpleString& mockName)
-    : actualCallOrder_(0), expectedCallOrder_(0), strictOrdering_(false), standardReporter_(&defaultReporter_), ignoreOtherCalls_(false), enabled_(true), lastActualFunctionCall_(NULLPTR), mockName_(mockName), tracing_(false)
+    : actualCallOrder_(0), expectedCallOrder_(0), strictOrdering_(false), callsOutOfOrder_(false), standardReporter_(&defaultReporter_), ignoreOtherCalls_(false), enabled_(true), lastActualFunctionCall_(NULLPTR), mockName_(mockName), typedFunctions_(NULLPTR), concurrentCalls_(NULLPTR), ownsConcurrentCalls_(false), expectationsFile_(NULLPTR), fileExpectation_(NULLPTR), callRecorder_(NULLPTR), handles_(NULLPTR), tracing_(false)
 {
     setActiveReporter(NULLPTR);
 }
 
 MockSupport::~MockSupport()
 {
+    clearCount_++;
+    clearTypedFunctions();
+    setConcurrentCalls(NULLPTR);
+    clearCallFiles();
+    clearHandles();
 }
 
 void MockSupport::crashOnFailure(bool shouldCrash)
@@ -112,18 +155,26 @@ void MockSupport::removeAllComparatorsAndCopiers()
 
 void MockSupport::clear()
 {
+    clearCount_++;
+
     delete lastActualFunctionCall_;
     lastActualFunctionCall_ = NULLPTR;
 
     tracing_ = false;
     MockActualCallTrace::clearInstance();
+    setConcurrentCalls(NULLPTR);
+    clearCallFiles();
+    clearHandles();
 
     expectations_.deleteAllExpectationsAndClearList();
+    expectationsIndex_.clear();
+    clearTypedFunctions();
     ignoreOtherCalls_ = false;
     enabled_ = true;
     actualCallOrder_ = 0;
     expectedCallOrder_ = 0;
     strictOrdering_ = false;
+    callsOutOfOrder_ = false;
 
     for (MockNamedValueListNode* p = data_.begin(); p; p = p->next()) {
         MockSupport* support = getMockSupport(p);
@@ -133,6 +184,9 @@ void MockSupport::clear()
         }
     }
     data_.clear();
+
+    /* Scopes are cleared with their parent, which resets the arena once all of them are gone */
+    if (mockName_.isEmpty()) MockMemoryArena::reset();
 }
 
 void MockSupport::strictOrder()
@@ -157,53 +211,251 @@ void MockSupport::expectNoCall(const SimpleString& functionName)
 }
 
 MockExpectedCall& MockSupport::expectNCalls(unsigned int amount, const SimpleString& functionName)
+{
+    return expectCalls(amount, amount, functionName);
+}
+
+MockExpectedCall& MockSupport::expectAtLeastNCalls(unsigned int amount, const SimpleString& functionName)
+{
+    return expectCalls(amount, MockCheckedExpectedCall::NO_MAXIMUM_CALLS, functionName);
+}
+
+MockExpectedCall& MockSupport::expectAtMostNCalls(unsigned int amount, const SimpleString& functionName)
+{
+    return expectCalls(0, amount, functionName);
+}
+
+MockExpectedCall& MockSupport::expectCalls(unsigned int minimumCalls, unsigned int maximumCalls, const SimpleString& functionName)
 {
     if (!enabled_) return MockIgnoredExpectedCall::instance();
 
     countCheck();
 
-    MockCheckedExpectedCall* call = new MockCheckedExpectedCall(amount);
-    call->withName(appendScopeToName(functionName));
-    if (strictOrdering_) {
-        call->withCallOrder(expectedCallOrder_ + 1, expectedCallOrder_ + amount);
-        expectedCallOrder_ += amount;
+    MockCheckedExpectedCall* call = createExpectedCall(minimumCalls, maximumCalls, functionName);
+
+    /* One expectation counts all of its calls; a range of calls has no fixed position in a strict order */
+    if (strictOrdering_ && minimumCalls == maximumCalls) {
+        call->withCallOrder(expectedCallOrder_ + 1, expectedCallOrder_ + minimumCalls);
+        expectedCallOrder_ += minimumCalls;
     }
-    expectations_.addExpectedCall(call);
     return *call;
 }
 
-MockCheckedActualCall* MockSupport::createActualCall()
+MockCheckedExpectedCall* MockSupport::createExpectedCall(unsigned int minimumCalls, unsigned int maximumCalls, const SimpleString& functionName)
+{
+    const SimpleString scopeFunctionName = appendScopeToName(functionName);
+
+    MockCheckedExpectedCall* call = new MockCheckedExpectedCall(minimumCalls, maximumCalls);
+    call->withName(scopeFunctionName);
+    expectationsIndex_.addExpectedCall(scopeFunctionName, call);
+    expectations_.addExpectedCall(call);
+    return call;
+}
+
+void MockSupport::expectCallsFromFile(const SimpleString& fileName)
+{
+    if (!enabled_) return;
+
+    if (expectationsFile_) {
+        failTestWithCallFileError(fileName, 0, SimpleString("calls are already expected from ") + expectationsFile_->getFileName());
+        return;
+    }
+
+    expectationsFile_ = new MockCallFileReader(fileName);
+    if (!expectationsFile_->isOpen()) {
+        failTestWithCallFileError(fileName, 0, "cannot open the file");
+        return;
+    }
+    advanceExpectationsFile();
+}
+
+bool MockSupport::advanceExpectationsFile()
+{
+    /* The last actual call can still refer to the expectations retired while it was made */
+    if (lastActualFunctionCall_ == NULLPTR) retiredFileExpectations_.deleteAllExpectationsAndClearList();
+
+    if (expectationsFile_ == NULLPTR) return true;
+    if (fileExpectation_ && fileExpectation_->canMatchActualCalls()) return true;
+    retireFileExpectation();
+
+    if (!expectationsFile_->readNextCall()) {
+        if (!expectationsFile_->getError().isEmpty()) {
+            failTestWithCallFileError(expectationsFile_->getFileName(), expectationsFile_->getLineNumber(), expectationsFile_->getError());
+            return false;
+        }
+        delete expectationsFile_;
+        expectationsFile_ = NULLPTR;
+        return true;
+    }
+
+    countCheck();
+    fileExpectation_ = createExpectedCall(1, 1, expectationsFile_->getFunctionName());
+    if (!expectationsFile_->applyTo(*fileExpectation_)) {
+        failTestWithCallFileError(expectationsFile_->getFileName(), expectationsFile_->getLineNumber(), expectationsFile_->getError());
+        return false;
+    }
+    return true;
+}
+
+void MockSupport::retireFileExpectation()
+{
+    if (fileExpectation_ == NULLPTR) return;
+
+    expectations_.removeExpectedCall(fileExpectation_);
+    expectationsIndex_.removeExpectedCall(fileExpectation_);
+    if (lastActualFunctionCall_) retiredFileExpectations_.addExpectedCall(fileExpectation_);
+    else delete fileExpectation_;
+    fileExpectation_ = NULLPTR;
+}
+
+void MockSupport::recordActualCallsToFile(const SimpleString& fileName)
+{
+    finishLastActualCall();
+    stopRecordingActualCalls();
+
+    callRecorder_ = new MockCallFileWriter(fileName);
+    if (!callRecorder_->isOpen())
+        failTestWithCallFileError(fileName, 0, "cannot create the file");
+}
+
+void MockSupport::stopRecordingActualCalls()
+{
+    delete callRecorder_;
+    callRecorder_ = NULLPTR;
+}
+
+void MockSupport::clearCallFiles()
 {
-    lastActualFunctionCall_ = new MockCheckedActualCall(++actualCallOrder_, activeReporter_, expectations_);
+    delete expectationsFile_;
+    expectationsFile_ = NULLPTR;
+    fileExpectation_ = NULLPTR;
+    retiredFileExpectations_.deleteAllExpectationsAndClearList();
+    stopRecordingActualCalls();
+}
+
+void MockSupport::addHandle(MockSupportHandle* handle)
+{
+    handle->nextHandle_ = handles_;
+    handles_ = handle;
+}
+
+void MockSupport::clearHandles()
+{
+    while (handles_) {
+        MockSupportHandle* next = handles_->nextHandle_;
+        delete handles_;
+        handles_ = next;
+    }
+}
+
+void MockSupport::failTestWithCallFileError(const SimpleString& fileName, size_t lineNumber, const SimpleString& message)
+{
+    MockCallFileFailure failure(activeReporter_->getTestToFail(), fileName, lineNumber, message);
+    failTest(failure);
+}
+
+MockCheckedActualCall* MockSupport::createActualCall(const char* internedFunctionName)
+{
+    /* Calls ordered per thread are checked while replaying the concurrent calls instead */
+    unsigned int callOrder = ++actualCallOrder_;
+    if (concurrentCalls_ && concurrentCalls_->isOrderPerThread()) callOrder = MockCheckedExpectedCall::NO_EXPECTED_CALL_ORDER;
+
+    /*
+     * The first expectation for the function that can still match is normally the one the call
+     * is for, so the call is matched against it alone and only falls back to all candidates when
+     * it doesn't match. The candidates are filtered while being copied, so they are walked once.
+     */
+    MockCheckedExpectedCall* expectedNextCall = expectationsIndex_.firstPotentiallyMatchingExpectationFor(internedFunctionName);
+    if (expectedNextCall && isFirstExpectationDueAt(expectedNextCall, callOrder))
+        lastActualFunctionCall_ = new MockCheckedActualCall(callOrder, activeReporter_, expectations_,
+                                                            expectationsIndex_.expectationsFor(internedFunctionName), expectedNextCall);
+    else
+        lastActualFunctionCall_ = new MockCheckedActualCall(callOrder, activeReporter_, expectations_,
+                                                            expectationsIndex_.expectationsFor(internedFunctionName));
     return lastActualFunctionCall_;
 }
 
-bool MockSupport::callIsIgnored(const SimpleString& functionName)
+bool MockSupport::isFirstExpectationDueAt(const MockCheckedExpectedCall* expectation, unsigned int callOrder) const
 {
-    return ignoreOtherCalls_ && !expectations_.hasExpectationWithName(functionName);
+    /* Expectations ignoring other parameters are only preferred when nothing else matches */
+    if (expectation->isIgnoringOtherParameters()) return false;
+    return !strictOrdering_ || expectation->isExpectedAtCallOrder(callOrder);
 }
 
-MockActualCall& MockSupport::actualCall(const SimpleString& functionName)
+bool MockSupport::callIsIgnored(const char* internedFunctionName)
 {
-    const SimpleString scopeFunctionName = appendScopeToName(functionName);
+    return ignoreOtherCalls_ && !expectationsIndex_.hasExpectationWithName(internedFunctionName);
+}
 
+void MockSupport::finishLastActualCall()
+{
     if (lastActualFunctionCall_) {
         lastActualFunctionCall_->checkExpectations();
+        checkCallOrderOf(lastActualFunctionCall_);
+        /* A range of calls has no place in the call order, so its calls do not count there */
+        if (lastActualFunctionCall_->wasMatchedByRangeOfCalls()) actualCallOrder_--;
+        else if (fileExpectation_ && lastActualFunctionCall_->getMatchingExpectation() == fileExpectation_) actualCallOrder_--;
         delete lastActualFunctionCall_;
         lastActualFunctionCall_ = NULLPTR;
     }
+}
+
+MockActualCall& MockSupport::checkedActualCall(const SimpleString& scopeFunctionName, const char* internedFunctionName)
+{
+    if (callIsIgnored(internedFunctionName)) {
+        return MockIgnoredActualCall::instance();
+    }
+
+    MockCheckedActualCall* call = createActualCall(internedFunctionName);
+    call->withInternedName(scopeFunctionName, internedFunctionName);
+    return *call;
+}
+
+MockActualCall& MockSupport::actualCall(const SimpleString& functionName)
+{
+    const SimpleString scopeFunctionName = appendScopeToName(functionName);
+    if (concurrentCalls_) return concurrentCalls_->record(*this, scopeFunctionName);
+
+    return actualCallWithScopedName(scopeFunctionName);
+}
+
+MockActualCall& MockSupport::actualCallWithScopedName(const SimpleString& scopeFunctionName)
+{
+    finishLastActualCall();
 
     if (!enabled_) return MockIgnoredActualCall::instance();
     if (tracing_) return MockActualCallTrace::instance().withName(scopeFunctionName);
+    if (callRecorder_) return callRecorder_->startCall(scopeFunctionName.subString(mockName_.isEmpty() ? 0 : mockName_.size() + 2));
+    if (!advanceExpectationsFile()) return MockIgnoredActualCall::instance();
 
+    /* Names of expected calls are interned; a name without a handle is compared as a string */
+    return checkedActualCall(scopeFunctionName, expectationsIndex_.findName(scopeFunctionName));
+}
 
-    if (callIsIgnored(scopeFunctionName)) {
-        return MockIgnoredActualCall::instance();
+bool MockSupport::isResolvedFor(const MockSupport* support, const MockFunctionId& function)
+{
+    return function.support_ == support && function.resolvedAtClear_ == clearCount_;
+}
+
+MockActualCall& MockSupport::actualCall(MockFunctionId& function)
+{
+    if (concurrentCalls_) return concurrentCalls_->record(*this, appendScopeToName(function.functionName_));
+
+    /* The interned name is the scoped name and stays valid until this support is cleared */
+    if (!isResolvedFor(this, function)) {
+        function.internedName_ = expectationsIndex_.internName(appendScopeToName(function.functionName_));
+        function.support_ = this;
+        function.resolvedAtClear_ = clearCount_;
     }
 
-    MockCheckedActualCall* call = createActualCall();
-    call->withName(scopeFunctionName);
-    return *call;
+    finishLastActualCall();
+
+    if (!enabled_) return MockIgnoredActualCall::instance();
+    if (tracing_) return MockActualCallTrace::instance().withName(function.internedName_);
+    if (callRecorder_) return callRecorder_->startCall(function.functionName_);
+    if (!advanceExpectationsFile()) return MockIgnoredActualCall::instance();
+
+    return checkedActualCall(function.internedName_, function.internedName_);
 }
 
 void MockSupport::ignoreOtherCalls()
@@ -238,6 +490,120 @@ void MockSupport::tracing(bool enabled)
         if (getMockSupport(p)) getMockSupport(p)->tracing(enabled);
 }
 
+void MockSupport::tracingToRingBuffer(size_t maximumEvents, MockActualCallTrace::OverflowPolicy policy)
+{
+    MockActualCallTrace::instance().useRingBuffer(maximumEvents, policy);
+    tracing(true);
+}
+
+void MockSupport::concurrentRecording(bool enabled, bool strictOrderPerThread)
+{
+    if (!enabled) {
+        replayConcurrentCalls();
+        setConcurrentCalls(NULLPTR);
+        return;
+    }
+
+    if (concurrentCalls_ && concurrentCalls_->isOrderPerThread() == strictOrderPerThread) return;
+
+    replayConcurrentCalls();
+    finishLastActualCall();
+    /* The old log goes first, as each log wraps the string allocator it found */
+    setConcurrentCalls(NULLPTR);
+    setConcurrentCalls(new MockConcurrentCallLog(strictOrderPerThread));
+    ownsConcurrentCalls_ = true;
+}
+
+bool MockSupport::isRecordingConcurrently() const
+{
+    return concurrentCalls_ != NULLPTR;
+}
+
+bool MockSupport::isCalledFromARecordingThread() const
+{
+    return concurrentCalls_ != NULLPTR && concurrentCalls_->isCalledFromAnotherThread();
+}
+
+void MockSupport::setConcurrentCalls(MockConcurrentCallLog* concurrentCalls)
+{
+    if (ownsConcurrentCalls_) delete concurrentCalls_;
+    concurrentCalls_ = concurrentCalls;
+    ownsConcurrentCalls_ = false;
+
+    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
+        if (getMockSupport(p)) getMockSupport(p)->setConcurrentCalls(concurrentCalls);
+}
+
+struct MockThreadCallOrder
+{
+    MockThreadCallOrder(const MockSupport* support, unsigned int threadIndex, MockThreadCallOrder* next)
+        : support_(support), threadIndex_(threadIndex), lastCallOrder_(0), next_(next) {}
+
+    const MockSupport* support_;
+    unsigned int threadIndex_;
+    unsigned int lastCallOrder_;
+    MockThreadCallOrder* next_;
+};
+
+static MockThreadCallOrder* threadCallOrderFor(MockThreadCallOrder*& orders, const MockSupport* support, unsigned int threadIndex)
+{
+    for (MockThreadCallOrder* order = orders; order; order = order->next_)
+        if (order->support_ == support && order->threadIndex_ == threadIndex)
+            return order;
+
+    orders = new MockThreadCallOrder(support, threadIndex, orders);
+    return orders;
+}
+
+void MockSupport::replayConcurrentCalls()
+{
+    if (concurrentCalls_ == NULLPTR) return;
+
+    SimpleString missingScope = concurrentCalls_->takeMissingScope();
+    if (!missingScope.isEmpty()) {
+        MockScopeCreatedWhileRecordingFailure failure(activeReporter_->getTestToFail(), missingScope);
+        failTest(failure);
+        return;
+    }
+
+    const bool orderPerThread = concurrentCalls_->isOrderPerThread();
+    MockRecordedActualCall* call = concurrentCalls_->takeCalls();
+    MockThreadCallOrder* orders = NULLPTR;
+
+    while (call) {
+        /* A failure clears this support, and with it the supports of the remaining calls */
+        if (concurrentCalls_) {
+            MockSupport& support = call->getSupport();
+            call->replayOn(support.actualCallWithScopedName(call->getFunctionName()));
+
+            MockCheckedActualCall* actualCall = support.lastActualFunctionCall_;
+            if (actualCall) actualCall->checkExpectations();
+            if (actualCall) support.checkCallOrderOf(actualCall);
+
+            MockCheckedExpectedCall* expectation = (actualCall) ? actualCall->getMatchingExpectation() : NULLPTR;
+            if (orderPerThread && expectation && expectation->getExpectedCallOrder() != MockCheckedExpectedCall::NO_EXPECTED_CALL_ORDER) {
+                MockThreadCallOrder* order = threadCallOrderFor(orders, &support, call->getThreadIndex());
+                if (expectation->getExpectedCallOrder() < order->lastCallOrder_) {
+                    expectation->callWasMadeOutOfOrder();
+                    support.callsOutOfOrder_ = true;
+                }
+                else
+                    order->lastCallOrder_ = expectation->getExpectedCallOrder();
+            }
+        }
+
+        MockRecordedActualCall* next = call->getNext();
+        delete call;
+        call = next;
+    }
+
+    while (orders) {
+        MockThreadCallOrder* next = orders->next_;
+        delete orders;
+        orders = next;
+    }
+}
+
 const char* MockSupport::getTraceOutput()
 {
     return MockActualCallTrace::instance().getTraceOutput();
@@ -245,7 +611,8 @@ const char* MockSupport::getTraceOutput()
 
 bool MockSupport::expectedCallsLeft()
 {
-    int callsLeft = expectations_.hasUnfulfilledExpectations();
+    int callsLeft = expectations_.hasUnfulfilledExpectations() || hasUnfulfilledTypedExpectations();
+    if (expectationsFile_ && expectationsFile_->hasMoreCalls()) callsLeft++;
 
     for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
         if (getMockSupport(p)) callsLeft += getMockSupport(p)->expectedCallsLeft();
@@ -265,29 +632,99 @@ bool MockSupport::wasLastActualCallFulfilled()
     return true;
 }
 
-void MockSupport::failTestWithExpectedCallsNotFulfilled()
+void MockSupport::addExpectationsOfAllScopesTo(MockExpectedCallsList& expectationsList)
 {
-    MockExpectedCallsList expectationsList;
     expectationsList.addExpectations(expectations_);
 
     for(MockNamedValueListNode *p = data_.begin();p;p = p->next())
         if(getMockSupport(p))
             expectationsList.addExpectations(getMockSupport(p)->expectations_);
+}
+
+MockFailure MockSupport::createExpectedCallsNotFulfilledFailure()
+{
+    MockExpectedCallsList expectationsList;
+    addExpectationsOfAllScopesTo(expectationsList);
+
+    MockTypedFunction* typedFunction = getTypedFunctionWithUnfulfilledExpectations();
+    if (!expectationsList.hasUnfulfilledExpectations() && typedFunction)
+        return MockExpectedTypedCallsDidntHappenFailure(activeReporter_->getTestToFail(), *typedFunction);
+
+    return MockExpectedCallsDidntHappenFailure(activeReporter_->getTestToFail(), expectationsList);
+}
 
-    MockExpectedCallsDidntHappenFailure failure(activeReporter_->getTestToFail(), expectationsList);
+void MockSupport::failTestWithExpectedCallsNotFulfilled()
+{
+    /* The failure is built in its own frame so the list nodes are back in the arena before failTest() clears it */
+    MockFailure failure = createExpectedCallsNotFulfilledFailure();
     failTest(failure);
 }
 
-void MockSupport::failTestWithOutOfOrderCalls()
+void MockSupport::addTypedFunction(MockTypedFunction* function)
 {
-    MockExpectedCallsList expectationsList;
-    expectationsList.addExpectations(expectations_);
+    function->registeredWith_ = this;
+    function->nextRegistered_ = typedFunctions_;
+    typedFunctions_ = function;
+}
 
-    for(MockNamedValueListNode *p = data_.begin();p;p = p->next())
-        if(getMockSupport(p))
-            expectationsList.addExpectations(getMockSupport(p)->expectations_);
+void MockSupport::removeTypedFunction(MockTypedFunction* function)
+{
+    MockTypedFunction** p = &typedFunctions_;
+    while (*p && *p != function) p = &(*p)->nextRegistered_;
+    if (*p) *p = function->nextRegistered_;
 
-    MockCallOrderFailure failure(activeReporter_->getTestToFail(), expectationsList);
+    function->registeredWith_ = NULLPTR;
+    function->nextRegistered_ = NULLPTR;
+}
+
+void MockSupport::clearTypedFunctions()
+{
+    while (typedFunctions_) {
+        MockTypedFunction* function = typedFunctions_;
+        typedFunctions_ = function->nextRegistered_;
+        function->clearExpectations();
+        function->registeredWith_ = NULLPTR;
+        function->nextRegistered_ = NULLPTR;
+    }
+}
+
+bool MockSupport::hasUnfulfilledTypedExpectations()
+{
+    for (MockTypedFunction* function = typedFunctions_; function; function = function->nextRegistered_)
+        if (function->hasUnfulfilledExpectations())
+            return true;
+    return false;
+}
+
+MockTypedFunction* MockSupport::getTypedFunctionWithUnfulfilledExpectations()
+{
+    for (MockTypedFunction* function = typedFunctions_; function; function = function->nextRegistered_)
+        if (function->hasUnfulfilledExpectations())
+            return function;
+
+    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next()) {
+        MockTypedFunction* function = (getMockSupport(p)) ? getMockSupport(p)->getTypedFunctionWithUnfulfilledExpectations() : NULLPTR;
+        if (function) return function;
+    }
+    return NULLPTR;
+}
+
+void MockSupport::failTestWithUnexpectedTypedCall(const MockTypedFunction& function, const SimpleString& actualCall)
+{
+    MockUnexpectedTypedCallHappenedFailure failure(activeReporter_->getTestToFail(), actualCall, function);
+    failTest(failure);
+}
+
+MockFailure MockSupport::createCallOrderFailure()
+{
+    MockExpectedCallsList expectationsList;
+    addExpectationsOfAllScopesTo(expectationsList);
+    return MockCallOrderFailure(activeReporter_->getTestToFail(), expectationsList);
+}
+
+void MockSupport::failTestWithOutOfOrderCalls()
+{
+    MockFailure failure = createCallOrderFailure();
     failTest(failure);
 }
 
@@ -304,17 +741,26 @@ void MockSupport::countCheck()
 
 void MockSupport::checkExpectationsOfLastActualCall()
 {
-    if(lastActualFunctionCall_)
+    if(lastActualFunctionCall_) {
         lastActualFunctionCall_->checkExpectations();
+        checkCallOrderOf(lastActualFunctionCall_);
+    }
 
     for(MockNamedValueListNode *p = data_.begin();p;p = p->next())
-        if(getMockSupport(p) && getMockSupport(p)->lastActualFunctionCall_)
-            getMockSupport(p)->lastActualFunctionCall_->checkExpectations();
+        if(getMockSupport(p))
+            getMockSupport(p)->checkExpectationsOfLastActualCall();
+}
+
+void MockSupport::checkCallOrderOf(MockCheckedActualCall* call)
+{
+    /* Each call is checked against its expected order when it is made, so the expectations need no walk */
+    MockCheckedExpectedCall* expectation = call->getMatchingExpectation();
+    if (expectation && expectation->isOutOfOrder()) callsOutOfOrder_ = true;
 }
 
 bool MockSupport::hasCallsOutOfOrder()
 {
-    if (expectations_.hasCallsOutOfOrder())
+    if (callsOutOfOrder_)
     {
         return true;
     }
@@ -328,7 +774,9 @@ bool MockSupport::hasCallsOutOfOrder()
 
 void MockSupport::checkExpectations()
 {
+    replayConcurrentCalls();
     checkExpectationsOfLastActualCall();
+    if (!advanceExpectationsFile()) return;
 
     if (wasLastActualCallFulfilled() && expectedCallsLeft())
         failTestWithExpectedCallsNotFulfilled();
@@ -432,6 +880,7 @@ MockSupport* MockSupport::clone(const SimpleString& mockName)
     if (strictOrdering_) newMock->strictOrder();
 
     newMock->tracing(tracing_);
+    newMock->concurrentCalls_ = concurrentCalls_;
     newMock->installComparatorsAndCopiers(comparatorsAndCopiersRepository_);
     return newMock;
 }
@@ -441,13 +890,40 @@ MockSupport* MockSupport::getMockSupportScope(const SimpleString& name)
     SimpleString mockingSupportName = MOCK_SUPPORT_SCOPE_PREFIX;
     mockingSupportName += name;
 
-    if (hasData(mockingSupportName)) {
-        STRCMP_EQUAL("MockSupport", getData(mockingSupportName).getType().asCharString());
-        return (MockSupport*) getData(mockingSupportName).getObjectPointer();
+    MockNamedValue* scope = findMockSupportScope(mockingSupportName);
+    if (isCalledFromARecordingThread()) {
+        /* Only the test thread creates scopes, the calls go to this support and the replay fails */
+        if (scope) return (MockSupport*) scope->getObjectPointer();
+        concurrentCalls_->recordMissingScope(name);
+        return this;
     }
 
+    if (scope) {
+        STRCMP_EQUAL("MockSupport", scope->getType().asCharString());
+        return (MockSupport*) scope->getObjectPointer();
+    }
+    return createMockSupportScope(mockingSupportName, name);
+}
+
+/* While recording, the scopes are looked up by the recording threads too */
+MockNamedValue* MockSupport::findMockSupportScope(const SimpleString& mockingSupportName)
+{
+    if (concurrentCalls_ == NULLPTR) return data_.getValueByName(mockingSupportName);
+
+    ScopedMutexLock lock(concurrentCalls_->getMutex());
+    return data_.getValueByName(mockingSupportName);
+}
+
+MockSupport* MockSupport::createMockSupportScope(const SimpleString& mockingSupportName, const SimpleString& name)
+{
     MockSupport *newMock = clone(name);
 
+    if (concurrentCalls_ == NULLPTR) {
+        setDataObject(mockingSupportName, "MockSupport", newMock);
+        return newMock;
+    }
+
+    ScopedMutexLock lock(concurrentCalls_->getMutex());
     setDataObject(mockingSupportName, "MockSupport", newMock);
     return newMock;
 }
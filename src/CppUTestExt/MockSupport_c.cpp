@@ -115,6 +115,107 @@ public:
 
 static MockCFunctionCopierNode* copierList_ = NULLPTR;
 
+class MockFunctionHandle_c : public MockSupportHandle
+{
+public:
+    MockFunctionHandle_c(MockFunction_c* function, MockSupport* support)
+        : function_(function), support_(support), id_(function->name, (function->scope) ? function->scope : ""),
+          parameterNames_((function->parameterCount) ? new SimpleString[function->parameterCount] : NULLPTR)
+    {
+        for (size_t i = 0; i < function->parameterCount; i++)
+            parameterNames_[i] = function->parameters[i].name;
+    }
+
+    virtual ~MockFunctionHandle_c() _destructor_override
+    {
+        delete [] parameterNames_;
+        function_->resolved = NULLPTR;
+    }
+
+    MockFunction_c* function_;
+    MockSupport* support_;
+    MockFunctionId id_;
+    SimpleString* parameterNames_;
+};
+
+static MockFunctionHandle_c* resolveFunction_c(MockFunction_c* function)
+{
+    if (function->resolved == NULLPTR) {
+        MockSupport* support = &mock((function->scope) ? function->scope : "");
+        MockFunctionHandle_c* handle = new MockFunctionHandle_c(function, support);
+        support->addHandle(handle);
+        function->resolved = handle;
+    }
+    return (MockFunctionHandle_c*) function->resolved;
+}
+
+template <typename Call>
+static Call* withPositionalParameters_c(Call* call, const MockFunctionHandle_c* handle, va_list& arguments)
+{
+    const MockParameter_c* parameters = handle->function_->parameters;
+    for (size_t i = 0; i < handle->function_->parameterCount; i++) {
+        const SimpleString& name = handle->parameterNames_[i];
+        switch (parameters[i].type) {
+        case MOCKVALUETYPE_BOOL:
+            call = &call->withParameter(name, va_arg(arguments, int) != 0);
+            break;
+        case MOCKVALUETYPE_INTEGER:
+            call = &call->withParameter(name, va_arg(arguments, int));
+            break;
+        case MOCKVALUETYPE_UNSIGNED_INTEGER:
+            call = &call->withParameter(name, va_arg(arguments, unsigned int));
+            break;
+        case MOCKVALUETYPE_LONG_INTEGER:
+            call = &call->withParameter(name, va_arg(arguments, long int));
+            break;
+        case MOCKVALUETYPE_UNSIGNED_LONG_INTEGER:
+            call = &call->withParameter(name, va_arg(arguments, unsigned long int));
+            break;
+#ifdef CPPUTEST_USE_LONG_LONG
+        case MOCKVALUETYPE_LONG_LONG_INTEGER:
+            call = &call->withParameter(name, va_arg(arguments, cpputest_longlong));
+            break;
+        case MOCKVALUETYPE_UNSIGNED_LONG_LONG_INTEGER:
+            call = &call->withParameter(name, va_arg(arguments, cpputest_ulonglong));
+            break;
+#else
+        case MOCKVALUETYPE_LONG_LONG_INTEGER:
+        case MOCKVALUETYPE_UNSIGNED_LONG_LONG_INTEGER:
+            FAIL("Long Long type is not supported");
+            return call;
+#endif
+        case MOCKVALUETYPE_DOUBLE:
+            call = &call->withParameter(name, va_arg(arguments, double));
+            break;
+        case MOCKVALUETYPE_STRING:
+            call = &call->withParameter(name, va_arg(arguments, const char*));
+            break;
+        case MOCKVALUETYPE_POINTER:
+            call = &call->withParameter(name, va_arg(arguments, void*));
+            break;
+        case MOCKVALUETYPE_CONST_POINTER:
+            call = &call->withParameter(name, va_arg(arguments, const void*));
+            break;
+        case MOCKVALUETYPE_FUNCTIONPOINTER:
+            call = &call->withParameter(name, (cpputest_cpp_function_pointer) va_arg(arguments, void (*)(void)));
+            break;
+        case MOCKVALUETYPE_MEMORYBUFFER:
+        {
+            const unsigned char* buffer = va_arg(arguments, const unsigned char*);
+            call = &call->withParameter(name, buffer, va_arg(arguments, size_t));
+            break;
+        }
+        case MOCKVALUETYPE_OBJECT:
+            call = &call->withParameterOfType(parameters[i].typeName, name, va_arg(arguments, const void*));
+            break;
+        default:
+            FAIL("Unknown type of a positional mock parameter");
+            return call;
+        }
+    }
+    return call;
+}
+
 extern "C" {
 
 void strictOrder_c();
@@ -1104,4 +1205,51 @@ MockSupport_c* mock_scope_c(const char* scope)
     return &gMockSupport;
 }
 
+static MockFunctionHandle_c* useFunction_c(MockFunction_c* function)
+{
+    MockFunctionHandle_c* handle = resolveFunction_c(function);
+    currentMockSupport = handle->support_;
+    currentMockSupport->setActiveReporter(&failureReporterForC);
+    currentMockSupport->setDefaultComparatorsAndCopiersRepository();
+    return handle;
+}
+
+static MockExpectedCall_c* expectCalls_c(unsigned int number, MockFunction_c* function, va_list& arguments)
+{
+    MockFunctionHandle_c* handle = useFunction_c(function);
+    expectedCall = &currentMockSupport->expectNCalls(number, function->name);
+    expectedCall = withPositionalParameters_c(expectedCall, handle, arguments);
+    return &gExpectedCall;
+}
+
+MockExpectedCall_c* mock_c_expectCall(MockFunction_c* function, ...)
+{
+    va_list arguments;
+    va_start(arguments, function);
+    MockExpectedCall_c* call = expectCalls_c(1, function, arguments);
+    va_end(arguments);
+    return call;
+}
+
+MockExpectedCall_c* mock_c_expectNCalls(unsigned int number, MockFunction_c* function, ...)
+{
+    va_list arguments;
+    va_start(arguments, function);
+    MockExpectedCall_c* call = expectCalls_c(number, function, arguments);
+    va_end(arguments);
+    return call;
+}
+
+MockActualCall_c* mock_c_actualCall(MockFunction_c* function, ...)
+{
+    MockFunctionHandle_c* handle = useFunction_c(function);
+    actualCall = &currentMockSupport->actualCall(handle->id_);
+
+    va_list arguments;
+    va_start(arguments, function);
+    actualCall = withPositionalParameters_c(actualCall, handle, arguments);
+    va_end(arguments);
+    return &gActualCall;
+}
+
 }
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/PerfCountersPlugin.h"
+
+#if CPPUTEST_HAVE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char* const counterNames[PerfCountersPlugin::NUMBER_OF_COUNTERS] = {
+    "instructions", "cycles", "cache_misses", "branch_misses",
+    "task_clock_ns", "page_faults"
+};
+
+PerfCountersPlugin::PerfCountersPlugin(const SimpleString& name)
+    : TestPlugin(name), active_(false), openedInProcess_(0)
+{
+    for (int i = 0; i < NUMBER_OF_COUNTERS; i++)
+        handles_[i] = -1;
+}
+
+PerfCountersPlugin::~PerfCountersPlugin()
+{
+    closeCounters();
+}
+
+bool PerfCountersPlugin::parseArguments(int /* ac */, const char *const *av, int index)
+{
+    if (SimpleString(av[index]) != "-pperfcounters") return false;
+    activate();
+    return true;
+}
+
+void PerfCountersPlugin::activate()
+{
+    active_ = true;
+}
+
+bool PerfCountersPlugin::isCounting(Counter counter) const
+{
+    return handles_[counter] != -1;
+}
+
+const char* PerfCountersPlugin::nameOf(Counter counter)
+{
+    return counterNames[counter];
+}
+
+/*
+ * Counters count the thread that opened them, so a test running in a forked
+ * process (-p) opens its own and leaves the inherited ones alone.
+ */
+void PerfCountersPlugin::preTestAction(UtestShell&, TestResult&)
+{
+    if (!active_) return;
+
+    if (openedInProcess_ != currentProcess()) {
+        closeCounters();
+        openCounters();
+    }
+
+    for (int i = 0; i < NUMBER_OF_COUNTERS; i++)
+        if (handles_[i] != -1) startCounter(handles_[i]);
+}
+
+void PerfCountersPlugin::postTestAction(UtestShell&, TestResult& result)
+{
+    if (!active_) return;
+
+    for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+        unsigned long value = 0;
+        if (handles_[i] != -1 && stopCounter(handles_[i], value))
+            result.addCurrentTestCounter(counterNames[i], value);
+    }
+}
+
+void PerfCountersPlugin::openCounters()
+{
+    bool anyHardwareCounter = false;
+    for (int i = INSTRUCTIONS; i <= BRANCH_MISSES; i++) {
+        handles_[i] = openCounter((Counter) i);
+        anyHardwareCounter = anyHardwareCounter || (handles_[i] != -1);
+    }
+
+    if (!anyHardwareCounter)
+        for (int i = TASK_CLOCK; i <= PAGE_FAULTS; i++)
+            handles_[i] = openCounter((Counter) i);
+
+    openedInProcess_ = currentProcess();
+}
+
+void PerfCountersPlugin::closeCounters()
+{
+    for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+        if (handles_[i] != -1) closeCounter(handles_[i]);
+        handles_[i] = -1;
+    }
+    openedInProcess_ = 0;
+}
+
+#if CPPUTEST_HAVE_PERF_EVENT
+
+static const struct { __u32 type; __u64 config; } counterEvents[PerfCountersPlugin::NUMBER_OF_COUNTERS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+};
+
+int PerfCountersPlugin::openCounter(Counter counter)
+{
+    struct perf_event_attr attr;
+    PlatformSpecificMemset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counterEvents[counter].type;
+    attr.config = counterEvents[counter].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    /* The calling thread, on whatever cpu it runs */
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+void PerfCountersPlugin::startCounter(int handle)
+{
+    ioctl(handle, PERF_EVENT_IOC_RESET, 0);
+    ioctl(handle, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+bool PerfCountersPlugin::stopCounter(int handle, unsigned long& value)
+{
+    ioctl(handle, PERF_EVENT_IOC_DISABLE, 0);
+
+    __u64 count = 0;
+    if (read(handle, &count, sizeof(count)) != (ssize_t) sizeof(count)) return false;
+    value = (unsigned long) count;
+    return true;
+}
+
+void PerfCountersPlugin::closeCounter(int handle)
+{
+    close(handle);
+}
+
+long PerfCountersPlugin::currentProcess()
+{
+    return (long) getpid();
+}
+
+#else
+
+int PerfCountersPlugin::openCounter(Counter)
+{
+    return -1;
+}
+
+void PerfCountersPlugin::startCounter(int)
+{
+}
+
+bool PerfCountersPlugin::stopCounter(int, unsigned long&)
+{
+    return false;
+}
+
+void PerfCountersPlugin::closeCounter(int)
+{
+}
+
+long PerfCountersPlugin::currentProcess()
+{
+    return 1;
+}
+
+#endif
@@ -72,6 +72,24 @@ static void C2000RunTestInASeperateProcess(UtestShell* shell, TestPlugin* plugin
 void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell*, TestPlugin*, TestResult*) =
     C2000RunTestInASeperateProcess;
 
+static void DummyPlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+static void DummyPlatformSpecificStopWatchdog(void)
+{
+}
+
+void (*PlatformSpecificStartWatchdog)(UtestShell*, size_t) = DummyPlatformSpecificStartWatchdog;
+void (*PlatformSpecificStopWatchdog)(void) = DummyPlatformSpecificStopWatchdog;
+
+static int DummyPlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage*) = DummyPlatformSpecificGetResourceUsage;
+
 extern "C" {
 
 static int C2000SetJmp(void (*function) (void* data), void* data)
@@ -140,14 +158,46 @@ static void C2000FPuts(const char* str, PlatformSpecificFile file)
    fputs(str, (FILE*)file);
 }
 
+static void C2000FWrite(const void* buffer, size_t size, PlatformSpecificFile file)
+{
+   fwrite(buffer, 1, size, (FILE*)file);
+}
+
+static size_t C2000FRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+   return fread(buffer, 1, size, (FILE*)file);
+}
+
 static void C2000FClose(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static PlatformSpecificDirectory C2000OpenDir(const char* dirname)
+{
+    (void)dirname;
+    return NULLPTR;
+}
+
+static const char* C2000ReadDir(PlatformSpecificDirectory directory)
+{
+    (void)directory;
+    return NULLPTR;
+}
+
+static void C2000CloseDir(PlatformSpecificDirectory directory)
+{
+    (void)directory;
+}
+
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = C2000FOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = C2000FPuts;
+void (*PlatformSpecificFWrite)(const void* buffer, size_t size, PlatformSpecificFile file) = C2000FWrite;
+size_t (*PlatformSpecificFRead)(void* buffer, size_t size, PlatformSpecificFile file) = C2000FRead;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = C2000FClose;
+PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char* dirname) = C2000OpenDir;
+const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory directory) = C2000ReadDir;
+void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory directory) = C2000CloseDir;
 
 static int CL2000Putchar(int c)
 {
@@ -251,4 +301,11 @@ void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = DummyMutexDestroy;
 
+static unsigned long DummyGetThreadId(void)
+{
+    return 0;
+}
+
+unsigned long (*PlatformSpecificGetThreadId)(void) = DummyGetThreadId;
+
 }
\ No newline at end of file
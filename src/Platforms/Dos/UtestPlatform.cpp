@@ -76,6 +76,24 @@ void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell*, TestPlugin*, Test
 int (*PlatformSpecificFork)() = DummyPlatformSpecificFork;
 int (*PlatformSpecificWaitPid)(int, int*, int) = DummyPlatformSpecificWaitPid;
 
+static void DummyPlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+static void DummyPlatformSpecificStopWatchdog(void)
+{
+}
+
+void (*PlatformSpecificStartWatchdog)(UtestShell*, size_t) = DummyPlatformSpecificStartWatchdog;
+void (*PlatformSpecificStopWatchdog)(void) = DummyPlatformSpecificStopWatchdog;
+
+static int DummyPlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage*) = DummyPlatformSpecificGetResourceUsage;
+
 extern "C" {
 
 static int DosSetJmp(void (*function) (void* data), void* data)
@@ -133,14 +151,46 @@ static void DosFPuts(const char* str, PlatformSpecificFile file)
    fputs(str, (FILE*)file);
 }
 
+static void DosFWrite(const void* buffer, size_t size, PlatformSpecificFile file)
+{
+   fwrite(buffer, 1, size, (FILE*)file);
+}
+
+static size_t DosFRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+   return fread(buffer, 1, size, (FILE*)file);
+}
+
 static void DosFClose(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static PlatformSpecificDirectory DosOpenDir(const char* dirname)
+{
+    (void)dirname;
+    return NULLPTR;
+}
+
+static const char* DosReadDir(PlatformSpecificDirectory directory)
+{
+    (void)directory;
+    return NULLPTR;
+}
+
+static void DosCloseDir(PlatformSpecificDirectory directory)
+{
+    (void)directory;
+}
+
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = DosFOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = DosFPuts;
+void (*PlatformSpecificFWrite)(const void* buffer, size_t size, PlatformSpecificFile file) = DosFWrite;
+size_t (*PlatformSpecificFRead)(void* buffer, size_t size, PlatformSpecificFile file) = DosFRead;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = DosFClose;
+PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char* dirname) = DosOpenDir;
+const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory directory) = DosReadDir;
+void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory directory) = DosCloseDir;
 
 static int DosPutchar(int c)
 {
@@ -239,4 +289,11 @@ void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = DummyMutexDestroy;
 
+static unsigned long DummyGetThreadId(void)
+{
+    return 0;
+}
+
+unsigned long (*PlatformSpecificGetThreadId)(void) = DummyGetThreadId;
+
 }
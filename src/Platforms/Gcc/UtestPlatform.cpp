@@ -37,9 +37,13 @@
 #ifdef CPPUTEST_HAVE_GETTIMEOFDAY
 #include <sys/time.h>
 #endif
+#ifdef CPPUTEST_HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif
 #ifdef CPPUTEST_HAVE_FORK
 #include <unistd.h>
 #include <sys/wait.h>
+#include <sys/mman.h>
 #include <errno.h>
 #endif
 
@@ -51,16 +55,64 @@
 #include <math.h>
 #include <ctype.h>
 #include <signal.h>
+#include <dirent.h>
 
 #ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
 #include <pthread.h>
 #endif
+#ifdef __GLIBC__
+#include <execinfo.h>
+#endif
 
 #include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/TestResultChannel.h"
 
 static jmp_buf test_exit_jmp_buf[10];
 static int jmp_buf_index = 0;
 
+#ifdef CPPUTEST_HAVE_GETRUSAGE
+
+static void ResourceUsageFrom(const struct rusage& from, TestResourceUsage* usage)
+{
+    usage->userTimeInMicroseconds_ = (unsigned long) from.ru_utime.tv_sec * 1000000 + (unsigned long) from.ru_utime.tv_usec;
+    usage->systemTimeInMicroseconds_ = (unsigned long) from.ru_stime.tv_sec * 1000000 + (unsigned long) from.ru_stime.tv_usec;
+#ifdef __APPLE__
+    usage->peakResidentSetInKilobytes_ = (unsigned long) from.ru_maxrss / 1024;
+#else
+    usage->peakResidentSetInKilobytes_ = (unsigned long) from.ru_maxrss;
+#endif
+    usage->majorPageFaults_ = (unsigned long) from.ru_majflt;
+    usage->minorPageFaults_ = (unsigned long) from.ru_minflt;
+    usage->voluntaryContextSwitches_ = (unsigned long) from.ru_nvcsw;
+    usage->involuntaryContextSwitches_ = (unsigned long) from.ru_nivcsw;
+}
+
+/* Per thread where possible, so tests running on parallel workers don't see each other */
+#ifdef RUSAGE_THREAD
+#define CPPUTEST_RUSAGE_WHO RUSAGE_THREAD
+#else
+#define CPPUTEST_RUSAGE_WHO RUSAGE_SELF
+#endif
+
+static int GccPlatformSpecificGetResourceUsage(TestResourceUsage* usage)
+{
+    struct rusage self;
+    if (getrusage(CPPUTEST_RUSAGE_WHO, &self) != 0) return 0;
+    ResourceUsageFrom(self, usage);
+    return 1;
+}
+
+#else
+
+static int GccPlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
+#endif
+
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage* usage) = GccPlatformSpecificGetResourceUsage;
+
 #ifndef CPPUTEST_HAVE_FORK
 
 static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, TestPlugin*, TestResult* result)
@@ -80,10 +132,38 @@ static int PlatformSpecificWaitPidImplementation(int, int*, int)
 
 #else
 
-static void SetTestFailureByStatusCode(UtestShell* shell, TestResult* result, int status)
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+static const size_t separateProcessResultChannelSize = 64 * 1024;
+
+class SeparateProcessResultChannelMemory
+{
+public:
+    SeparateProcessResultChannelMemory() : memory_(mmap(NULLPTR, separateProcessResultChannelSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0))
+    {
+        if (memory_ == MAP_FAILED) memory_ = NULLPTR;
+    }
+
+    ~SeparateProcessResultChannelMemory()
+    {
+        if (memory_) munmap(memory_, separateProcessResultChannelSize);
+    }
+
+    void* memory() const { return memory_; }
+
+private:
+    void* memory_;
+};
+
+static void SetTestFailureByStatusCode(UtestShell* shell, TestResult* result, int status, bool failureAlreadyReported, bool timedOut)
 {
     if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+        if (failureAlreadyReported) return;
         result->addFailure(TestFailure(shell, "Failed in separate process"));
+    } else if (WIFSIGNALED(status) && timedOut) {
+        result->addFailure(TestFailure(shell, StringFromFormat("Failed in separate process - timed out after %lu ms", (unsigned long) shell->getTimeout())));
     } else if (WIFSIGNALED(status)) {
         SimpleString message("Failed in separate process - killed by signal ");
         message += StringFrom(WTERMSIG(status));
@@ -93,12 +173,60 @@ static void SetTestFailureByStatusCode(UtestShell* shell, TestResult* result, in
     }
 }
 
+/*
+ * The real waitpid reaps with wait4 so the child's resource usage can be
+ * handed to the result. Replacement waitpids leave it unmeasured.
+ */
+static TestResourceUsage reapedChildResourceUsage;
+
+static void ReportReapedChildResourceUsage(TestResult* result)
+{
+    if (reapedChildResourceUsage.measured_)
+        result->addSeparateProcessResourceUsage(reapedChildResourceUsage);
+    reapedChildResourceUsage = TestResourceUsage();
+}
+
+static long MonotonicTimeInMillis()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/*
+ * Without a deadline this blocks like waitpid. With one it polls, backing off
+ * up to a few milliseconds, and kills the child once the deadline has passed.
+ */
+static pid_t WaitPidUntil(pid_t pid, int* status, long deadline, bool& timedOut)
+{
+    if (deadline == 0) return PlatformSpecificWaitPid(pid, status, WUNTRACED);
+
+    long pollInMicros = 50;
+    for (;;) {
+        pid_t w = PlatformSpecificWaitPid(pid, status, WUNTRACED | WNOHANG);
+        if (w != 0) return w;
+        if (MonotonicTimeInMillis() >= deadline) {
+            timedOut = true;
+            kill(pid, SIGKILL);
+            return PlatformSpecificWaitPid(pid, status, WUNTRACED);
+        }
+        struct timespec poll = { 0, pollInMicros * 1000 };
+        nanosleep(&poll, NULLPTR);
+        if (pollInMicros < 5000) pollInMicros *= 2;
+    }
+}
+
 static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, TestPlugin* plugin, TestResult* result)
 {
     const pid_t syscallError = -1;
     pid_t cpid;
     pid_t w;
     int status = 0;
+    bool timedOut = false;
+    SeparateProcessResultChannelMemory channelMemory;
+    TestResultChannel channel(channelMemory.memory(), separateProcessResultChannelSize);
+    channel.clear();
+    reapedChildResourceUsage = TestResourceUsage();
 
     cpid = PlatformSpecificFork();
 
@@ -108,13 +236,19 @@ static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, Test
     }
 
     if (cpid == 0) {            /* Code executed by child */
+        if (channelMemory.memory()) {                                  // LCOV_EXCL_LINE
+            TestResultChannelWriter channelResult(*result, channel);   // LCOV_EXCL_LINE
+            shell->runOneTestInCurrentProcess(plugin, channelResult);  // LCOV_EXCL_LINE
+            _exit(channel.getFailureCount() != 0);                     // LCOV_EXCL_LINE
+        }
         const size_t initialFailureCount = result->getFailureCount(); // LCOV_EXCL_LINE
         shell->runOneTestInCurrentProcess(plugin, *result);        // LCOV_EXCL_LINE
         _exit(initialFailureCount < result->getFailureCount());    // LCOV_EXCL_LINE
     } else {                    /* Code executed by parent */
+        const long deadline = shell->getTimeout() ? MonotonicTimeInMillis() + (long) shell->getTimeout() : 0;
         size_t amountOfRetries = 0;
         do {
-            w = PlatformSpecificWaitPid(cpid, &status, WUNTRACED);
+            w = WaitPidUntil(cpid, &status, deadline, timedOut);
             if (w == syscallError) {
                 // OS X debugger causes EINTR
                 if (EINTR == errno) {
@@ -129,7 +263,11 @@ static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, Test
                     return;
                 }
             } else {
-                SetTestFailureByStatusCode(shell, result, status);
+                if (WIFEXITED(status) || WIFSIGNALED(status)) {
+                    channel.replayInto(shell, *result);
+                    ReportReapedChildResourceUsage(result);
+                }
+                SetTestFailureByStatusCode(shell, result, status, channel.getFailureCount() != 0, timedOut);
                 if (WIFSTOPPED(status)) kill(w, SIGCONT);
             }
         } while ((w == syscallError) || (!WIFEXITED(status) && !WIFSIGNALED(status)));
@@ -143,7 +281,17 @@ static pid_t PlatformSpecificForkImplementation(void)
 
 static pid_t PlatformSpecificWaitPidImplementation(int pid, int* status, int options)
 {
+#ifdef CPPUTEST_HAVE_GETRUSAGE
+    struct rusage childUsage;
+    pid_t w = wait4(pid, status, options, &childUsage);
+    if (w > 0 && (WIFEXITED(*status) || WIFSIGNALED(*status))) {
+        ResourceUsageFrom(childUsage, &reapedChildResourceUsage);
+        reapedChildResourceUsage.measured_ = true;
+    }
+    return w;
+#else
     return waitpid(pid, status, options);
+#endif
 }
 
 #endif
@@ -158,6 +306,149 @@ void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell* shell, TestPlugin*
 int (*PlatformSpecificFork)(void) = PlatformSpecificForkImplementation;
 int (*PlatformSpecificWaitPid)(int, int*, int) = PlatformSpecificWaitPidImplementation;
 
+///////////// Watchdog
+
+#if defined(CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK) && defined(CPPUTEST_HAVE_FORK)
+
+/*
+ * One watchdog thread per process waits for the deadline of the running test.
+ * When it passes, the test is named on stderr and the test thread is sent
+ * SIGABRT, which dumps its stack where the C library can and aborts.
+ * Deadlines use the monotonic clock where the condition can wait on it, so
+ * setting the wall clock during a test neither fires nor delays the watchdog.
+ */
+#ifdef __APPLE__
+#define WATCHDOG_CLOCK CLOCK_REALTIME
+#else
+#define WATCHDOG_CLOCK CLOCK_MONOTONIC
+#endif
+
+static pthread_mutex_t watchdogMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t watchdogCondition = PTHREAD_COND_INITIALIZER;
+static pid_t watchdogProcess = 0;
+static bool watchdogArmed = false;
+static struct timespec watchdogDeadline;
+static unsigned long watchdogTimeout = 0;
+static pthread_t watchdogTestThread;
+static char watchdogTestName[256];
+static char watchdogTestLocation[256];
+
+/* Runs on the test thread, so only backtrace() can capture its frames; it is
+ * preloaded when the watchdog starts so it no longer loads libgcc here. */
+static void WatchdogAbortWithStack(int)
+{
+#ifdef __GLIBC__
+    static const char header[] = "Stack of the test thread:\n";
+    void* frames[64];
+    int depth = backtrace(frames, 64);
+    if (write(2, header, sizeof(header) - 1) >= 0)
+        backtrace_symbols_fd(frames, depth, 2);
+#endif
+    signal(SIGABRT, SIG_DFL);
+    abort();
+}
+
+static void WatchdogPreloadBacktrace()
+{
+#ifdef __GLIBC__
+    void* frame[1];
+    (void) backtrace(frame, 1);
+#endif
+}
+
+static void WatchdogInitCondition()
+{
+#ifndef __APPLE__
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, WATCHDOG_CLOCK);
+    pthread_cond_init(&watchdogCondition, &attributes);
+    pthread_condattr_destroy(&attributes);
+#endif
+}
+
+static bool WatchdogDeadlinePassed()
+{
+    struct timespec now;
+    clock_gettime(WATCHDOG_CLOCK, &now);
+    return (now.tv_sec > watchdogDeadline.tv_sec) || (now.tv_sec == watchdogDeadline.tv_sec && now.tv_nsec >= watchdogDeadline.tv_nsec);
+}
+
+static void* WatchdogThread(void*)
+{
+    pthread_mutex_lock(&watchdogMutex);
+    for (;;) {
+        if (!watchdogArmed)
+            pthread_cond_wait(&watchdogCondition, &watchdogMutex);
+        else if (pthread_cond_timedwait(&watchdogCondition, &watchdogMutex, &watchdogDeadline) == ETIMEDOUT && watchdogArmed && WatchdogDeadlinePassed())
+            break;
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "\n%s: error: %s timed out after %lu ms\n", watchdogTestLocation, watchdogTestName, watchdogTimeout);
+    signal(SIGABRT, WatchdogAbortWithStack);
+    pthread_kill(watchdogTestThread, SIGABRT);
+
+    /* In case the test thread blocks the signal */
+    sleep(1);
+    abort();
+}
+
+static void WatchdogCopy(char* to, const SimpleString& from)
+{
+    SimpleString::StrNCpy(to, from.asCharString(), 255);
+    to[255] = '\0';
+}
+
+static void GccPlatformSpecificStartWatchdog(UtestShell* shell, size_t timeoutInMillis)
+{
+    WatchdogCopy(watchdogTestName, shell->getFormattedName());
+    WatchdogCopy(watchdogTestLocation, StringFromFormat("%s:%lu", shell->getFile().asCharString(), (unsigned long) shell->getLineNumber()));
+
+    pthread_mutex_lock(&watchdogMutex);
+    if (watchdogProcess != getpid()) {
+        pthread_t thread;
+        WatchdogPreloadBacktrace();
+        WatchdogInitCondition();
+        if (pthread_create(&thread, NULLPTR, WatchdogThread, NULLPTR) == 0) pthread_detach(thread);
+        watchdogProcess = getpid();
+    }
+    clock_gettime(WATCHDOG_CLOCK, &watchdogDeadline);
+    watchdogDeadline.tv_sec += (time_t) (timeoutInMillis / 1000);
+    watchdogDeadline.tv_nsec += (long) (timeoutInMillis % 1000) * 1000000;
+    if (watchdogDeadline.tv_nsec >= 1000000000) {
+        watchdogDeadline.tv_sec++;
+        watchdogDeadline.tv_nsec -= 1000000000;
+    }
+    watchdogTimeout = (unsigned long) timeoutInMillis;
+    watchdogTestThread = pthread_self();
+    watchdogArmed = true;
+    pthread_cond_signal(&watchdogCondition);
+    pthread_mutex_unlock(&watchdogMutex);
+}
+
+static void GccPlatformSpecificStopWatchdog()
+{
+    pthread_mutex_lock(&watchdogMutex);
+    watchdogArmed = false;
+    pthread_mutex_unlock(&watchdogMutex);
+}
+
+#else
+
+static void GccPlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+static void GccPlatformSpecificStopWatchdog()
+{
+}
+
+#endif
+
+void (*PlatformSpecificStartWatchdog)(UtestShell* shell, size_t timeoutInMillis) = GccPlatformSpecificStartWatchdog;
+void (*PlatformSpecificStopWatchdog)(void) = GccPlatformSpecificStopWatchdog;
+
 extern "C" {
 
 static int PlatformSpecificSetJmpImplementation(void (*function) (void* data), void* data)
@@ -251,11 +542,41 @@ static void PlatformSpecificFPutsImplementation(const char* str, PlatformSpecifi
    fputs(str, (FILE*)file);
 }
 
+static void PlatformSpecificFWriteImplementation(const void* buffer, size_t size, PlatformSpecificFile file)
+{
+   fwrite(buffer, 1, size, (FILE*)file);
+}
+
+static size_t PlatformSpecificFReadImplementation(void* buffer, size_t size, PlatformSpecificFile file)
+{
+   return fread(buffer, 1, size, (FILE*)file);
+}
+
 static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static PlatformSpecificDirectory PlatformSpecificOpenDirImplementation(const char* dirname)
+{
+   return opendir(dirname);
+}
+
+static const char* PlatformSpecificReadDirImplementation(PlatformSpecificDirectory directory)
+{
+   struct dirent* entry;
+   while ((entry = readdir((DIR*)directory)) != NULLPTR) {
+      if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+         return entry->d_name;
+   }
+   return NULLPTR;
+}
+
+static void PlatformSpecificCloseDirImplementation(PlatformSpecificDirectory directory)
+{
+   closedir((DIR*)directory);
+}
+
 static void PlatformSpecificFlushImplementation()
 {
   fflush(stdout);
@@ -263,8 +584,14 @@ static void PlatformSpecificFlushImplementation()
 
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+void (*PlatformSpecificFWrite)(const void*, size_t, PlatformSpecificFile) = PlatformSpecificFWriteImplementation;
+size_t (*PlatformSpecificFRead)(void*, size_t, PlatformSpecificFile) = PlatformSpecificFReadImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
 
+PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char*) = PlatformSpecificOpenDirImplementation;
+const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory) = PlatformSpecificReadDirImplementation;
+void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory) = PlatformSpecificCloseDirImplementation;
+
 int (*PlatformSpecificPutchar)(int) = putchar;
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
 
@@ -351,4 +678,15 @@ void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = PThreadMutexLock;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = PThreadMutexUnlock;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = PThreadMutexDestroy;
 
+static unsigned long PThreadGetThreadId(void)
+{
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+    return (unsigned long) pthread_self();
+#else
+    return 0;
+#endif
+}
+
+unsigned long (*PlatformSpecificGetThreadId)(void) = PThreadGetThreadId;
+
 }
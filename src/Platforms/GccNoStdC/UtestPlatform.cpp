@@ -38,6 +38,9 @@
 void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell*, TestPlugin*, TestResult*) = NULLPTR;
 int (*PlatformSpecificFork)() = NULLPTR;
 int (*PlatformSpecificWaitPid)(int, int*, int) = NULLPTR;
+void (*PlatformSpecificStartWatchdog)(UtestShell*, size_t) = NULLPTR;
+void (*PlatformSpecificStopWatchdog)(void) = NULLPTR;
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage*) = NULLPTR;
 
 TestOutput::WorkingEnvironment PlatformSpecificGetWorkingEnvironment()
 {
@@ -54,8 +57,14 @@ const char* (*GetPlatformSpecificTimeString)() = NULLPTR;
 /* IO operations */
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = NULLPTR;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = NULLPTR;
+void (*PlatformSpecificFWrite)(const void* buffer, size_t size, PlatformSpecificFile file) = NULLPTR;
+size_t (*PlatformSpecificFRead)(void* buffer, size_t size, PlatformSpecificFile file) = NULLPTR;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = NULLPTR;
 
+PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char* dirname) = NULLPTR;
+const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory directory) = NULLPTR;
+void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory directory) = NULLPTR;
+
 int (*PlatformSpecificPutchar)(int c) = NULLPTR;
 void (*PlatformSpecificFlush)(void) = NULLPTR;
 
@@ -77,6 +86,7 @@ PlatformSpecificMutex (*PlatformSpecificMutexCreate)(void) = NULLPTR;
 void (*PlatformSpecificMutexLock)(PlatformSpecificMutex mtx) = NULLPTR;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex mtx) = NULLPTR;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex mtx) = NULLPTR;
+unsigned long (*PlatformSpecificGetThreadId)(void) = NULLPTR;
 
 void (*PlatformSpecificSrand)(unsigned int) = NULLPTR;
 int (*PlatformSpecificRand)(void) = NULLPTR;
@@ -72,6 +72,24 @@ void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell*, TestPlugin*, Test
 int (*PlatformSpecificFork)() = DummyPlatformSpecificFork;
 int (*PlatformSpecificWaitPid)(int, int*, int) = DummyPlatformSpecificWaitPid;
 
+static void DummyPlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+static void DummyPlatformSpecificStopWatchdog(void)
+{
+}
+
+void (*PlatformSpecificStartWatchdog)(UtestShell*, size_t) = DummyPlatformSpecificStartWatchdog;
+void (*PlatformSpecificStopWatchdog)(void) = DummyPlatformSpecificStopWatchdog;
+
+static int DummyPlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage*) = DummyPlatformSpecificGetResourceUsage;
+
 extern "C"
 {
 
@@ -147,6 +165,15 @@ extern "C"
         printf("%s", str);
     }
 
+    static void PlatformSpecificFWriteImplementation(const void* buffer, size_t size, PlatformSpecificFile file)
+    {
+    }
+
+    static size_t PlatformSpecificFReadImplementation(void* buffer, size_t size, PlatformSpecificFile file)
+    {
+        return 0;
+    }
+
     static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
     {
     }
@@ -155,9 +182,31 @@ extern "C"
     {
     }
 
+    static PlatformSpecificDirectory PlatformSpecificOpenDirImplementation(const char* dirname)
+    {
+        (void)dirname;
+        return NULLPTR;
+    }
+
+    static const char* PlatformSpecificReadDirImplementation(PlatformSpecificDirectory directory)
+    {
+        (void)directory;
+        return NULLPTR;
+    }
+
+    static void PlatformSpecificCloseDirImplementation(PlatformSpecificDirectory directory)
+    {
+        (void)directory;
+    }
+
     PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
     void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+    void (*PlatformSpecificFWrite)(const void*, size_t, PlatformSpecificFile) = PlatformSpecificFWriteImplementation;
+    size_t (*PlatformSpecificFRead)(void*, size_t, PlatformSpecificFile) = PlatformSpecificFReadImplementation;
     void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+    PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char*) = PlatformSpecificOpenDirImplementation;
+    const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory) = PlatformSpecificReadDirImplementation;
+    void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory) = PlatformSpecificCloseDirImplementation;
 
     int (*PlatformSpecificPutchar)(int) = putchar;
     void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
@@ -217,4 +266,11 @@ extern "C"
     void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
     void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = DummyMutexDestroy;
 
+    static unsigned long DummyGetThreadId(void)
+    {
+        return 0;
+    }
+
+    unsigned long (*PlatformSpecificGetThreadId)(void) = DummyGetThreadId;
+
 }
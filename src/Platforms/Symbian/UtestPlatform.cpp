@@ -67,6 +67,19 @@ void PlatformSpecificRunTestInASeperateProcess(UtestShell* shell, TestPlugin* pl
    shell->runOneTest(plugin, *result);
 }
 
+void PlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+void PlatformSpecificStopWatchdog()
+{
+}
+
+int PlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
 static long TimeInMillisImplementation() {
     struct timeval tv;
     struct timezone tz;
@@ -133,10 +146,29 @@ void PlatformSpecificFPuts(const char* str, PlatformSpecificFile file) {
     fputs(str, (FILE*)file);
 }
 
+void PlatformSpecificFWrite(const void* buffer, size_t size, PlatformSpecificFile file) {
+    fwrite(buffer, 1, size, (FILE*)file);
+}
+
+size_t PlatformSpecificFRead(void* buffer, size_t size, PlatformSpecificFile file) {
+    return fread(buffer, 1, size, (FILE*)file);
+}
+
 void PlatformSpecificFClose(PlatformSpecificFile file) {
     fclose((FILE*)file);
 }
 
+PlatformSpecificDirectory PlatformSpecificOpenDir(const char*) {
+    return NULL;
+}
+
+const char* PlatformSpecificReadDir(PlatformSpecificDirectory) {
+    return NULL;
+}
+
+void PlatformSpecificCloseDir(PlatformSpecificDirectory) {
+}
+
 extern "C" {
 
 static int IsNanImplementation(double d)
@@ -180,3 +212,10 @@ void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = DummyMutexDestroy;
 
+static unsigned long DummyGetThreadId(void)
+{
+    return 0;
+}
+
+unsigned long (*PlatformSpecificGetThreadId)(void) = DummyGetThreadId;
+
@@ -14,6 +14,7 @@
 #include <math.h>
 #include <float.h>
 #include <time.h>
+#include <io.h>
 #include "CppUTest/PlatformSpecificFunctions.h"
 
 #include <windows.h>
@@ -68,6 +69,24 @@ static void VisualCppRunTestInASeperateProcess(UtestShell* shell, TestPlugin* pl
 void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell* shell, TestPlugin* plugin, TestResult* result) =
         VisualCppRunTestInASeperateProcess;
 
+static void DummyPlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+static void DummyPlatformSpecificStopWatchdog(void)
+{
+}
+
+void (*PlatformSpecificStartWatchdog)(UtestShell*, size_t) = DummyPlatformSpecificStartWatchdog;
+void (*PlatformSpecificStopWatchdog)(void) = DummyPlatformSpecificStopWatchdog;
+
+static int DummyPlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage*) = DummyPlatformSpecificGetResourceUsage;
+
 TestOutput::WorkingEnvironment PlatformSpecificGetWorkingEnvironment()
 {
     return TestOutput::visualStudio;
@@ -153,15 +172,73 @@ static void VisualCppFPuts(const char* str, PlatformSpecificFile file)
     fputs(str, (FILE*)file);
 }
 
+static void VisualCppFWrite(const void* buffer, size_t size, PlatformSpecificFile file)
+{
+   fwrite(buffer, 1, size, (FILE*)file);
+}
+
+static size_t VisualCppFRead(void* buffer, size_t size, PlatformSpecificFile file)
+{
+   return fread(buffer, 1, size, (FILE*)file);
+}
+
 static void VisualCppFClose(PlatformSpecificFile file)
 {
     fclose((FILE*)file);
 }
 
+struct VisualCppDirectory
+{
+    intptr_t handle;
+    struct _finddata_t entry;
+    bool hasEntry;
+};
+
+static PlatformSpecificDirectory VisualCppOpenDir(const char* dirname)
+{
+    char pattern[_MAX_PATH];
+    _snprintf(pattern, sizeof(pattern), "%s\\*", dirname);
+    pattern[sizeof(pattern) - 1] = '\0';
+
+    VisualCppDirectory* directory = (VisualCppDirectory*) malloc(sizeof(VisualCppDirectory));
+    if (directory == NULLPTR) return NULLPTR;
+    directory->handle = _findfirst(pattern, &directory->entry);
+    if (directory->handle == -1) {
+        free(directory);
+        return NULLPTR;
+    }
+    directory->hasEntry = true;
+    return directory;
+}
+
+static const char* VisualCppReadDir(PlatformSpecificDirectory dir)
+{
+    VisualCppDirectory* directory = (VisualCppDirectory*) dir;
+    while (directory->hasEntry || _findnext(directory->handle, &directory->entry) == 0) {
+        directory->hasEntry = false;
+        if (strcmp(directory->entry.name, ".") != 0 && strcmp(directory->entry.name, "..") != 0)
+            return directory->entry.name;
+    }
+    return NULLPTR;
+}
+
+static void VisualCppCloseDir(PlatformSpecificDirectory dir)
+{
+    VisualCppDirectory* directory = (VisualCppDirectory*) dir;
+    _findclose(directory->handle);
+    free(directory);
+}
+
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = VisualCppFOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = VisualCppFPuts;
+void (*PlatformSpecificFWrite)(const void* buffer, size_t size, PlatformSpecificFile file) = VisualCppFWrite;
+size_t (*PlatformSpecificFRead)(void* buffer, size_t size, PlatformSpecificFile file) = VisualCppFRead;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = VisualCppFClose;
 
+PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char* dirname) = VisualCppOpenDir;
+const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory directory) = VisualCppReadDir;
+void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory directory) = VisualCppCloseDir;
+
 static void VisualCppFlush()
 {
     fflush(stdout);
@@ -231,3 +308,10 @@ PlatformSpecificMutex (*PlatformSpecificMutexCreate)(void) = VisualCppMutexCreat
 void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = VisualCppMutexLock;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = VisualCppMutexUnlock;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = VisualCppMutexDestroy;
+
+static unsigned long VisualCppGetThreadId(void)
+{
+    return (unsigned long) GetCurrentThreadId();
+}
+
+unsigned long (*PlatformSpecificGetThreadId)(void) = VisualCppGetThreadId;
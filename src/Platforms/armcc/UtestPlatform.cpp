@@ -74,6 +74,24 @@ void (*PlatformSpecificRunTestInASeperateProcess)(UtestShell* shell, TestPlugin*
 int (*PlatformSpecificFork)(void) = DummyPlatformSpecificFork;
 int (*PlatformSpecificWaitPid)(int, int*, int) = DummyPlatformSpecificWaitPid;
 
+static void DummyPlatformSpecificStartWatchdog(UtestShell*, size_t)
+{
+}
+
+static void DummyPlatformSpecificStopWatchdog(void)
+{
+}
+
+void (*PlatformSpecificStartWatchdog)(UtestShell*, size_t) = DummyPlatformSpecificStartWatchdog;
+void (*PlatformSpecificStopWatchdog)(void) = DummyPlatformSpecificStopWatchdog;
+
+static int DummyPlatformSpecificGetResourceUsage(TestResourceUsage*)
+{
+    return 0;
+}
+
+int (*PlatformSpecificGetResourceUsage)(TestResourceUsage*) = DummyPlatformSpecificGetResourceUsage;
+
 extern "C" {
 
 static int PlatformSpecificSetJmpImplementation(void (*function) (void* data), void* data)
@@ -136,6 +154,16 @@ static void PlatformSpecificFPutsImplementation(const char* str, PlatformSpecifi
     fputs(str, (FILE*)file);
 }
 
+static void PlatformSpecificFWriteImplementation(const void* buffer, size_t size, PlatformSpecificFile file)
+{
+   fwrite(buffer, 1, size, (FILE*)file);
+}
+
+static size_t PlatformSpecificFReadImplementation(void* buffer, size_t size, PlatformSpecificFile file)
+{
+   return fread(buffer, 1, size, (FILE*)file);
+}
+
 static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
 {
     fclose((FILE*)file);
@@ -146,9 +174,31 @@ static void PlatformSpecificFlushImplementation()
     fflush(stdout);
 }
 
+static PlatformSpecificDirectory PlatformSpecificOpenDirImplementation(const char* dirname)
+{
+    (void)dirname;
+    return NULLPTR;
+}
+
+static const char* PlatformSpecificReadDirImplementation(PlatformSpecificDirectory directory)
+{
+    (void)directory;
+    return NULLPTR;
+}
+
+static void PlatformSpecificCloseDirImplementation(PlatformSpecificDirectory directory)
+{
+    (void)directory;
+}
+
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+void (*PlatformSpecificFWrite)(const void*, size_t, PlatformSpecificFile) = PlatformSpecificFWriteImplementation;
+size_t (*PlatformSpecificFRead)(void*, size_t, PlatformSpecificFile) = PlatformSpecificFReadImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+PlatformSpecificDirectory (*PlatformSpecificOpenDir)(const char*) = PlatformSpecificOpenDirImplementation;
+const char* (*PlatformSpecificReadDir)(PlatformSpecificDirectory) = PlatformSpecificReadDirImplementation;
+void (*PlatformSpecificCloseDir)(PlatformSpecificDirectory) = PlatformSpecificCloseDirImplementation;
 
 int (*PlatformSpecificPutchar)(int) = putchar;
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
@@ -201,4 +251,11 @@ void (*PlatformSpecificMutexLock)(PlatformSpecificMutex) = DummyMutexLock;
 void (*PlatformSpecificMutexUnlock)(PlatformSpecificMutex) = DummyMutexUnlock;
 void (*PlatformSpecificMutexDestroy)(PlatformSpecificMutex) = DummyMutexDestroy;
 
+static unsigned long DummyGetThreadId(void)
+{
+    return 0;
+}
+
+unsigned long (*PlatformSpecificGetThreadId)(void) = DummyGetThreadId;
+
 }
@@ -28,6 +28,7 @@
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/CommandLineArguments.h"
 #include "CppUTest/TestRegistry.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
 
 class OptionsPlugin: public TestPlugin
 {
@@ -117,6 +118,110 @@ TEST(CommandLineArguments, repeatSetDefaultsToTwoAndShuffleDisabled)
     LONGS_EQUAL(2, args->getRepeatCount());
 }
 
+TEST(CommandLineArguments, fuzzingIsOffByDefault)
+{
+    int argc = 1;
+    const char* argv[] = { "tests.exe" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(0, args->getFuzzRuns());
+    CHECK(args->getCorpusDirectory().isEmpty());
+}
+
+TEST(CommandLineArguments, fuzzDefaultsToAHundredThousandRuns)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--fuzz" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(100000, args->getFuzzRuns());
+}
+
+TEST(CommandLineArguments, fuzzWithRuns)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--fuzz=250" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(250, args->getFuzzRuns());
+}
+
+TEST(CommandLineArguments, fuzzWithoutRunsIsAnError)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--fuzz=0" };
+    CHECK_FALSE(newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, propertyRunsAndSeedAreUnsetByDefault)
+{
+    int argc = 1;
+    const char* argv[] = { "tests.exe" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(0, args->getPropertyRuns());
+    LONGS_EQUAL(0, args->getPropertySeed());
+}
+
+TEST(CommandLineArguments, propertyRunsAndSeed)
+{
+    int argc = 4;
+    const char* argv[] = { "tests.exe", "--property-runs", "1000", "--property-seed=42" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(1000, args->getPropertyRuns());
+    LONGS_EQUAL(42, args->getPropertySeed());
+}
+
+TEST(CommandLineArguments, propertySeedZeroIsAnError)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "--property-seed", "0" };
+    CHECK_FALSE(newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, testTimeoutIsOffByDefault)
+{
+    int argc = 1;
+    const char* argv[] = { "tests.exe" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(0, args->getTestTimeout());
+}
+
+TEST(CommandLineArguments, testTimeout)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--timeout=1500" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(1500, args->getTestTimeout());
+}
+
+TEST(CommandLineArguments, testTimeoutOfZeroIsAnError)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "--timeout", "0" };
+    CHECK_FALSE(newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, corpusDirectory)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "--corpus", "inputs" };
+    CHECK(newArgumentParser(argc, argv));
+    STRCMP_EQUAL("inputs", args->getCorpusDirectory().asCharString());
+}
+
+TEST(CommandLineArguments, fuzzSeed)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "--fuzz=10", "--fuzz-seed=77" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(10, args->getFuzzRuns());
+    LONGS_EQUAL(77, args->getFuzzSeed());
+}
+
+TEST(CommandLineArguments, fuzzSeedZeroIsAnError)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "--fuzz-seed", "0" };
+    CHECK_FALSE(newArgumentParser(argc, argv));
+}
+
 TEST(CommandLineArguments, reverseEnabled)
 {
     int argc = 2;
@@ -424,6 +529,15 @@ TEST(CommandLineArguments, setJUnitOutputDifferentParameter)
     CHECK(args->isJUnitOutput());
 }
 
+TEST(CommandLineArguments, setJUnitSingleFileOutput)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "-ojunitsingle" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isJUnitSingleFileOutput());
+    CHECK(!args->isJUnitOutput());
+}
+
 TEST(CommandLineArguments, setTeamCityOutputDifferentParameter)
 {
     int argc = 3;
@@ -432,6 +546,22 @@ TEST(CommandLineArguments, setTeamCityOutputDifferentParameter)
     CHECK(args->isTeamCityOutput());
 }
 
+TEST(CommandLineArguments, setJsonOutput)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "-ojson" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isJsonOutput());
+}
+
+TEST(CommandLineArguments, setBinaryOutputDifferentParameter)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "-o", "binary" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isBinaryOutput());
+}
+
 TEST(CommandLineArguments, setOutputToGarbage)
 {
     int argc = 3;
@@ -464,9 +594,11 @@ TEST(CommandLineArguments, weirdParamatersReturnsFalse)
 
 TEST(CommandLineArguments, printUsage)
 {
-    STRCMP_EQUAL("use -h for more extensive help\nusage [-h] [-v] [-vv] [-c] [-p] [-lg] [-ln] [-ri] [-r#]\n"
+    STRCMP_EQUAL("use -h for more extensive help\nusage [-h] [-v] [-vv] [-c] [-p] [-lg] [-ln] [-ri] [-r#] [--timeout=ms]\n"
                                                  "      [-g|sg|xg|xsg groupName]... [-n|sn|xn|xsn testName]... [-t groupName.testName]...\n"
-                                                 "      [-b] [-s [randomizerSeed>0]] [\"TEST(groupName, testName)\"]... [-o{normal, junit, teamcity}] [-k packageName]\n",
+                                                 "      [--filter-file fileName]... [--fuzz[=runs]] [--corpus directory] [--fuzz-seed seed]\n"
+                                                 "      [--property-runs runs] [--property-seed seed]\n"
+                                                 "      [-b] [-s [randomizerSeed>0]] [\"TEST(groupName, testName)\"]... [-o{normal, junit, junitsingle, teamcity, json, binary}] [-k packageName]\n",
             args->usage());
 }
 
@@ -539,3 +671,136 @@ TEST(CommandLineArguments, setOptRun)
     CHECK(args->isRunIgnored());
 }
 
+static const char* filterFileContent = NULLPTR;
+static size_t filterFilePosition = 0;
+static SimpleString* openedFilterFile = NULLPTR;
+static bool filterFileClosed = false;
+
+static PlatformSpecificFile StubFOpen(const char* fileName, const char*)
+{
+    *openedFilterFile = fileName;
+    if (SimpleString::StrCmp(fileName, "missing") == 0) return NULLPTR;
+    filterFilePosition = 0;
+    return (PlatformSpecificFile) &filterFileContent;
+}
+
+static size_t StubFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    size_t amount = SimpleString::StrLen(filterFileContent) - filterFilePosition;
+    if (amount > size) amount = size;
+    PlatformSpecificMemCpy(buffer, filterFileContent + filterFilePosition, amount);
+    filterFilePosition += amount;
+    return amount;
+}
+
+static void StubFClose(PlatformSpecificFile)
+{
+    filterFileClosed = true;
+}
+
+TEST_GROUP(CommandLineArgumentsFilterFile)
+{
+    CommandLineArguments* args;
+    OptionsPlugin* plugin;
+    SimpleString fileName;
+
+    void setup() _override
+    {
+        plugin = new OptionsPlugin("options");
+        args = NULLPTR;
+        openedFilterFile = &fileName;
+        filterFileClosed = false;
+        UT_PTR_SET(PlatformSpecificFOpen, StubFOpen);
+        UT_PTR_SET(PlatformSpecificFRead, StubFRead);
+        UT_PTR_SET(PlatformSpecificFClose, StubFClose);
+    }
+    void teardown() _override
+    {
+        delete args;
+        delete plugin;
+    }
+
+    bool parseFilterFile(const char* content)
+    {
+        filterFileContent = content;
+        const char* argv[] = { "tests.exe", "--filter-file", "filters.txt" };
+        args = new CommandLineArguments(3, argv);
+        return args->parse(plugin);
+    }
+};
+
+TEST(CommandLineArgumentsFilterFile, emptyFileAddsNoFilters)
+{
+    CHECK(parseFilterFile(""));
+    STRCMP_EQUAL("filters.txt", fileName.asCharString());
+    CHECK(filterFileClosed);
+    CHECK(NULLPTR == args->getGroupFilters());
+    CHECK(NULLPTR == args->getNameFilters());
+    CHECK(NULLPTR == args->getTestFilters());
+}
+
+TEST(CommandLineArgumentsFilterFile, fileNameCanBeAttachedWithEquals)
+{
+    filterFileContent = "";
+    const char* argv[] = { "tests.exe", "--filter-file=other.txt" };
+    args = new CommandLineArguments(2, argv);
+    CHECK(args->parse(plugin));
+    STRCMP_EQUAL("other.txt", fileName.asCharString());
+}
+
+TEST(CommandLineArgumentsFilterFile, missingFileIsAnError)
+{
+    const char* argv[] = { "tests.exe", "--filter-file", "missing" };
+    args = new CommandLineArguments(3, argv);
+    CHECK_FALSE(args->parse(plugin));
+}
+
+TEST(CommandLineArgumentsFilterFile, groupDotNameLinesSelectExactTests)
+{
+    CHECK(parseFilterFile("group1.test1\n  group2.test2 \r\n"));
+    TestFilter test1("group1.test1");
+    test1.strictMatching();
+    TestFilter test2("group2.test2");
+    test2.strictMatching();
+    CHECK_EQUAL(test2, *args->getTestFilters());
+    CHECK_EQUAL(test1, *args->getTestFilters()->getNext());
+    CHECK(NULLPTR == args->getTestFilters()->getNext()->getNext());
+}
+
+TEST(CommandLineArgumentsFilterFile, optionLinesAddFilters)
+{
+    CHECK(parseFilterFile("# reruns\n\n-sg group\n-xn  slow\n-t other.name\n-xsggroup2"));
+    TestFilter strictGroup("group");
+    strictGroup.strictMatching();
+    TestFilter excludedGroup("group2");
+    excludedGroup.strictMatching();
+    excludedGroup.invertMatching();
+    TestFilter excludedName("slow");
+    excludedName.invertMatching();
+    CHECK_EQUAL(excludedGroup, *args->getGroupFilters());
+    CHECK_EQUAL(TestFilter("other"), *args->getGroupFilters()->getNext());
+    CHECK_EQUAL(strictGroup, *args->getGroupFilters()->getNext()->getNext());
+    CHECK_EQUAL(TestFilter("name"), *args->getNameFilters());
+    CHECK_EQUAL(excludedName, *args->getNameFilters()->getNext());
+}
+
+TEST(CommandLineArgumentsFilterFile, linesCanSpanReadChunks)
+{
+    SimpleString content(".", 600);
+    content += "\n-n ";
+    content += SimpleString("x", 600);
+    content = SimpleString("g") + content;
+    CHECK(parseFilterFile(content.asCharString()));
+    CHECK_EQUAL(TestFilter(SimpleString("x", 600)), *args->getNameFilters());
+    LONGS_EQUAL(601, args->getTestFilters()->getFilter().size());
+}
+
+TEST(CommandLineArgumentsFilterFile, unknownOptionIsAnError)
+{
+    CHECK_FALSE(parseFilterFile("-sg group\n-v\n"));
+}
+
+TEST(CommandLineArgumentsFilterFile, lineWithoutGroupDotNameIsAnError)
+{
+    CHECK_FALSE(parseFilterFile("justaname\n"));
+}
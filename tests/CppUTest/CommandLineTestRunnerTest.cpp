@@ -63,10 +63,13 @@ public:
   StringBufferTestOutput* fakeJUnitOutputWhichIsReallyABuffer_;
   StringBufferTestOutput* fakeConsoleOutputWhichIsReallyABuffer;
   StringBufferTestOutput* fakeTCOutputWhichIsReallyABuffer;
+  StringBufferTestOutput* fakeJsonOutputWhichIsReallyABuffer;
+  StringBufferTestOutput* fakeBinaryOutputWhichIsReallyABuffer;
 
   CommandLineTestRunnerWithStringBufferOutput(int argc, const char *const *argv, TestRegistry* registry)
     : CommandLineTestRunner(argc, argv, registry), fakeJUnitOutputWhichIsReallyABuffer_(NULLPTR),
-    fakeConsoleOutputWhichIsReallyABuffer(NULLPTR), fakeTCOutputWhichIsReallyABuffer(NULLPTR)
+    fakeConsoleOutputWhichIsReallyABuffer(NULLPTR), fakeTCOutputWhichIsReallyABuffer(NULLPTR),
+    fakeJsonOutputWhichIsReallyABuffer(NULLPTR), fakeBinaryOutputWhichIsReallyABuffer(NULLPTR)
   {}
 
   TestOutput* createConsoleOutput()
@@ -86,6 +89,18 @@ public:
     fakeTCOutputWhichIsReallyABuffer = new StringBufferTestOutput;
     return fakeTCOutputWhichIsReallyABuffer;
   }
+
+  TestOutput* createJsonOutput(const SimpleString&)
+  {
+    fakeJsonOutputWhichIsReallyABuffer = new StringBufferTestOutput;
+    return fakeJsonOutputWhichIsReallyABuffer;
+  }
+
+  TestOutput* createBinaryOutput(const SimpleString&)
+  {
+    fakeBinaryOutputWhichIsReallyABuffer = new StringBufferTestOutput;
+    return fakeBinaryOutputWhichIsReallyABuffer;
+  }
 };
 
 TEST_GROUP(CommandLineTestRunner)
@@ -211,6 +226,26 @@ TEST(CommandLineTestRunner, JunitOutputAndVerboseEnabled)
     STRCMP_CONTAINS("TEST(group1, test1)", commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
 }
 
+TEST(CommandLineTestRunner, JsonOutputEnabled)
+{
+    const char* argv[] = { "tests.exe", "-ojson"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.fakeJsonOutputWhichIsReallyABuffer != NULLPTR);
+    CHECK(commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer == NULLPTR);
+}
+
+TEST(CommandLineTestRunner, BinaryOutputAndVerboseEnabled)
+{
+    const char* argv[] = { "tests.exe", "-obinary", "-v"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(3, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    STRCMP_CONTAINS("TEST(group1, test1)", commandLineTestRunner.fakeBinaryOutputWhichIsReallyABuffer->getOutput().asCharString());
+    STRCMP_CONTAINS("TEST(group1, test1)", commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
+
 TEST(CommandLineTestRunner, veryVerboseSetOnOutput)
 {
     const char* argv[] = { "tests.exe", "-vv"};
@@ -376,6 +411,37 @@ TEST(CommandLineTestRunner, realJunitOutputShouldBeCreatedAndWorkProperly)
 
 }
 
+TEST(CommandLineTestRunner, realJunitSingleFileOutputShouldBeCreatedAndWorkProperly)
+{
+    const char* argv[] = { "tests.exe", "-ojunitsingle", "-kpackage", };
+
+    FakeOutput fakeOutput; /* UT_PTR_SET() is not reentrant */
+
+    CommandLineTestRunner commandLineTestRunner(3, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+
+    fakeOutput.restoreOriginals();
+
+    STRCMP_CONTAINS("<testsuites>\n<testsuite", fakeOutput.file.asCharString());
+    STRCMP_CONTAINS("<testcase classname=\"package.group1\" name=\"test1\"", fakeOutput.file.asCharString());
+    STRCMP_CONTAINS("</testsuite>\n</testsuites>\n", fakeOutput.file.asCharString());
+}
+
+TEST(CommandLineTestRunner, realJsonOutputShouldBeCreatedAndWorkProperly)
+{
+    const char* argv[] = { "tests.exe", "-ojson", "-kpackage", };
+
+    FakeOutput fakeOutput; /* UT_PTR_SET() is not reentrant */
+
+    CommandLineTestRunner commandLineTestRunner(3, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+
+    fakeOutput.restoreOriginals();
+
+    STRCMP_CONTAINS("{\"event\":\"test\",\"group\":\"group1\",\"name\":\"test1\"", fakeOutput.file.asCharString());
+    STRCMP_CONTAINS("{\"event\":\"summary\",\"tests\":1,", fakeOutput.file.asCharString());
+}
+
 TEST(CommandLineTestRunner, realTeamCityOutputShouldBeCreatedAndWorkProperly)
 {
     const char* argv[] = { "tests.exe", "-oteamcity", "-v", "-kpackage", };
@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+struct FakeCorpusFile
+{
+    const char* name;
+    const char* content;
+};
+
+static const FakeCorpusFile* fakeCorpus = NULLPTR;
+static size_t fakeCorpusSize = 0;
+static size_t fakeCorpusEntry = 0;
+static bool fakeCorpusIsOpen = false;
+static char fakeOpenedDirectory[64];
+static const FakeCorpusFile* fakeOpenedFile = NULLPTR;
+static size_t fakeFilePosition = 0;
+static char fakeWrittenPath[64];
+static size_t fakeWrittenSize = 0;
+
+static void copyName(char* to, const char* from)
+{
+    SimpleString::StrNCpy(to, from, 63);
+    to[63] = '\0';
+}
+
+static PlatformSpecificDirectory FakeOpenDir(const char* dirname)
+{
+    copyName(fakeOpenedDirectory, dirname);
+    if (fakeCorpus == NULLPTR) return NULLPTR;
+    fakeCorpusEntry = 0;
+    fakeCorpusIsOpen = true;
+    return (PlatformSpecificDirectory) &fakeCorpus;
+}
+
+static const char* FakeReadDir(PlatformSpecificDirectory)
+{
+    if (fakeCorpusEntry == fakeCorpusSize) return NULLPTR;
+    return fakeCorpus[fakeCorpusEntry++].name;
+}
+
+static void FakeCloseDir(PlatformSpecificDirectory)
+{
+    fakeCorpusIsOpen = false;
+}
+
+static PlatformSpecificFile FakeFOpen(const char* fileName, const char* flag)
+{
+    if (SimpleString(flag) == "wb") {
+        copyName(fakeWrittenPath, fileName);
+        fakeWrittenSize = 0;
+        return (PlatformSpecificFile) &fakeWrittenPath;
+    }
+    for (size_t i = 0; i < fakeCorpusSize; i++) {
+        if (SimpleString(fakeOpenedDirectory) + "/" + fakeCorpus[i].name == fileName && fakeCorpus[i].content) {
+            fakeOpenedFile = &fakeCorpus[i];
+            fakeFilePosition = 0;
+            return (PlatformSpecificFile) fakeOpenedFile;
+        }
+    }
+    return NULLPTR;
+}
+
+static size_t FakeFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    size_t amount = SimpleString::StrLen(fakeOpenedFile->content) - fakeFilePosition;
+    if (amount > size) amount = size;
+    PlatformSpecificMemCpy(buffer, fakeOpenedFile->content + fakeFilePosition, amount);
+    fakeFilePosition += amount;
+    return amount;
+}
+
+static void FakeFWrite(const void*, size_t size, PlatformSpecificFile)
+{
+    fakeWrittenSize += size;
+}
+
+static void FakeFClose(PlatformSpecificFile)
+{
+}
+
+static void setFakeCorpus(const FakeCorpusFile* files, size_t count)
+{
+    fakeCorpus = files;
+    fakeCorpusSize = count;
+}
+
+static const FakeCorpusFile twoInputs[] = { { ".keep", "" }, { "first", "ab" }, { "unreadable", NULLPTR }, { "second", "xyz" } };
+
+TEST_GROUP(TestCorpusGenerator)
+{
+    TestCorpusGenerator* corpus;
+
+    void setup() _override
+    {
+        setFakeCorpus(NULLPTR, 0);
+        fakeOpenedDirectory[0] = '\0';
+        UT_PTR_SET(PlatformSpecificOpenDir, FakeOpenDir);
+        UT_PTR_SET(PlatformSpecificReadDir, FakeReadDir);
+        UT_PTR_SET(PlatformSpecificCloseDir, FakeCloseDir);
+        UT_PTR_SET(PlatformSpecificFOpen, FakeFOpen);
+        UT_PTR_SET(PlatformSpecificFRead, FakeFRead);
+        UT_PTR_SET(PlatformSpecificFClose, FakeFClose);
+        corpus = new TestCorpusGenerator("Group", "test");
+    }
+
+    void teardown() _override
+    {
+        delete corpus;
+    }
+
+    SimpleString currentInput()
+    {
+        return SimpleString((const char*) corpus->getData()).subString(0, corpus->getSize());
+    }
+};
+
+TEST(TestCorpusGenerator, withoutCorpusOnlyTheEmptyInputIsACase)
+{
+    CHECK(corpus->first());
+    STRCMP_EQUAL("empty", corpus->getCaseName());
+    LONGS_EQUAL(0, corpus->getSize());
+    CHECK_FALSE(corpus->next());
+}
+
+TEST(TestCorpusGenerator, corpusDirectoryIsNamedAfterTheTest)
+{
+    corpus->first();
+    STRCMP_EQUAL("corpus/Group.test", fakeOpenedDirectory);
+    STRCMP_EQUAL("corpus/Group.test", corpus->getCorpusPath());
+}
+
+TEST(TestCorpusGenerator, corpusDirectoryCanBeChanged)
+{
+    corpus->setCorpusDirectory("fuzz/inputs");
+    corpus->first();
+    STRCMP_EQUAL("fuzz/inputs/Group.test", fakeOpenedDirectory);
+}
+
+TEST(TestCorpusGenerator, readsTheFilesAfterTheEmptyInput)
+{
+    setFakeCorpus(twoInputs, 4);
+    CHECK(corpus->first());
+    CHECK(corpus->next());
+    STRCMP_EQUAL("first", corpus->getCaseName());
+    STRCMP_EQUAL("ab", currentInput().asCharString());
+    CHECK(corpus->next());
+    STRCMP_EQUAL("second", corpus->getCaseName());
+    STRCMP_EQUAL("xyz", currentInput().asCharString());
+    CHECK_FALSE(corpus->next());
+    CHECK_FALSE(fakeCorpusIsOpen);
+}
+
+TEST(TestCorpusGenerator, restartsAtTheEmptyInput)
+{
+    setFakeCorpus(twoInputs, 4);
+    corpus->first();
+    corpus->next();
+    CHECK(corpus->first());
+    STRCMP_EQUAL("empty", corpus->getCaseName());
+    LONGS_EQUAL(0, corpus->getSize());
+}
+
+TEST_GROUP(FuzzMutator)
+{
+};
+
+TEST(FuzzMutator, randomStaysBelowTheBound)
+{
+    FuzzMutator mutator(1);
+    for (int i = 0; i < 1000; i++)
+        CHECK(mutator.random(7) < 7);
+    LONGS_EQUAL(0, mutator.random(0));
+}
+
+TEST(FuzzMutator, growsTheEmptyInput)
+{
+    FuzzMutator mutator(2);
+    unsigned char data[8];
+    CHECK(mutator.mutate(data, 0, sizeof(data), NULLPTR, 0) > 0);
+}
+
+TEST(FuzzMutator, staysWithinTheMaximumSize)
+{
+    FuzzMutator mutator(3);
+    unsigned char data[16] = { 0 };
+    const unsigned char other[32] = { 1, 2, 3 };
+    size_t size = 0;
+    for (int i = 0; i < 10000; i++) {
+        size = mutator.mutate(data, size, sizeof(data), other, sizeof(other));
+        CHECK(size <= sizeof(data));
+    }
+}
+
+TEST(FuzzMutator, sameSeedMutatesTheSame)
+{
+    FuzzMutator mutator(42);
+    FuzzMutator sameMutator(42);
+    unsigned char data[16] = { 'a', 'b', 'c', 'd' };
+    unsigned char sameData[16] = { 'a', 'b', 'c', 'd' };
+
+    size_t size = mutator.mutate(data, 4, sizeof(data), NULLPTR, 0);
+    LONGS_EQUAL(size, sameMutator.mutate(sameData, 4, sizeof(sameData), NULLPTR, 0));
+    MEMCMP_EQUAL(data, sameData, size);
+}
+
+static char inputsSeen[64];
+static size_t inputsRun = 0;
+static size_t failOnInputLongerThan = 0;
+
+#if defined(__GNUC__)
+
+extern "C" void __sanitizer_cov_trace_pc_guard_init(unsigned int* start, unsigned int* stop);
+extern "C" void __sanitizer_cov_trace_pc_guard(unsigned int* guard);
+
+/* What an instrumented 'if (data[0] == 'F')' would call */
+static unsigned int fakeGuards[2];
+static bool fakeCoverage = false;
+
+static void reachFakeCoverage(const unsigned char* data, size_t size)
+{
+    if (!fakeCoverage) return;
+    __sanitizer_cov_trace_pc_guard(&fakeGuards[0]);
+    if (size > 0 && data[0] == 'F') __sanitizer_cov_trace_pc_guard(&fakeGuards[1]);
+}
+
+#else
+
+static void reachFakeCoverage(const unsigned char*, size_t)
+{
+}
+
+#endif
+
+class RecordingFuzzTest : public Utest
+{
+public:
+    explicit RecordingFuzzTest(const FuzzUtestShell* shell) : shell_(shell)
+    {
+    }
+
+    void testBody() _override
+    {
+        if (inputsRun < 3) {
+            size_t length = SimpleString::StrLen(inputsSeen);
+            if (inputsRun > 0) inputsSeen[length++] = ' ';
+            PlatformSpecificMemCpy(inputsSeen + length, shell_->getData(), shell_->getSize());
+            inputsSeen[length + shell_->getSize()] = '\0';
+        }
+        inputsRun++;
+        reachFakeCoverage(shell_->getData(), shell_->getSize());
+        if (failOnInputLongerThan != 0 && shell_->getSize() > failOnInputLongerThan)
+            FAIL("too long");
+    }
+
+private:
+    const FuzzUtestShell* shell_;
+};
+
+class RecordingFuzzShell : public FuzzUtestShell
+{
+public:
+    RecordingFuzzShell() : FuzzUtestShell("Group", "test")
+    {
+    }
+
+    virtual Utest* createTest() _override
+    {
+        return new RecordingFuzzTest(this);
+    }
+};
+
+class CountingPlugin : public TestPlugin
+{
+public:
+    CountingPlugin() : TestPlugin("counting"), preTestActions(0), postTestActions(0)
+    {
+    }
+
+    virtual void preTestAction(UtestShell&, TestResult&) _override
+    {
+        preTestActions++;
+    }
+
+    virtual void postTestAction(UtestShell&, TestResult&) _override
+    {
+        postTestActions++;
+    }
+
+    size_t preTestActions;
+    size_t postTestActions;
+};
+
+TEST_GROUP(FuzzUtestShell)
+{
+    TestRegistry registry;
+    StringBufferTestOutput output;
+    TestResult* result;
+    RecordingFuzzShell shell;
+    CountingPlugin plugin;
+
+    void setup() _override
+    {
+        inputsSeen[0] = '\0';
+        inputsRun = 0;
+        failOnInputLongerThan = 0;
+        fakeWrittenPath[0] = '\0';
+        setFakeCorpus(NULLPTR, 0);
+        UT_PTR_SET(PlatformSpecificOpenDir, FakeOpenDir);
+        UT_PTR_SET(PlatformSpecificReadDir, FakeReadDir);
+        UT_PTR_SET(PlatformSpecificCloseDir, FakeCloseDir);
+        UT_PTR_SET(PlatformSpecificFOpen, FakeFOpen);
+        UT_PTR_SET(PlatformSpecificFRead, FakeFRead);
+        UT_PTR_SET(PlatformSpecificFWrite, FakeFWrite);
+        UT_PTR_SET(PlatformSpecificFClose, FakeFClose);
+        result = new TestResult(output);
+        registry.addTest(&shell);
+        registry.installPlugin(&plugin);
+    }
+
+    void teardown() _override
+    {
+        delete result;
+    }
+};
+
+TEST(FuzzUtestShell, replaysTheCorpusAsCases)
+{
+    setFakeCorpus(twoInputs, 4);
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL(" ab xyz", inputsSeen);
+    LONGS_EQUAL(3, result->getRunCount());
+    LONGS_EQUAL(0, result->getFailureCount());
+}
+
+TEST(FuzzUtestShell, casesAreNamedAfterTheCorpusFiles)
+{
+    setFakeCorpus(twoInputs, 4);
+    CHECK(shell.firstCase());
+    STRCMP_EQUAL("FUZZ_TEST(Group, test/empty)", shell.getFormattedName().asCharString());
+    CHECK(shell.nextCase());
+    STRCMP_EQUAL("FUZZ_TEST(Group, test/first)", shell.getFormattedName().asCharString());
+}
+
+TEST(FuzzUtestShell, fuzzingIsASingleCase)
+{
+    setFakeCorpus(twoInputs, 4);
+    shell.setFuzzOptions(10, NULLPTR, 0);
+    CHECK(shell.firstCase());
+    STRCMP_EQUAL("FUZZ_TEST(Group, test)", shell.getFormattedName().asCharString());
+    CHECK_FALSE(shell.nextCase());
+}
+
+TEST(FuzzUtestShell, fuzzingRunsTheCorpusThenTheMutations)
+{
+    setFakeCorpus(twoInputs, 4);
+    registry.setFuzzRuns(100);
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL(" ab xyz", inputsSeen);
+    LONGS_EQUAL(103, inputsRun);
+    LONGS_EQUAL(1, result->getRunCount());
+    STRCMP_CONTAINS("FUZZ_TEST(Group, test): 103 runs", output.getOutput().asCharString());
+}
+
+TEST(FuzzUtestShell, pluginsRunAroundEveryInput)
+{
+    registry.setFuzzRuns(50);
+    registry.runAllTests(*result);
+
+    LONGS_EQUAL(51, plugin.preTestActions);
+    LONGS_EQUAL(51, plugin.postTestActions);
+}
+
+TEST(FuzzUtestShell, fuzzingStopsAtTheFirstFailureAndSavesTheInput)
+{
+    failOnInputLongerThan = 2;
+    registry.setFuzzRuns(100000);
+    registry.runAllTests(*result);
+
+    LONGS_EQUAL(2, result->getFailureCount());
+    CHECK(inputsRun < 100001);
+    STRCMP_CONTAINS("corpus/Group.test-crash-", fakeWrittenPath);
+    CHECK(fakeWrittenSize > 2);
+    STRCMP_CONTAINS("too long", output.getOutput().asCharString());
+    STRCMP_CONTAINS("Failing input of", output.getOutput().asCharString());
+    STRCMP_CONTAINS(fakeWrittenPath, output.getOutput().asCharString());
+    STRCMP_CONTAINS("mutated with --fuzz-seed ", output.getOutput().asCharString());
+}
+
+TEST(FuzzUtestShell, theReportedSeedRepeatsTheFailingInput)
+{
+    failOnInputLongerThan = 2;
+    registry.setFuzzRuns(100000);
+    registry.runAllTests(*result);
+    SimpleString report = output.getOutput();
+    const char* seed = SimpleString::StrStr(report.asCharString(), "--fuzz-seed ") + 12;
+    SimpleString crashPath = fakeWrittenPath;
+    size_t runs = inputsRun;
+
+    inputsRun = 0;
+    registry.setFuzzSeed(SimpleString::AtoU(seed));
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL(crashPath.asCharString(), fakeWrittenPath);
+    LONGS_EQUAL(runs, inputsRun);
+}
+
+TEST(FuzzUtestShell, corpusDirectoryComesFromTheRegistry)
+{
+    registry.setCorpusDirectory("inputs");
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("inputs/Group.test", fakeOpenedDirectory);
+}
+
+#if defined(__GNUC__)
+
+TEST(FuzzUtestShell, keepsAndSavesInputsThatReachNewCoverage)
+{
+    __sanitizer_cov_trace_pc_guard_init(fakeGuards, fakeGuards + 2);
+    fakeCoverage = true;
+    registry.setFuzzRuns(200000);
+    registry.runAllTests(*result);
+    fakeCoverage = false;
+
+    STRCMP_CONTAINS("corpus/Group.test/", fakeWrittenPath);
+    STRCMP_CONTAINS("2 inputs in corpus, 2 coverage features", output.getOutput().asCharString());
+}
+
+#endif
+
+TEST_GROUP(FuzzTestUsage)
+{
+};
+
+FUZZ_TEST(FuzzTestUsage, inputIsReadable)(const unsigned char* data, size_t size)
+{
+    unsigned long sum = 0;
+    for (size_t i = 0; i < size; i++)
+        sum += data[i];
+    CHECK(sum <= 255UL * size);
+}
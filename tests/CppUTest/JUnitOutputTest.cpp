@@ -65,6 +65,16 @@ public:
         isOpen_ = false;
     }
 
+    void reopen()
+    {
+        isOpen_ = true;
+    }
+
+    bool isOpen()
+    {
+        return isOpen_;
+    }
+
     const char* line(size_t lineNumber)
     {
         buffer_.split("\n", linesOfFile_);
@@ -112,6 +122,15 @@ public:
         return firstFile_;
     }
 
+    FileForJUnitOutputTests* openFileForAppend(const SimpleString& filename)
+    {
+        FileForJUnitOutputTests* existingFile = file(filename.asCharString());
+        if (existingFile == NULLPTR)
+            return openFile(filename);
+        existingFile->reopen();
+        return existingFile;
+    }
+
     int amountOfFiles() {
         int totalAmountOfFiles = 0;
         for (FileForJUnitOutputTests* current = firstFile_; current != NULLPTR; current = current->nextFile())
@@ -313,8 +332,10 @@ public:
 extern "C" {
     static FileSystemForJUnitTestOutputTests fileSystem;
 
-    static PlatformSpecificFile mockFOpen(const char* filename, const char*)
+    static PlatformSpecificFile mockFOpen(const char* filename, const char* flag)
     {
+        if (SimpleString(flag) == "a")
+            return fileSystem.openFileForAppend(filename);
         return fileSystem.openFile(filename);
     }
 
@@ -757,3 +778,101 @@ TEST(JUnitOutputTest, UTPRINTOutputInJUnitOutputWithSpecials)
     outputFile = fileSystem.file("cpputest_groupname.xml");
     STRCMP_EQUAL("<system-out>The &lt;rain&gt; in &quot;Spain&quot;{newline}Goes \\mainly\\ down the Dr&amp;in{newline}</system-out>\n", outputFile->lineFromTheBack(3));
 }
+
+TEST(JUnitOutputTest, singleFileOutputWritesAllGroupsToOneFile)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+            .withGroup("firstTestGroup")
+                .withTest("testName")
+            .withGroup("secondTestGroup")
+                .withTest("testName")
+            .end();
+
+    LONGS_EQUAL(1, fileSystem.amountOfFiles());
+    CHECK(fileSystem.fileExists("cpputest_all.xml"));
+}
+
+TEST(JUnitOutputTest, singleFileOutputWithPackageNameUsesPackageInFileName)
+{
+    junitOutput->setSingleFileOutput(true);
+    junitOutput->setPackageName("packagename");
+    testCaseRunner->start()
+            .withGroup("groupname").withTest("testname")
+            .end();
+
+    CHECK(fileSystem.fileExists("cpputest_packagename_all.xml"));
+}
+
+TEST(JUnitOutputTest, singleFileOutputIsWrappedInTestSuitesBlock)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+            .withGroup("groupname").withTest("testname")
+            .end();
+
+    outputFile = fileSystem.file("cpputest_all.xml");
+    STRCMP_EQUAL("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n", outputFile->line(1));
+    STRCMP_EQUAL("<testsuites>\n", outputFile->line(2));
+    STRCMP_EQUAL("</testsuites>\n", outputFile->lineFromTheBack(1));
+    CHECK(!outputFile->isOpen());
+}
+
+TEST(JUnitOutputTest, singleFileOutputContainsOneTestSuitePerGroup)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+            .withGroup("groupOne")
+                .withTest("testA").thatFails("Failure", "file", 99)
+            .endGroupAndClearTest()
+            .withGroup("groupTwo")
+                .withTest("testB")
+            .end();
+
+    outputFile = fileSystem.file("cpputest_all.xml");
+    STRCMP_EQUAL("<testsuite errors=\"0\" failures=\"1\" hostname=\"localhost\" name=\"groupOne\" tests=\"1\" time=\"0.000\" timestamp=\"1978-10-03T00:00:00\">\n", outputFile->line(3));
+    STRCMP_EQUAL("<testcase classname=\"groupOne\" name=\"testA\" assertions=\"0\" time=\"0.000\" file=\"file\" line=\"1\">\n", outputFile->line(6));
+    STRCMP_EQUAL("</testsuite>\n", outputFile->line(12));
+    STRCMP_EQUAL("<testsuite errors=\"0\" failures=\"0\" hostname=\"localhost\" name=\"groupTwo\" tests=\"1\" time=\"0.000\" timestamp=\"1978-10-03T00:00:00\">\n", outputFile->line(13));
+    STRCMP_EQUAL("<testcase classname=\"groupTwo\" name=\"testB\" assertions=\"0\" time=\"0.000\" file=\"file\" line=\"1\">\n", outputFile->line(16));
+}
+
+TEST(JUnitOutputTest, singleFileOutputIsClosedAfterEachGroup)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+            .withGroup("groupname").withTest("testname")
+            .endGroupAndClearTest();
+
+    outputFile = fileSystem.file("cpputest_all.xml");
+    CHECK(!outputFile->isOpen());
+    STRCMP_EQUAL("</testsuite>\n", outputFile->lineFromTheBack(1));
+}
+
+TEST(JUnitOutputTest, singleFileOutputOnlyContainsTheOutputOfItsOwnGroup)
+{
+    junitOutput->setSingleFileOutput(true);
+    testCaseRunner->start()
+            .withGroup("groupOne")
+                .withTest("testA").thatPrints("firstoutput")
+            .endGroupAndClearTest()
+            .withGroup("groupTwo")
+                .withTest("testB").thatPrints("secondoutput")
+            .end();
+
+    outputFile = fileSystem.file("cpputest_all.xml");
+    STRCMP_EQUAL("<system-out>secondoutput</system-out>\n", outputFile->lineFromTheBack(4));
+}
+
+TEST(JUnitOutputTest, writesLargerThanTheWriteBufferAreWrittenCompletely)
+{
+    SimpleString longMessage("x", 5000);
+    testCaseRunner->start()
+            .withGroup("groupname")
+                .withTest("testname").thatFails(longMessage.asCharString(), "file", 1)
+            .end();
+
+    outputFile = fileSystem.file("cpputest_groupname.xml");
+    STRCMP_CONTAINS(longMessage.asCharString(), outputFile->line(6));
+    STRCMP_EQUAL("</testsuite>\n", outputFile->lineFromTheBack(1));
+}
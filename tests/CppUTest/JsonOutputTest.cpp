@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/JsonTestOutput.h"
+#include "CppUTest/TestResult.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+struct FileForJsonOutputTests
+{
+    FileForJsonOutputTests() : binarySize(0), closed(false) {}
+
+    SimpleString name;
+    SimpleString mode;
+    SimpleString content;
+    unsigned char binary[1024];
+    size_t binarySize;
+    bool closed;
+};
+
+static FileForJsonOutputTests* jsonFile;
+static long jsonMillisTime;
+
+extern "C" {
+
+    static PlatformSpecificFile mockFOpen(const char* filename, const char* mode)
+    {
+        jsonFile->name = filename;
+        jsonFile->mode = mode;
+        jsonFile->closed = false;
+        return (PlatformSpecificFile) jsonFile;
+    }
+
+    static void mockFPuts(const char* str, PlatformSpecificFile)
+    {
+        jsonFile->content += str;
+    }
+
+    static void mockFWrite(const void* buffer, size_t size, PlatformSpecificFile)
+    {
+        PlatformSpecificMemCpy(jsonFile->binary + jsonFile->binarySize, buffer, size);
+        jsonFile->binarySize += size;
+    }
+
+    static void mockFClose(PlatformSpecificFile)
+    {
+        jsonFile->closed = true;
+    }
+
+    static long mockGetPlatformSpecificTimeInMillis()
+    {
+        return jsonMillisTime;
+    }
+}
+
+static TestResourceUsage* jsonResourceUsage;
+
+static int mockGetResourceUsage(TestResourceUsage* usage)
+{
+    if (jsonResourceUsage == NULLPTR) return 0;
+    *usage = *jsonResourceUsage;
+    return 1;
+}
+
+TEST_GROUP(JsonOutputTest)
+{
+    JsonTestOutput* output;
+    TestResult* result;
+    UtestShell* test;
+
+    void setup()
+    {
+        jsonFile = new FileForJsonOutputTests;
+        jsonMillisTime = 0;
+        UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
+        UT_PTR_SET(PlatformSpecificFPuts, mockFPuts);
+        UT_PTR_SET(PlatformSpecificFWrite, mockFWrite);
+        UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        UT_PTR_SET(GetPlatformSpecificTimeInMillis, mockGetPlatformSpecificTimeInMillis);
+        UT_PTR_SET(PlatformSpecificGetResourceUsage, mockGetResourceUsage);
+        jsonResourceUsage = NULLPTR;
+        output = new JsonTestOutput;
+        result = new TestResult(*output);
+        test = new UtestShell("group", "name", "file.cpp", 10);
+    }
+
+    void teardown()
+    {
+        delete test;
+        delete result;
+        delete output;
+        delete jsonFile;
+    }
+
+    void runTest(UtestShell* shell, size_t checks, long millis, TestFailure* failure = NULLPTR)
+    {
+        result->currentTestStarted(shell);
+        for (size_t i = 0; i < checks; i++)
+            result->countCheck();
+        jsonMillisTime += millis;
+        if (failure) result->addFailure(*failure);
+        result->currentTestEnded(shell);
+    }
+};
+
+TEST(JsonOutputTest, fileIsOpenedAtStartAndClosedAtEnd)
+{
+    result->testsStarted();
+    STRCMP_EQUAL("cpputest_results.jsonl", jsonFile->name.asCharString());
+    CHECK(!jsonFile->closed);
+    result->testsEnded();
+    CHECK(jsonFile->closed);
+}
+
+TEST(JsonOutputTest, packageNameIsUsedInTheFileName)
+{
+    output->setPackageName("package");
+    result->testsStarted();
+    STRCMP_EQUAL("cpputest_package_results.jsonl", jsonFile->name.asCharString());
+}
+
+TEST(JsonOutputTest, passingTestIsWrittenAsOneLine)
+{
+    result->testsStarted();
+    runTest(test, 3, 5);
+
+    STRCMP_EQUAL("{\"event\":\"test\",\"group\":\"group\",\"name\":\"name\",\"file\":\"file.cpp\",\"line\":10,\"status\":\"passed\",\"checks\":3,\"duration_us\":5000}\n",
+                 jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, checkCountIsPerTest)
+{
+    result->testsStarted();
+    runTest(test, 3, 0);
+    jsonFile->content = "";
+    runTest(test, 2, 0);
+
+    STRCMP_CONTAINS("\"checks\":2,", jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, measuredResourceUsageIsWrittenAfterTheDuration)
+{
+    TestResourceUsage usage;
+    jsonResourceUsage = &usage;
+    result->testsStarted();
+    result->currentTestStarted(test);
+    usage.userTimeInMicroseconds_ = 1500;
+    usage.systemTimeInMicroseconds_ = 20;
+    usage.peakResidentSetInKilobytes_ = 64;
+    usage.majorPageFaults_ = 1;
+    usage.minorPageFaults_ = 9;
+    usage.voluntaryContextSwitches_ = 3;
+    usage.involuntaryContextSwitches_ = 4;
+    result->currentTestEnded(test);
+
+    STRCMP_CONTAINS("\"duration_us\":0,\"resources\":{\"user_us\":1500,\"sys_us\":20,\"peak_rss_delta_kb\":64,"
+                    "\"major_faults\":1,\"minor_faults\":9,\"voluntary_switches\":3,\"involuntary_switches\":4}}\n",
+                    jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, countersAreWrittenLast)
+{
+    result->testsStarted();
+    result->currentTestStarted(test);
+    result->addCurrentTestCounter("instructions", 1000);
+    result->addCurrentTestCounter("page_faults", 2);
+    result->currentTestEnded(test);
+
+    STRCMP_CONTAINS("\"duration_us\":0,\"counters\":{\"instructions\":1000,\"page_faults\":2}}\n", jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, failingTestContainsTheFirstFailure)
+{
+    TestFailure failure(test, "failfile.cpp", 20, "it \"broke\"\n\tbadly\\");
+    TestFailure secondFailure(test, "other.cpp", 30, "again");
+    result->testsStarted();
+    result->currentTestStarted(test);
+    result->addFailure(failure);
+    result->addFailure(secondFailure);
+    result->currentTestEnded(test);
+
+    STRCMP_CONTAINS("\"status\":\"failed\",\"failure\":{\"file\":\"failfile.cpp\",\"line\":20,\"message\":\"it \\\"broke\\\"\\n\\tbadly\\\\\"},",
+                    jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, ignoredTestHasIgnoredStatus)
+{
+    IgnoredUtestShell ignoredTest("group", "ignored", "file.cpp", 11);
+    result->testsStarted();
+    runTest(&ignoredTest, 0, 0);
+
+    STRCMP_CONTAINS("\"name\":\"ignored\",\"file\":\"file.cpp\",\"line\":11,\"status\":\"ignored\"", jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, controlCharactersAreEscaped)
+{
+    UtestShell weirdTest("gr\x01oup", "na\rme", "file.cpp", 1);
+    result->testsStarted();
+    runTest(&weirdTest, 0, 0);
+
+    STRCMP_CONTAINS("\"group\":\"gr\\u0001oup\",\"name\":\"na\\rme\"", jsonFile->content.asCharString());
+}
+
+TEST(JsonOutputTest, summaryIsWrittenAtTheEnd)
+{
+    result->testsStarted();
+    runTest(test, 1, 0);
+    result->countTest();
+    result->countRun();
+    jsonFile->content = "";
+    result->testsEnded();
+
+    STRCMP_EQUAL("{\"event\":\"summary\",\"tests\":1,\"ran\":1,\"checks\":1,\"ignored\":0,\"filtered_out\":0,\"failures\":0,\"duration_us\":0}\n",
+                 jsonFile->content.asCharString());
+}
+
+TEST_GROUP(BinaryOutputTest)
+{
+    BinaryTestOutput* output;
+    TestResult* result;
+    UtestShell* test;
+
+    void setup()
+    {
+        jsonFile = new FileForJsonOutputTests;
+        jsonMillisTime = 0;
+        UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
+        UT_PTR_SET(PlatformSpecificFPuts, mockFPuts);
+        UT_PTR_SET(PlatformSpecificFWrite, mockFWrite);
+        UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        UT_PTR_SET(GetPlatformSpecificTimeInMillis, mockGetPlatformSpecificTimeInMillis);
+        UT_PTR_SET(PlatformSpecificGetResourceUsage, mockGetResourceUsage);
+        jsonResourceUsage = NULLPTR;
+        output = new BinaryTestOutput;
+        result = new TestResult(*output);
+        test = new UtestShell("g", "n", "f", 7);
+    }
+
+    void teardown()
+    {
+        delete test;
+        delete result;
+        delete output;
+        delete jsonFile;
+    }
+
+    size_t unsigned32At(size_t position)
+    {
+        return (size_t) jsonFile->binary[position]
+                | ((size_t) jsonFile->binary[position + 1] << 8)
+                | ((size_t) jsonFile->binary[position + 2] << 16)
+                | ((size_t) jsonFile->binary[position + 3] << 24);
+    }
+};
+
+TEST(BinaryOutputTest, fileIsOpenedInBinaryMode)
+{
+    output->setPackageName("package");
+    result->testsStarted();
+    STRCMP_EQUAL("cpputest_package_results.bin", jsonFile->name.asCharString());
+    STRCMP_EQUAL("wb", jsonFile->mode.asCharString());
+}
+
+TEST(BinaryOutputTest, passingTestRecord)
+{
+    result->testsStarted();
+    result->currentTestStarted(test);
+    result->countCheck();
+    jsonMillisTime += 2;
+    result->currentTestEnded(test);
+
+    const unsigned char expected[] = {
+        42, 0, 0, 0,
+        BinaryTestOutput::RECORD_TEST, BinaryTestOutput::STATUS_PASSED,
+        1, 0, 0, 0, 'g',
+        1, 0, 0, 0, 'n',
+        1, 0, 0, 0, 'f',
+        7, 0, 0, 0,
+        1, 0, 0, 0,
+        0xd0, 0x07, 0, 0, 0, 0, 0, 0
+    };
+    LONGS_EQUAL(sizeof(expected) - 4 + 4, jsonFile->binarySize);
+    LONGS_EQUAL(jsonFile->binarySize - 4, unsigned32At(0));
+    MEMCMP_EQUAL(expected + 4, jsonFile->binary + 4, sizeof(expected) - 4);
+}
+
+TEST(BinaryOutputTest, failingTestRecordContainsFailure)
+{
+    TestFailure failure(test, "x", 3, "msg");
+    result->testsStarted();
+    result->currentTestStarted(test);
+    result->addFailure(failure);
+    result->currentTestEnded(test);
+
+    BYTES_EQUAL(BinaryTestOutput::STATUS_FAILED, jsonFile->binary[5]);
+    const unsigned char expectedFailure[] = {
+        1, 0, 0, 0, 'x',
+        3, 0, 0, 0,
+        3, 0, 0, 0, 'm', 's', 'g'
+    };
+    MEMCMP_EQUAL(expectedFailure, jsonFile->binary + jsonFile->binarySize - sizeof(expectedFailure), sizeof(expectedFailure));
+    LONGS_EQUAL(jsonFile->binarySize - 4, unsigned32At(0));
+}
+
+TEST(BinaryOutputTest, measuredResourceUsageIsAppendedToTheTestRecord)
+{
+    TestResourceUsage usage;
+    jsonResourceUsage = &usage;
+    result->testsStarted();
+    result->currentTestStarted(test);
+    usage.userTimeInMicroseconds_ = 0x0102;
+    usage.involuntaryContextSwitches_ = 5;
+    result->currentTestEnded(test);
+
+    const size_t resourcesStart = 4 + 2 + 3 * 5 + 4 + 4 + 8;
+    LONGS_EQUAL(resourcesStart + 7 * 8, jsonFile->binarySize);
+    LONGS_EQUAL(jsonFile->binarySize - 4, unsigned32At(0));
+    LONGS_EQUAL(0x0102, unsigned32At(resourcesStart));
+    LONGS_EQUAL(5, unsigned32At(resourcesStart + 6 * 8));
+}
+
+TEST(BinaryOutputTest, countersFollowTheTestRecord)
+{
+    result->testsStarted();
+    result->currentTestStarted(test);
+    result->addCurrentTestCounter("cycles", 0x0304);
+    result->currentTestEnded(test);
+
+    const size_t countersStart = 4 + 2 + 3 * 5 + 4 + 4 + 8;
+    const unsigned char expected[] = {
+        1 + 4 + 4 + 6 + 8, 0, 0, 0,
+        BinaryTestOutput::RECORD_COUNTERS,
+        1, 0, 0, 0,
+        6, 0, 0, 0, 'c', 'y', 'c', 'l', 'e', 's',
+        0x04, 0x03, 0, 0, 0, 0, 0, 0
+    };
+    LONGS_EQUAL(countersStart + sizeof(expected), jsonFile->binarySize);
+    MEMCMP_EQUAL(expected, jsonFile->binary + countersStart, sizeof(expected));
+}
+
+TEST(BinaryOutputTest, summaryRecord)
+{
+    result->testsStarted();
+    result->countTest();
+    result->countTest();
+    result->countRun();
+    result->countIgnored();
+    result->testsEnded();
+
+    LONGS_EQUAL(4 + 1 + 6 * 4 + 8, jsonFile->binarySize);
+    BYTES_EQUAL(BinaryTestOutput::RECORD_SUMMARY, jsonFile->binary[4]);
+    LONGS_EQUAL(2, unsigned32At(5));
+    LONGS_EQUAL(1, unsigned32At(9));
+    LONGS_EQUAL(1, unsigned32At(17));
+}
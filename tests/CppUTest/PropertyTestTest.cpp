@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+
+TEST_GROUP(PropertyIntegers)
+{
+    PropertyRandom random;
+
+    TEST_GROUP_CppUTestGroupPropertyIntegers() : random(7)
+    {
+    }
+};
+
+TEST(PropertyIntegers, generatesValuesInTheRange)
+{
+    PropertyIntegers<int> integers(-3, 5);
+    bool seen[9] = { false };
+    for (int i = 0; i < 1000; i++) {
+        int value = integers.generate(random);
+        CHECK(value >= -3 && value <= 5);
+        seen[value + 3] = true;
+    }
+    for (int i = 0; i < 9; i++)
+        CHECK(seen[i]);
+}
+
+TEST(PropertyIntegers, generatesTheWholeRangeOfTheType)
+{
+    PropertyIntegers<unsigned char> bytes(0, 255);
+    bool seenLast = false;
+    for (int i = 0; i < 1000; i++)
+        seenLast |= (bytes.generate(random) == 255);
+    CHECK(seenLast);
+}
+
+TEST(PropertyIntegers, shrinksTowardsZero)
+{
+    PropertyIntegers<int> integers(-100, 100);
+    int simpler = 0;
+
+    CHECK(integers.shrink(40, 0, simpler));
+    LONGS_EQUAL(0, simpler);
+    CHECK(integers.shrink(40, 1, simpler));
+    LONGS_EQUAL(20, simpler);
+    CHECK(integers.shrink(-40, 2, simpler));
+    LONGS_EQUAL(-30, simpler);
+    CHECK(integers.shrink(40, 5, simpler));
+    LONGS_EQUAL(39, simpler);
+    CHECK_FALSE(integers.shrink(40, 6, simpler));
+    CHECK_FALSE(integers.shrink(0, 0, simpler));
+}
+
+TEST(PropertyIntegers, shrinksTowardsTheEndOfTheRangeClosestToZero)
+{
+    PropertyIntegers<int> positive(10, 20);
+    PropertyIntegers<int> negative(-20, -10);
+    int simpler = 0;
+
+    CHECK(positive.shrink(15, 0, simpler));
+    LONGS_EQUAL(10, simpler);
+    CHECK(negative.shrink(-15, 0, simpler));
+    LONGS_EQUAL(-10, simpler);
+    CHECK_FALSE(positive.shrink(10, 0, simpler));
+}
+
+TEST(PropertyIntegers, describesByStringFrom)
+{
+    STRCMP_EQUAL("-12", PropertyIntegers<int>(-20, 20).describe(-12).asCharString());
+}
+
+TEST_GROUP(PropertyLists)
+{
+    PropertyRandom random;
+
+    TEST_GROUP_CppUTestGroupPropertyLists() : random(11)
+    {
+    }
+};
+
+TEST(PropertyLists, removalCandidatesAreTheWholeThenHalvesThenSingleElements)
+{
+    size_t expected[][2] = { { 0, 4 }, { 0, 2 }, { 2, 2 }, { 0, 1 }, { 1, 1 }, { 2, 1 }, { 3, 1 } };
+    for (size_t i = 0; i < 7; i++) {
+        size_t candidate = i, start = 99, count = 99;
+        CHECK(propertyRemovalCandidate(4, candidate, start, count));
+        LONGS_EQUAL(expected[i][0], start);
+        LONGS_EQUAL(expected[i][1], count);
+    }
+    size_t candidate = 9, start, count;
+    CHECK_FALSE(propertyRemovalCandidate(4, candidate, start, count));
+    LONGS_EQUAL(2, candidate);
+}
+
+TEST(PropertyLists, generatesUpToTheMaximumSize)
+{
+    PropertyLists<PropertyIntegers<int> > lists(PropertyIntegers<int>(0, 9), 5);
+    size_t longest = 0;
+    for (int i = 0; i < 200; i++) {
+        PropertyList<int> list = lists.generate(random);
+        CHECK(list.size() <= 5);
+        if (list.size() > longest) longest = list.size();
+        for (size_t j = 0; j < list.size(); j++)
+            CHECK(list[j] >= 0 && list[j] <= 9);
+    }
+    LONGS_EQUAL(5, longest);
+}
+
+TEST(PropertyLists, shrinksByRemovingElementsThenByShrinkingThem)
+{
+    PropertyLists<PropertyIntegers<int> > lists(PropertyIntegers<int>(0, 9), 5);
+    PropertyList<int> list;
+    list.add(4);
+    list.add(6);
+    PropertyList<int> simpler;
+
+    CHECK(lists.shrink(list, 0, simpler));
+    STRCMP_EQUAL("{}", StringFrom(simpler).asCharString());
+    CHECK(lists.shrink(list, 2, simpler));
+    STRCMP_EQUAL("{4}", StringFrom(simpler).asCharString());
+    CHECK(lists.shrink(list, 3, simpler));
+    STRCMP_EQUAL("{0, 6}", StringFrom(simpler).asCharString());
+    CHECK(lists.shrink(list, 6, simpler));
+    STRCMP_EQUAL("{4, 0}", StringFrom(simpler).asCharString());
+    CHECK_FALSE(lists.shrink(list, 9, simpler));
+}
+
+TEST(PropertyLists, bytesAreDescribedInHex)
+{
+    PropertyBytes bytes(4);
+    PropertyList<unsigned char> list;
+    list.add(0x0f);
+    list.add(0xa0);
+    STRCMP_EQUAL("{0F A0}", bytes.describe(list).asCharString());
+}
+
+TEST(PropertyLists, stringsUseTheAlphabet)
+{
+    PropertyStrings strings(8, "xy");
+    for (int i = 0; i < 100; i++) {
+        SimpleString text = strings.generate(random);
+        CHECK(text.size() <= 8);
+        for (size_t j = 0; j < text.size(); j++)
+            CHECK(text.at(j) == 'x' || text.at(j) == 'y');
+    }
+}
+
+TEST(PropertyLists, stringsShrinkToTheFirstCharacterOfTheAlphabet)
+{
+    PropertyStrings strings(8, "xy");
+    SimpleString simpler;
+
+    CHECK(strings.shrink("yy", 0, simpler));
+    STRCMP_EQUAL("", simpler.asCharString());
+    CHECK(strings.shrink("yy", 2, simpler));
+    STRCMP_EQUAL("y", simpler.asCharString());
+    CHECK(strings.shrink("yy", 4, simpler));
+    STRCMP_EQUAL("yx", simpler.asCharString());
+    CHECK_FALSE(strings.shrink("xx", 3, simpler));
+    STRCMP_EQUAL("\"xy\"", strings.describe("xy").asCharString());
+}
+
+struct PropertyPoint
+{
+    int x;
+    int y;
+};
+
+static SimpleString StringFrom(const PropertyPoint& point)
+{
+    return StringFromFormat("(%d, %d)", point.x, point.y);
+}
+
+class PropertyPoints : public PropertyGenerator<PropertyPoint>
+{
+public:
+    virtual PropertyPoint generate(PropertyRandom& random) const _override
+    {
+        PropertyPoint point;
+        point.x = coordinates_.generate(random);
+        point.y = coordinates_.generate(random);
+        return point;
+    }
+
+    virtual bool shrink(const PropertyPoint& value, size_t candidate, PropertyPoint& simpler) const _override
+    {
+        simpler = value;
+        if (coordinates_.shrink(value.x, candidate, simpler.x)) return true;
+
+        size_t xCandidates = 0;
+        while (coordinates_.shrink(value.x, xCandidates, simpler.x)) xCandidates++;
+        simpler.x = value.x;
+        return coordinates_.shrink(value.y, candidate - xCandidates, simpler.y);
+    }
+
+    virtual SimpleString describe(const PropertyPoint& value) const _override
+    {
+        return StringFrom(value);
+    }
+
+    PropertyPoints() : coordinates_(-50, 50)
+    {
+    }
+
+private:
+    PropertyIntegers<int> coordinates_;
+};
+
+static size_t propertyCalls;
+static int lessThanTenLine;
+static UtestShell* shellBeforeProperty;
+static UtestShell* shellAfterProperty;
+
+static void lessThanTen(int value)
+{
+    propertyCalls++;
+    lessThanTenLine = __LINE__; CHECK(value < 10);
+}
+
+static void alwaysHolds(int value)
+{
+    propertyCalls++;
+    CHECK(value >= 0);
+}
+
+static void elementsBelowFifty(const PropertyList<int>& list)
+{
+    for (size_t i = 0; i < list.size(); i++)
+        CHECK_TEXT(list[i] < 50, "element too large");
+}
+
+static void pointsNearTheOrigin(const PropertyList<PropertyPoint>& points)
+{
+    for (size_t i = 0; i < points.size(); i++)
+        CHECK(points[i].x < 20 || points[i].y > -20);
+}
+
+#if CPPUTEST_USE_STD_CPP_LIB
+
+static size_t trialObjectsAlive;
+
+class PropertyTrialObject
+{
+public:
+    PropertyTrialObject() { trialObjectsAlive++; }
+    ~PropertyTrialObject() { trialObjectsAlive--; }
+};
+
+static void lessThanTenWithAnObject(int value)
+{
+    PropertyTrialObject object;
+    SimpleString text = StringFrom(value);
+    CHECK(value < 10);
+}
+
+static void checkLessThanTenWithAnObject()
+{
+    checkProperty(PropertyIntegers<int>(0, 1000), lessThanTenWithAnObject, "file.cpp", 12);
+}
+
+#endif
+
+static void checkLessThanTen()
+{
+    checkProperty(PropertyIntegers<int>(0, 1000), lessThanTen, "file.cpp", 8);
+}
+
+static void checkAlwaysHolds()
+{
+    shellBeforeProperty = UtestShell::getCurrent();
+    checkProperty(PropertyIntegers<int>(0, 1000), alwaysHolds, "file.cpp", 9);
+    shellAfterProperty = UtestShell::getCurrent();
+}
+
+static void checkElementsBelowFifty()
+{
+    checkProperty(PropertyLists<PropertyIntegers<int> >(PropertyIntegers<int>(0, 90), 10), elementsBelowFifty, "file.cpp", 10);
+}
+
+static void checkPointsNearTheOrigin()
+{
+    checkProperty(PropertyLists<PropertyPoints>(PropertyPoints(), 4), pointsNearTheOrigin, "file.cpp", 11);
+}
+
+TEST_GROUP(PropertyChecker)
+{
+    TestTestingFixture fixture;
+    size_t savedRuns;
+    unsigned int savedSeed;
+
+    void setup() _override
+    {
+        savedRuns = PropertyChecker::getRuns();
+        savedSeed = PropertyChecker::getSeed();
+        PropertyChecker::setRuns(100);
+        PropertyChecker::setSeed(1234);
+        propertyCalls = 0;
+        shellAfterProperty = NULLPTR;
+    }
+
+    void teardown() _override
+    {
+        PropertyChecker::setRuns(savedRuns);
+        PropertyChecker::setSeed(savedSeed);
+    }
+};
+
+TEST(PropertyChecker, runsThePropertyForEveryRunInOneTest)
+{
+    PropertyChecker::setRuns(250);
+    fixture.runTestWithMethod(checkAlwaysHolds);
+    LONGS_EQUAL(0, fixture.getFailureCount());
+    LONGS_EQUAL(1, fixture.getRunCount());
+    LONGS_EQUAL(250, propertyCalls);
+    LONGS_EQUAL(250, fixture.getCheckCount());
+    POINTERS_EQUAL(shellBeforeProperty, shellAfterProperty);
+}
+
+TEST(PropertyChecker, failureReportsTheSimplestCounterexampleAndTheSeed)
+{
+    fixture.runTestWithMethod(checkLessThanTen);
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains("FOR_ALL at file.cpp:8 failed after");
+    fixture.assertPrintContains("with --property-seed 1234");
+    fixture.assertPrintContains("Simplest counterexample");
+    fixture.assertPrintContains("): 10\n");
+    fixture.assertPrintContains("CHECK(value < 10) failed");
+}
+
+#if CPPUTEST_USE_STD_CPP_LIB
+
+TEST(PropertyChecker, failedTrialsDestroyTheObjectsOfTheProperty)
+{
+    trialObjectsAlive = 0;
+    fixture.runTestWithMethod(checkLessThanTenWithAnObject);
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    LONGS_EQUAL(0, trialObjectsAlive);
+}
+
+#endif
+
+TEST(PropertyChecker, failureIsReportedAtTheFailedCheck)
+{
+    fixture.runTestWithMethod(checkLessThanTen);
+    fixture.assertPrintContains(StringFromFormat("%s:%d", __FILE__, lessThanTenLine));
+}
+
+/* The summary line after the failure ends with the run time, which differs between runs */
+static SimpleString failureMessageIn(const SimpleString& output)
+{
+    const char* summary = SimpleString::StrStr(output.asCharString(), "Errors (");
+    return (summary) ? output.subString(0, (size_t) (summary - output.asCharString())) : output;
+}
+
+TEST(PropertyChecker, theSameSeedFindsTheSameCounterexample)
+{
+    PropertyChecker::setRuns(3);
+    fixture.runTestWithMethod(checkElementsBelowFifty);
+    SimpleString first = failureMessageIn(fixture.getOutput());
+    fixture.flushOutputAndResetResult();
+    fixture.runTestWithMethod(checkElementsBelowFifty);
+
+    STRCMP_CONTAINS("Simplest counterexample", first.asCharString());
+    STRCMP_EQUAL(first.asCharString(), failureMessageIn(fixture.getOutput()).asCharString());
+}
+
+TEST(PropertyChecker, listsShrinkToTheFewestAndSmallestElements)
+{
+    fixture.runTestWithMethod(checkElementsBelowFifty);
+    fixture.assertPrintContains("): {50}\n");
+    fixture.assertPrintContains("element too large");
+}
+
+TEST(PropertyChecker, userTypesShrinkThroughTheirGenerator)
+{
+    fixture.runTestWithMethod(checkPointsNearTheOrigin);
+    fixture.assertPrintContains("): {(20, -20)}\n");
+}
+
+TEST_GROUP(ForAll)
+{
+};
+
+FOR_ALL(ForAll, reversingTwiceGivesTheOriginal, PropertyStrings(20), const SimpleString& text)
+{
+    SimpleStringCollection words;
+    text.split(" ", words);
+    SimpleString joined;
+    for (size_t i = 0; i < words.size(); i++) joined += words[i];
+    STRCMP_EQUAL(text.asCharString(), joined.asCharString());
+}
+
+FOR_ALL(ForAll, bytesStayInRange, PropertyBytes(16), const PropertyList<unsigned char>& bytes)
+{
+    CHECK(bytes.size() <= 16);
+}
@@ -1263,3 +1263,102 @@ TEST(SimpleString, BracketsFormattedHexStringFromForULongLong)
 
 #endif
 
+TEST_GROUP(SimpleStringInternTable)
+{
+    SimpleStringInternTable table;
+};
+
+TEST(SimpleStringInternTable, emptyTableFindsNothing)
+{
+    POINTERS_EQUAL(NULLPTR, table.find("name"));
+    LONGS_EQUAL(0, table.size());
+}
+
+TEST(SimpleStringInternTable, internReturnsACopyOfTheString)
+{
+    char name[] = "name";
+    const char* handle = table.intern(name);
+
+    CHECK(handle != name);
+    STRCMP_EQUAL("name", handle);
+    LONGS_EQUAL(1, table.size());
+}
+
+TEST(SimpleStringInternTable, equalStringsGiveTheSameHandle)
+{
+    SimpleString first("group::function");
+    SimpleString second("group::function");
+
+    POINTERS_EQUAL(table.intern(first), table.intern(second));
+    LONGS_EQUAL(1, table.size());
+}
+
+TEST(SimpleStringInternTable, differentStringsGiveDifferentHandles)
+{
+    CHECK(table.intern("foo") != table.intern("bar"));
+    LONGS_EQUAL(2, table.size());
+}
+
+TEST(SimpleStringInternTable, findReturnsTheInternedHandle)
+{
+    const char* handle = table.intern("foo");
+
+    POINTERS_EQUAL(handle, table.find("foo"));
+    POINTERS_EQUAL(handle, table.find(SimpleString("foo")));
+    POINTERS_EQUAL(NULLPTR, table.find("fo"));
+}
+
+TEST(SimpleStringInternTable, emptyStringCanBeInterned)
+{
+    const char* handle = table.intern("");
+
+    STRCMP_EQUAL("", handle);
+    POINTERS_EQUAL(handle, table.find(""));
+}
+
+TEST(SimpleStringInternTable, handlesStayValidWhenTheTableGrows)
+{
+    const char* first = table.intern("name0");
+    for (int i = 1; i < 500; i++)
+        table.intern(StringFromFormat("name%d", i));
+
+    LONGS_EQUAL(500, table.size());
+    POINTERS_EQUAL(first, table.find("name0"));
+    STRCMP_EQUAL("name0", first);
+    STRCMP_EQUAL("name321", table.find("name321"));
+}
+
+TEST(SimpleStringInternTable, clearForgetsAllStrings)
+{
+    table.intern("foo");
+    table.clear();
+
+    LONGS_EQUAL(0, table.size());
+    POINTERS_EQUAL(NULLPTR, table.find("foo"));
+    STRCMP_EQUAL("foo", table.intern("foo"));
+}
+
+TEST(SimpleStringInternTable, dataCanBeAttachedToAnInternedString)
+{
+    int data = 0;
+    table.intern("foo");
+    table.setData("foo", &data);
+
+    POINTERS_EQUAL(&data, table.getData("foo"));
+    POINTERS_EQUAL(NULLPTR, table.getData("bar"));
+}
+
+TEST(SimpleStringInternTable, dataIsNotAttachedToAStringThatIsNotInterned)
+{
+    int data = 0;
+    table.setData("foo", &data);
+
+    POINTERS_EQUAL(NULLPTR, table.getData("foo"));
+    LONGS_EQUAL(0, table.size());
+}
+
+TEST(SimpleStringInternTable, hashIsFnv1a)
+{
+    UNSIGNED_LONGS_EQUAL(2166136261u, SimpleStringInternTable::hash(""));
+    CHECK(SimpleStringInternTable::hash("a") != SimpleStringInternTable::hash("b"));
+}
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/TestFilter.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+TEST_GROUP(TestRangeGenerator)
+{
+};
+
+TEST(TestRangeGenerator, enumeratesFromBeginUpToEnd)
+{
+    TestRangeGenerator range(3, 6);
+    CHECK(range.first());
+    LONGS_EQUAL(3, range.getValue());
+    CHECK(range.next());
+    LONGS_EQUAL(4, range.getValue());
+    CHECK(range.next());
+    LONGS_EQUAL(5, range.getValue());
+    CHECK_FALSE(range.next());
+}
+
+TEST(TestRangeGenerator, stepsBackwards)
+{
+    TestRangeGenerator range(4, 0, -2);
+    CHECK(range.first());
+    LONGS_EQUAL(4, range.getValue());
+    CHECK(range.next());
+    LONGS_EQUAL(2, range.getValue());
+    CHECK_FALSE(range.next());
+}
+
+TEST(TestRangeGenerator, emptyRangeHasNoCases)
+{
+    TestRangeGenerator range(3, 3);
+    CHECK_FALSE(range.first());
+}
+
+TEST(TestRangeGenerator, zeroStepHasNoCases)
+{
+    TestRangeGenerator range(0, 3, 0);
+    CHECK_FALSE(range.first());
+}
+
+TEST(TestRangeGenerator, stopsBeforeSteppingPastLongMax)
+{
+    TestRangeGenerator range(LONG_MAX - 3, LONG_MAX, 2);
+    CHECK(range.first());
+    CHECK(range.next());
+    LONGS_EQUAL(LONG_MAX - 1, range.getValue());
+    CHECK_FALSE(range.next());
+    LONGS_EQUAL(LONG_MAX - 1, range.getValue());
+}
+
+TEST(TestRangeGenerator, stopsBeforeSteppingPastLongMin)
+{
+    TestRangeGenerator range(LONG_MIN + 3, LONG_MIN, -2);
+    CHECK(range.first());
+    CHECK(range.next());
+    LONGS_EQUAL(LONG_MIN + 1, range.getValue());
+    CHECK_FALSE(range.next());
+}
+
+TEST(TestRangeGenerator, stepLargerThanHalfTheRangeOfLong)
+{
+    TestRangeGenerator range(-1, LONG_MAX, LONG_MAX);
+    CHECK(range.first());
+    CHECK(range.next());
+    LONGS_EQUAL(LONG_MAX - 1, range.getValue());
+    CHECK_FALSE(range.next());
+}
+
+TEST(TestRangeGenerator, restartsAtTheBegin)
+{
+    TestRangeGenerator range(1, 3);
+    range.first();
+    range.next();
+    CHECK(range.first());
+    LONGS_EQUAL(1, range.getValue());
+}
+
+TEST(TestRangeGenerator, casesAreNamedByIndex)
+{
+    TestRangeGenerator range(1, 3);
+    CHECK(NULLPTR == range.getCaseName());
+}
+
+TEST_GROUP(TestArrayGenerator)
+{
+};
+
+TEST(TestArrayGenerator, enumeratesTheValues)
+{
+    static const char* const values[] = { "a", "b" };
+    TestArrayGenerator<const char*> array(values);
+    CHECK(array.first());
+    STRCMP_EQUAL("a", array.getValue());
+    CHECK(array.next());
+    STRCMP_EQUAL("b", array.getValue());
+    CHECK_FALSE(array.next());
+}
+
+TEST(TestArrayGenerator, takesAPointerAndACount)
+{
+    static const int values[] = { 1, 2, 3 };
+    TestArrayGenerator<int> array(values + 1, 1);
+    CHECK(array.first());
+    LONGS_EQUAL(2, array.getValue());
+    CHECK_FALSE(array.next());
+}
+
+TEST(TestArrayGenerator, emptyArrayHasNoCases)
+{
+    TestArrayGenerator<int> array(NULLPTR, 0);
+    CHECK_FALSE(array.first());
+}
+
+static const char* linesFileContent = NULLPTR;
+static size_t linesFilePosition = 0;
+static size_t linesFileReadLimit = 0;
+static int linesFileOpenCount = 0;
+static int linesFileCloseCount = 0;
+
+static PlatformSpecificFile StubFOpen(const char* fileName, const char*)
+{
+    if (SimpleString::StrCmp(fileName, "missing") == 0) return NULLPTR;
+    linesFileOpenCount++;
+    linesFilePosition = 0;
+    return (PlatformSpecificFile) &linesFileContent;
+}
+
+static size_t StubFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    size_t amount = SimpleString::StrLen(linesFileContent) - linesFilePosition;
+    if (amount > size) amount = size;
+    if (amount > linesFileReadLimit) amount = linesFileReadLimit;
+    PlatformSpecificMemCpy(buffer, linesFileContent + linesFilePosition, amount);
+    linesFilePosition += amount;
+    return amount;
+}
+
+static void StubFClose(PlatformSpecificFile)
+{
+    linesFileCloseCount++;
+}
+
+TEST_GROUP(TestFileLinesGenerator)
+{
+    void setup() _override
+    {
+        linesFileReadLimit = 4096;
+        linesFileOpenCount = 0;
+        linesFileCloseCount = 0;
+        UT_PTR_SET(PlatformSpecificFOpen, StubFOpen);
+        UT_PTR_SET(PlatformSpecificFRead, StubFRead);
+        UT_PTR_SET(PlatformSpecificFClose, StubFClose);
+    }
+};
+
+TEST(TestFileLinesGenerator, enumeratesTheLinesAndClosesTheFileAtTheEnd)
+{
+    linesFileContent = "first\nsecond\n";
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK(lines.first());
+    STRCMP_EQUAL("first", lines.getValue());
+    CHECK(lines.next());
+    STRCMP_EQUAL("second", lines.getValue());
+    CHECK_FALSE(lines.next());
+    LONGS_EQUAL(1, linesFileCloseCount);
+}
+
+TEST(TestFileLinesGenerator, lastLineNeedsNoNewline)
+{
+    linesFileContent = "first\nlast";
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK(lines.first());
+    CHECK(lines.next());
+    STRCMP_EQUAL("last", lines.getValue());
+    CHECK_FALSE(lines.next());
+}
+
+TEST(TestFileLinesGenerator, emptyLinesAreCases)
+{
+    linesFileContent = "\n\nthird\n";
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK(lines.first());
+    STRCMP_EQUAL("", lines.getValue());
+    CHECK(lines.next());
+    CHECK(lines.next());
+    STRCMP_EQUAL("third", lines.getValue());
+    CHECK_FALSE(lines.next());
+}
+
+TEST(TestFileLinesGenerator, carriageReturnsAreStripped)
+{
+    linesFileContent = "dos\r\n";
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK(lines.first());
+    STRCMP_EQUAL("dos", lines.getValue());
+}
+
+TEST(TestFileLinesGenerator, linesSpanReads)
+{
+    linesFileContent = "a line longer than a read\nnext\n";
+    linesFileReadLimit = 3;
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK(lines.first());
+    STRCMP_EQUAL("a line longer than a read", lines.getValue());
+    CHECK(lines.next());
+    STRCMP_EQUAL("next", lines.getValue());
+    CHECK_FALSE(lines.next());
+}
+
+TEST(TestFileLinesGenerator, emptyFileHasNoCases)
+{
+    linesFileContent = "";
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK_FALSE(lines.first());
+    LONGS_EQUAL(1, linesFileCloseCount);
+}
+
+TEST(TestFileLinesGenerator, missingFileIsOneCaseWithAnError)
+{
+    TestFileLinesGenerator lines("missing");
+    CHECK(lines.first());
+    STRCMP_EQUAL("cannot open missing", lines.getCaseError());
+    STRCMP_EQUAL("", lines.getValue());
+    CHECK_FALSE(lines.next());
+}
+
+TEST(TestFileLinesGenerator, linesHaveNoError)
+{
+    linesFileContent = "first\n";
+    TestFileLinesGenerator lines("corpus.txt");
+    CHECK(lines.first());
+    CHECK(NULLPTR == lines.getCaseError());
+}
+
+TEST(TestFileLinesGenerator, restartingReopensTheFile)
+{
+    linesFileContent = "first\nsecond\n";
+    TestFileLinesGenerator lines("corpus.txt");
+    lines.first();
+    lines.next();
+    CHECK(lines.first());
+    STRCMP_EQUAL("first", lines.getValue());
+    LONGS_EQUAL(2, linesFileOpenCount);
+    LONGS_EQUAL(1, linesFileCloseCount);
+}
+
+static long casesRun[10];
+static size_t casesRunCount;
+
+class NamedRangeGenerator : public TestRangeGenerator
+{
+public:
+    NamedRangeGenerator() : TestRangeGenerator(0, 2)
+    {
+    }
+
+    virtual const char* getCaseName() const _override
+    {
+        return getValue() == 0 ? "zero" : "one";
+    }
+};
+
+template <typename Generator>
+class RecordingParameterizedTest : public Utest
+{
+public:
+    explicit RecordingParameterizedTest(const Generator& generator) : generator_(generator)
+    {
+    }
+
+    void testBody() _override
+    {
+        casesRun[casesRunCount++] = generator_.getValue();
+    }
+
+private:
+    const Generator& generator_;
+};
+
+template <typename Generator>
+class RecordingParameterizedShell : public ParameterizedUtestShell
+{
+public:
+    RecordingParameterizedShell(const char* groupName, const char* testName, Generator& generator)
+        : ParameterizedUtestShell(groupName, testName, generator), generator_(generator)
+    {
+    }
+
+    virtual Utest* createTest() _override
+    {
+        return new RecordingParameterizedTest<Generator>(generator_);
+    }
+
+private:
+    Generator& generator_;
+};
+
+static void recordGroupSetup()
+{
+    casesRun[casesRunCount++] = -1;
+}
+
+static void recordGroupTeardown()
+{
+    casesRun[casesRunCount++] = -2;
+}
+
+TEST_GROUP(ParameterizedUtestShell)
+{
+    TestRegistry registry;
+    StringBufferTestOutput output;
+    TestResult* result;
+    TestRangeGenerator range;
+    RecordingParameterizedShell<TestRangeGenerator> shell;
+
+    TEST_GROUP_CppUTestGroupParameterizedUtestShell() :
+        range(10, 14), shell("Group", "test", range)
+    {
+    }
+
+    void setup() _override
+    {
+        casesRunCount = 0;
+        result = new TestResult(output);
+        registry.addTest(&shell);
+    }
+
+    void teardown() _override
+    {
+        delete result;
+    }
+
+    SimpleString recordedCases()
+    {
+        SimpleString recorded;
+        for (size_t i = 0; i < casesRunCount; i++) {
+            if (i) recorded += " ";
+            recorded += StringFrom(casesRun[i]);
+        }
+        return recorded;
+    }
+};
+
+TEST(ParameterizedUtestShell, runsEveryCase)
+{
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("10 11 12 13", recordedCases().asCharString());
+    LONGS_EQUAL(4, result->getTestCount());
+    LONGS_EQUAL(4, result->getRunCount());
+}
+
+TEST(ParameterizedUtestShell, caseWithAnErrorFailsWithoutRunning)
+{
+    TestRegistry linesRegistry;
+    TestFileLinesGenerator lines("no/such/cases.txt");
+    ParameterizedUtestShell linesShell("Group", "lines", lines);
+    linesRegistry.addTest(&linesShell);
+
+    linesRegistry.runAllTests(*result);
+
+    LONGS_EQUAL(1, result->getRunCount());
+    LONGS_EQUAL(1, result->getFailureCount());
+    STRCMP_CONTAINS("cannot open no/such/cases.txt", output.getOutput().asCharString());
+}
+
+TEST(ParameterizedUtestShell, casesAreReportedByIndex)
+{
+    output.verbose(TestOutput::level_verbose);
+    registry.runAllTests(*result);
+
+    STRCMP_CONTAINS("TEST_P(Group, test/0)", output.getOutput().asCharString());
+    STRCMP_CONTAINS("TEST_P(Group, test/3)", output.getOutput().asCharString());
+}
+
+TEST(ParameterizedUtestShell, casesAreReportedByTheNameTheGeneratorGives)
+{
+    NamedRangeGenerator named;
+    RecordingParameterizedShell<NamedRangeGenerator> namedShell("Group", "named", named);
+    TestRegistry namedRegistry;
+    namedRegistry.addTest(&namedShell);
+    output.verbose(TestOutput::level_verbose);
+
+    namedRegistry.runAllTests(*result);
+
+    STRCMP_CONTAINS("TEST_P(Group, named/zero)", output.getOutput().asCharString());
+    STRCMP_CONTAINS("TEST_P(Group, named/one)", output.getOutput().asCharString());
+}
+
+TEST(ParameterizedUtestShell, nameIsRestoredAfterTheRun)
+{
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("test", shell.getName().asCharString());
+}
+
+TEST(ParameterizedUtestShell, singleCaseIsSelectedByItsName)
+{
+    TestFilter filter("test/2");
+    filter.strictMatching();
+    registry.setNameFilters(&filter);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("12", recordedCases().asCharString());
+    LONGS_EQUAL(3, result->getFilteredOutCount());
+}
+
+TEST(ParameterizedUtestShell, allCasesAreSelectedByTheNameOfTheTest)
+{
+    TestFilter filter("test");
+    filter.strictMatching();
+    registry.setNameFilters(&filter);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("10 11 12 13", recordedCases().asCharString());
+}
+
+TEST(ParameterizedUtestShell, singleCaseIsExcludedByItsName)
+{
+    TestFilter filter("test/1");
+    filter.strictMatching();
+    filter.invertMatching();
+    registry.setNameFilters(&filter);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("10 12 13", recordedCases().asCharString());
+}
+
+TEST(ParameterizedUtestShell, casesAreSelectedAsGroupDotName)
+{
+    TestFilter filter("Group.test/3");
+    filter.strictMatching();
+    registry.setTestFilters(&filter);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("13", recordedCases().asCharString());
+}
+
+TEST(ParameterizedUtestShell, groupFixturesRunAroundAllCases)
+{
+    TestGroupFixtureShell setupOnce("Group", "setupOnce", "File", 1, recordGroupSetup, true);
+    TestGroupFixtureShell teardownOnce("Group", "teardownOnce", "File", 2, recordGroupTeardown, false);
+    registry.addGroupFixture(&setupOnce);
+    registry.addGroupFixture(&teardownOnce);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("-1 10 11 12 13 -2", recordedCases().asCharString());
+}
+
+TEST(ParameterizedUtestShell, groupFixturesDoNotRunWhenAllCasesAreFilteredOut)
+{
+    TestGroupFixtureShell setupOnce("Group", "setupOnce", "File", 1, recordGroupSetup, true);
+    registry.addGroupFixture(&setupOnce);
+    TestFilter filter("other");
+    registry.setNameFilters(&filter);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("", recordedCases().asCharString());
+}
+
+static const int primes[] = { 2, 3, 5, 7 };
+static TestArrayGenerator<int> somePrimes(primes);
+static TestRangeGenerator firstThousand(0, 1000);
+
+TEST_GROUP(TestParameterized)
+{
+};
+
+TEST_P(TestParameterized, primesAreOddExceptTwo, somePrimes)
+{
+    int prime = somePrimes.getValue();
+    CHECK(prime == 2 || prime % 2 == 1);
+}
+
+TEST_P(TestParameterized, squaresAreNotNegative, firstThousand)
+{
+    long value = firstThousand.getValue();
+    CHECK(value * value >= 0);
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestFilter.h"
+#include "CppUTest/TestFilterMatcher.h"
+
+TEST_GROUP(TestFilterAutomaton)
+{
+    TestFilterAutomaton automaton;
+};
+
+TEST(TestFilterAutomaton, emptyAutomatonMatchesNothing)
+{
+    automaton.compile();
+    CHECK(automaton.isEmpty());
+    CHECK_FALSE(automaton.matches("anything"));
+}
+
+TEST(TestFilterAutomaton, emptyPatternMatchesEverything)
+{
+    automaton.add("");
+    automaton.compile();
+    CHECK(automaton.matches(""));
+    CHECK(automaton.matches("anything"));
+}
+
+TEST(TestFilterAutomaton, findsAnyPatternAnywhereInTheText)
+{
+    automaton.add("he");
+    automaton.add("she");
+    automaton.add("his");
+    automaton.add("hers");
+    automaton.compile();
+    CHECK(automaton.matches("ushers"));
+    CHECK(automaton.matches("this"));
+    CHECK(automaton.matches("ahe"));
+    CHECK_FALSE(automaton.matches("hi"));
+    CHECK_FALSE(automaton.matches("s h e"));
+    CHECK_FALSE(automaton.matches(""));
+}
+
+TEST(TestFilterAutomaton, followsFailureLinksIntoOverlappingPatterns)
+{
+    automaton.add("abcd");
+    automaton.add("bce");
+    automaton.compile();
+    CHECK(automaton.matches("abce"));
+    CHECK_FALSE(automaton.matches("abcbc"));
+}
+
+TEST(TestFilterAutomaton, matchesLikeTestFilterForManyPatterns)
+{
+    for (int i = 0; i < 200; i++)
+        automaton.add(StringFromFormat("Test%dEnd", i).asCharString());
+    automaton.compile();
+    CHECK(automaton.matches("aTest199End"));
+    CHECK(automaton.matches("Test0End"));
+    CHECK_FALSE(automaton.matches("Test200End"));
+    CHECK_FALSE(automaton.matches("Test19"));
+}
+
+TEST(TestFilterAutomaton, clearRemovesAllPatterns)
+{
+    automaton.add("abc");
+    automaton.clear();
+    automaton.compile();
+    CHECK(automaton.isEmpty());
+    CHECK_FALSE(automaton.matches("abc"));
+}
+
+TEST_GROUP(TestFilterMatcher)
+{
+    TestFilterMatcher matcher;
+};
+
+TEST(TestFilterMatcher, withoutFiltersEverythingMatches)
+{
+    matcher.compile(NULLPTR, NULLPTR);
+    CHECK(matcher.match("group", "name"));
+}
+
+TEST(TestFilterMatcher, substringAndStrictGroupFilters)
+{
+    TestFilter substring("roup");
+    TestFilter exact("Other");
+    exact.strictMatching();
+    substring.add(&exact);
+    matcher.compile(&substring, NULLPTR);
+
+    CHECK(matcher.match("group", "name"));
+    CHECK(matcher.match("Other", "name"));
+    CHECK_FALSE(matcher.match("Others", "name"));
+}
+
+TEST(TestFilterMatcher, groupAndNameFiltersMustBothMatch)
+{
+    TestFilter group("group");
+    TestFilter name("name");
+    matcher.compile(&group, &name);
+
+    CHECK(matcher.match("group", "name"));
+    CHECK_FALSE(matcher.match("group", "other"));
+    CHECK_FALSE(matcher.match("other", "name"));
+}
+
+TEST(TestFilterMatcher, exactTestsDontCrossMatch)
+{
+    TestFilter test1("group1.test1");
+    TestFilter test2("group2.test2");
+    test1.strictMatching();
+    test2.strictMatching();
+    test1.add(&test2);
+    matcher.compile(NULLPTR, NULLPTR, &test1);
+
+    CHECK(matcher.match("group1", "test1"));
+    CHECK(matcher.match("group2", "test2"));
+    CHECK_FALSE(matcher.match("group1", "test2"));
+    CHECK_FALSE(matcher.match("group", "1.test1"));
+}
+
+TEST(TestFilterMatcher, exactTestsAddToGroupSelection)
+{
+    TestFilter group("group1");
+    TestFilter test("group2.test2");
+    test.strictMatching();
+    matcher.compile(&group, NULLPTR, &test);
+
+    CHECK(matcher.match("group1", "anything"));
+    CHECK(matcher.match("group2", "test2"));
+    CHECK_FALSE(matcher.match("group2", "test3"));
+}
+
+TEST(TestFilterMatcher, exactTestsWithLongNames)
+{
+    SimpleString longGroup("g", 300);
+    TestFilter test(longGroup + ".name");
+    test.strictMatching();
+    matcher.compile(NULLPTR, NULLPTR, &test);
+
+    CHECK(matcher.match(longGroup.asCharString(), "name"));
+    CHECK_FALSE(matcher.match(longGroup.asCharString(), "other"));
+}
+
+TEST(TestFilterMatcher, excludesTakePrecedenceOverIncludes)
+{
+    TestFilter group("group");
+    TestFilter excludedGroup("slowgroup");
+    excludedGroup.invertMatching();
+    group.add(&excludedGroup);
+    TestFilter excludedName("flaky");
+    excludedName.invertMatching();
+    matcher.compile(&group, &excludedName);
+
+    CHECK(matcher.match("group", "name"));
+    CHECK_FALSE(matcher.match("slowgroup", "name"));
+    CHECK_FALSE(matcher.match("group", "flakyname"));
+    CHECK_FALSE(matcher.match("other", "name"));
+}
+
+TEST(TestFilterMatcher, excludesAloneRunEverythingElse)
+{
+    TestFilter excluded1("one");
+    TestFilter excluded2("two");
+    excluded1.invertMatching();
+    excluded2.invertMatching();
+    excluded2.strictMatching();
+    excluded1.add(&excluded2);
+    matcher.compile(&excluded1, NULLPTR);
+
+    CHECK(matcher.match("three", "name"));
+    CHECK(matcher.match("twofold", "name"));
+    CHECK_FALSE(matcher.match("someone", "name"));
+    CHECK_FALSE(matcher.match("two", "name"));
+}
+
+TEST(TestFilterMatcher, excludedExactTest)
+{
+    TestFilter test("group.name");
+    test.strictMatching();
+    test.invertMatching();
+    matcher.compile(NULLPTR, NULLPTR, &test);
+
+    CHECK(matcher.match("group", "other"));
+    CHECK_FALSE(matcher.match("group", "name"));
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestOutput.h"
+
+static const char* events[10];
+static size_t eventCount;
+
+static void record(const char* event)
+{
+    events[eventCount++] = event;
+}
+
+static SimpleString recordedEvents()
+{
+    SimpleString recorded;
+    for (size_t i = 0; i < eventCount; i++) {
+        if (i) recorded += " ";
+        recorded += events[i];
+    }
+    return recorded;
+}
+
+static void setupGroupA()
+{
+    record("setupA");
+}
+
+static void teardownGroupA()
+{
+    record("teardownA");
+}
+
+static void failingSetupGroupA()
+{
+    record("failingSetupA");
+    FAIL("no resources");
+}
+
+class RecordingTest : public UtestShell
+{
+public:
+    RecordingTest(const char* group, const char* name) :
+        UtestShell(group, name, "File", 1), name_(name)
+    {
+    }
+
+    virtual void runOneTest(TestPlugin*, TestResult& result) _override
+    {
+        result.countRun();
+        record(name_);
+    }
+
+private:
+    const char* name_;
+};
+
+TEST_GROUP(TestGroupFixture)
+{
+    TestRegistry registry;
+    StringBufferTestOutput output;
+    TestResult* result;
+    RecordingTest a1;
+    RecordingTest a2;
+    RecordingTest b1;
+    TestGroupFixtureShell setupOnce;
+    TestGroupFixtureShell teardownOnce;
+
+    TEST_GROUP_CppUTestGroupTestGroupFixture() :
+        a1("A", "a1"), a2("A", "a2"), b1("B", "b1"),
+        setupOnce("A", "setupOnce", "File", 2, setupGroupA, true),
+        teardownOnce("A", "teardownOnce", "File", 3, teardownGroupA, false)
+    {
+    }
+
+    void setup() _override
+    {
+        eventCount = 0;
+        result = new TestResult(output);
+        registry.addGroupFixture(&setupOnce);
+        registry.addGroupFixture(&teardownOnce);
+    }
+
+    void teardown() _override
+    {
+        delete result;
+    }
+};
+
+TEST(TestGroupFixture, setupOnceRunsBeforeTheFirstTestAndTeardownOnceAfterTheLast)
+{
+    registry.addTest(&b1);
+    registry.addTest(&a2);
+    registry.addTest(&a1);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("setupA a1 a2 teardownA b1", recordedEvents().asCharString());
+}
+
+TEST(TestGroupFixture, fixturesFollowTheOrderTheTestsRunIn)
+{
+    registry.addTest(&a2);
+    registry.addTest(&b1);
+    registry.addTest(&a1);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("setupA a1 b1 a2 teardownA", recordedEvents().asCharString());
+}
+
+TEST(TestGroupFixture, fixturesOfAGroupWithoutTestsToRunDoNotRun)
+{
+    TestFilter groupFilter("B");
+    registry.setGroupFilters(&groupFilter);
+    registry.addTest(&b1);
+    registry.addTest(&a1);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("b1", recordedEvents().asCharString());
+}
+
+TEST(TestGroupFixture, fixturesRunAroundTheTestsThatAreNotFilteredOut)
+{
+    TestFilter nameFilter("a2");
+    registry.setNameFilters(&nameFilter);
+    registry.addTest(&a2);
+    registry.addTest(&a1);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("setupA a2 teardownA", recordedEvents().asCharString());
+}
+
+TEST(TestGroupFixture, ignoredTestsDoNotSetUpTheGroup)
+{
+    IgnoredUtestShell ignored("A", "ignored", "File", 1);
+    registry.addTest(&ignored);
+
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("", recordedEvents().asCharString());
+    LONGS_EQUAL(1, result->getIgnoredCount());
+}
+
+TEST(TestGroupFixture, fixturesRunOncePerRepetition)
+{
+    registry.addTest(&a1);
+
+    registry.runAllTests(*result);
+    registry.runAllTests(*result);
+
+    STRCMP_EQUAL("setupA a1 teardownA setupA a1 teardownA", recordedEvents().asCharString());
+}
+
+TEST(TestGroupFixture, failingSetupOnceSkipsTheTestsOfTheGroup)
+{
+    TestGroupFixtureShell failingSetupOnce("A", "setupOnce", "File", 4, failingSetupGroupA, true);
+    TestGroupFixtureShell teardownAfterFailure("A", "teardownOnce", "File", 5, teardownGroupA, false);
+    TestRegistry failingRegistry;
+    failingRegistry.addGroupFixture(&failingSetupOnce);
+    failingRegistry.addGroupFixture(&teardownAfterFailure);
+    failingRegistry.addTest(&b1);
+    failingRegistry.addTest(&a2);
+    failingRegistry.addTest(&a1);
+
+    failingRegistry.runAllTests(*result);
+
+    STRCMP_EQUAL("failingSetupA teardownA b1", recordedEvents().asCharString());
+    LONGS_EQUAL(1, result->getFailureCount());
+    LONGS_EQUAL(2, result->getIgnoredCount());
+    LONGS_EQUAL(1, result->getRunCount());
+    STRCMP_CONTAINS("TEST_GROUP_SETUP_ONCE(A, setupOnce)", output.getOutput().asCharString());
+    STRCMP_CONTAINS("no resources", output.getOutput().asCharString());
+}
+
+static int* groupResource = NULLPTR;
+static int setupsOfTheGroup = 0;
+
+TEST_GROUP(TestGroupFixtureUsage)
+{
+};
+
+TEST_GROUP_SETUP_ONCE(TestGroupFixtureUsage)
+{
+    setupsOfTheGroup++;
+    groupResource = new int[100];
+    groupResource[0] = 42;
+}
+
+TEST_GROUP_TEARDOWN_ONCE(TestGroupFixtureUsage)
+{
+    delete [] groupResource;
+    groupResource = NULLPTR;
+    setupsOfTheGroup = 0;
+}
+
+TEST(TestGroupFixtureUsage, groupResourceIsNotALeakOfTheFirstTest)
+{
+    LONGS_EQUAL(42, groupResource[0]);
+}
+
+TEST(TestGroupFixtureUsage, groupIsSetUpOnce)
+{
+    LONGS_EQUAL(1, setupsOfTheGroup);
+    LONGS_EQUAL(42, groupResource[0]);
+}
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestOutputMultiplexer.h"
+#include "CppUTest/TestFailure.h"
+
+class EventRecordingTestOutput : public TestOutput
+{
+public:
+    SimpleString events;
+
+    virtual void printTestsStarted() _override
+    {
+        events += "<tests>";
+    }
+
+    virtual void printTestsEnded(const TestResult& /*result*/) _override
+    {
+        events += "</tests>";
+    }
+
+    virtual void printCurrentGroupStarted(const UtestShell& test) _override
+    {
+        events += StringFromFormat("<group %s>", test.getGroup().asCharString());
+    }
+
+    virtual void printCurrentGroupEnded(const TestResult& res) _override
+    {
+        events += StringFromFormat("</group %d ms>", (int) res.getCurrentGroupTotalExecutionTime());
+    }
+
+    virtual void printCurrentTestStarted(const UtestShell& test) _override
+    {
+        events += StringFromFormat("<test %s>", test.getName().asCharString());
+    }
+
+    virtual void printCurrentTestEnded(const TestResult& res) _override
+    {
+        events += StringFromFormat("</test %d ms %d checks>", (int) res.getCurrentTestTotalExecutionTime(), (int) res.getCheckCount());
+    }
+
+    virtual void printFailure(const TestFailure& failure) _override
+    {
+        events += StringFromFormat("<failure %s>", failure.getMessage().asCharString());
+    }
+
+    virtual void printBuffer(const char* text) _override
+    {
+        events += text;
+    }
+
+    virtual void flush() _override
+    {
+    }
+};
+
+class MultiplexerWorker
+{
+public:
+    MultiplexerWorker(TestOutputMultiplexer& multiplexer)
+        : output_(multiplexer.createWorkerOutput()), result_(*output_)
+    {
+    }
+
+    ~MultiplexerWorker()
+    {
+        delete output_;
+    }
+
+    void start(UtestShell& test)
+    {
+        result_.currentTestStarted(&test);
+    }
+
+    void check()
+    {
+        result_.countCheck();
+    }
+
+    void print(const char* text)
+    {
+        result_.print(text);
+    }
+
+    void fail(UtestShell& test, const char* message)
+    {
+        result_.addFailure(TestFailure(&test, message));
+    }
+
+    void end(size_t executionTime = 0)
+    {
+        result_.setCurrentTestTotalExecutionTime(executionTime);
+        output_->printCurrentTestEnded(result_);
+    }
+
+    void run(UtestShell& test)
+    {
+        start(test);
+        end();
+    }
+
+private:
+    MultiplexedWorkerTestOutput* output_;
+    TestResult result_;
+};
+
+TEST_GROUP(TestOutputMultiplexer)
+{
+    EventRecordingTestOutput* target;
+    StringBufferTestOutput* progress;
+    TestOutputMultiplexer* multiplexer;
+    MultiplexerWorker* worker1;
+    MultiplexerWorker* worker2;
+    UtestShell* testA;
+    UtestShell* testB;
+    UtestShell* testC;
+
+    void setup() _override
+    {
+        target = new EventRecordingTestOutput;
+        progress = new StringBufferTestOutput;
+        testA = new UtestShell("group1", "A", "file", 1);
+        testB = new UtestShell("group1", "B", "file", 2);
+        testC = new UtestShell("group2", "C", "file", 3);
+        multiplexer = NULLPTR;
+        worker1 = NULLPTR;
+        worker2 = NULLPTR;
+    }
+
+    void teardown() _override
+    {
+        delete worker1;
+        delete worker2;
+        delete multiplexer;
+        delete testA;
+        delete testB;
+        delete testC;
+        delete progress;
+        delete target;
+    }
+
+    void createMultiplexer(TestOutputMultiplexer::Order order)
+    {
+        multiplexer = new TestOutputMultiplexer(*target, order);
+        worker1 = new MultiplexerWorker(*multiplexer);
+        worker2 = new MultiplexerWorker(*multiplexer);
+    }
+
+    void scheduleAll()
+    {
+        multiplexer->scheduleTest(*testA);
+        multiplexer->scheduleTest(*testB);
+        multiplexer->scheduleTest(*testC);
+    }
+};
+
+TEST(TestOutputMultiplexer, registryOrderHoldsBackTestsThatCompleteEarly)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+    scheduleAll();
+
+    worker1->start(*testA);
+    worker2->run(*testB);
+    STRCMP_EQUAL("", target->events.asCharString());
+
+    worker1->end();
+    STRCMP_EQUAL("<group group1><test A></test 0 ms 0 checks><test B></test 0 ms 0 checks>", target->events.asCharString());
+    LONGS_EQUAL(2, multiplexer->getEmittedCount());
+}
+
+TEST(TestOutputMultiplexer, completionOrderEmitsTestsAsSoonAsTheyEnd)
+{
+    createMultiplexer(TestOutputMultiplexer::completionOrder);
+    scheduleAll();
+
+    worker1->start(*testA);
+    worker2->run(*testB);
+    STRCMP_EQUAL("<group group1><test B></test 0 ms 0 checks>", target->events.asCharString());
+
+    worker1->end();
+    STRCMP_EQUAL("<group group1><test B></test 0 ms 0 checks><test A></test 0 ms 0 checks>", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, eventsOfOneTestAreNotInterleavedWithAnother)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+    scheduleAll();
+
+    worker1->start(*testA);
+    worker2->start(*testB);
+    worker1->print("a1 ");
+    worker2->print("b1 ");
+    worker1->print("a2 ");
+    worker2->end();
+    worker1->end();
+
+    STRCMP_CONTAINS("<test A>a1 a2 </test", target->events.asCharString());
+    STRCMP_CONTAINS("<test B>b1 </test", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, failuresChecksAndTimesAreReplayed)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+    multiplexer->scheduleTest(*testA);
+
+    worker1->start(*testA);
+    worker1->check();
+    worker1->check();
+    worker1->fail(*testA, "boom");
+    worker1->end(7);
+
+    STRCMP_EQUAL("<group group1><test A><failure boom></test 7 ms 2 checks>", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, groupsAreStartedAndEndedAroundTheirTests)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+    scheduleAll();
+    multiplexer->testsStarted();
+
+    worker1->start(*testA);
+    worker1->end(1);
+    worker2->start(*testB);
+    worker2->end(2);
+    worker1->start(*testC);
+    worker1->end(4);
+
+    TestResult result(*target);
+    multiplexer->testsEnded(result);
+
+    STRCMP_EQUAL("<tests><group group1><test A></test 1 ms 0 checks><test B></test 2 ms 0 checks></group 3 ms>"
+                 "<group group2><test C></test 4 ms 0 checks></group 4 ms></tests>", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, testsEndedEmitsCompletedTestsAndSkipsTheOnesThatNeverRan)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+    scheduleAll();
+
+    worker2->run(*testC);
+    TestResult result(*target);
+    multiplexer->testsEnded(result);
+
+    STRCMP_EQUAL("<group group2><test C></test 0 ms 0 checks></group 0 ms></tests>", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, unscheduledTestsAreEmittedInTheOrderTheyStarted)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+
+    worker1->start(*testB);
+    worker2->run(*testA);
+    worker1->end();
+
+    STRCMP_EQUAL("<group group1><test B></test 0 ms 0 checks><test A></test 0 ms 0 checks>", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, printingBeforeATestStartsBelongsToThatTest)
+{
+    createMultiplexer(TestOutputMultiplexer::registryOrder);
+
+    worker1->print("before ");
+    worker1->run(*testA);
+
+    STRCMP_EQUAL("<group group1><test A>before </test 0 ms 0 checks>", target->events.asCharString());
+}
+
+TEST(TestOutputMultiplexer, progressLineShowsCompletedRunningAndFailedTests)
+{
+    createMultiplexer(TestOutputMultiplexer::completionOrder);
+    multiplexer->setProgressOutput(progress);
+    scheduleAll();
+
+    worker1->start(*testA);
+    worker2->start(*testB);
+    worker2->fail(*testB, "failed");
+    worker2->end();
+
+    STRCMP_EQUAL("\r[1/3] 1 running, 1 failed", progress->getOutput().asCharString());
+    LONGS_EQUAL(3, multiplexer->getScheduledCount());
+    LONGS_EQUAL(1, multiplexer->getCompletedCount());
+}
@@ -31,6 +31,7 @@
 #include "CppUTest/PlatformSpecificFunctions.h"
 
 static long millisTime;
+static TestResourceUsage* resourceUsage;
 
 extern "C" {
 
@@ -41,6 +42,13 @@ extern "C" {
 
 }
 
+static int MockGetResourceUsage(TestResourceUsage* usage)
+{
+    if (resourceUsage == NULLPTR) return 0;
+    *usage = *resourceUsage;
+    return 1;
+}
+
 TEST_GROUP(TestOutput)
 {
     TestOutput* printer;
@@ -62,7 +70,9 @@ TEST_GROUP(TestOutput)
         result = new TestResult(*mock);
         result->setTotalExecutionTime(10);
         millisTime = 0;
+        resourceUsage = NULLPTR;
         UT_PTR_SET(GetPlatformSpecificTimeInMillis, MockGetPlatformSpecificTimeInMillis);
+        UT_PTR_SET(PlatformSpecificGetResourceUsage, MockGetResourceUsage);
         TestOutput::setWorkingEnvironment(TestOutput::eclipse);
 
     }
@@ -178,6 +188,36 @@ TEST(TestOutput, PrintTestVerboseEnded)
     STRCMP_EQUAL("TEST(group, test) - 5 ms\n", mock->getOutput().asCharString());
 }
 
+TEST(TestOutput, PrintTestVerboseEndedWithResourceUsage)
+{
+    TestResourceUsage usage;
+    usage.userTimeInMicroseconds_ = 1000;
+    usage.peakResidentSetInKilobytes_ = 2000;
+    usage.minorPageFaults_ = 10;
+    resourceUsage = &usage;
+    mock->verbose(TestOutput::level_verbose);
+    result->currentTestStarted(tst);
+    usage.userTimeInMicroseconds_ = 2200;
+    usage.systemTimeInMicroseconds_ = 300;
+    usage.peakResidentSetInKilobytes_ = 2120;
+    usage.minorPageFaults_ = 41;
+    usage.voluntaryContextSwitches_ = 2;
+    millisTime = 5;
+    result->currentTestEnded(tst);
+    STRCMP_EQUAL("TEST(group, test) - 5 ms (user 1.200 ms, sys 0.300 ms, rss +120 kB, "
+                 "faults 0 major / 31 minor, switches 2 voluntary / 0 involuntary)\n", mock->getOutput().asCharString());
+}
+
+TEST(TestOutput, PrintTestVerboseEndedWithCounters)
+{
+    mock->verbose(TestOutput::level_verbose);
+    result->currentTestStarted(tst);
+    result->addCurrentTestCounter("instructions", 1234);
+    result->addCurrentTestCounter("cycles", 567);
+    result->currentTestEnded(tst);
+    STRCMP_EQUAL("TEST(group, test) - 0 ms [instructions 1234, cycles 567]\n", mock->getOutput().asCharString());
+}
+
 TEST(TestOutput, printColorWithSuccess)
 {
     mock->color();
@@ -29,6 +29,8 @@
 #include "CppUTest/TestRegistry.h"
 #include "CppUTest/TestOutput.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTest/MemoryLeakWarningPlugin.h"
+#include "CppUTest/MemoryLeakDetector.h"
 
 namespace
 {
@@ -263,6 +265,61 @@ TEST(TestRegistry, findTestWithGroup)
     CHECK(myRegistry->findTestWithGroup("GroupOfATestThatDoesExist") != NULLPTR);
 }
 
+TEST(TestRegistry, findTestWithNameReturnsTheFirstTestInListOrder)
+{
+    test1->setTestName("SameName");
+    test2->setTestName("SameName");
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    CHECK(myRegistry->findTestWithName("SameName") == test2);
+}
+
+TEST(TestRegistry, findTestWithGroupAndName)
+{
+    test1->setTestName("name1");
+    test2->setTestName("name2");
+    test3->setTestName("name1");
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    myRegistry->addTest(test3);
+    CHECK(myRegistry->findTestWithGroupAndName("Group", "name1") == test1);
+    CHECK(myRegistry->findTestWithGroupAndName("Group", "name2") == test2);
+    CHECK(myRegistry->findTestWithGroupAndName("group2", "name1") == test3);
+    CHECK(myRegistry->findTestWithGroupAndName("group2", "name2") == NULLPTR);
+}
+
+TEST(TestRegistry, indexBuiltDuringATestIsNotLeakChecked)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    size_t leaks = MemoryLeakWarningPlugin::getGlobalDetector()->totalMemoryLeaks(mem_leak_period_checking);
+
+    CHECK(myRegistry->findTestWithGroup("group2") == test3);
+    LONGS_EQUAL(leaks, MemoryLeakWarningPlugin::getGlobalDetector()->totalMemoryLeaks(mem_leak_period_checking));
+}
+
+TEST(TestRegistry, countTestsInGroupCountsTestsOfGroupsThatAreNotContiguous)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->addTest(test2);
+    LONGS_EQUAL(2, myRegistry->countTestsInGroup("Group"));
+    LONGS_EQUAL(1, myRegistry->countTestsInGroup("group2"));
+    LONGS_EQUAL(0, myRegistry->countTestsInGroup("NoSuchGroup"));
+}
+
+TEST(TestRegistry, lookupsSeeTestsAddedAfterThePreviousLookup)
+{
+    test1->setTestName("first");
+    test2->setTestName("second");
+    myRegistry->addTest(test1);
+    CHECK(myRegistry->findTestWithName("second") == NULLPTR);
+    myRegistry->addTest(test2);
+    CHECK(myRegistry->findTestWithName("second") == test2);
+    myRegistry->unDoLastAddTest();
+    CHECK(myRegistry->findTestWithName("second") == NULLPTR);
+}
+
 TEST(TestRegistry, nameFilterWorks)
 {
     test1->setTestName("testname");
@@ -285,6 +342,34 @@ TEST(TestRegistry, groupFilterWorks)
     CHECK(!test2->hasRun_);
 }
 
+TEST(TestRegistry, testFiltersRunExactTests)
+{
+    test1->setTestName("testname");
+    test2->setTestName("othername");
+    TestFilter testFilter("group2.othername");
+    testFilter.strictMatching();
+    test3->setTestName("othername");
+    myRegistry->setTestFilters(&testFilter);
+    addAndRunAllTests();
+    CHECK(!test1->hasRun_);
+    CHECK(!test2->hasRun_);
+    CHECK(test3->hasRun_);
+}
+
+TEST(TestRegistry, excludeFilterWinsOverIncludeFilter)
+{
+    test1->setGroupName("groupname");
+    test2->setGroupName("groupname_slow");
+    TestFilter groupFilter("groupname");
+    TestFilter excludeFilter("slow");
+    excludeFilter.invertMatching();
+    groupFilter.add(&excludeFilter);
+    myRegistry->setGroupFilters(&groupFilter);
+    addAndRunAllTests();
+    CHECK(test1->hasRun_);
+    CHECK(!test2->hasRun_);
+}
+
 TEST(TestRegistry, runTestInSeperateProcess)
 {
     myRegistry->setRunTestsInSeperateProcess();
@@ -361,6 +446,40 @@ TEST(TestRegistry, listTestGroupAndCaseNames_shouldListBackwardsGroupATestaAfter
     STRCMP_EQUAL("GROUP_A.test_aa GROUP_B.test_b GROUP_A.test_a", s.asCharString());
 }
 
+TEST(TestRegistry, listTestGroupAndCaseNames_listsEachGroupDotNameOnce)
+{
+    test1->setTestName("test_a");
+    test2->setTestName("test_a");
+    test3->setTestName("test_a");
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    myRegistry->addTest(test3);
+
+    myRegistry->listTestGroupAndCaseNames(*result);
+    STRCMP_EQUAL("group2.test_a Group.test_a", output->getOutput().asCharString());
+}
+
+TEST(TestRegistry, listTestGroupAndCaseNames_onlyListsTestsThatPassTheFilters)
+{
+    test1->setTestName("test_a");
+    test2->setTestName("test_b");
+    test3->setTestName("test_a");
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    myRegistry->addTest(test3);
+    TestFilter nameFilter("test_a");
+    myRegistry->setNameFilters(&nameFilter);
+
+    myRegistry->listTestGroupAndCaseNames(*result);
+    STRCMP_EQUAL("group2.test_a Group.test_a", output->getOutput().asCharString());
+}
+
+TEST(TestRegistry, listTestGroupNamesOfEmptyRegistry)
+{
+    myRegistry->listTestGroupNames(*result);
+    STRCMP_EQUAL("", output->getOutput().asCharString());
+}
+
 TEST(TestRegistry, shuffleEmptyListIsNoOp)
 {
     CHECK_TRUE(myRegistry->getFirstTest() == NULLPTR);
@@ -425,3 +544,27 @@ TEST(TestRegistry, reverseZeroTests)
 
     CHECK(NULLPTR == myRegistry->getFirstTest());
 }
+
+TEST(TestRegistry, testsHaveNoTimeoutByDefault)
+{
+    addAndRunAllTests();
+    LONGS_EQUAL(0, test1->getTimeout());
+}
+
+TEST(TestRegistry, testTimeoutAppliesToAllTests)
+{
+    myRegistry->setTestTimeout(250);
+    addAndRunAllTests();
+    LONGS_EQUAL(250, test1->getTimeout());
+    LONGS_EQUAL(250, test3->getTimeout());
+}
+
+TEST(TestRegistry, timeoutOfATestOverridesTheTestTimeout)
+{
+    TestTimeout timeout("group2", "Name", 5000);
+    TestTimeoutInstaller installer(timeout);
+    myRegistry->setTestTimeout(250);
+    addAndRunAllTests();
+    LONGS_EQUAL(250, test1->getTimeout());
+    LONGS_EQUAL(5000, test3->getTimeout());
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestResultChannel.h"
+#include "CppUTest/TestOutput.h"
+
+TEST_GROUP(TestResultChannel)
+{
+    char memory[512];
+    TestResultChannel* channel;
+    StringBufferTestOutput* output;
+    TestResult* result;
+    UtestShell* shell;
+
+    void setup() _override
+    {
+        channel = new TestResultChannel(memory, sizeof(memory));
+        channel->clear();
+        output = new StringBufferTestOutput;
+        result = new TestResult(*output);
+        shell = new UtestShell("group", "test", "file.cpp", 10);
+    }
+
+    void teardown() _override
+    {
+        delete shell;
+        delete result;
+        delete output;
+        delete channel;
+    }
+};
+
+TEST(TestResultChannel, emptyChannelReplaysNothing)
+{
+    channel->replayInto(shell, *result);
+
+    LONGS_EQUAL(0, result->getCheckCount());
+    LONGS_EQUAL(0, result->getFailureCount());
+    STRCMP_EQUAL("", output->getOutput().asCharString());
+}
+
+TEST(TestResultChannel, checksAreCountedAndReplayed)
+{
+    channel->countCheck();
+    channel->countCheck();
+    channel->countCheck();
+
+    channel->replayInto(shell, *result);
+
+    LONGS_EQUAL(3, channel->getCheckCount());
+    LONGS_EQUAL(3, result->getCheckCount());
+}
+
+TEST(TestResultChannel, failureIsReplayedWithItsLocationAndMessage)
+{
+    channel->addFailure(TestFailure(shell, "other.cpp", 42, "the message"));
+
+    channel->replayInto(shell, *result);
+
+    LONGS_EQUAL(1, result->getFailureCount());
+    STRCMP_CONTAINS("other.cpp:42", output->getOutput().asCharString());
+    STRCMP_CONTAINS("the message", output->getOutput().asCharString());
+}
+
+TEST(TestResultChannel, printedTextIsReplayedInOrder)
+{
+    channel->print("first ");
+    channel->addFailure(TestFailure(shell, "file.cpp", 11, "failure"));
+    channel->print("second");
+
+    channel->replayInto(shell, *result);
+
+    const char* text = output->getOutput().asCharString();
+    CHECK(SimpleString::StrStr(text, "first ") < SimpleString::StrStr(text, "failure"));
+    CHECK(SimpleString::StrStr(text, "failure") < SimpleString::StrStr(text, "second"));
+}
+
+TEST(TestResultChannel, countersAreReplayedIntoTheCurrentTest)
+{
+    TestResultChannelWriter writer(*result, *channel);
+    writer.addCurrentTestCounter("instructions", 123456);
+    writer.addCurrentTestCounter("cycles", 789);
+    LONGS_EQUAL(0, result->getCurrentTestCounters().count_);
+
+    channel->replayInto(shell, *result);
+
+    const TestCounters& counters = result->getCurrentTestCounters();
+    LONGS_EQUAL(2, counters.count_);
+    STRCMP_EQUAL("instructions", counters.names_[0]);
+    LONGS_EQUAL(123456, counters.values_[0]);
+    STRCMP_EQUAL("cycles", counters.names_[1]);
+    LONGS_EQUAL(789, counters.values_[1]);
+}
+
+TEST(TestResultChannel, clearForgetsEverything)
+{
+    channel->countCheck();
+    channel->print("text");
+    channel->addFailure(TestFailure(shell, "failure"));
+
+    channel->clear();
+    channel->replayInto(shell, *result);
+
+    LONGS_EQUAL(0, result->getCheckCount());
+    LONGS_EQUAL(0, result->getFailureCount());
+    STRCMP_EQUAL("", output->getOutput().asCharString());
+}
+
+TEST(TestResultChannel, outputThatDoesNotFitIsDroppedAndReported)
+{
+    SimpleString longText("x", 400);
+    channel->print(longText.asCharString());
+    channel->print(longText.asCharString());
+
+    channel->replayInto(shell, *result);
+
+    LONGS_EQUAL(1, channel->getDroppedCount());
+    STRCMP_CONTAINS("1 output event(s) of the separate process did not fit in the result channel", output->getOutput().asCharString());
+    LONGS_EQUAL(0, result->getFailureCount());
+}
+
+TEST(TestResultChannel, failureThatDoesNotFitIsStillCounted)
+{
+    SimpleString longText("x", 400);
+    channel->print(longText.asCharString());
+    channel->addFailure(TestFailure(shell, "file.cpp", 11, longText));
+
+    channel->replayInto(shell, *result);
+
+    LONGS_EQUAL(1, result->getFailureCount());
+    STRCMP_CONTAINS("1 failure(s) did not fit in the result channel", output->getOutput().asCharString());
+}
+
+TEST(TestResultChannel, memoryTooSmallForTheHeaderIsIgnored)
+{
+    TestResultChannel tooSmall(memory, 1);
+    tooSmall.clear();
+    tooSmall.countCheck();
+    tooSmall.print("text");
+    tooSmall.addFailure(TestFailure(shell, "failure"));
+
+    tooSmall.replayInto(shell, *result);
+
+    LONGS_EQUAL(0, tooSmall.getCheckCount());
+    LONGS_EQUAL(0, tooSmall.getFailureCount());
+    LONGS_EQUAL(0, tooSmall.getDroppedCount());
+    LONGS_EQUAL(0, result->getFailureCount());
+}
+
+TEST(TestResultChannel, writerSendsEverythingToTheChannelInsteadOfTheOutput)
+{
+    TestResultChannelWriter writer(*result, *channel);
+
+    writer.countCheck();
+    writer.print("printed");
+    writer.printVeryVerbose("very verbose");
+    writer.addFailure(TestFailure(shell, "failure"));
+
+    STRCMP_EQUAL("", output->getOutput().asCharString());
+    LONGS_EQUAL(1, channel->getCheckCount());
+    LONGS_EQUAL(1, channel->getFailureCount());
+
+    output->verbose(TestOutput::level_veryVerbose);
+    channel->replayInto(shell, *result);
+
+    STRCMP_CONTAINS("printed", output->getOutput().asCharString());
+    STRCMP_CONTAINS("very verbose", output->getOutput().asCharString());
+    LONGS_EQUAL(1, result->getCheckCount());
+    LONGS_EQUAL(1, result->getFailureCount());
+}
@@ -38,6 +38,15 @@ extern "C" {
 
 }
 
+static TestResourceUsage* resourceUsage;
+
+static int MockGetResourceUsage(TestResourceUsage* usage)
+{
+    if (resourceUsage == NULLPTR) return 0;
+    *usage = *resourceUsage;
+    return 1;
+}
+
 TEST_GROUP(TestResult)
 {
     TestOutput* printer;
@@ -51,6 +60,8 @@ TEST_GROUP(TestResult)
         printer = mock;
         res = new TestResult(*printer);
         UT_PTR_SET(GetPlatformSpecificTimeInMillis, MockGetPlatformSpecificTimeInMillis);
+        UT_PTR_SET(PlatformSpecificGetResourceUsage, MockGetResourceUsage);
+        resourceUsage = NULLPTR;
     }
     void teardown()
     {
@@ -97,3 +108,94 @@ TEST(TestResult, ResultIsNotOkIfNoTestsRunOrIgnored)
     res->countTest();
     CHECK_TRUE(res->isFailure());
 }
+
+TEST(TestResult, ResourceUsageIsNotMeasuredWhenThePlatformCannotTell)
+{
+    UtestShell test("group", "test", "file", 1);
+    res->currentTestStarted(&test);
+    res->currentTestEnded(&test);
+    CHECK_FALSE(res->getCurrentTestResourceUsage().measured_);
+}
+
+TEST(TestResult, ResourceUsageIsTheGrowthDuringTheTest)
+{
+    UtestShell test("group", "test", "file", 1);
+    TestResourceUsage usage;
+    usage.userTimeInMicroseconds_ = 100;
+    usage.peakResidentSetInKilobytes_ = 1000;
+    usage.majorPageFaults_ = 1;
+    usage.involuntaryContextSwitches_ = 7;
+    resourceUsage = &usage;
+    res->currentTestStarted(&test);
+    usage.userTimeInMicroseconds_ = 150;
+    usage.systemTimeInMicroseconds_ = 20;
+    usage.peakResidentSetInKilobytes_ = 1064;
+    usage.majorPageFaults_ = 3;
+    usage.involuntaryContextSwitches_ = 8;
+    res->currentTestEnded(&test);
+
+    const TestResourceUsage& measured = res->getCurrentTestResourceUsage();
+    CHECK(measured.measured_);
+    LONGS_EQUAL(50, measured.userTimeInMicroseconds_);
+    LONGS_EQUAL(20, measured.systemTimeInMicroseconds_);
+    LONGS_EQUAL(64, measured.peakResidentSetInKilobytes_);
+    LONGS_EQUAL(2, measured.majorPageFaults_);
+    LONGS_EQUAL(1, measured.involuntaryContextSwitches_);
+}
+
+TEST(TestResult, ResourceUsageIncludesTheSeparateProcess)
+{
+    UtestShell test("group", "test", "file", 1);
+    TestResourceUsage usage;
+    usage.peakResidentSetInKilobytes_ = 1000;
+    resourceUsage = &usage;
+    res->currentTestStarted(&test);
+
+    TestResourceUsage child;
+    child.userTimeInMicroseconds_ = 300;
+    child.peakResidentSetInKilobytes_ = 1500;
+    child.minorPageFaults_ = 40;
+    child.voluntaryContextSwitches_ = 2;
+    res->addSeparateProcessResourceUsage(child);
+    res->currentTestEnded(&test);
+
+    const TestResourceUsage& measured = res->getCurrentTestResourceUsage();
+    LONGS_EQUAL(300, measured.userTimeInMicroseconds_);
+    LONGS_EQUAL(500, measured.peakResidentSetInKilobytes_);
+    LONGS_EQUAL(40, measured.minorPageFaults_);
+    LONGS_EQUAL(2, measured.voluntaryContextSwitches_);
+}
+
+TEST(TestResult, SeparateProcessResourceUsageIsForgottenWhenTheNextTestStarts)
+{
+    UtestShell test("group", "test", "file", 1);
+    TestResourceUsage usage;
+    resourceUsage = &usage;
+    TestResourceUsage child;
+    child.userTimeInMicroseconds_ = 300;
+    res->addSeparateProcessResourceUsage(child);
+    res->currentTestStarted(&test);
+    res->currentTestEnded(&test);
+    LONGS_EQUAL(0, res->getCurrentTestResourceUsage().userTimeInMicroseconds_);
+}
+
+TEST(TestResult, CountersAreForgottenWhenTheNextTestStarts)
+{
+    UtestShell test("group", "test", "file", 1);
+    res->addCurrentTestCounter("instructions", 10);
+    LONGS_EQUAL(1, res->getCurrentTestCounters().count_);
+    res->currentTestStarted(&test);
+    LONGS_EQUAL(0, res->getCurrentTestCounters().count_);
+}
+
+TEST(TestResult, CounterNamesAreCutAndFullCounterListsIgnoreTheRest)
+{
+    TestCounters counters;
+    counters.add("a_counter_name_that_is_far_too_long", 1);
+    STRCMP_EQUAL("a_counter_name_that_is_", counters.names_[0]);
+
+    for (int i = 1; i < TestCounters::maxCounters + 2; i++)
+        counters.add("more", (unsigned long) i);
+    LONGS_EQUAL(TestCounters::maxCounters, counters.count_);
+    LONGS_EQUAL(TestCounters::maxCounters - 1, counters.values_[TestCounters::maxCounters - 1]);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/CppUTestConfig.h"
+#if CPPUTEST_HAVE_TEST_SECTION
+#define CPPUTEST_USE_TEST_SECTION 1
+#endif
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestOutput.h"
+
+static int createdTests = 0;
+
+class SectionTest : public Utest
+{
+public:
+    void testBody() _override
+    {
+    }
+};
+
+static Utest* createSectionTest()
+{
+    createdTests++;
+    return new SectionTest;
+}
+
+static const TestDescriptor firstDescriptor = { "group", "first", "file.cpp", 10, createSectionTest, false };
+static const TestDescriptor secondDescriptor = { "group", "second", "other.cpp", 20, createSectionTest, true };
+static const TestDescriptor* const descriptors[] = { &firstDescriptor, &secondDescriptor };
+
+TEST_GROUP(TestSectionRegistration)
+{
+    TestRegistry registry;
+};
+
+TEST(TestSectionRegistration, descriptorsAreInstalledLikeTestInstallerDoes)
+{
+    registry.addTests(descriptors, descriptors + 2);
+
+    LONGS_EQUAL(2, registry.countTests());
+    UtestShell* second = registry.getFirstTest();
+    UtestShell* first = second->getNext();
+    STRCMP_EQUAL("group", first->getGroup().asCharString());
+    STRCMP_EQUAL("first", first->getName().asCharString());
+    STRCMP_EQUAL("file.cpp", first->getFile().asCharString());
+    LONGS_EQUAL(10, first->getLineNumber());
+    STRCMP_EQUAL("second", second->getName().asCharString());
+    STRCMP_EQUAL("other.cpp", second->getFile().asCharString());
+}
+
+TEST(TestSectionRegistration, ignoredDescriptorsGetAnIgnoredShell)
+{
+    registry.addTests(descriptors, descriptors + 2);
+
+    CHECK_FALSE(registry.findTestWithName("second")->willRun());
+    CHECK(registry.findTestWithName("first")->willRun());
+}
+
+TEST(TestSectionRegistration, shellsCreateTheTestsOfTheirDescriptor)
+{
+    StringBufferTestOutput output;
+    TestResult result(output);
+    createdTests = 0;
+    registry.addTests(descriptors, descriptors + 1);
+    registry.runAllTests(result);
+    LONGS_EQUAL(1, createdTests);
+    LONGS_EQUAL(1, result.getRunCount());
+}
+
+TEST(TestSectionRegistration, descriptorsCanBeAddedMoreThanOnce)
+{
+    registry.addTests(descriptors, descriptors + 1);
+    registry.addTests(descriptors + 1, descriptors + 2);
+    LONGS_EQUAL(2, registry.countTests());
+}
+
+TEST(TestSectionRegistration, emptySectionAddsNothing)
+{
+    registry.addTests(descriptors, descriptors);
+    LONGS_EQUAL(0, registry.countTests());
+}
+
+#if CPPUTEST_HAVE_TEST_SECTION
+
+TEST(TestSectionRegistration, testInTheSectionIsRegisteredInTheDefaultRegistry)
+{
+    UtestShell* shell = TestRegistry::getCurrentRegistry()->findTestWithGroupAndName("TestSectionRegistration", "testInTheSectionIsRegisteredInTheDefaultRegistry");
+    POINTERS_EQUAL(UtestShell::getCurrent(), shell);
+    STRCMP_CONTAINS("TestSectionRegistrationTest.cpp", shell->getFile().asCharString());
+}
+
+IGNORE_TEST(TestSectionRegistration, ignoredTestInTheSection)
+{
+    FAIL("ignored tests don't run");
+}
+
+TEST(TestSectionRegistration, ignoredTestInTheSectionIsRegisteredAsIgnored)
+{
+    UtestShell* shell = TestRegistry::getCurrentRegistry()->findTestWithGroupAndName("TestSectionRegistration", "ignoredTestInTheSection");
+    CHECK(shell != NULLPTR);
+    CHECK_FALSE(shell->willRun());
+}
+
+#endif
@@ -99,6 +99,8 @@ extern "C" {
 
 #include <unistd.h>
 #include <signal.h>
+#include <sys/wait.h>
+#include <time.h>
 
 static void _stoppedTestFunction()
 {
@@ -117,8 +119,38 @@ TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, FailureInSepa
     fixture.setRunTestsInSeperateProcess();
     fixture.setTestFunction(_failFunction);
     fixture.runAllTests();
-    fixture.assertPrintContains("Failed in separate process");
-    fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran, 0 checks, 0 ignored, 0 filtered out");
+    fixture.assertPrintContains("This test fails");
+    fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran, 1 checks, 0 ignored, 0 filtered out");
+}
+
+static void _checkingFunction()
+{
+    CHECK(true);
+    CHECK(true);
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, ChecksInSeparateProcessAreCounted)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(_checkingFunction);
+    fixture.runAllTests();
+    fixture.assertPrintContains("OK (1 tests, 1 ran, 2 checks, 0 ignored, 0 filtered out");
+}
+
+static void _printThenKilledFunction()
+{
+    UT_PRINT("printed before being killed");
+    kill(getpid(), SIGKILL);
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, OutputOfKilledSeparateProcessIsKept)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(_printThenKilledFunction);
+    fixture.runAllTests();
+    fixture.assertPrintContains("printed before being killed");
+    fixture.assertPrintContains("Failed in separate process - killed by signal 9");
+    fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran");
 }
 
 #if (! CPPUTEST_SANITIZE_ADDRESS)
@@ -148,6 +180,33 @@ TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, StoppedInSepa
     fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran");
 }
 
+#ifdef CPPUTEST_HAVE_GETRUSAGE
+
+/* Spins on user time; polling clock() alone mostly adds up system time */
+static volatile unsigned long spentCpuWork;
+
+static void _spendCpuTimeFunction()
+{
+    TestResourceUsage usage;
+    do {
+        for (unsigned long i = 0; i < 100000; i++)
+            spentCpuWork = spentCpuWork + i;
+        PlatformSpecificGetResourceUsage(&usage);
+    } while (usage.userTimeInMicroseconds_ < 50000);
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, ResourceUsageOfSeparateProcessIsReported)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setOutputVerbose();
+    fixture.setTestFunction(_spendCpuTimeFunction);
+    fixture.runAllTests();
+    fixture.assertPrintContains(" ms (user ");
+    fixture.assertPrintContainsNot("(user 0.");
+}
+
+#endif
+
 TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, CallToForkFailedInSeparateProcessWorks)
 {
     UT_PTR_SET(PlatformSpecificFork, fork_failed_stub);
@@ -193,6 +252,30 @@ TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, CallToWaitPid
     fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran");
 }
 
+static void _hangingFunction()
+{
+    for (;;) pause();
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, HungSeparateProcessIsKilledAfterTheTimeout)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.getRegistry()->setTestTimeout(20);
+    fixture.setTestFunction(_hangingFunction);
+    fixture.runAllTests();
+    fixture.assertPrintContains("Failed in separate process - timed out after 20 ms");
+    fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran");
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, SeparateProcessWithinTheTimeoutPasses)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.getRegistry()->setTestTimeout(10000);
+    fixture.setTestFunction(_checkingFunction);
+    fixture.runAllTests();
+    fixture.assertPrintContains("OK (1 tests, 1 ran, 2 checks, 0 ignored, 0 filtered out");
+}
+
 TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, MultipleTestsInSeparateProcessAreCountedProperly)
 {
     fixture.setRunTestsInSeperateProcess();
@@ -206,6 +289,58 @@ TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, MultipleTests
     fixture.assertPrintContains("Errors (2 failures, 5 tests, 5 ran, 0 checks, 0 ignored, 0 filtered out");
 }
 
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+
+TEST_GROUP(UTestPlatformsTest_PlatformSpecificWatchdog)
+{
+};
+
+static void _hungTestInChild(int errorOutput)
+{
+    dup2(errorOutput, 2);
+    PlatformSpecificStartWatchdog(UtestShell::getCurrent(), 20);
+    _hangingFunction();
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificWatchdog, HungTestIsReportedAndAborted)
+{
+    int errorPipe[2];
+    CHECK(pipe(errorPipe) == 0);
+    pid_t child = fork();
+    if (child == 0) {
+        close(errorPipe[0]);                                // LCOV_EXCL_LINE
+        _hungTestInChild(errorPipe[1]);                     // LCOV_EXCL_LINE
+    }
+    close(errorPipe[1]);
+
+    char report[4096];
+    size_t length = 0;
+    ssize_t amount;
+    while ((amount = read(errorPipe[0], report + length, sizeof(report) - 1 - length)) > 0)
+        length += (size_t) amount;
+    report[length] = '\0';
+    close(errorPipe[0]);
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    CHECK(WIFSIGNALED(status));
+    LONGS_EQUAL(SIGABRT, WTERMSIG(status));
+    STRCMP_CONTAINS("TEST(UTestPlatformsTest_PlatformSpecificWatchdog, HungTestIsReportedAndAborted) timed out after 20 ms", report);
+#ifdef __GLIBC__
+    STRCMP_CONTAINS("Stack of the test thread:", report);
+#endif
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificWatchdog, StoppedWatchdogLetsTheTestFinish)
+{
+    PlatformSpecificStartWatchdog(UtestShell::getCurrent(), 10);
+    PlatformSpecificStopWatchdog();
+    struct timespec wait = { 0, 30 * 1000000 };
+    nanosleep(&wait, NULLPTR);
+}
+
+#endif
+
 #endif
 #endif
 
@@ -243,6 +243,79 @@ TEST(UtestShell, RunInSeparateProcessTest)
     fixture.assertPrintContains("Failed in separate process");
 }
 
+static size_t watchdogStartedWithTimeout = 0;
+static UtestShell* watchdogStartedForTest = NULLPTR;
+static bool watchdogRunning = false;
+static bool watchdogWasRunningDuringTest = false;
+
+static void StubPlatformSpecificStartWatchdog(UtestShell* shell, size_t timeoutInMillis)
+{
+    watchdogStartedForTest = shell;
+    watchdogStartedWithTimeout = timeoutInMillis;
+    watchdogRunning = true;
+}
+
+static void StubPlatformSpecificStopWatchdog()
+{
+    watchdogRunning = false;
+}
+
+static void _checkWatchdogFunction()
+{
+    watchdogWasRunningDuringTest = watchdogRunning;
+}
+
+static void _failWhileWatchedFunction()
+{
+    FAIL("fails while watched");
+}
+
+TEST(UtestShell, WatchdogIsNotStartedWithoutTimeout)
+{
+    UT_PTR_SET(PlatformSpecificStartWatchdog, StubPlatformSpecificStartWatchdog);
+    UT_PTR_SET(PlatformSpecificStopWatchdog, StubPlatformSpecificStopWatchdog);
+    watchdogStartedForTest = NULLPTR;
+    fixture.setTestFunction(_checkWatchdogFunction);
+    fixture.runAllTests();
+    POINTERS_EQUAL(NULLPTR, watchdogStartedForTest);
+    CHECK_FALSE(watchdogWasRunningDuringTest);
+}
+
+TEST(UtestShell, WatchdogWatchesTheTestWhileItRuns)
+{
+    UT_PTR_SET(PlatformSpecificStartWatchdog, StubPlatformSpecificStartWatchdog);
+    UT_PTR_SET(PlatformSpecificStopWatchdog, StubPlatformSpecificStopWatchdog);
+    fixture.getRegistry()->setTestTimeout(100);
+    fixture.setTestFunction(_checkWatchdogFunction);
+    fixture.runAllTests();
+    CHECK(watchdogStartedForTest != NULLPTR);
+    LONGS_EQUAL(100, watchdogStartedWithTimeout);
+    CHECK(watchdogWasRunningDuringTest);
+    CHECK_FALSE(watchdogRunning);
+}
+
+TEST(UtestShell, WatchdogIsStoppedWhenTheTestFails)
+{
+    UT_PTR_SET(PlatformSpecificStartWatchdog, StubPlatformSpecificStartWatchdog);
+    UT_PTR_SET(PlatformSpecificStopWatchdog, StubPlatformSpecificStopWatchdog);
+    fixture.getRegistry()->setTestTimeout(100);
+    fixture.setTestFunction(_failWhileWatchedFunction);
+    fixture.runAllTests();
+    fixture.assertPrintContains("fails while watched");
+    CHECK_FALSE(watchdogRunning);
+}
+
+TEST(UtestShell, WatchdogIsLeftToTheSeparateProcess)
+{
+    UT_PTR_SET(PlatformSpecificRunTestInASeperateProcess, StubPlatformSpecificRunTestInASeperateProcess);
+    UT_PTR_SET(PlatformSpecificStartWatchdog, StubPlatformSpecificStartWatchdog);
+    watchdogStartedForTest = NULLPTR;
+    fixture.getRegistry()->setTestTimeout(100);
+    fixture.getRegistry()->setRunTestsInSeperateProcess();
+    fixture.runAllTests();
+    POINTERS_EQUAL(NULLPTR, watchdogStartedForTest);
+}
+
 #ifndef CPPUTEST_HAVE_FORK
 
 IGNORE_TEST(UtestShell, TestDefaultCrashMethodInSeparateProcessTest) {}
@@ -403,6 +476,17 @@ TEST(UtestMyOwn, NullParameters)
     CHECK(nullTest.shouldRun(&emptyFilter, &emptyFilter));
 }
 
+TEST(UtestMyOwn, ExcludeFiltersWinOverIncludeFilters)
+{
+    UtestShell test("group", "name", "file", 1);
+    TestFilter includeGroup("group");
+    TestFilter excludeGroup("roup");
+    excludeGroup.invertMatching();
+    CHECK(test.shouldRun(&includeGroup, NULLPTR));
+    includeGroup.add(&excludeGroup);
+    CHECK_FALSE(test.shouldRun(&includeGroup, NULLPTR));
+}
+
 class AllocateAndDeallocateInConstructorAndDestructor
 {
     char* memory_;
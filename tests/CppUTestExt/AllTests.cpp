@@ -30,6 +30,7 @@
 #include "CppUTest/SimpleStringInternalCache.h"
 #include "CppUTestExt/MemoryReporterPlugin.h"
 #include "CppUTestExt/MockSupportPlugin.h"
+#include "CppUTestExt/PerfCountersPlugin.h"
 
 #ifdef CPPUTEST_INCLUDE_GTEST_TESTS
 #include "CppUTestExt/GTestConvertor.h"
@@ -48,8 +49,10 @@ int main(int ac, const char *const *av)
 
         MemoryReporterPlugin plugin;
         MockSupportPlugin mockPlugin;
+        PerfCountersPlugin perfCountersPlugin;
         TestRegistry::getCurrentRegistry()->installPlugin(&plugin);
         TestRegistry::getCurrentRegistry()->installPlugin(&mockPlugin);
+        TestRegistry::getCurrentRegistry()->installPlugin(&perfCountersPlugin);
 
 #ifndef GMOCK_RENAME_MAIN
         result = CommandLineTestRunner::RunAllTests(ac, av);
@@ -61,6 +61,54 @@ TEST_GROUP(MockExpectedCallsList)
     }
 };
 
+TEST(MockExpectedCallsList, removeExpectedCallKeepsTheOthersInOrder)
+{
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+    list->addExpectedCall(call3);
+    list->removeExpectedCall(call2);
+    list->addExpectedCall(call4);
+
+    LONGS_EQUAL(3, list->size());
+    POINTERS_EQUAL(call1, list->removeFirstMatchingExpectation());
+    POINTERS_EQUAL(call3, list->removeFirstMatchingExpectation());
+    POINTERS_EQUAL(call4, list->removeFirstMatchingExpectation());
+}
+
+TEST(MockExpectedCallsList, onlyKeepPotentiallyMatchingExpectationsDropsExhaustedExpectations)
+{
+    call1->callWasMade(1);
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+    list->onlyKeepPotentiallyMatchingExpectations();
+
+    LONGS_EQUAL(1, list->size());
+    POINTERS_EQUAL(call2, list->removeFirstMatchingExpectation());
+}
+
+TEST(MockExpectedCallsList, firstPotentiallyMatchingExpectationDropsExhaustedExpectationsAtTheFront)
+{
+    call1->callWasMade(1);
+    call3->callWasMade(2);
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+    list->addExpectedCall(call3);
+
+    POINTERS_EQUAL(call2, list->firstPotentiallyMatchingExpectation());
+    LONGS_EQUAL(2, list->size());
+}
+
+TEST(MockExpectedCallsList, firstPotentiallyMatchingExpectationOfExhaustedList)
+{
+    call1->callWasMade(1);
+    list->addExpectedCall(call1);
+
+    POINTERS_EQUAL(NULLPTR, list->firstPotentiallyMatchingExpectation());
+    CHECK(list->isEmpty());
+    list->addExpectedCall(call2);
+    LONGS_EQUAL(1, list->size());
+}
+
 TEST(MockExpectedCallsList, emptyList)
 {
     CHECK(! list->hasUnfulfilledExpectations());
@@ -137,6 +185,35 @@ TEST(MockExpectedCallsList, onlyKeepExpectationsRelatedTo)
     LONGS_EQUAL(1, list->size());
 }
 
+TEST(MockExpectedCallsList, onlyKeepExpectationsRelatedToInternedNameComparesHandles)
+{
+    const char* relate = "relate";
+    const char* unrelate = "unrelate";
+    call1->withName("relate");
+    call1->setInternedName(relate);
+    call2->withName("unrelate");
+    call2->setInternedName(unrelate);
+    call3->withName("relate");
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+    list->addExpectedCall(call3);
+    list->onlyKeepExpectationsRelatedTo("relate", relate);
+    LONGS_EQUAL(2, list->size());
+    CHECK(list->hasExpectationWithName("relate", relate));
+    CHECK(!list->hasExpectationWithName("unrelate", unrelate));
+}
+
+TEST(MockExpectedCallsList, renamingAnExpectationDropsItsInternedName)
+{
+    const char* relate = "relate";
+    call1->withName("relate");
+    call1->setInternedName(relate);
+    call1->withName("other");
+    list->addExpectedCall(call1);
+    CHECK(!list->hasExpectationWithName("relate", relate));
+    CHECK(list->hasExpectationWithName("other", NULLPTR));
+}
+
 TEST(MockExpectedCallsList, removeAllExpectationsExceptThisThatRelateToTheWoleList)
 {
     call1->withName("relate");
@@ -334,3 +411,73 @@ TEST(MockExpectedCallsList, hasFinalizedMatchingExpectations_listHasFinalizedCal
 
     CHECK(list->hasFinalizedMatchingExpectations());
 }
+
+TEST_GROUP(MockExpectedCallsIndex)
+{
+    MockExpectedCallsIndex index;
+    MockCheckedExpectedCall call1;
+    MockCheckedExpectedCall call2;
+    MockCheckedExpectedCall call3;
+};
+
+TEST(MockExpectedCallsIndex, unknownNameHasNoExpectations)
+{
+    POINTERS_EQUAL(NULLPTR, index.findName("foo"));
+    CHECK(! index.hasExpectationWithName(index.findName("foo")));
+    CHECK(index.potentiallyMatchingExpectationsFor(index.findName("foo")).isEmpty());
+}
+
+TEST(MockExpectedCallsIndex, expectationsAreFoundByTheirName)
+{
+    index.addExpectedCall("foo", &call1);
+    index.addExpectedCall("bar", &call2);
+    index.addExpectedCall("foo", &call3);
+
+    const char* foo = index.findName("foo");
+    POINTERS_EQUAL(foo, call1.getInternedName());
+    CHECK(index.hasExpectationWithName(foo));
+    LONGS_EQUAL(2, index.potentiallyMatchingExpectationsFor(foo).size());
+    LONGS_EQUAL(1, index.potentiallyMatchingExpectationsFor(index.findName("bar")).size());
+}
+
+TEST(MockExpectedCallsIndex, fulfilledExpectationsAreNoLongerCandidatesButStillCount)
+{
+    index.addExpectedCall("foo", &call1);
+    call1.callWasMade(1);
+
+    const char* foo = index.findName("foo");
+    CHECK(index.hasExpectationWithName(foo));
+    CHECK(index.potentiallyMatchingExpectationsFor(foo).isEmpty());
+}
+
+TEST(MockExpectedCallsIndex, firstPotentiallyMatchingExpectationForAName)
+{
+    index.addExpectedCall("foo", &call1);
+    index.addExpectedCall("foo", &call2);
+    call1.callWasMade(1);
+
+    const char* foo = index.findName("foo");
+    POINTERS_EQUAL(&call2, index.firstPotentiallyMatchingExpectationFor(foo));
+    LONGS_EQUAL(1, index.expectationsFor(foo).size());
+    POINTERS_EQUAL(NULLPTR, index.firstPotentiallyMatchingExpectationFor(index.findName("bar")));
+    CHECK(index.expectationsFor(index.findName("bar")).isEmpty());
+}
+
+TEST(MockExpectedCallsIndex, renamingAnExpectationMovesItToTheNewName)
+{
+    call1.withName("foo");
+    index.addExpectedCall("foo", &call1);
+    call1.withName("bar");
+
+    CHECK(! index.hasExpectationWithName(index.findName("foo")));
+    CHECK(index.hasExpectationWithName(index.findName("bar")));
+    POINTERS_EQUAL(index.findName("bar"), call1.getInternedName());
+}
+
+TEST(MockExpectedCallsIndex, clearForgetsAllNames)
+{
+    index.addExpectedCall("foo", &call1);
+    index.clear();
+
+    POINTERS_EQUAL(NULLPTR, index.findName("foo"));
+}
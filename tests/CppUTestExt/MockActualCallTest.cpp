@@ -270,3 +270,104 @@ TEST(MockCheckedActualCall, MockActualCallTraceClear)
     actual.clear();
     STRCMP_EQUAL("", actual.getTraceOutput());
 }
+
+TEST(MockCheckedActualCall, MockActualCallTraceKeepsItsOwnCopyOfStringParameters)
+{
+    char value[] = "before";
+    MockActualCallTrace actual;
+    actual.withName("func").withStringParameter("string", value);
+    value[0] = 'B';
+
+    STRCMP_EQUAL("\nFunction name:func string:before", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceIsRenderedAgainAfterNewEvents)
+{
+    MockActualCallTrace actual;
+    actual.withName("foo");
+    STRCMP_EQUAL("\nFunction name:foo", actual.getTraceOutput());
+
+    actual.withName("bar").withIntParameter("int", 2);
+    STRCMP_EQUAL("\nFunction name:foo\nFunction name:bar int:2 (0x2)", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceGrowsWithoutRingBuffer)
+{
+    MockActualCallTrace actual;
+    for (int i = 0; i < 1000; i++)
+        actual.withName("func").withIntParameter("i", i);
+
+    LONGS_EQUAL(2000, actual.getEventCount());
+    LONGS_EQUAL(0, actual.getDroppedEventCount());
+    STRCMP_CONTAINS("i:999 (0x3e7)", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceRingBufferOverwritesOldestCalls)
+{
+    MockActualCallTrace actual;
+    actual.useRingBuffer(5);
+    actual.withName("first").withIntParameter("a", 1);
+    actual.withName("second").withIntParameter("b", 2);
+    actual.withName("third").withIntParameter("c", 3);
+
+    LONGS_EQUAL(5, actual.getEventCount());
+    LONGS_EQUAL(1, actual.getDroppedEventCount());
+    STRCMP_EQUAL("\nTrace events dropped:1"
+                 "\nFunction name:second b:2 (0x2)"
+                 "\nFunction name:third c:3 (0x3)", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceRingBufferCanDropNewestCalls)
+{
+    MockActualCallTrace actual;
+    actual.useRingBuffer(3, MockActualCallTrace::DROP_NEWEST);
+    actual.withName("first").withIntParameter("a", 1);
+    actual.withName("second").withIntParameter("b", 2);
+    actual.withName("third");
+
+    LONGS_EQUAL(3, actual.getEventCount());
+    LONGS_EQUAL(2, actual.getDroppedEventCount());
+    STRCMP_EQUAL("\nFunction name:first a:1 (0x1)"
+                 "\nFunction name:second"
+                 "\nTrace events dropped:2", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceRingBufferDoesNotKeepOverwrittenValues)
+{
+    MockActualCallTrace actual;
+    actual.useRingBuffer(4);
+    const unsigned char buffer[] = { 0xAB, 0xCD };
+    for (unsigned int i = 0; i < 1000; i++) {
+        char value[16];
+        SimpleString::StrNCpy(value, StringFrom(i).asCharString(), sizeof(value));
+        actual.withName("func").withStringParameter("s", value);
+        actual.withName("buffer").withMemoryBufferParameter("b", buffer, (i % 2) + 1);
+    }
+
+    LONGS_EQUAL(4, actual.getNameCount());
+    STRCMP_EQUAL("\nTrace events dropped:3996"
+                 "\nFunction name:func s:999"
+                 "\nFunction name:buffer b:Size = 2 | HexContents = AB CD", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceKeepsACopyOfStringValues)
+{
+    MockActualCallTrace actual;
+    char value[] = "before";
+    actual.withName("func").withStringParameter("s", value).withStringParameter("null", NULLPTR);
+    value[0] = 'X';
+
+    STRCMP_EQUAL("\nFunction name:func s:before null:", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceRingBufferIsEmptyAfterClear)
+{
+    MockActualCallTrace actual;
+    actual.useRingBuffer(2);
+    actual.withName("first").withIntParameter("a", 1).withIntParameter("b", 2);
+    actual.clear();
+    actual.withName("second");
+
+    LONGS_EQUAL(0, actual.getDroppedEventCount());
+    STRCMP_EQUAL("\nFunction name:second", actual.getTraceOutput());
+}
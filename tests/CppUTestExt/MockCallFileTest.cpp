@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/MockCallFile.h"
+#include "CppUTestExt/MockCheckedExpectedCall.h"
+#include "CppUTestExt/MockMemoryArena.h"
+#include "MockFailureReporterForTest.h"
+
+static const char* fileContent = NULLPTR;
+static size_t filePosition = 0;
+static size_t readLimit = 4096;
+static SimpleString* writtenContent = NULLPTR;
+
+static PlatformSpecificFile StubFOpen(const char* fileName, const char*)
+{
+    if (SimpleString::StrCmp(fileName, "missing") == 0) return NULLPTR;
+    filePosition = 0;
+    return (PlatformSpecificFile) &fileContent;
+}
+
+static size_t StubFRead(void* buffer, size_t size, PlatformSpecificFile)
+{
+    size_t amount = SimpleString::StrLen(fileContent) - filePosition;
+    if (amount > size) amount = size;
+    if (amount > readLimit) amount = readLimit;
+    PlatformSpecificMemCpy(buffer, fileContent + filePosition, amount);
+    filePosition += amount;
+    return amount;
+}
+
+static void StubFPuts(const char* text, PlatformSpecificFile)
+{
+    *writtenContent += text;
+}
+
+static void StubFClose(PlatformSpecificFile)
+{
+}
+
+TEST_GROUP(MockCallFile)
+{
+    SimpleString written;
+
+    void setup() _override
+    {
+        fileContent = "";
+        readLimit = 4096;
+        writtenContent = &written;
+        UT_PTR_SET(PlatformSpecificFOpen, StubFOpen);
+        UT_PTR_SET(PlatformSpecificFRead, StubFRead);
+        UT_PTR_SET(PlatformSpecificFPuts, StubFPuts);
+        UT_PTR_SET(PlatformSpecificFClose, StubFClose);
+    }
+
+    void teardown() _override
+    {
+        mock().checkExpectations();
+        CHECK_NO_MOCK_FAILURE();
+        MockFailureReporterForTest::clearReporter();
+        mock().clear();
+    }
+};
+
+TEST(MockCallFile, callsFromFileAreExpected)
+{
+    fileContent = "# a capture\n\nopen string:path=%2Fdev%2Fuart%200 return:int=3\r\nwrite int:fd=3 buffer:data=0a0B \n";
+
+    mock().expectCallsFromFile("calls");
+
+    LONGS_EQUAL(3, mock().actualCall("open").withStringParameter("path", "/dev/uart 0").returnIntValue());
+    const unsigned char data[] = { 0x0a, 0x0b };
+    mock().actualCall("write").withIntParameter("fd", 3).withMemoryBufferParameter("data", data, sizeof(data));
+}
+
+TEST(MockCallFile, callsFromFileAreExpectedInTheOrderOfTheFile)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "first\nsecond\n";
+
+    mock().expectCallsFromFile("calls");
+    mock().actualCall("second");
+
+    STRCMP_CONTAINS("Unexpected call to function: second", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+    STRCMP_CONTAINS("first", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, callsLeftInTheFileAreNotFulfilled)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "first\nsecond\n";
+
+    mock().expectCallsFromFile("calls");
+    mock().actualCall("first");
+    CHECK(mock().expectedCallsLeft());
+    mock().checkExpectations();
+
+    STRCMP_CONTAINS("Expected call WAS NOT fulfilled", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+    STRCMP_CONTAINS("second", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, wrongParameterValueFails)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "write int:fd=3\n";
+
+    mock().expectCallsFromFile("calls");
+    mock().actualCall("write").withIntParameter("fd", 4);
+
+    STRCMP_CONTAINS("Unexpected parameter value to parameter \"fd\"", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, allParameterTypes)
+{
+    fileContent = "f bool:b=true int:i=-2147483648 uint:u=0xffffffff long:l=-7 ulong:ul=8 double:d=-1.25e2 string:s=a%3Ab pointer:p=0x10 cpointer:cp=0x20 fpointer:fp=0x30\n";
+
+    mock().expectCallsFromFile("calls");
+    mock().actualCall("f")
+        .withBoolParameter("b", true)
+        .withIntParameter("i", -2147483647 - 1)
+        .withUnsignedIntParameter("u", 0xffffffff)
+        .withLongIntParameter("l", -7)
+        .withUnsignedLongIntParameter("ul", 8)
+        .withDoubleParameter("d", -125.0)
+        .withStringParameter("s", "a:b")
+        .withPointerParameter("p", (void*) 0x10)
+        .withConstPointerParameter("cp", (const void*) 0x20)
+        .withFunctionPointerParameter("fp", (void (*)()) 0x30);
+}
+
+#ifdef CPPUTEST_USE_LONG_LONG
+
+TEST(MockCallFile, longLongParameters)
+{
+    fileContent = "f llong:ll=-9223372036854775808 ullong:ull=18446744073709551615 return:llong=-1\n";
+
+    mock().expectCallsFromFile("calls");
+    LONGLONGS_EQUAL(-1, mock().actualCall("f")
+        .withLongLongIntParameter("ll", (cpputest_longlong) (((cpputest_ulonglong) 1) << 63))
+        .withUnsignedLongLongIntParameter("ull", (cpputest_ulonglong) -1)
+        .returnLongLongIntValue());
+}
+
+#endif
+
+TEST(MockCallFile, returnValues)
+{
+    fileContent = "b return:bool=1\nu return:uint=7\nl return:long=-7\nul return:ulong=7\nd return:double=0.5\ns return:string=x%20y\np return:pointer=0x10\n";
+
+    mock().expectCallsFromFile("calls");
+    CHECK(mock().actualCall("b").returnBoolValue());
+    LONGS_EQUAL(7, mock().actualCall("u").returnUnsignedIntValue());
+    LONGS_EQUAL(-7, mock().actualCall("l").returnLongIntValue());
+    LONGS_EQUAL(7, mock().actualCall("ul").returnUnsignedLongIntValue());
+    DOUBLES_EQUAL(0.5, mock().actualCall("d").returnDoubleValue(), 0.0);
+    STRCMP_EQUAL("x y", mock().actualCall("s").returnStringValue());
+    POINTERS_EQUAL((void*) 0x10, mock().actualCall("p").returnPointerValue());
+}
+
+TEST(MockCallFile, outputParametersAndIgnoredParameters)
+{
+    fileContent = "read int:fd=3 out:data=6869 out:unchanged ...\n";
+    char data[3] = "--";
+    char unchanged = 'u';
+
+    mock().expectCallsFromFile("calls");
+    mock().actualCall("read").withIntParameter("fd", 3).withIntParameter("flags", 1)
+        .withOutputParameter("data", data).withOutputParameter("unchanged", &unchanged);
+
+    STRCMP_EQUAL("hi", data);
+    BYTES_EQUAL('u', unchanged);
+}
+
+TEST(MockCallFile, parseErrorsReportTheFileAndLine)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "first\n# comment\nsecond int:x=12a\n";
+
+    mock().expectCallsFromFile("calls");
+    mock().actualCall("first");
+    mock().actualCall("second");
+
+    STRCMP_EQUAL("Mock Failure: calls:3: invalid int: 12a", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, valuesOutOfRangeAreParseErrors)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "f int:x=2147483648\n";
+
+    mock().expectCallsFromFile("calls");
+
+    STRCMP_EQUAL("Mock Failure: calls:1: invalid int: 2147483648", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, unknownTypesAreParseErrors)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "f float:x=1\n";
+
+    mock().expectCallsFromFile("calls");
+
+    STRCMP_EQUAL("Mock Failure: calls:1: unknown parameter type: float", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, missingFileFails)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+
+    mock().expectCallsFromFile("missing");
+
+    STRCMP_EQUAL("Mock Failure: missing: cannot open the file", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, onlyOneFileAtATime)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    fileContent = "first\n";
+
+    mock().expectCallsFromFile("calls");
+    mock().expectCallsFromFile("more");
+
+    STRCMP_EQUAL("Mock Failure: more: calls are already expected from calls", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockCallFile, callsAreStreamedWithoutGrowingTheExpectations)
+{
+    SimpleString content;
+    for (int i = 0; i < 500; i++)
+        content += StringFromFormat("call%d int:value=%d\n", i % 7, i);
+    fileContent = content.asCharString();
+    readLimit = 5;
+
+    mock().expectCallsFromFile("calls");
+    for (int i = 0; i < 7; i++)
+        mock().actualCall(StringFromFormat("call%d", i)).withIntParameter("value", i);
+    size_t allocations = MockMemoryArena::getAllocationCount();
+
+    for (int i = 7; i < 500; i++)
+        mock().actualCall(StringFromFormat("call%d", i % 7)).withIntParameter("value", i);
+
+    LONGS_EQUAL(allocations, MockMemoryArena::getAllocationCount());
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockCallFile, callsFromFileTakeNoPartInTheStrictOrder)
+{
+    fileContent = "fromFile\n";
+
+    mock().strictOrder();
+    mock().expectCallsFromFile("calls");
+    mock().expectOneCall("first");
+    mock().expectOneCall("second");
+
+    mock().actualCall("first");
+    mock().actualCall("fromFile");
+    mock().actualCall("second");
+}
+
+TEST(MockCallFile, callsFromFileInAScope)
+{
+    fileContent = "open\n";
+
+    mock("driver").expectCallsFromFile("calls");
+    mock("driver").actualCall("open");
+}
+
+TEST(MockCallFile, actualCallsAreRecorded)
+{
+    const unsigned char data[] = { 0x00, 0xff };
+    int output;
+
+    mock().recordActualCallsToFile("recording");
+    mock().actualCall("open").withStringParameter("path", "/dev/a b").withBoolParameter("sync", false);
+    mock().actualCall("write").withUnsignedIntParameter("size", 2).withMemoryBufferParameter("data", data, sizeof(data));
+    mock().actualCall("read").withOutputParameter("out", &output).withParameterOfType("Type", "value", NULLPTR);
+    mock().actualCall("close").withDoubleParameter("d", 0.5).withPointerParameter("p", (void*) 0x10);
+    mock().stopRecordingActualCalls();
+
+    STRCMP_EQUAL("open string:path=/dev/a%20b bool:sync=false\n"
+                 "write uint:size=2 buffer:data=00ff\n"
+                 "read out:out ...\n"
+                 "close double:d=0.5 pointer:p=0x10\n", written.asCharString());
+}
+
+TEST(MockCallFile, recordedCallsCanBeExpected)
+{
+    mock("scope").recordActualCallsToFile("recording");
+    mock("scope").actualCall("a%b").withLongIntParameter("x:y", -3).withStringParameter("s", "=\n");
+    mock("scope").stopRecordingActualCalls();
+    mock().clear();
+
+    fileContent = written.asCharString();
+    mock("scope").expectCallsFromFile("recording");
+    mock("scope").actualCall("a%b").withLongIntParameter("x:y", -3).withStringParameter("s", "=\n");
+}
+
+TEST(MockCallFile, nullStringsRoundTrip)
+{
+    mock().recordActualCallsToFile("recording");
+    mock().actualCall("f").withStringParameter("s", NULLPTR).withStringParameter("e", "");
+    mock().stopRecordingActualCalls();
+    STRCMP_EQUAL("f string:s=%null string:e=\n", written.asCharString());
+
+    fileContent = written.asCharString();
+    MockCallFileReader reader("recording");
+    MockCheckedExpectedCall call(1);
+    CHECK(reader.readNextCall());
+    CHECK(reader.applyTo(call));
+    POINTERS_EQUAL(NULLPTR, call.getInputParameter("s").getStringValue());
+    STRCMP_EQUAL("", call.getInputParameter("e").getStringValue());
+}
+
+TEST(MockCallFile, nonFiniteDoublesRoundTrip)
+{
+    double zero = 0.0;
+    mock().recordActualCallsToFile("recording");
+    mock().actualCall("f").withDoubleParameter("n", zero / zero).withDoubleParameter("i", 1.0 / zero).withDoubleParameter("m", -1.0 / zero);
+    mock().stopRecordingActualCalls();
+    STRCMP_EQUAL("f double:n=nan double:i=inf double:m=-inf\n", written.asCharString());
+
+    fileContent = written.asCharString();
+    MockCallFileReader reader("recording");
+    MockCheckedExpectedCall call(1);
+    CHECK(reader.readNextCall());
+    CHECK(reader.applyTo(call));
+    CHECK(PlatformSpecificIsNan(call.getInputParameter("n").getDoubleValue()));
+    CHECK(PlatformSpecificIsInf(call.getInputParameter("i").getDoubleValue()));
+    CHECK(call.getInputParameter("i").getDoubleValue() > 0);
+    CHECK(PlatformSpecificIsInf(call.getInputParameter("m").getDoubleValue()));
+    CHECK(call.getInputParameter("m").getDoubleValue() < 0);
+}
+
+TEST(MockCallFile, escapingAndHexBytes)
+{
+    STRCMP_EQUAL("a%20b%25c%3ad%3de%23f%0a", MockCallFileWriter::escape("a b%c:d=e#f\n").asCharString());
+    STRCMP_EQUAL("", MockCallFileWriter::escape(NULLPTR).asCharString());
+    const unsigned char bytes[] = { 0x01, 0xab, 0xff };
+    STRCMP_EQUAL("01abff", MockCallFileWriter::hexBytes(bytes, sizeof(bytes)).asCharString());
+}
+
+TEST(MockCallFile, recordingToAFileThatCannotBeCreatedFails)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+
+    mock().recordActualCallsToFile("missing");
+
+    STRCMP_EQUAL("Mock Failure: missing: cannot create the file", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
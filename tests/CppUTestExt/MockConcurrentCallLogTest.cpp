@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/MockConcurrentCallLog.h"
+#include "MockFailureReporterForTest.h"
+
+static unsigned long currentThreadId = 1;
+
+static unsigned long StubGetThreadId(void)
+{
+    return currentThreadId;
+}
+
+TEST_GROUP(MockConcurrentCallLog)
+{
+    void setup() _override
+    {
+        currentThreadId = 1;
+        UT_PTR_SET(PlatformSpecificGetThreadId, StubGetThreadId);
+    }
+};
+
+TEST(MockConcurrentCallLog, emptyLog)
+{
+    MockConcurrentCallLog log;
+    LONGS_EQUAL(0, log.getCallCount());
+    LONGS_EQUAL(0, log.getThreadCount());
+    POINTERS_EQUAL(NULLPTR, log.takeCalls());
+}
+
+TEST(MockConcurrentCallLog, callsAreNumberedPerThread)
+{
+    MockConcurrentCallLog log;
+    log.record(mock(), "a");
+    currentThreadId = 2;
+    log.record(mock(), "b");
+    currentThreadId = 1;
+    log.record(mock(), "c");
+
+    LONGS_EQUAL(3, log.getCallCount());
+    LONGS_EQUAL(2, log.getThreadCount());
+
+    MockRecordedActualCall* calls = log.takeCalls();
+    LONGS_EQUAL(0, log.getCallCount());
+    STRCMP_EQUAL("a", calls->getFunctionName().asCharString());
+    LONGS_EQUAL(0, calls->getThreadIndex());
+    LONGS_EQUAL(1, calls->getThreadSequence());
+    STRCMP_EQUAL("b", calls->getNext()->getFunctionName().asCharString());
+    LONGS_EQUAL(1, calls->getNext()->getThreadIndex());
+    LONGS_EQUAL(1, calls->getNext()->getThreadSequence());
+    STRCMP_EQUAL("c", calls->getNext()->getNext()->getFunctionName().asCharString());
+    LONGS_EQUAL(0, calls->getNext()->getNext()->getThreadIndex());
+    LONGS_EQUAL(2, calls->getNext()->getNext()->getThreadSequence());
+
+    while (calls) {
+        MockRecordedActualCall* next = calls->getNext();
+        delete calls;
+        calls = next;
+    }
+}
+
+TEST(MockConcurrentCallLog, clearDeletesTheCalls)
+{
+    MockConcurrentCallLog log;
+    log.record(mock(), "a").withIntParameter("p", 1);
+    log.clear();
+    LONGS_EQUAL(0, log.getCallCount());
+    LONGS_EQUAL(0, log.getThreadCount());
+}
+
+TEST(MockConcurrentCallLog, recordedCallsReturnDefaults)
+{
+    MockConcurrentCallLog log;
+    MockActualCall& call = log.record(mock(), "a");
+    LONGS_EQUAL(5, call.returnIntValueOrDefault(5));
+    CHECK_FALSE(call.hasReturnValue());
+}
+
+TEST_GROUP(MockConcurrentRecording)
+{
+    void setup() _override
+    {
+        currentThreadId = 1;
+        UT_PTR_SET(PlatformSpecificGetThreadId, StubGetThreadId);
+        mock().concurrentRecording();
+    }
+
+    void teardown() _override
+    {
+        mock().checkExpectations();
+        CHECK_NO_MOCK_FAILURE();
+        MockFailureReporterForTest::clearReporter();
+        mock().clear();
+    }
+};
+
+TEST(MockConcurrentRecording, callsAreMatchedWhenCheckingExpectations)
+{
+    mock().expectOneCall("foo").withParameter("p", 1);
+    mock().actualCall("foo").withParameter("p", 1);
+    CHECK(mock().expectedCallsLeft());
+
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockConcurrentRecording, unexpectedCallIsReportedWhenCheckingExpectations)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockExpectedCallsListForTest expectations;
+    MockUnexpectedCallHappenedFailure expectedFailure(mockFailureTest(), "foo", expectations);
+
+    mock().actualCall("foo");
+    CHECK_NO_MOCK_FAILURE();
+
+    mock().checkExpectations();
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockConcurrentRecording, stringAndMemoryBufferParametersAreCopied)
+{
+    char text[] = "hello";
+    unsigned char buffer[] = { 1, 2, 3 };
+    const unsigned char expectedBuffer[] = { 1, 2, 3 };
+
+    mock().expectOneCall("foo").withParameter("s", "hello").withMemoryBufferParameter("b", expectedBuffer, sizeof(expectedBuffer));
+    mock().actualCall("foo").withParameter("s", text).withMemoryBufferParameter("b", buffer, sizeof(buffer));
+    text[0] = 'j';
+    buffer[0] = 9;
+
+    mock().checkExpectations();
+}
+
+TEST(MockConcurrentRecording, allParameterKindsAreReplayed)
+{
+    int object;
+    int output = 0;
+    const int outputValue = 7;
+
+    mock().expectOneCall("foo").onObject(&object)
+        .withParameter("bool", true)
+        .withParameter("int", -1)
+        .withParameter("unsigned", 1u)
+        .withParameter("long", -2l)
+        .withParameter("unsigned long", 2ul)
+        .withParameter("double", 1.5)
+        .withParameter("pointer", &object)
+        .withParameter("const pointer", (const void*) &object)
+        .withOutputParameterReturning("output", &outputValue, sizeof(outputValue));
+    mock().actualCall("foo").onObject(&object)
+        .withParameter("bool", true)
+        .withParameter("int", -1)
+        .withParameter("unsigned", 1u)
+        .withParameter("long", -2l)
+        .withParameter("unsigned long", 2ul)
+        .withParameter("double", 1.5)
+        .withParameter("pointer", &object)
+        .withParameter("const pointer", (const void*) &object)
+        .withOutputParameter("output", &output);
+    LONGS_EQUAL(0, output);
+
+    mock().checkExpectations();
+    LONGS_EQUAL(7, output);
+}
+
+TEST(MockConcurrentRecording, scopedCallsAreReplayedInTheirScope)
+{
+    mock("scope").expectOneCall("foo");
+    mock("scope").actualCall("foo");
+
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockConcurrentRecording, recordingThreadUsesAScopeOfTheTestThread)
+{
+    mock("scope").expectOneCall("foo");
+    currentThreadId = 2;
+    mock("scope").actualCall("foo");
+    currentThreadId = 1;
+
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockConcurrentRecording, recordingThreadCannotCreateAScope)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockScopeCreatedWhileRecordingFailure expectedFailure(mockFailureTest(), "unknown");
+
+    currentThreadId = 2;
+    mock("unknown").actualCall("foo");
+    currentThreadId = 1;
+    CHECK_NO_MOCK_FAILURE();
+
+    mock().checkExpectations();
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockConcurrentRecording, strictOrderUsesTheOrderOfTheLog)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+    mock().expectOneCall("foo1");
+    mock().expectOneCall("foo2");
+
+    currentThreadId = 2;
+    mock().actualCall("foo2");
+    currentThreadId = 1;
+    mock().actualCall("foo1");
+
+    mock().checkExpectations();
+    STRCMP_CONTAINS("Out of order calls", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+    CLEAR_MOCK_FAILURE();
+}
+
+TEST(MockConcurrentRecording, strictOrderPerThreadAllowsInterleavedThreads)
+{
+    mock().concurrentRecording(true, true);
+    mock().strictOrder();
+    mock().expectOneCall("a1");
+    mock().expectOneCall("a2");
+    mock().expectOneCall("b1");
+
+    currentThreadId = 2;
+    mock().actualCall("b1");
+    currentThreadId = 1;
+    mock().actualCall("a1");
+    mock().actualCall("a2");
+
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockConcurrentRecording, strictOrderPerThreadFailsWithinAThread)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().concurrentRecording(true, true);
+    mock().strictOrder();
+    mock().expectOneCall("a1");
+    mock().expectOneCall("a2");
+
+    mock().actualCall("a2");
+    mock().actualCall("a1");
+
+    mock().checkExpectations();
+    STRCMP_CONTAINS("Out of order calls", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+    CLEAR_MOCK_FAILURE();
+}
+
+TEST(MockConcurrentRecording, disablingReplaysTheCalls)
+{
+    mock().expectOneCall("foo");
+    mock().actualCall("foo");
+
+    mock().concurrentRecording(false);
+    CHECK_FALSE(mock().expectedCallsLeft());
+
+    mock().expectOneCall("bar");
+    MockCheckedActualCall& call = (MockCheckedActualCall&) mock().actualCall("bar");
+    call.checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockConcurrentRecording, clearDiscardsRecordedCalls)
+{
+    mock().actualCall("foo");
+    mock().clear();
+    mock().checkExpectations();
+}
+
+TEST(MockConcurrentRecording, functionIdIsRecorded)
+{
+    static MockFunctionId function("foo");
+    mock().expectOneCall("foo");
+    function.actualCall();
+    CHECK(mock().expectedCallsLeft());
+
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+#ifdef CPPUTEST_HAVE_PTHREAD_MUTEX_LOCK
+
+#include <pthread.h>
+
+static const int callsPerThread = 100;
+static MockFunctionId threadFunctionId("id", "scope");
+
+static void* recordCallsOfThread(void* argument)
+{
+    const int thread = *(const int*) argument;
+    for (int i = 0; i < callsPerThread; i++) {
+        mock().actualCall("work").withParameter("thread", thread).withParameter("name", "worker");
+        mock("scope").actualCall("scoped").withParameter("index", i);
+        threadFunctionId.actualCall().withParameter("thread", thread);
+    }
+    return NULLPTR;
+}
+
+TEST_GROUP(MockConcurrentRecordingThreads)
+{
+    void teardown() _override
+    {
+        mock().clear();
+    }
+};
+
+TEST(MockConcurrentRecordingThreads, callsOfSeveralThreadsAreAllMatched)
+{
+    enum { threadCount = 4 };
+    pthread_t threads[threadCount];
+    int threadNumbers[threadCount];
+
+    mock().expectNCalls(threadCount * callsPerThread, "work").ignoreOtherParameters();
+    mock("scope").expectNCalls(threadCount * callsPerThread, "scoped").ignoreOtherParameters();
+    mock("scope").expectNCalls(threadCount * callsPerThread, "id").ignoreOtherParameters();
+    mock().concurrentRecording();
+
+    for (int i = 0; i < threadCount; i++) {
+        threadNumbers[i] = i;
+        LONGS_EQUAL(0, pthread_create(&threads[i], NULLPTR, recordCallsOfThread, &threadNumbers[i]));
+    }
+    for (int i = 0; i < threadCount; i++)
+        LONGS_EQUAL(0, pthread_join(threads[i], NULLPTR));
+
+    CHECK(mock().expectedCallsLeft());
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+#endif
@@ -563,6 +563,41 @@ TEST(MockExpectedCall, toStringForNoParametersMultiCallCalledExpectedTimes)
     STRCMP_EQUAL("name -> no parameters (expected 2 calls, called 2 times)", expectedCall.callToString().asCharString());
 }
 
+TEST(MockExpectedCall, toStringForAtLeastCalls)
+{
+    MockCheckedExpectedCall expectedCall(2, MockCheckedExpectedCall::NO_MAXIMUM_CALLS);
+    expectedCall.withName("name");
+    expectedCall.callWasMade(1);
+    STRCMP_EQUAL("name -> no parameters (expected at least 2 calls, called 1 time)", expectedCall.callToString().asCharString());
+}
+
+TEST(MockExpectedCall, toStringForAtMostCalls)
+{
+    MockCheckedExpectedCall expectedCall(0, 1);
+    expectedCall.withName("name");
+    STRCMP_EQUAL("name -> no parameters (expected at most 1 call, called 0 times)", expectedCall.callToString().asCharString());
+}
+
+TEST(MockExpectedCall, toStringForARangeOfCalls)
+{
+    MockCheckedExpectedCall expectedCall(2, 4);
+    expectedCall.withName("name");
+    STRCMP_EQUAL("name -> no parameters (expected between 2 and 4 calls, called 0 times)", expectedCall.callToString().asCharString());
+}
+
+TEST(MockExpectedCall, rangeOfCallsIsFulfilledWithinTheRange)
+{
+    MockCheckedExpectedCall expectedCall(1, 2);
+    CHECK(! expectedCall.isFulfilled());
+    CHECK(expectedCall.canMatchActualCalls());
+    expectedCall.callWasMade(1);
+    CHECK(expectedCall.isFulfilled());
+    CHECK(expectedCall.canMatchActualCalls());
+    expectedCall.callWasMade(2);
+    CHECK(expectedCall.isFulfilled());
+    CHECK(! expectedCall.canMatchActualCalls());
+}
+
 TEST(MockExpectedCall, toStringForIgnoredParameters)
 {
     MockCheckedExpectedCall expectedCall(1);
@@ -711,6 +746,24 @@ TEST(MockExpectedCall, callOrderIsFulfilledMultiple)
     CHECK_FALSE(expectedCall.isOutOfOrder());
 }
 
+TEST(MockExpectedCall, isExpectedAtCallOrderWithinItsRange)
+{
+    MockCheckedExpectedCall expectedCall(3);
+    CHECK_FALSE(expectedCall.isExpectedAtCallOrder(MockCheckedExpectedCall::NO_EXPECTED_CALL_ORDER));
+    expectedCall.withCallOrder(10, 12);
+    CHECK_FALSE(expectedCall.isExpectedAtCallOrder(9));
+    CHECK(expectedCall.isExpectedAtCallOrder(10));
+    CHECK(expectedCall.isExpectedAtCallOrder(12));
+    CHECK_FALSE(expectedCall.isExpectedAtCallOrder(13));
+}
+
+TEST(MockExpectedCall, isIgnoringOtherParameters)
+{
+    CHECK_FALSE(call->isIgnoringOtherParameters());
+    call->ignoreOtherParameters();
+    CHECK(call->isIgnoringOtherParameters());
+}
+
 TEST(MockExpectedCall, hasOutputParameter)
 {
     const int value = 1;
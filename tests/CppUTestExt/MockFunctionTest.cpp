@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+#include "CppUTestExt/MockFunction.h"
+#include "MockFailureReporterForTest.h"
+
+struct MockFunctionTestPoint
+{
+    MockFunctionTestPoint(int x, int y) : x_(x), y_(y) {}
+    int x_;
+    int y_;
+};
+
+static bool operator==(const MockFunctionTestPoint& left, const MockFunctionTestPoint& right)
+{
+    return left.x_ == right.x_ && left.y_ == right.y_;
+}
+
+static SimpleString StringFrom(const MockFunctionTestPoint& point)
+{
+    return StringFromFormat("(%d,%d)", point.x_, point.y_);
+}
+
+TEST_GROUP(MockFunction)
+{
+    void teardown()
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+TEST(MockFunction, callWithoutParametersMatchesExpectation)
+{
+    MockFunction<void()> reset("reset");
+    reset.expect();
+    reset();
+}
+
+TEST(MockFunction, returnsTheValueOfTheMatchingExpectation)
+{
+    MockFunction<int(int)> square("square");
+    square.expect().with(2).andReturn(4);
+    square.expect().with(eq(3)).andReturn(9);
+
+    LONGS_EQUAL(9, square(3));
+    LONGS_EQUAL(4, square(2));
+}
+
+TEST(MockFunction, returnsADefaultValueWithoutAReturnValue)
+{
+    MockFunction<int()> read("read");
+    read.expect();
+    LONGS_EQUAL(0, read());
+}
+
+TEST(MockFunction, argumentsAreComparedInTheirOwnType)
+{
+    MockFunction<bool(const MockFunctionTestPoint&, int)> draw("draw");
+    draw.expect().with(eq(MockFunctionTestPoint(1, 2)), any()).andReturn(true);
+
+    CHECK(draw(MockFunctionTestPoint(1, 2), 42));
+}
+
+TEST(MockFunction, stringArgumentsAreComparedByContent)
+{
+    char name[] = "name";
+    MockFunction<void(const char*)> open("open");
+    open.expect().with("name");
+    open(name);
+}
+
+TEST(MockFunction, expectationsMatchInTheOrderTheyWereExpected)
+{
+    MockFunction<int(int)> read("read");
+    read.expect().with(any()).andReturn(1);
+    read.expect().with(any()).andReturn(2);
+
+    LONGS_EQUAL(1, read(0));
+    LONGS_EQUAL(2, read(0));
+}
+
+TEST(MockFunction, expectationCanBeForSeveralCalls)
+{
+    MockFunction<void(int, int, int, int)> write("write");
+    write.expect(3).with(1, any(), 3, any());
+    for (int i = 0; i < 3; i++)
+        write(1, i, 3, i);
+    CHECK(! mock().expectedCallsLeft());
+}
+
+static void expectationsAreCountedAsChecksTestFunction_()
+{
+    MockFunction<void()> reset("reset");
+    reset.expect();
+    reset.expect();
+    mock().clear();
+}
+
+TEST(MockFunction, expectationIsCountedAsACheck)
+{
+    TestTestingFixture fixture;
+    fixture.setTestFunction(expectationsAreCountedAsChecksTestFunction_);
+    fixture.runAllTests();
+    LONGS_EQUAL(2, fixture.getCheckCount());
+}
+
+TEST(MockFunction, unfulfilledExpectationsAreReportedByCheckExpectations)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockFunction<int(int, const char*)> read("read");
+    read.expect().with(1, "x");
+    read.expect().with(any(), any());
+    read(5, "y");
+
+    CHECK(mock().expectedCallsLeft());
+    mock().checkExpectations();
+
+    STRCMP_EQUAL("Mock Failure: Expected call WAS NOT fulfilled.\n"
+                 "\tEXPECTED calls that WERE NOT fulfilled:\n"
+                 "\t\tread -> <1>, <x> (expected 1 call, called 0 times)\n"
+                 "\tEXPECTED calls that WERE fulfilled:\n"
+                 "\t\tread -> <any>, <any> (expected 1 call, called 1 time)",
+                 mockFailureString().asCharString());
+}
+
+TEST(MockFunction, unexpectedCallFailsTheTest)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockFunction<int(int)> read("read");
+    read.expect().with(1);
+
+    LONGS_EQUAL(0, read(2));
+
+    STRCMP_EQUAL("Mock Failure: Unexpected call to function: read -> <2>\n"
+                 "\tEXPECTED calls that WERE NOT fulfilled:\n"
+                 "\t\tread -> <1> (expected 1 call, called 0 times)\n"
+                 "\tEXPECTED calls that WERE fulfilled:\n"
+                 "\t\t<none>",
+                 mockFailureString().asCharString());
+}
+
+TEST(MockFunction, callBeyondTheExpectedCountIsUnexpected)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockFunction<void()> reset("reset");
+    reset.expect();
+    reset();
+    reset();
+
+    STRCMP_CONTAINS("Unexpected call to function: reset -> no parameters", mockFailureString().asCharString());
+}
+
+TEST(MockFunction, scopedFunctionIsCheckedByItsScope)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockFunction<void(int)> write("write", "io");
+    write.expect().with(1);
+
+    CHECK(mock("io").expectedCallsLeft());
+    CHECK(mock().expectedCallsLeft());
+    mock().checkExpectations();
+
+    STRCMP_CONTAINS("io::write -> <1> (expected 1 call, called 0 times)", mockFailureString().asCharString());
+}
+
+TEST(MockFunction, clearRemovesTheExpectations)
+{
+    MockFunction<void(int)> write("write", "io");
+    write.expect().with(1);
+    mock().clear();
+
+    CHECK(! mock().expectedCallsLeft());
+    write.expect().with(2);
+    write(2);
+}
+
+TEST(MockFunction, destroyedFunctionIsNoLongerChecked)
+{
+    {
+        MockFunction<void()> reset("reset");
+        reset.expect();
+    }
+    CHECK(! mock().expectedCallsLeft());
+}
+
+TEST(MockFunction, typedAndNamedExpectationsCanBeMixed)
+{
+    MockFunction<void(int)> write("write");
+    write.expect().with(1);
+    mock().expectOneCall("flush");
+
+    write(1);
+    mock().actualCall("flush");
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+#include "CppUTestExt/MockMemoryArena.h"
+#include "CppUTestExt/MockCheckedExpectedCall.h"
+#include "CppUTestExt/MockExpectedCallsList.h"
+#include "CppUTest/MemoryLeakDetector.h"
+#include "CppUTest/MemoryLeakWarningPlugin.h"
+
+TEST_GROUP(MockMemoryArena)
+{
+    void teardown() _override
+    {
+        mock().clear();
+    }
+};
+
+TEST(MockMemoryArena, allocationsAreCountedUntilDeallocated)
+{
+    size_t allocationsBefore = MockMemoryArena::getAllocationCount();
+    void* first = MockMemoryArena::allocate(10);
+    void* second = MockMemoryArena::allocate(20);
+
+    LONGS_EQUAL(allocationsBefore + 2, MockMemoryArena::getAllocationCount());
+    MockMemoryArena::deallocate(first);
+    MockMemoryArena::deallocate(second);
+    LONGS_EQUAL(allocationsBefore, MockMemoryArena::getAllocationCount());
+}
+
+TEST(MockMemoryArena, allocationsAreAligned)
+{
+    void* first = MockMemoryArena::allocate(3);
+    void* second = MockMemoryArena::allocate(5);
+
+    LONGS_EQUAL(0, ((size_t) first) % (2 * sizeof(void*)));
+    LONGS_EQUAL(0, ((size_t) second) % (2 * sizeof(void*)));
+    CHECK(first != second);
+
+    MockMemoryArena::deallocate(second);
+    MockMemoryArena::deallocate(first);
+}
+
+TEST(MockMemoryArena, memoryFreedOnTopIsReused)
+{
+    void* first = MockMemoryArena::allocate(16);
+    MockMemoryArena::deallocate(first);
+    void* second = MockMemoryArena::allocate(16);
+
+    POINTERS_EQUAL(first, second);
+    MockMemoryArena::deallocate(second);
+}
+
+TEST(MockMemoryArena, memoryFreedOutOfOrderIsReusedOnceTheTopIsFreed)
+{
+    void* first = MockMemoryArena::allocate(16);
+    void* second = MockMemoryArena::allocate(16);
+    MockMemoryArena::deallocate(first);
+    MockMemoryArena::deallocate(second);
+
+    void* third = MockMemoryArena::allocate(16);
+    POINTERS_EQUAL(first, third);
+    MockMemoryArena::deallocate(third);
+}
+
+TEST(MockMemoryArena, largeAllocationsGetTheirOwnChunk)
+{
+    void* small = MockMemoryArena::allocate(16);
+    size_t chunksBefore = MockMemoryArena::getChunkCount();
+    char* large = (char*) MockMemoryArena::allocate(256 * 1024);
+    large[256 * 1024 - 1] = 'a';
+
+    LONGS_EQUAL(chunksBefore + 1, MockMemoryArena::getChunkCount());
+    MockMemoryArena::deallocate(large);
+    MockMemoryArena::deallocate(small);
+}
+
+TEST(MockMemoryArena, resetReleasesAllChunksWhenNothingIsAllocated)
+{
+    mock().clear();
+    MockMemoryArena::deallocate(MockMemoryArena::allocate(16));
+    MockMemoryArena::reset();
+
+    LONGS_EQUAL(0, MockMemoryArena::getAllocationCount());
+    LONGS_EQUAL(0, MockMemoryArena::getChunkCount());
+}
+
+TEST(MockMemoryArena, resetKeepsMemoryThatIsStillAllocated)
+{
+    mock().clear();
+    MockCheckedExpectedCall* call = new MockCheckedExpectedCall;
+    call->withName("foo");
+    MockMemoryArena::reset();
+
+    CHECK(call->relatesTo("foo"));
+    LONGS_EQUAL(1, MockMemoryArena::getAllocationCount());
+    delete call;
+    LONGS_EQUAL(0, MockMemoryArena::getChunkCount());
+}
+
+TEST(MockMemoryArena, memoryStillAllocatedAtResetDoesNotPinLaterAllocations)
+{
+    mock().clear();
+    void* survivor = MockMemoryArena::allocate(16);
+    MockMemoryArena::reset();
+
+    void* first = MockMemoryArena::allocate(16);
+    LONGS_EQUAL(2, MockMemoryArena::getChunkCount());
+    MockMemoryArena::deallocate(first);
+    void* second = MockMemoryArena::allocate(16);
+    POINTERS_EQUAL(first, second);
+
+    MockMemoryArena::deallocate(survivor);
+    LONGS_EQUAL(1, MockMemoryArena::getChunkCount());
+    MockMemoryArena::deallocate(second);
+}
+
+TEST(MockMemoryArena, clearResetsTheArenaWhileATestStillHoldsArenaObjects)
+{
+    mock().clear();
+    MockExpectedCallsList expectations;
+    expectations.addExpectedCall(new MockCheckedExpectedCall);
+    mock().expectOneCall("foo");
+    mock().clear();
+
+    LONGS_EQUAL(2, MockMemoryArena::getAllocationCount());
+    mock().expectOneCall("foo");
+    mock().clear();
+    LONGS_EQUAL(1, MockMemoryArena::getChunkCount());
+
+    expectations.deleteAllExpectationsAndClearList();
+    LONGS_EQUAL(0, MockMemoryArena::getChunkCount());
+}
+
+TEST(MockMemoryArena, expectationsAreAllocatedFromTheArena)
+{
+    mock().clear();
+    mock().expectOneCall("foo").withParameter("value", 1);
+
+    CHECK(MockMemoryArena::getAllocationCount() > 0);
+    mock().actualCall("foo").withParameter("value", 1);
+    mock().checkExpectations();
+    mock().clear();
+
+    LONGS_EQUAL(0, MockMemoryArena::getAllocationCount());
+    LONGS_EQUAL(0, MockMemoryArena::getChunkCount());
+}
+
+TEST(MockMemoryArena, arenaObjectsAreNotTrackedByTheMemoryLeakDetector)
+{
+    MemoryLeakDetector* detector = MemoryLeakWarningPlugin::getGlobalDetector();
+    size_t leaksBefore = detector->totalMemoryLeaks(mem_leak_period_checking);
+    size_t allocationsBefore = MockMemoryArena::getAllocationCount();
+
+    MockArenaObject* object = new MockArenaObject;
+    LONGS_EQUAL(leaksBefore, detector->totalMemoryLeaks(mem_leak_period_checking));
+    LONGS_EQUAL(allocationsBefore + 1, MockMemoryArena::getAllocationCount());
+    delete object;
+}
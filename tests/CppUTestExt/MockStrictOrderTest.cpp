@@ -197,3 +197,116 @@ TEST(MockStrictOrderTest, orderUsingNCalls)
 
     mock().checkExpectations();
 }
+
+TEST(MockStrictOrderTest, orderObservedWithParametersOfTheSameFunction)
+{
+    mock().strictOrder();
+
+    mock().expectOneCall("foo").withParameter("p", 1);
+    mock().expectOneCall("foo").withParameter("p", 2);
+    mock().expectNCalls(2, "foo").withParameter("p", 3);
+    mock().actualCall("foo").withParameter("p", 1);
+    mock().actualCall("foo").withParameter("p", 2);
+    mock().actualCall("foo").withParameter("p", 3);
+    mock().actualCall("foo").withParameter("p", 3);
+
+    mock().checkExpectations();
+}
+
+TEST(MockStrictOrderTest, orderViolatedByParameterOfTheSameFunction)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+
+    MockExpectedCallsListForTest expectations;
+    MockCheckedExpectedCall* call1 = expectations.addFunctionOrdered("foo", 1);
+    call1->withParameter("p", 1);
+    call1->callWasMade(2);
+    MockCheckedExpectedCall* call2 = expectations.addFunctionOrdered("foo", 2);
+    call2->withParameter("p", 2);
+    call2->callWasMade(1);
+    MockCallOrderFailure expectedFailure(mockFailureTest(), expectations);
+
+    mock().expectOneCall("foo").withParameter("p", 1);
+    mock().expectOneCall("foo").withParameter("p", 2);
+    mock().actualCall("foo").withParameter("p", 2);
+    mock().actualCall("foo").withParameter("p", 1);
+
+    mock().checkExpectations();
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockStrictOrderTest, orderViolatedByMissingParameterOfTheSameFunction)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+
+    MockExpectedCallsListForTest expectations;
+    MockCheckedExpectedCall* call1 = expectations.addFunctionOrdered("foo", 1);
+    call1->withParameter("p", 1).withParameter("q", 2);
+    call1->callWasMade(2);
+    MockCheckedExpectedCall* call2 = expectations.addFunctionOrdered("foo", 2);
+    call2->withParameter("p", 1);
+    call2->callWasMade(1);
+    MockCallOrderFailure expectedFailure(mockFailureTest(), expectations);
+
+    mock().expectOneCall("foo").withParameter("p", 1).withParameter("q", 2);
+    mock().expectOneCall("foo").withParameter("p", 1);
+    mock().actualCall("foo").withParameter("p", 1);
+    mock().actualCall("foo").withParameter("p", 1).withParameter("q", 2);
+
+    mock().checkExpectations();
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockStrictOrderTest, orderViolatedByObjectOfTheSameFunction)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+    int object1;
+    int object2;
+
+    mock().expectOneCall("foo").onObject(&object1);
+    mock().expectOneCall("foo").onObject(&object2);
+    mock().actualCall("foo").onObject(&object2);
+    mock().actualCall("foo").onObject(&object1);
+
+    mock().checkExpectations();
+    STRCMP_CONTAINS("Mock Failure: Out of order calls", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
+
+TEST(MockStrictOrderTest, unexpectedParameterIsStillReportedInStrictOrder)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+
+    MockExpectedCallsListForTest expectations;
+    expectations.addFunctionOrdered("foo", 1)->withParameter("p", 1);
+    expectations.addFunctionOrdered("foo", 2)->withParameter("p", 2);
+    MockNamedValue parameter("p");
+    parameter.setValue(3);
+    MockUnexpectedInputParameterFailure expectedFailure(mockFailureTest(), "foo", parameter, expectations);
+
+    mock().expectOneCall("foo").withParameter("p", 1);
+    mock().expectOneCall("foo").withParameter("p", 2);
+    mock().actualCall("foo").withParameter("p", 3);
+
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockStrictOrderTest, outputParameterOfTheSameFunctionOutOfOrder)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().strictOrder();
+    int value = 2;
+    int output = 0;
+
+    mock().expectOneCall("foo").withParameter("p", 1);
+    mock().expectOneCall("foo").withOutputParameterReturning("out", &value, sizeof(value));
+    mock().actualCall("foo").withOutputParameter("out", &output);
+    mock().actualCall("foo").withParameter("p", 1);
+    LONGS_EQUAL(2, output);
+
+    mock().checkExpectations();
+    STRCMP_CONTAINS("Mock Failure: Out of order calls", MockFailureReporterForTest::getReporter()->mockFailureString.asCharString());
+}
@@ -169,6 +169,108 @@ TEST(MockSupportTest, tracingWorksHierarchically)
     STRCMP_CONTAINS("foo", mock().getTraceOutput());
 }
 
+TEST(MockSupportTest, tracingToRingBuffer)
+{
+    mock().tracingToRingBuffer(2);
+
+    mock().actualCall("boo");
+    mock("scope").actualCall("foo").withParameter("int", 1);
+
+    STRCMP_EQUAL("\nTrace events dropped:1\nFunction name:scope::foo int:1 (0x1)", mock().getTraceOutput());
+}
+
+TEST(MockSupportTest, functionIdMatchesExpectation)
+{
+    MockFunctionId fooId("foo");
+    mock().expectOneCall("foo").withParameter("value", 1).andReturnValue(2);
+
+    LONGS_EQUAL(2, fooId.actualCall().withParameter("value", 1).returnIntValue());
+}
+
+TEST(MockSupportTest, functionIdIsReusedForManyCalls)
+{
+    MockFunctionId fooId("foo");
+    mock().expectNCalls(3, "foo");
+    mock().expectOneCall("bar");
+
+    fooId.actualCall();
+    fooId.actualCall();
+    mock().actualCall("bar");
+    fooId.actualCall();
+}
+
+TEST(MockSupportTest, functionIdWithScopeMatchesScopedExpectation)
+{
+    MockFunctionId fooId("foo", "scope");
+    mock("scope").expectOneCall("foo");
+
+    fooId.actualCall();
+
+    STRCMP_EQUAL("foo", fooId.getFunctionName());
+    STRCMP_EQUAL("scope", fooId.getScopeName());
+}
+
+TEST(MockSupportTest, functionIdCanBeCalledOnAnotherMockSupport)
+{
+    MockSupport localMock;
+    MockFunctionId fooId("foo");
+    localMock.expectOneCall("foo");
+    mock().expectOneCall("foo");
+
+    localMock.actualCall(fooId);
+    fooId.actualCall();
+    localMock.checkExpectations();
+    localMock.clear();
+}
+
+TEST(MockSupportTest, functionIdIsResolvedAgainAfterClear)
+{
+    MockFunctionId fooId("foo", "scope");
+    mock("scope").expectOneCall("foo");
+    fooId.actualCall();
+    mock().checkExpectations();
+    mock().clear();
+
+    mock("scope").expectOneCall("foo").andReturnValue(3);
+
+    LONGS_EQUAL(3, fooId.actualCall().returnIntValue());
+}
+
+TEST(MockSupportTest, functionIdReportsUnexpectedCall)
+{
+    MockFunctionId fooId("foo", "scope");
+    fooId.actualCall();
+
+    MockUnexpectedCallHappenedFailure expectedFailure(mockFailureTest(), "scope::foo", expectations);
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockSupportTest, functionIdIsIgnoredWhenOtherCallsAreIgnored)
+{
+    MockFunctionId fooId("foo");
+    mock().ignoreOtherCalls();
+
+    fooId.actualCall().withParameter("value", 1);
+}
+
+TEST(MockSupportTest, functionIdIsIgnoredWhenDisabled)
+{
+    MockFunctionId fooId("foo");
+    mock().disable();
+    fooId.actualCall().withParameter("value", 1);
+    mock().enable();
+}
+
+TEST(MockSupportTest, functionIdIsTraced)
+{
+    MockFunctionId fooId("foo", "scope");
+    mock().tracing(true);
+
+    fooId.actualCall().withParameter("value", 1);
+
+    STRCMP_CONTAINS("scope::foo", mock().getTraceOutput());
+}
+
 TEST_GROUP(MockSupportTestWithFixture)
 {
     TestTestingFixture fixture;
@@ -621,6 +621,72 @@ TEST(MockSupport_c, WorksInCFile)
     all_mock_support_c_calls();
 }
 
+static const MockParameter_c allParameters_c[] = {
+    { MOCKVALUETYPE_BOOL, "bool", NULLPTR },
+    { MOCKVALUETYPE_INTEGER, "int", NULLPTR },
+    { MOCKVALUETYPE_UNSIGNED_INTEGER, "unsigned", NULLPTR },
+    { MOCKVALUETYPE_LONG_INTEGER, "long", NULLPTR },
+    { MOCKVALUETYPE_UNSIGNED_LONG_INTEGER, "unsigned long", NULLPTR },
+    { MOCKVALUETYPE_DOUBLE, "double", NULLPTR },
+    { MOCKVALUETYPE_STRING, "string", NULLPTR },
+    { MOCKVALUETYPE_POINTER, "pointer", NULLPTR },
+    { MOCKVALUETYPE_CONST_POINTER, "const pointer", NULLPTR },
+    { MOCKVALUETYPE_FUNCTIONPOINTER, "function pointer", NULLPTR },
+    { MOCKVALUETYPE_MEMORYBUFFER, "buffer", NULLPTR },
+    { MOCKVALUETYPE_OBJECT, "object", "typeName" }
+};
+
+static MockFunction_c allParametersFunction_c = MOCK_FUNCTION_C("all", allParameters_c);
+
+TEST(MockSupport_c, functionHandlePassesAllParameterTypesByPosition)
+{
+    const unsigned char buffer[] = { 0xab, 0xcd };
+    mock_c()->installComparator("typeName", typeNameIsEqual, typeNameValueToString);
+
+    mock_c_expectCall(&allParametersFunction_c, 1, -2, 3u, -4L, 5ul, 6.5, "seven", (void*) 8, (const void*) 9,
+                      dummy_function_for_mock_c_test, buffer, sizeof(buffer), (const void*) 10)->andReturnIntValue(11);
+    LONGS_EQUAL(11, mock_c_actualCall(&allParametersFunction_c, 1, -2, 3u, -4L, 5ul, 6.5, "seven", (void*) 8, (const void*) 9,
+                                      dummy_function_for_mock_c_test, buffer, sizeof(buffer), (const void*) 10)->intReturnValue());
+
+    mock_c()->checkExpectations();
+    mock_c()->removeAllComparatorsAndCopiers();
+}
+
+static const MockParameter_c fdParameter_c[] = { { MOCKVALUETYPE_INTEGER, "fd", NULLPTR } };
+static MockFunction_c closeFunction_c = MOCK_SCOPED_FUNCTION_C("io", "close", fdParameter_c);
+
+TEST(MockSupport_c, functionHandleIsResolvedAgainAfterClear)
+{
+    mock_scope_c("io")->expectOneCall("close")->withIntParameters("fd", 3);
+    mock_c_actualCall(&closeFunction_c, 3);
+    CHECK(closeFunction_c.resolved != NULLPTR);
+    mock_c()->checkExpectations();
+
+    mock_c()->clear();
+    POINTERS_EQUAL(NULLPTR, closeFunction_c.resolved);
+
+    mock_c_expectNCalls(2, &closeFunction_c, 4);
+    mock_c_actualCall(&closeFunction_c, 4);
+    mock_scope_c("io")->actualCall("close")->withIntParameters("fd", 4);
+    mock_c()->checkExpectations();
+}
+
+static void failingCallThroughFunctionHandle_c()
+{
+    mock_c_expectCall(&closeFunction_c, 3);
+    mock_c_actualCall(&closeFunction_c, 4);
+} // LCOV_EXCL_LINE
+
+TEST(MockSupport_c, failingCallThroughFunctionHandleFailsTheTest)
+{
+    TestTestingFixture fixture;
+    fixture.setTestFunction(failingCallThroughFunctionHandle_c);
+    fixture.runAllTests();
+
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains("Unexpected parameter value to parameter \"fd\" to function \"io::close\": <4 (0x4)>");
+}
+
 static bool destructorWasCalled = false;
 
 static void failedCallToMockC()
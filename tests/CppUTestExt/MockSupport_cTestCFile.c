@@ -38,6 +38,15 @@ static const char* typeNameValueToString(const void* object)
     return (const char*) object;
 }
 
+static const MockParameter_c writeParameters[] = {
+    { MOCKVALUETYPE_INTEGER, "fd", NULL },
+    { MOCKVALUETYPE_MEMORYBUFFER, "data", NULL },
+    { MOCKVALUETYPE_STRING, "mode", NULL }
+};
+
+static MockFunction_c writeFunction = MOCK_FUNCTION_C("write", writeParameters);
+static MockFunction_c closeFunction = MOCK_FUNCTION_WITHOUT_PARAMETERS_C("close");
+
 void all_mock_support_c_calls(void)
 {
     mock_c()->strictOrder();
@@ -218,4 +227,14 @@ void all_mock_support_c_calls(void)
     mock_scope_c("other")->expectedCallsLeft();
     mock_scope_c("scope")->expectedCallsLeft();
     mock_scope_c("scope")->actualCall("boo");
+
+    {
+        const unsigned char data[] = { 1, 2 };
+        mock_c_expectCall(&writeFunction, 3, data, sizeof(data), "w")->andReturnIntValue(2);
+        mock_c_expectNCalls(2, &closeFunction);
+        mock_c_actualCall(&writeFunction, 3, data, sizeof(data), "w")->intReturnValue();
+        mock_c_actualCall(&closeFunction);
+        mock_c_actualCall(&closeFunction);
+        mock_c()->checkExpectations();
+    }
 }
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTestExt/PerfCountersPlugin.h"
+
+class FakePerfCountersPlugin : public PerfCountersPlugin
+{
+public:
+    bool available_[NUMBER_OF_COUNTERS];
+    bool started_[NUMBER_OF_COUNTERS];
+    unsigned long values_[NUMBER_OF_COUNTERS];
+    bool readFails_;
+    int opened_;
+    int& closed_;
+    long process_;
+
+    FakePerfCountersPlugin(int& closed) : readFails_(false), opened_(0), closed_(closed), process_(1)
+    {
+        for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+            available_[i] = true;
+            started_[i] = false;
+            values_[i] = 100 + (unsigned long) i;
+        }
+    }
+
+    virtual ~FakePerfCountersPlugin() _destructor_override
+    {
+        closeCounters();
+    }
+
+protected:
+    virtual int openCounter(Counter counter) _override
+    {
+        if (!available_[counter]) return -1;
+        opened_++;
+        return counter;
+    }
+
+    virtual void startCounter(int handle) _override
+    {
+        started_[handle] = true;
+    }
+
+    virtual bool stopCounter(int handle, unsigned long& value) _override
+    {
+        started_[handle] = false;
+        value = values_[handle];
+        return !readFails_;
+    }
+
+    virtual void closeCounter(int) _override
+    {
+        closed_++;
+    }
+
+    virtual long currentProcess() _override
+    {
+        return process_;
+    }
+};
+
+TEST_GROUP(PerfCountersPlugin)
+{
+    StringBufferTestOutput output;
+    TestResult* result;
+    UtestShell* test;
+    FakePerfCountersPlugin* plugin;
+    int closed;
+
+    void setup() _override
+    {
+        closed = 0;
+        result = new TestResult(output);
+        test = new UtestShell("group", "name", "file", 1);
+        plugin = new FakePerfCountersPlugin(closed);
+    }
+
+    void teardown() _override
+    {
+        delete plugin;
+        delete test;
+        delete result;
+    }
+
+    void runTest()
+    {
+        result->currentTestStarted(test);
+        plugin->preTestAction(*test, *result);
+        plugin->postTestAction(*test, *result);
+    }
+
+    void withoutHardwareCounters()
+    {
+        for (int i = PerfCountersPlugin::INSTRUCTIONS; i <= PerfCountersPlugin::BRANCH_MISSES; i++)
+            plugin->available_[i] = false;
+    }
+};
+
+TEST(PerfCountersPlugin, countsNothingUntilActivated)
+{
+    runTest();
+    LONGS_EQUAL(0, plugin->opened_);
+    LONGS_EQUAL(0, result->getCurrentTestCounters().count_);
+}
+
+TEST(PerfCountersPlugin, isActivatedByItsArgument)
+{
+    const char* argv[] = { "-pperfcounters", "-pother" };
+    CHECK(plugin->parseArguments(2, argv, 0));
+    CHECK_FALSE(plugin->parseArguments(2, argv, 1));
+    runTest();
+    CHECK(plugin->isCounting(PerfCountersPlugin::INSTRUCTIONS));
+}
+
+TEST(PerfCountersPlugin, hardwareCountersAreAddedToTheResult)
+{
+    plugin->activate();
+    runTest();
+
+    const TestCounters& counters = result->getCurrentTestCounters();
+    LONGS_EQUAL(4, counters.count_);
+    STRCMP_EQUAL("instructions", counters.names_[0]);
+    LONGS_EQUAL(100, counters.values_[0]);
+    STRCMP_EQUAL("cycles", counters.names_[1]);
+    STRCMP_EQUAL("cache_misses", counters.names_[2]);
+    STRCMP_EQUAL("branch_misses", counters.names_[3]);
+    LONGS_EQUAL(103, counters.values_[3]);
+    CHECK_FALSE(plugin->isCounting(PerfCountersPlugin::TASK_CLOCK));
+}
+
+TEST(PerfCountersPlugin, countersOnlyRunDuringTheTest)
+{
+    plugin->activate();
+    result->currentTestStarted(test);
+    plugin->preTestAction(*test, *result);
+    CHECK(plugin->started_[PerfCountersPlugin::INSTRUCTIONS]);
+    plugin->postTestAction(*test, *result);
+    CHECK_FALSE(plugin->started_[PerfCountersPlugin::INSTRUCTIONS]);
+}
+
+TEST(PerfCountersPlugin, missingHardwareCountersAreLeftOut)
+{
+    plugin->available_[PerfCountersPlugin::CACHE_MISSES] = false;
+    plugin->activate();
+    runTest();
+
+    LONGS_EQUAL(3, result->getCurrentTestCounters().count_);
+    STRCMP_EQUAL("branch_misses", result->getCurrentTestCounters().names_[2]);
+}
+
+TEST(PerfCountersPlugin, fallsBackToSoftwareCountersWithoutHardwareCounters)
+{
+    withoutHardwareCounters();
+    plugin->activate();
+    runTest();
+
+    const TestCounters& counters = result->getCurrentTestCounters();
+    LONGS_EQUAL(2, counters.count_);
+    STRCMP_EQUAL("task_clock_ns", counters.names_[0]);
+    STRCMP_EQUAL("page_faults", counters.names_[1]);
+    LONGS_EQUAL(105, counters.values_[1]);
+}
+
+TEST(PerfCountersPlugin, countersThatCannotBeReadAreNotReported)
+{
+    plugin->readFails_ = true;
+    plugin->activate();
+    runTest();
+    LONGS_EQUAL(0, result->getCurrentTestCounters().count_);
+}
+
+TEST(PerfCountersPlugin, countersAreOpenedOncePerProcess)
+{
+    plugin->activate();
+    runTest();
+    runTest();
+    LONGS_EQUAL(4, plugin->opened_);
+    LONGS_EQUAL(0, closed);
+
+    plugin->process_ = 2;
+    runTest();
+    LONGS_EQUAL(8, plugin->opened_);
+    LONGS_EQUAL(4, closed);
+}
+
+TEST(PerfCountersPlugin, countersAreClosedWithThePlugin)
+{
+    plugin->activate();
+    runTest();
+    delete plugin;
+    plugin = NULLPTR;
+    LONGS_EQUAL(4, closed);
+}
+
+#if CPPUTEST_HAVE_PERF_EVENT
+
+TEST(PerfCountersPlugin, realCountersAreEitherHardwareOrSoftware)
+{
+    PerfCountersPlugin realPlugin;
+    realPlugin.activate();
+    result->currentTestStarted(test);
+    realPlugin.preTestAction(*test, *result);
+    realPlugin.postTestAction(*test, *result);
+
+    const bool hardware = realPlugin.isCounting(PerfCountersPlugin::INSTRUCTIONS) || realPlugin.isCounting(PerfCountersPlugin::CYCLES)
+        || realPlugin.isCounting(PerfCountersPlugin::CACHE_MISSES) || realPlugin.isCounting(PerfCountersPlugin::BRANCH_MISSES);
+    if (hardware) CHECK_FALSE(realPlugin.isCounting(PerfCountersPlugin::TASK_CLOCK));
+    CHECK(result->getCurrentTestCounters().count_ <= 4);
+}
+
+#endif